@@ -45,6 +45,12 @@ If you have questions concerning this license or the applicable additional terms
 	A translation with start == end or a rotation with angle == 0 performs
 	a position test and fills in the trace_t structure accordingly.
 
+	Translation, Rotation, Contents and Contacts are reentrant for threads that
+	own a trace context. The main thread always owns one, any other thread has
+	to acquire a trace context before tracing. Loading models, setting up trace
+	models and drawing is only allowed from the main thread while no other
+	thread is tracing.
+
 ===============================================================================
 */
 
@@ -121,6 +127,10 @@ public:
 	virtual void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+	// Translates a batch of points and reports the first collision for each of them.
+	// Gives the same results as a point Translation for every start/end pair but is faster for many rays.
+	virtual void			PointTranslations( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
 	// Returns the contents touched by the trace model or 0 if the trace model is in free space.
 	virtual int				Contents( const idVec3 &start,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -141,6 +151,11 @@ public:
 	virtual void			ListModels( void ) = 0;
 	// Writes a collision model file for the given map entity.
 	virtual bool			WriteCollisionModelForMapEntity( const idMapEntity *mapEnt, const char *filename, const bool testTraceModel = true ) = 0;
+
+	// Acquires a trace context for the calling thread, returns false if all trace contexts are in use.
+	virtual bool			AcquireTraceContext( void ) = 0;
+	// Releases the trace context acquired by the calling thread.
+	virtual void			ReleaseTraceContext( void ) = 0;
 };
 
 extern idCollisionModelManager *		collisionModelManager;
@@ -59,10 +59,10 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t *tw, cm_b
 	float d, bestd;
 	idVec3 *p;
 
-	if ( b->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( b->traceCheckcount[tw->traceContext] == tw->checkCount ) {
 		return false;
 	}
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
+	b->traceCheckcount[tw->traceContext] = tw->checkCount;
 
 	if ( !(b->contents & tw->contents) ) {
 		return false;
@@ -131,18 +131,18 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {								\
-	if ( !((v)->sideSet & (1<<bitNum)) ) {											\
+#define CM_SetTrmPolygonSidedness( v, mark, plane, bitNum ) {						\
+	if ( !((mark)->sideSet & (1<<bitNum)) ) {										\
 		float fl;																	\
 		fl = plane.Distance( (v)->p );												\
 		/* cannot use float sign bit because it is undetermined when fl == 0.0f */	\
 		if ( fl < 0.0f ) {															\
-			(v)->side |= (1 << bitNum);												\
+			(mark)->side |= (1 << bitNum);											\
 		}																			\
 		else {																		\
-			(v)->side &= ~(1 << bitNum);											\
+			(mark)->side &= ~(1 << bitNum);											\
 		}																			\
-		(v)->sideSet |= (1 << bitNum);												\
+		(mark)->sideSet |= (1 << bitNum);											\
 	}																				\
 }
 
@@ -160,12 +160,13 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	cm_trmEdge_t *trmEdge;
 	cm_edge_t *edge;
 	cm_vertex_t *v, *v1, *v2;
+	cm_traceMark_t *edgeMark, *vertexMark, *v1Mark, *v2Mark;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->traceCheckcount[tw->traceContext] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->traceCheckcount[tw->traceContext] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -197,14 +198,14 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
 			// if this edge is already tested
-			if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( edge->traceMarks[tw->traceContext].checkcount == tw->checkCount ) {
 				continue;
 			}
 
 			for ( j = 0; j < 2; j++ ) {
 				v = &tw->model->vertices[edge->vertexNum[j]];
 				// if this vertex is already tested
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( v->traceMarks[tw->traceContext].checkcount == tw->checkCount ) {
 					continue;
 				}
 
@@ -239,19 +240,20 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		edgeMark = &edge->traceMarks[tw->traceContext];
 		// reset sidedness cache if this is the first time we encounter this edge
-		if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			edge->sideSet = 0;
+		if ( edgeMark->checkcount != tw->checkCount ) {
+			edgeMark->sideSet = 0;
 		}
 		// pluecker coordinate for edge
 		tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[edge->vertexNum[0]].p,
 													tw->model->vertices[edge->vertexNum[1]].p );
-		v = &tw->model->vertices[edge->vertexNum[INTSIGNBITSET(edgeNum)]];
+		vertexMark = &tw->model->vertices[edge->vertexNum[INTSIGNBITSET(edgeNum)]].traceMarks[tw->traceContext];
 		// reset sidedness cache if this is the first time we encounter this vertex
-		if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			v->sideSet = 0;
+		if ( vertexMark->checkcount != tw->checkCount ) {
+			vertexMark->sideSet = 0;
 		}
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		vertexMark->checkcount = tw->checkCount;
 	}
 
 	// get side of polygon for each trm vertex
@@ -273,8 +275,9 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[j];
 			edge = tw->model->edges + abs(edgeNum);
 #if 1
-			CM_SetTrmEdgeSidedness( edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
-			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> i) & 1) ^ flip ) {
+			edgeMark = &edge->traceMarks[tw->traceContext];
+			CM_SetTrmEdgeSidedness( edgeMark, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
+			if ( INTSIGNBITSET(edgeNum) ^ ((edgeMark->side >> i) & 1) ^ flip ) {
 				break;
 			}
 #else
@@ -312,22 +315,25 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		edgeMark = &edge->traceMarks[tw->traceContext];
+		if ( edgeMark->checkcount == tw->checkCount ) {
 			continue;
 		}
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		edgeMark->checkcount = tw->checkCount;
 
 		for ( j = 0; j < tw->numPolys; j++ ) {
 #if 1
 			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness( v1, tw->polys[j].plane, j );
+			v1Mark = &v1->traceMarks[tw->traceContext];
+			CM_SetTrmPolygonSidedness( v1, v1Mark, tw->polys[j].plane, j );
 			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness( v2, tw->polys[j].plane, j );
+			v2Mark = &v2->traceMarks[tw->traceContext];
+			CM_SetTrmPolygonSidedness( v2, v2Mark, tw->polys[j].plane, j );
 			// if the polygon edge does not cross the trm polygon plane
-			if ( !(((v1->side ^ v2->side) >> j) & 1) ) {
+			if ( !(((v1Mark->side ^ v2Mark->side) >> j) & 1) ) {
 				continue;
 			}
-			flip = (v1->side >> j) & 1;
+			flip = (v1Mark->side >> j) & 1;
 #else
 			float d1, d2;
 
@@ -350,8 +356,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 				trmEdge = tw->edges + abs(trmEdgeNum);
 #if 1
 				bitNum = abs(trmEdgeNum);
-				CM_SetTrmEdgeSidedness( edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
-				if ( INTSIGNBITSET(trmEdgeNum) ^ ((edge->side >> bitNum) & 1) ^ flip ) {
+				CM_SetTrmEdgeSidedness( edgeMark, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
+				if ( INTSIGNBITSET(trmEdgeNum) ^ ((edgeMark->side >> bitNum) & 1) ^ flip ) {
 					break;
 				}
 #else
@@ -482,6 +488,7 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 	bool model_rotated, trm_rotated;
 	idMat3 invModelAxis, tmpAxis;
 	idVec3 dir;
+	cm_traceContext_t *context = GetTraceContext();
 	ALIGN16( cm_traceWork_t tw );
 
 	// fast point case
@@ -497,8 +504,8 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 		return results->c.contents;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
-
+	tw.traceContext = context - traceContexts;
+	tw.checkCount = ++context->checkCount;
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -628,7 +635,7 @@ int idCollisionModelManagerLocal::Contents( const idVec3 &start,
 									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
 	trace_t results;
 
-	if ( model < 0 || model > idCollisionModelManagerLocal::maxModels || model > MAX_SUBMODELS ) {
+	if ( model < 0 || model >= CM_MAX_MODEL_HANDLES || model >= idCollisionModelManagerLocal::maxModels + CM_MAX_TRACE_CONTEXTS ) {
 		common->Printf("idCollisionModelManagerLocal::Contents: invalid model handle\n");
 		return 0;
 	}
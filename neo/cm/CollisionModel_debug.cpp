@@ -350,6 +350,10 @@ static idCVar cm_testWalk(			"cm_testWalk",			"1",					CVAR_GAME | CVAR_BOOL,		"
 static idCVar cm_testLength(		"cm_testLength",		"1024",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testRadius(		"cm_testRadius",		"64",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testAngle(			"cm_testAngle",			"60",					CVAR_GAME | CVAR_FLOAT,		"" );
+static idCVar cm_testThreads(		"cm_testThreads",		"0",					CVAR_GAME | CVAR_INTEGER,	"number of threads that repeat the test translations and compare the results with the main thread", 0, CM_MAX_TRACE_CONTEXTS - 1 );
+static idCVar cm_testRays(			"cm_testRays",			"0",					CVAR_GAME | CVAR_BOOL,		"compare single point traces with batched point traces for coherent and random rays" );
+static idCVar cm_recordTraces(		"cm_recordTraces",		"0",					CVAR_GAME | CVAR_INTEGER,	"records the next n translations of the main thread into the trace corpus of the map" );
+static idCVar cm_testTraceCorpus(	"cm_testTraceCorpus",	"0",					CVAR_GAME | CVAR_BOOL,		"replays the trace corpus of the map and compares the results bit for bit with the scalar sidedness tests" );
 
 static int total_translation;
 static int min_translation = 999999;
@@ -373,6 +377,22 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 	idBounds bounds;
 	trace_t trace;
 
+	if ( cm_recordTraces.GetInteger() > 0 ) {
+		numTracesToRecord = cm_recordTraces.GetInteger();
+		recordedTraces.Clear();
+		recordedTraces.SetGranularity( 1024 );
+		recordedTrms.Clear();
+		cm_recordTraces.SetInteger( 0 );
+		common->Printf( "recording %d traces\n", numTracesToRecord );
+	} else if ( numTracesToRecord <= 0 && recordedTraces.Num() ) {
+		WriteTraceCorpus();
+	}
+
+	if ( cm_testTraceCorpus.GetBool() ) {
+		cm_testTraceCorpus.SetBool( false );
+		TestTraceCorpus();
+	}
+
 	if ( !cm_testCollision.GetBool() ) {
 		return;
 	}
@@ -438,7 +458,38 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 	} else {
 		sprintf( buf, "%4d", cm_testTimes.GetInteger() );
 	}
-	common->Printf("%s translations: %4d milliseconds, (min = %d, max = %d, av = %1.1f)\n", buf, t, min_translation, max_translation, (float) total_translation / num_translation );
+	common->Printf("%s translations: %4d milliseconds, (min = %d, max = %d, av = %1.1f, %1.0f traces/sec)\n", buf, t, min_translation, max_translation, (float) total_translation / num_translation,
+						(float) cm_testTimes.GetInteger() * num_translation * 1000.0f / Max( total_translation, 1 ) );
+
+	if ( cm_testThreads.GetInteger() > 0 ) {
+		TestParallelTraces( start, itm, boxAxis, testend, cm_testTimes.GetInteger(), cm_testModel.GetInteger() );
+	}
+
+	if ( cm_testRays.GetBool() ) {
+		idVec3 *teststart = (idVec3 *) Mem_Alloc( cm_testTimes.GetInteger() * sizeof(idVec3) );
+
+		// rays from random points near the start in random directions
+		for ( k = 0; k < cm_testTimes.GetInteger(); k++ ) {
+			for ( i = 0; i < 3; i++ ) {
+				teststart[k][i] = start[i] + random.CRandomFloat() * cm_testRadius.GetFloat();
+			}
+		}
+		TestPointTranslations( "random", teststart, testend, cm_testTimes.GetInteger(), cm_testModel.GetInteger() );
+
+		// rays from the start in a narrow cone around a random direction
+		for ( i = 0; i < 3; i++ ) {
+			end[i] = start[i] + random.CRandomFloat() * cm_testLength.GetFloat();
+		}
+		for ( k = 0; k < cm_testTimes.GetInteger(); k++ ) {
+			teststart[k] = start;
+			for ( i = 0; i < 3; i++ ) {
+				testend[k][i] = end[i] + random.CRandomFloat() * cm_testRadius.GetFloat();
+			}
+		}
+		TestPointTranslations( "coherent", teststart, testend, cm_testTimes.GetInteger(), cm_testModel.GetInteger() );
+
+		Mem_Free( teststart );
+	}
 
 	if ( cm_testRandomMany.GetBool() ) {
 		// if many traces in one random direction
@@ -486,3 +537,384 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 	Mem_Free( testend );
 	testend = NULL;
 }
+
+/*
+===============================================================================
+
+Parallel trace test
+
+===============================================================================
+*/
+
+typedef struct cm_parallelTest_s {
+	xthreadInfo			thread;
+	int					threadNum;
+	const idVec3 *		start;
+	const idTraceModel *trm;
+	const idMat3 *		trmAxis;
+	const idVec3 *		ends;
+	const trace_t *		results;
+	const int *			contents;
+	int					numTraces;
+	cmHandle_t			model;
+	bool				acquired;
+	int					numMismatches;
+	volatile bool		done;
+} cm_parallelTest_t;
+
+/*
+================
+CM_TracesEqual
+================
+*/
+static bool CM_TracesEqual( const trace_t &a, const trace_t &b ) {
+	if ( a.fraction != b.fraction || !a.endpos.Compare( b.endpos ) ) {
+		return false;
+	}
+	if ( a.fraction < 1.0f ) {
+		if ( !a.c.normal.Compare( b.c.normal ) || a.c.dist != b.c.dist || a.c.contents != b.c.contents ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+CM_ParallelTestThread
+
+  runs the test translations starting at a different trace for every thread
+================
+*/
+static unsigned int CM_ParallelTestThread( void *parms ) {
+	cm_parallelTest_t *test = (cm_parallelTest_t *) parms;
+	trace_t trace;
+	int i, j, contents;
+
+	// the main thread always owns a trace context
+	test->acquired = ( test->threadNum == 0 ) || collisionModelManager->AcquireTraceContext();
+	if ( test->acquired ) {
+		for ( j = 0; j < test->numTraces; j++ ) {
+			i = ( j + test->threadNum * test->numTraces / CM_MAX_TRACE_CONTEXTS ) % test->numTraces;
+			collisionModelManager->Translation( &trace, *test->start, test->ends[i], test->trm, *test->trmAxis, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, test->model, vec3_origin, mat3_identity );
+			if ( !CM_TracesEqual( trace, test->results[i] ) ) {
+				test->numMismatches++;
+			}
+			contents = collisionModelManager->Contents( test->ends[i], test->trm, *test->trmAxis, -1, test->model, vec3_origin, mat3_identity );
+			if ( contents != test->contents[i] ) {
+				test->numMismatches++;
+			}
+		}
+		if ( test->threadNum != 0 ) {
+			collisionModelManager->ReleaseTraceContext();
+		}
+	}
+	test->done = true;
+	return 0;
+}
+
+/*
+================
+idCollisionModelManagerLocal::TestParallelTraces
+
+  the traces are run on the main thread first and then at the same time on the main thread and cm_testThreads other threads
+================
+*/
+void idCollisionModelManagerLocal::TestParallelTraces( const idVec3 &start, const idTraceModel &trm, const idMat3 &trmAxis, const idVec3 *ends, int numTraces, cmHandle_t model ) {
+	int i, numThreads, numMismatches, serialTime, parallelTime;
+	trace_t trace, *results;
+	int *contents;
+	cm_parallelTest_t tests[CM_MAX_TRACE_CONTEXTS];
+	bool done;
+
+	numThreads = idMath::ClampInt( 1, CM_MAX_TRACE_CONTEXTS - 1, cm_testThreads.GetInteger() );
+
+	results = (trace_t *) Mem_Alloc( numTraces * sizeof( trace_t ) );
+	contents = (int *) Mem_Alloc( numTraces * sizeof( int ) );
+
+	serialTime = Sys_Milliseconds();
+	for ( i = 0; i < numTraces; i++ ) {
+		Translation( &results[i], start, ends[i], &trm, trmAxis, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, model, vec3_origin, mat3_identity );
+		contents[i] = Contents( ends[i], &trm, trmAxis, -1, model, vec3_origin, mat3_identity );
+	}
+	serialTime = Sys_Milliseconds() - serialTime;
+
+	parallelTime = Sys_Milliseconds();
+	for ( i = 0; i <= numThreads; i++ ) {
+		tests[i].threadNum = i;
+		tests[i].start = &start;
+		tests[i].trm = &trm;
+		tests[i].trmAxis = &trmAxis;
+		tests[i].ends = ends;
+		tests[i].results = results;
+		tests[i].contents = contents;
+		tests[i].numTraces = numTraces;
+		tests[i].model = model;
+		tests[i].acquired = false;
+		tests[i].numMismatches = 0;
+		tests[i].done = false;
+		if ( i > 0 ) {
+			Sys_CreateThread( CM_ParallelTestThread, &tests[i], THREAD_NORMAL, tests[i].thread, "cm_testThreads", g_threads, &g_thread_count );
+		}
+	}
+	// the main thread traces with its own context at the same time
+	CM_ParallelTestThread( &tests[0] );
+	do {
+		done = true;
+		for ( i = 1; i <= numThreads; i++ ) {
+			if ( !tests[i].done ) {
+				done = false;
+			}
+		}
+		if ( !done ) {
+			Sys_Sleep( 1 );
+		}
+	} while( !done );
+	parallelTime = Sys_Milliseconds() - parallelTime;
+
+	numMismatches = 0;
+	for ( i = 0; i <= numThreads; i++ ) {
+		if ( i > 0 ) {
+			Sys_DestroyThread( tests[i].thread );
+		}
+		if ( !tests[i].acquired ) {
+			common->Warning( "cm_testThreads: thread %d could not acquire a trace context", i );
+		}
+		numMismatches += tests[i].numMismatches;
+	}
+
+	common->Printf( "%d threads x %d traces: serial %d msec, parallel %d msec, %d mismatches\n", numThreads + 1, numTraces * 2, serialTime, parallelTime, numMismatches );
+
+	Mem_Free( results );
+	Mem_Free( contents );
+}
+
+/*
+===============================================================================
+
+Batched point trace test
+
+===============================================================================
+*/
+
+/*
+================
+idCollisionModelManagerLocal::TestPointTranslations
+
+  runs the rays one at a time and then batched and reports the rays per second of both
+================
+*/
+void idCollisionModelManagerLocal::TestPointTranslations( const char *name, const idVec3 *starts, const idVec3 *ends, int numTraces, cmHandle_t model ) {
+	int i, numHits, numMismatches;
+	double serialTime, batchTime;
+	trace_t *serial, *batch;
+	idTimer timer;
+
+	serial = (trace_t *) Mem_Alloc( numTraces * sizeof( trace_t ) );
+	batch = (trace_t *) Mem_Alloc( numTraces * sizeof( trace_t ) );
+
+	timer.Start();
+	for ( i = 0; i < numTraces; i++ ) {
+		Translation( &serial[i], starts[i], ends[i], NULL, mat3_identity, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, model, vec3_origin, mat3_identity );
+	}
+	timer.Stop();
+	serialTime = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	PointTranslations( batch, starts, ends, numTraces, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, model, vec3_origin, mat3_identity );
+	timer.Stop();
+	batchTime = timer.Milliseconds();
+
+	numHits = numMismatches = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( serial[i].fraction < 1.0f ) {
+			numHits++;
+		}
+		if ( !CM_TracesEqual( serial[i], batch[i] ) ) {
+			numMismatches++;
+		}
+	}
+
+	common->Printf( "%d %s point traces (%d hits): single %1.2f msec (%1.0f rays/sec), batched %1.2f msec (%1.0f rays/sec), %d mismatches\n",
+						numTraces, name, numHits, serialTime, numTraces * 1000.0 / Max( serialTime, 0.001 ),
+						batchTime, numTraces * 1000.0 / Max( batchTime, 0.001 ), numMismatches );
+
+	Mem_Free( serial );
+	Mem_Free( batch );
+}
+
+/*
+===============================================================================
+
+Trace corpus
+
+===============================================================================
+*/
+
+/*
+================
+CM_TraceResultFromTrace
+================
+*/
+static void CM_TraceResultFromTrace( cm_traceResult_t &result, const trace_t &trace ) {
+	memset( &result, 0, sizeof( result ) );
+	result.fraction = trace.fraction;
+	result.endpos = trace.endpos;
+	result.endAxis = trace.endAxis;
+	result.type = trace.c.type;
+	result.point = trace.c.point;
+	result.normal = trace.c.normal;
+	result.dist = trace.c.dist;
+	result.contents = trace.c.contents;
+	result.modelFeature = trace.c.modelFeature;
+	result.trmFeature = trace.c.trmFeature;
+}
+
+/*
+================
+idCollisionModelManagerLocal::RecordTrace
+================
+*/
+void idCollisionModelManagerLocal::RecordTrace( const idVec3 &start, const idVec3 &end, const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	int i;
+
+	cm_recordedTrace_t &trace = recordedTraces.Alloc();
+	trace.start = start;
+	trace.end = end;
+	trace.trmNum = -1;
+	if ( trm ) {
+		for ( i = 0; i < recordedTrms.Num(); i++ ) {
+			if ( !memcmp( &recordedTrms[i], trm, sizeof( idTraceModel ) ) ) {
+				break;
+			}
+		}
+		if ( i >= recordedTrms.Num() ) {
+			recordedTrms.Append( *trm );
+		}
+		trace.trmNum = i;
+	}
+	trace.trmAxis = trmAxis;
+	trace.contentMask = contentMask;
+	trace.model = model;
+	trace.modelOrigin = modelOrigin;
+	trace.modelAxis = modelAxis;
+	memset( &trace.result, 0, sizeof( trace.result ) );
+
+	numTracesToRecord--;
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteTraceCorpus
+
+  stores the recorded traces with the results of the scalar sidedness tests in maps/<map>.trc
+================
+*/
+void idCollisionModelManagerLocal::WriteTraceCorpus( void ) {
+	int i;
+	idStr fileName;
+	idFile *fp;
+	trace_t trace;
+
+	fileName = mapName;
+	fileName.SetFileExtension( "trc" );
+
+	fp = fileSystem->OpenFileWrite( fileName );
+	if ( !fp ) {
+		common->Warning( "idCollisionModelManagerLocal::WriteTraceCorpus: Error opening file %s", fileName.c_str() );
+	} else {
+		cm_scalarPlueckers = true;
+		for ( i = 0; i < recordedTraces.Num(); i++ ) {
+			cm_recordedTrace_t &rec = recordedTraces[i];
+			Translation( &trace, rec.start, rec.end, rec.trmNum >= 0 ? &recordedTrms[rec.trmNum] : NULL, rec.trmAxis,
+							rec.contentMask, rec.model, rec.modelOrigin, rec.modelAxis );
+			CM_TraceResultFromTrace( rec.result, trace );
+		}
+		cm_scalarPlueckers = false;
+
+		// the corpus is only replayed on the machine that recorded it, so it is stored in native byte order
+		fp->WriteInt( CM_TRACE_CORPUS_IDENT );
+		fp->WriteInt( CM_TRACE_CORPUS_VERSION );
+		fp->WriteString( mapName );
+		fp->WriteInt( recordedTrms.Num() );
+		fp->Write( recordedTrms.Ptr(), recordedTrms.Num() * sizeof( idTraceModel ) );
+		fp->WriteInt( recordedTraces.Num() );
+		fp->Write( recordedTraces.Ptr(), recordedTraces.Num() * sizeof( cm_recordedTrace_t ) );
+		fileSystem->CloseFile( fp );
+
+		common->Printf( "wrote %d traces with %d trace models to %s\n", recordedTraces.Num(), recordedTrms.Num(), fileName.c_str() );
+	}
+
+	recordedTraces.Clear();
+	recordedTrms.Clear();
+}
+
+/*
+================
+idCollisionModelManagerLocal::TestTraceCorpus
+
+  replays maps/<map>.trc with the SSE and the scalar sidedness tests, compares
+  the results bit for bit with the recorded results and reports the traces per second
+================
+*/
+void idCollisionModelManagerLocal::TestTraceCorpus( void ) {
+	int i, pass, ident, version, numTrms, numTraces, numMismatches[2];
+	double time[2];
+	idStr fileName, corpusMap;
+	idFile *fp;
+	idList<idTraceModel> trms;
+	idList<cm_recordedTrace_t> traces;
+	trace_t trace;
+	cm_traceResult_t result;
+	idTimer timer;
+
+	fileName = mapName;
+	fileName.SetFileExtension( "trc" );
+
+	fp = fileSystem->OpenFileRead( fileName );
+	if ( !fp ) {
+		common->Warning( "no trace corpus %s, record one with cm_recordTraces", fileName.c_str() );
+		return;
+	}
+
+	fp->ReadInt( ident );
+	fp->ReadInt( version );
+	fp->ReadString( corpusMap );
+	if ( ident != CM_TRACE_CORPUS_IDENT || version != CM_TRACE_CORPUS_VERSION || corpusMap.Icmp( mapName ) ) {
+		common->Warning( "%s is not a version %d trace corpus of %s", fileName.c_str(), CM_TRACE_CORPUS_VERSION, mapName.c_str() );
+		fileSystem->CloseFile( fp );
+		return;
+	}
+	fp->ReadInt( numTrms );
+	trms.SetNum( numTrms );
+	fp->Read( trms.Ptr(), numTrms * sizeof( idTraceModel ) );
+	fp->ReadInt( numTraces );
+	traces.SetNum( numTraces );
+	fp->Read( traces.Ptr(), numTraces * sizeof( cm_recordedTrace_t ) );
+	fileSystem->CloseFile( fp );
+
+	for ( pass = 0; pass < 2; pass++ ) {
+		cm_scalarPlueckers = ( pass == 1 );
+		numMismatches[pass] = 0;
+		timer.Clear();
+		for ( i = 0; i < numTraces; i++ ) {
+			const cm_recordedTrace_t &rec = traces[i];
+			timer.Start();
+			Translation( &trace, rec.start, rec.end, rec.trmNum >= 0 ? &trms[rec.trmNum] : NULL, rec.trmAxis,
+							rec.contentMask, rec.model, rec.modelOrigin, rec.modelAxis );
+			timer.Stop();
+			CM_TraceResultFromTrace( result, trace );
+			if ( memcmp( &result, &rec.result, sizeof( result ) ) ) {
+				numMismatches[pass]++;
+			}
+		}
+		time[pass] = timer.Milliseconds();
+	}
+	cm_scalarPlueckers = false;
+
+	common->Printf( "%d traces from %s: SSE %1.2f msec (%1.0f traces/sec, %d mismatches), scalar %1.2f msec (%1.0f traces/sec, %d mismatches)\n",
+						numTraces, fileName.c_str(), time[0], numTraces * 1000.0 / Max( time[0], 0.001 ), numMismatches[0],
+						time[1], numTraces * 1000.0 / Max( time[1], 0.001 ), numMismatches[1] );
+}
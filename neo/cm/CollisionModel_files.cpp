@@ -328,9 +328,8 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer *src, cm_model_t *mode
 	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
 	for ( i = 0; i < model->numVertices; i++ ) {
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
 		model->vertices[i].checkcount = 0;
+		memset( model->vertices[i].traceMarks, 0, sizeof( model->vertices[i].traceMarks ) );
 	}
 	src->ExpectTokenString( "}" );
 }
@@ -352,12 +351,11 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer *src, cm_model_t *model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
 		model->edges[i].checkcount = 0;
+		memset( model->edges[i].traceMarks, 0, sizeof( model->edges[i].traceMarks ) );
 		model->numInternalEdges += model->edges[i].internal;
 	}
 	src->ExpectTokenString( "}" );
@@ -425,6 +423,7 @@ void idCollisionModelManagerLocal::ParsePolygons( idLexer *src, cm_model_t *mode
 		p->material = declManager->FindMaterial( token );
 		p->contents = p->material->GetContentFlags();
 		p->checkcount = 0;
+		memset( p->traceCheckcount, 0, sizeof( p->traceCheckcount ) );
 		// filter polygon into tree
 		R_FilterPolygonIntoTree( model, model->node, NULL, p );
 	}
@@ -469,6 +468,7 @@ void idCollisionModelManagerLocal::ParseBrushes( idLexer *src, cm_model_t *model
 			b->contents = ContentsFromString( token );
 		}
 		b->checkcount = 0;
+		memset( b->traceCheckcount, 0, sizeof( b->traceCheckcount ) );
 		b->primitiveNum = 0;
 		// filter brush into tree
 		R_FilterBrushIntoTree( model, model->node, NULL, b );
@@ -531,6 +531,8 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 	// calculate edge normals
 	checkCount++;
 	CalculateEdgeNormals( model, model->node );
+	// store the edge pluecker coordinates with the polygons
+	SetupPolygonPlueckers( model );
 	// get model bounds from brush and polygon bounds
 	CM_GetNodeBounds( &model->bounds, model->node );
 	// get model contents
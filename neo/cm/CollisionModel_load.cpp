@@ -184,14 +184,14 @@ void idCollisionModelManagerLocal::Clear( void ) {
 	numModels = 0;
 	models = NULL;
 	memset( trmPolygons, 0, sizeof( trmPolygons ) );
-	trmBrushes[0] = NULL;
+	memset( trmBrushes, 0, sizeof( trmBrushes ) );
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
+	numTracesToRecord = 0;
+	recordedTraces.Clear();
+	recordedTrms.Clear();
+	ClearTraceContexts();
 }
 
 /*
@@ -391,6 +391,10 @@ void idCollisionModelManagerLocal::FreeModel( cm_model_t *model ) {
 	Mem_Free( model->polygonBlock );
 	// free block allocated brushes
 	Mem_Free( model->brushBlock );
+	// free polygon edge pluecker coordinates
+	if ( model->polygonPlueckers ) {
+		Mem_Free16( model->polygonPlueckers );
+	}
 	// free edges
 	Mem_Free( model->edges );
 	// free vertices
@@ -434,21 +438,26 @@ idCollisionModelManagerLocal::FreeTrmModelStructure
 ================
 */
 void idCollisionModelManagerLocal::FreeTrmModelStructure( void ) {
-	int i;
+	int i, c;
+	cm_model_t *model;
 
 	assert( models );
-	if ( !models[MAX_SUBMODELS] ) {
-		return;
-	}
+	for ( c = 0; c < CM_MAX_TRACE_CONTEXTS; c++ ) {
+		model = models[TRACE_MODEL_HANDLE + c];
+		if ( !model ) {
+			continue;
+		}
 
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		FreePolygon( models[MAX_SUBMODELS], trmPolygons[i]->p );
-	}
-	FreeBrush( models[MAX_SUBMODELS], trmBrushes[0]->b );
+		for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
+			FreePolygon( model, trmPolygons[c][i]->p );
+		}
+		FreeBrush( model, trmBrushes[c]->b );
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel( models[MAX_SUBMODELS] );
+		model->node->polygons = NULL;
+		model->node->brushes = NULL;
+		FreeModel( model );
+		models[TRACE_MODEL_HANDLE + c] = NULL;
+	}
 }
 
 
@@ -553,6 +562,7 @@ cm_model_t *idCollisionModelManagerLocal::AllocModel( void ) {
 	model->brushRefBlocks = NULL;
 	model->polygonBlock = NULL;
 	model->brushBlock = NULL;
+	model->polygonPlueckers = NULL;
 	model->numPolygons = model->polygonMemory =
 	model->numBrushes = model->brushMemory =
 	model->numNodes = model->numBrushRefs =
@@ -670,6 +680,7 @@ cm_polygon_t *idCollisionModelManagerLocal::AllocPolygon( cm_model_t *model, int
 	} else {
 		poly = (cm_polygon_t *) Mem_Alloc( size );
 	}
+	poly->plueckers = NULL;
 	return poly;
 }
 
@@ -728,66 +739,76 @@ void idCollisionModelManagerLocal::AddBrushToNode( cm_model_t *model, cm_node_t
 /*
 ================
 idCollisionModelManagerLocal::SetupTrmModelStructure
+
+  each trace context gets its own trace model slot so threads can convert trace models at the same time
 ================
 */
 void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
-	int i;
+	int i, c;
 	cm_node_t *node;
 	cm_model_t *model;
 
-	// setup model
-	model = AllocModel();
-
-	assert( models );
-	models[MAX_SUBMODELS] = model;
-	// create node to hold the collision data
-	node = (cm_node_t *) AllocNode( model, 1 );
-	node->planeType = -1;
-	model->node = node;
-	// allocate vertex and edge arrays
-	model->numVertices = 0;
-	model->maxVertices = MAX_TRACEMODEL_VERTS;
-	model->vertices = (cm_vertex_t *) Mem_ClearedAlloc( model->maxVertices * sizeof(cm_vertex_t) );
-	model->numEdges = 0;
-	model->maxEdges = MAX_TRACEMODEL_EDGES+1;
-	model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
 	// create a material for the trace model polygons
 	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
 	if ( !trmMaterial ) {
 		common->FatalError( "_tracemodel material not found" );
 	}
 
-	// allocate polygons
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		trmPolygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
-		trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
-		trmPolygons[i]->p->bounds.Clear();
-		trmPolygons[i]->p->plane.Zero();
-		trmPolygons[i]->p->checkcount = 0;
-		trmPolygons[i]->p->contents = -1;		// all contents
-		trmPolygons[i]->p->material = trmMaterial;
-		trmPolygons[i]->p->numEdges = 0;
+	assert( models );
+	for ( c = 0; c < CM_MAX_TRACE_CONTEXTS; c++ ) {
+		// setup model
+		model = AllocModel();
+
+		models[TRACE_MODEL_HANDLE + c] = model;
+		// create node to hold the collision data
+		node = (cm_node_t *) AllocNode( model, 1 );
+		node->planeType = -1;
+		model->node = node;
+		// allocate vertex and edge arrays
+		model->numVertices = 0;
+		model->maxVertices = MAX_TRACEMODEL_VERTS;
+		model->vertices = (cm_vertex_t *) Mem_ClearedAlloc( model->maxVertices * sizeof(cm_vertex_t) );
+		model->numEdges = 0;
+		model->maxEdges = MAX_TRACEMODEL_EDGES+1;
+		model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
+
+		// allocate polygons
+		model->polygonPlueckers = (float *) Mem_Alloc16( MAX_TRACEMODEL_POLYS * 6 * CM_PLUECKER_STRIDE( MAX_TRACEMODEL_POLYEDGES ) * sizeof( float ) );
+		for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
+			trmPolygons[c][i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
+			trmPolygons[c][i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
+			trmPolygons[c][i]->p->plueckers = model->polygonPlueckers + i * 6 * CM_PLUECKER_STRIDE( MAX_TRACEMODEL_POLYEDGES );
+			trmPolygons[c][i]->p->bounds.Clear();
+			trmPolygons[c][i]->p->plane.Zero();
+			trmPolygons[c][i]->p->checkcount = 0;
+			memset( trmPolygons[c][i]->p->traceCheckcount, 0, sizeof( trmPolygons[c][i]->p->traceCheckcount ) );
+			trmPolygons[c][i]->p->contents = -1;		// all contents
+			trmPolygons[c][i]->p->material = trmMaterial;
+			trmPolygons[c][i]->p->numEdges = 0;
+		}
+		// allocate brush for position test
+		trmBrushes[c] = AllocBrushReference( model, 1 );
+		trmBrushes[c]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
+		trmBrushes[c]->b->primitiveNum = 0;
+		trmBrushes[c]->b->bounds.Clear();
+		trmBrushes[c]->b->checkcount = 0;
+		memset( trmBrushes[c]->b->traceCheckcount, 0, sizeof( trmBrushes[c]->b->traceCheckcount ) );
+		trmBrushes[c]->b->contents = -1;		// all contents
+		trmBrushes[c]->b->numPlanes = 0;
 	}
-	// allocate brush for position test
-	trmBrushes[0] = AllocBrushReference( model, 1 );
-	trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
-	trmBrushes[0]->b->primitiveNum = 0;
-	trmBrushes[0]->b->bounds.Clear();
-	trmBrushes[0]->b->checkcount = 0;
-	trmBrushes[0]->b->contents = -1;		// all contents
-	trmBrushes[0]->b->numPlanes = 0;
 }
 
 /*
 ================
 idCollisionModelManagerLocal::SetupTrmModel
 
-Trace models (item boxes, etc) are converted to collision models on the fly, using the last model slot
-as a reusable temporary buffer
+Trace models (item boxes, etc) are converted to collision models on the fly, using the model slot
+of the trace context of the calling thread as a reusable temporary buffer
 ================
 */
 cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm, const idMaterial *material ) {
-	int i, j;
+	int i, j, c;
+	cmHandle_t handle;
 	cm_vertex_t *vertex;
 	cm_edge_t *edge;
 	cm_polygon_t *poly;
@@ -802,12 +823,16 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		material = trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
+	// the trace model slot of the trace context of this thread
+	c = GetTraceContext() - traceContexts;
+	handle = TRACE_MODEL_HANDLE + c;
+
+	model = models[handle];
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 	// if not a valid trace model
 	if ( trm.type == TRM_INVALID || !trm.numPolys ) {
-		return TRACE_MODEL_HANDLE;
+		return handle;
 	}
 	// vertices
 	model->numVertices = trm.numVerts;
@@ -815,7 +840,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	trmVert = trm.verts;
 	for ( i = 0; i < trm.numVerts; i++, vertex++, trmVert++ ) {
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
+		memset( &vertex->traceMarks[c], 0, sizeof( vertex->traceMarks[c] ) );
 	}
 	// edges
 	model->numEdges = trm.numEdges;
@@ -826,13 +851,13 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
+		memset( &edge->traceMarks[c], 0, sizeof( edge->traceMarks[c] ) );
 	}
 	// polygons
 	model->numPolygons = trm.numPolys;
 	trmPoly = trm.polys;
 	for ( i = 0; i < trm.numPolys; i++, trmPoly++ ) {
-		poly = trmPolygons[i]->p;
+		poly = trmPolygons[c][i]->p;
 		poly->numEdges = trmPoly->numEdges;
 		for ( j = 0; j < trmPoly->numEdges; j++ ) {
 			poly->edges[j] = trmPoly->edges[j];
@@ -841,28 +866,29 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		poly->plane.SetDist( trmPoly->dist );
 		poly->bounds = trmPoly->bounds;
 		poly->material = material;
+		CM_SetupPolygonPlueckers( model, poly );
 		// link polygon at node
-		trmPolygons[i]->next = model->node->polygons;
-		model->node->polygons = trmPolygons[i];
+		trmPolygons[c][i]->next = model->node->polygons;
+		model->node->polygons = trmPolygons[c][i];
 	}
 	// if the trace model is convex
 	if ( trm.isConvex ) {
 		// setup brush for position test
-		trmBrushes[0]->b->numPlanes = trm.numPolys;
+		trmBrushes[c]->b->numPlanes = trm.numPolys;
 		for ( i = 0; i < trm.numPolys; i++ ) {
-			trmBrushes[0]->b->planes[i] = trmPolygons[i]->p->plane;
+			trmBrushes[c]->b->planes[i] = trmPolygons[c][i]->p->plane;
 		}
-		trmBrushes[0]->b->bounds = trm.bounds;
+		trmBrushes[c]->b->bounds = trm.bounds;
 		// link brush at node
-		trmBrushes[0]->next = model->node->brushes;
-		model->node->brushes = trmBrushes[0];
+		trmBrushes[c]->next = model->node->brushes;
+		model->node->brushes = trmBrushes[c];
 	}
 	// model bounds
 	model->bounds = trm.bounds;
 	// convex
 	model->isConvex = trm.isConvex;
 
-	return TRACE_MODEL_HANDLE;
+	return handle;
 }
 
 /*
@@ -1454,6 +1480,7 @@ cm_polygon_t *idCollisionModelManagerLocal::TryMergePolygons( cm_model_t *model,
 	memcpy( newp->edges, newEdges, newNumEdges * sizeof(int) );
 	newp->numEdges = newNumEdges;
 	newp->checkcount = 0;
+	memset( newp->traceCheckcount, 0, sizeof( newp->traceCheckcount ) );
 	// increase usage count for the edges of this polygon
 	for ( i = 0; i < newp->numEdges; i++ ) {
 		if ( !keep1 && newp->edges[i] == newEdgeNum1 ) {
@@ -2312,6 +2339,7 @@ int idCollisionModelManagerLocal::GetVertex( cm_model_t *model, const idVec3 &v,
 	}
 	model->vertices[model->numVertices].p = vert;
 	model->vertices[model->numVertices].checkcount = 0;
+	memset( model->vertices[model->numVertices].traceMarks, 0, sizeof( model->vertices[model->numVertices].traceMarks ) );
 	*vertexNum = model->numVertices;
 	// add vertice to hash
 	cm_vertexHash->Add( hashKey, model->numVertices );
@@ -2396,6 +2424,7 @@ int idCollisionModelManagerLocal::GetEdge( cm_model_t *model, const idVec3 &v1,
 	model->edges[model->numEdges].vertexNum[1] = v2num;
 	model->edges[model->numEdges].internal = false;
 	model->edges[model->numEdges].checkcount = 0;
+	memset( model->edges[model->numEdges].traceMarks, 0, sizeof( model->edges[model->numEdges].traceMarks ) );
 	model->edges[model->numEdges].numUsers = 1; // used by one polygon atm
 	model->edges[model->numEdges].normal.Zero();
 	//
@@ -2459,6 +2488,7 @@ void idCollisionModelManagerLocal::CreatePolygon( cm_model_t *model, idFixedWind
 	p->contents = material->GetContentFlags();
 	p->material = material;
 	p->checkcount = 0;
+	memset( p->traceCheckcount, 0, sizeof( p->traceCheckcount ) );
 	p->plane = plane;
 	p->bounds = bounds;
 	for ( i = 0; i < numPolyEdges; i++ ) {
@@ -2724,6 +2754,7 @@ void idCollisionModelManagerLocal::ConvertBrush( cm_model_t *model, const idMapB
 	// create brush for position test
 	brush = AllocBrush( model, mapBrush->GetNumSides() );
 	brush->checkcount = 0;
+	memset( brush->traceCheckcount, 0, sizeof( brush->traceCheckcount ) );
 	brush->contents = contents;
 	brush->material = material;
 	brush->primitiveNum = primitiveNum;
@@ -2924,6 +2955,82 @@ void idCollisionModelManagerLocal::OptimizeArrays( cm_model_t *model ) {
 	}
 }
 
+/*
+================
+CM_CountPolygonPlueckers_r
+================
+*/
+static int CM_CountPolygonPlueckers_r( cm_node_t *node, int checkCount ) {
+	int numFloats;
+	cm_polygonRef_t *pref;
+
+	numFloats = 0;
+	while ( 1 ) {
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			if ( pref->p->checkcount == checkCount ) {
+				continue;
+			}
+			pref->p->checkcount = checkCount;
+			numFloats += 6 * CM_PLUECKER_STRIDE( pref->p->numEdges );
+		}
+		if ( node->planeType == -1 ) {
+			break;
+		}
+		numFloats += CM_CountPolygonPlueckers_r( node->children[1], checkCount );
+		node = node->children[0];
+	}
+	return numFloats;
+}
+
+/*
+================
+CM_SetupPolygonPlueckers_r
+================
+*/
+static void CM_SetupPolygonPlueckers_r( const cm_model_t *model, cm_node_t *node, int checkCount, float **plueckers ) {
+	cm_polygonRef_t *pref;
+
+	while ( 1 ) {
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			if ( pref->p->checkcount == checkCount ) {
+				continue;
+			}
+			pref->p->checkcount = checkCount;
+			pref->p->plueckers = *plueckers;
+			*plueckers += 6 * CM_PLUECKER_STRIDE( pref->p->numEdges );
+			CM_SetupPolygonPlueckers( model, pref->p );
+		}
+		if ( node->planeType == -1 ) {
+			break;
+		}
+		CM_SetupPolygonPlueckers_r( model, node->children[1], checkCount, plueckers );
+		node = node->children[0];
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupPolygonPlueckers
+
+  stores the edge pluecker coordinates with the polygons so they do not need to be calculated for every trace
+================
+*/
+void idCollisionModelManagerLocal::SetupPolygonPlueckers( cm_model_t *model ) {
+	int numFloats;
+	float *plueckers;
+
+	checkCount++;
+	numFloats = CM_CountPolygonPlueckers_r( model->node, checkCount );
+	if ( !numFloats ) {
+		return;
+	}
+	model->polygonPlueckers = (float *) Mem_Alloc16( numFloats * sizeof( float ) );
+	plueckers = model->polygonPlueckers;
+	checkCount++;
+	CM_SetupPolygonPlueckers_r( model, model->node, checkCount, &plueckers );
+	assert( plueckers == model->polygonPlueckers + numFloats );
+}
+
 /*
 ================
 idCollisionModelManagerLocal::FinishModel
@@ -2945,6 +3052,8 @@ void idCollisionModelManagerLocal::FinishModel( cm_model_t *model ) {
 
 	// remove all unused vertices and edges
 	OptimizeArrays( model );
+	// store the edge pluecker coordinates with the polygons
+	SetupPolygonPlueckers( model );
 	// get model bounds from brush and polygon bounds
 	CM_GetNodeBounds( &model->bounds, model->node );
 	// get model contents
@@ -3362,7 +3471,7 @@ void idCollisionModelManagerLocal::LoadMap( const idMapFile *mapFile ) {
 	// models
 	maxModels = MAX_SUBMODELS;
 	numModels = 0;
-	models = (cm_model_t **) Mem_ClearedAlloc( (maxModels+1) * sizeof(cm_model_t *) );
+	models = (cm_model_t **) Mem_ClearedAlloc( (maxModels+CM_MAX_TRACE_CONTEXTS) * sizeof(cm_model_t *) );
 
 	// setup hash to speed up finding shared vertices and edges
 	SetupHash();
@@ -42,7 +42,7 @@ If you have questions concerning this license or the applicable additional terms
 #define CIRCLE_APPROXIMATION_LENGTH			64.0f
 
 #define	MAX_SUBMODELS						2048
-#define	TRACE_MODEL_HANDLE					MAX_SUBMODELS
+#define	TRACE_MODEL_HANDLE					MAX_SUBMODELS	// first of the per trace context trace model slots
 
 #define VERTEX_HASH_BOXSIZE					(1<<6)	// must be power of 2
 #define VERTEX_HASH_SIZE					(VERTEX_HASH_BOXSIZE*VERTEX_HASH_BOXSIZE)
@@ -58,6 +58,22 @@ If you have questions concerning this license or the applicable additional terms
 #define VERTEX_EPSILON						0.1f
 #define CHOP_EPSILON						0.1f
 
+#define CM_MAX_TRACE_CONTEXTS				4		// main thread plus the threads that can trace at the same time
+#define CM_MAX_MODEL_HANDLES				( MAX_SUBMODELS + CM_MAX_TRACE_CONTEXTS )
+
+// edge pluecker coordinates are stored per coordinate, each row padded to a multiple of four floats
+#define CM_PLUECKER_STRIDE( numEdges )		( ( (numEdges) + 3 ) & ~3 )
+
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 1 )
+#define CM_SSE_PLUECKERS									// test four pluecker coordinates at once
+#endif
+
+#ifdef _WIN32
+#define CM_THREAD_LOCAL						__declspec( thread )
+#else
+#define CM_THREAD_LOCAL						__thread
+#endif
+
 
 typedef struct cm_windingList_s {
 	int					numWindings;			// number of windings
@@ -78,19 +94,24 @@ Collision model
 ===============================================================================
 */
 
+typedef struct cm_traceMark_s {
+	int						checkcount;			// for multi-check avoidance during a trace
+	unsigned int			side;				// vertex: each bit tells at which side this vertex passes one of the trace model edges
+												// edge: each bit tells at which side of this edge one of the trace model vertices passes
+	unsigned int			sideSet;			// each bit tells if sidedness for the trace model edge or vertex has been calculated yet
+} cm_traceMark_t;
+
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
-	int						checkcount;			// for multi-check avoidance
-	unsigned long			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
+	int						checkcount;			// for multi-check avoidance outside of traces
+	cm_traceMark_t			traceMarks[CM_MAX_TRACE_CONTEXTS];	// per trace context
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance outside of traces
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned long			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
+	cm_traceMark_t			traceMarks[CM_MAX_TRACE_CONTEXTS];	// per trace context
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -102,10 +123,12 @@ typedef struct cm_polygonBlock_s {
 
 typedef struct cm_polygon_s {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance outside of traces
+	int						traceCheckcount[CM_MAX_TRACE_CONTEXTS];	// for multi-check avoidance per trace context
 	int						contents;			// contents behind polygon
 	const idMaterial *		material;			// material
 	idPlane					plane;				// polygon plane
+	float *					plueckers;			// pluecker coordinates of the edges, 6 rows of CM_PLUECKER_STRIDE( numEdges ) floats
 	int						numEdges;			// number of edges
 	int						edges[1];			// variable sized, indexes into cm_edge_t list
 } cm_polygon_t;
@@ -126,7 +149,8 @@ typedef struct cm_brushBlock_s {
 } cm_brushBlock_t;
 
 typedef struct cm_brush_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance outside of traces
+	int						traceCheckcount[CM_MAX_TRACE_CONTEXTS];	// for multi-check avoidance per trace context
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial *		material;			// material
@@ -178,6 +202,7 @@ typedef struct cm_model_s {
 	cm_brushRefBlock_t *	brushRefBlocks;		// list with blocks of brush references
 	cm_polygonBlock_t *		polygonBlock;		// memory block with all polygons
 	cm_brushBlock_t *		brushBlock;			// memory block with all brushes
+	float *					polygonPlueckers;	// edge pluecker coordinates of all polygons
 	// statistics
 	int						numPolygons;
 	int						polygonMemory;
@@ -232,6 +257,8 @@ typedef struct cm_trmPolygon_s {
 } cm_trmPolygon_t;
 
 typedef struct cm_traceWork_s {
+	int traceContext;								// index of the trace context for the multi-check avoidance marks
+	int checkCount;									// for multi-check avoidance
 	int numVerts;
 	cm_trmVertex_t vertices[MAX_TRACEMODEL_VERTS];	// trm vertices
 	int numEdges;
@@ -275,11 +302,143 @@ typedef struct cm_traceWork_s {
 	idPluecker polygonEdgePlueckerCache[CM_MAX_POLYGON_EDGES];
 	idPluecker polygonVertexPlueckerCache[CM_MAX_POLYGON_EDGES];
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
+	float polygonVertexPlueckers[6*CM_MAX_POLYGON_EDGES];	// polygonVertexPlueckerCache stored per coordinate
+	uint64 polygonEdgeSides[MAX_TRACEMODEL_VERTS];	// per trm vertex the sides at which it passes the polygon edges
+	uint64 polygonEdgesFlipped;						// polygon edges used in reverse direction
+	uint64 polygonEdgesToCheck;						// polygon edges not yet checked and not internal
 } cm_traceWork_t;
 
 /*
 ===============================================================================
 
+Pluecker sidedness tests
+
+Return the sign bits of the permuted inner products between a pluecker
+coordinate and a list of pluecker coordinates stored per coordinate.
+
+===============================================================================
+*/
+
+// sign bits of plueckers[i].PermutedInnerProduct( pl )
+uint64		CM_InnerProductSides( const float *plueckers, const int numPlueckers, const idPluecker &pl );
+// sign bits of pl.PermutedInnerProduct( plueckers[i] )
+uint64		CM_InnerProductSides( const idPluecker &pl, const float *plueckers, const int numPlueckers );
+// stores the edge pluecker coordinates of a polygon in poly->plueckers
+void		CM_SetupPolygonPlueckers( const cm_model_t *model, cm_polygon_t *poly );
+// use the scalar sidedness tests even where SSE is available, set while testing the trace corpus
+extern bool	cm_scalarPlueckers;
+
+/*
+===============================================================================
+
+Ray packets
+
+Point traces are run through the tree in packets so every node and polygon
+is fetched once for all the rays that pass it.
+
+===============================================================================
+*/
+
+#define CM_MAX_RAY_PACKET					32		// max number of rays traced through the tree together
+
+typedef struct cm_ray_s {
+	int index;										// index of the ray in the results
+	idVec3 start;									// start of ray in model space
+	idVec3 end;										// end of ray in model space
+	idVec3 endp;									// start + dir, end point used for the collision tests
+	idVec3 dir;										// ray direction
+	idPluecker pl;									// pluecker coordinate for the ray
+	idBounds bounds;								// bounds of the ray, shrinks when something is hit
+	idPlane heartPlane1;							// polygons should be near anough the ray heart planes
+	idPlane heartPlane2;
+	trace_t trace;									// collision detection result
+} cm_ray_t;
+
+typedef struct cm_raySegment_s {
+	int ray;										// ray in the packet
+	float p1f, p2f;									// fractions of the ray at the start and end of the segment
+	idVec3 p1, p2;									// start and end of the segment
+} cm_raySegment_t;
+
+typedef struct cm_rayPacket_s {
+	cm_model_t *model;								// model colliding with
+	int contents;									// ignore polygons that do not have any of these contents flags
+	int numRays;
+	cm_ray_t rays[CM_MAX_RAY_PACKET];
+	// rays gathered for the plane distance tests against a single polygon
+	int tests[CM_MAX_RAY_PACKET];
+	idVec3 testStarts[CM_MAX_RAY_PACKET];
+	idVec3 testEnds[CM_MAX_RAY_PACKET];
+	float startDists[CM_MAX_RAY_PACKET];
+	float endDists[CM_MAX_RAY_PACKET];
+} cm_rayPacket_t;
+
+/*
+===============================================================================
+
+Trace context
+
+A thread can only trace while it owns a trace context. The main thread always
+owns the first context, other threads acquire one of the remaining contexts.
+
+===============================================================================
+*/
+
+typedef struct cm_traceContext_s {
+	bool inUse;										// true if a thread owns this context
+	int checkCount;									// for multi-check avoidance
+	// for retrieving contact points
+	bool getContacts;
+	contactInfo_t *contacts;
+	int maxContacts;
+	int numContacts;
+	ALIGN16( cm_traceWork_t translationWork );		// kept out of the stack because it is large
+	ALIGN16( cm_traceWork_t rotationWork );
+	ALIGN16( cm_rayPacket_t rayPacket );
+} cm_traceContext_t;
+
+/*
+===============================================================================
+
+Trace corpus
+
+Translations recorded on the main thread during play. The corpus stores the
+results of the scalar sidedness tests so replays can be compared bit for bit.
+
+===============================================================================
+*/
+
+#define CM_TRACE_CORPUS_IDENT				(('R'<<24)+('T'<<16)+('M'<<8)+'C')
+#define CM_TRACE_CORPUS_VERSION				1
+
+typedef struct cm_traceResult_s {
+	float fraction;
+	idVec3 endpos;
+	idMat3 endAxis;
+	int type;
+	idVec3 point;
+	idVec3 normal;
+	float dist;
+	int contents;
+	int modelFeature;
+	int trmFeature;
+} cm_traceResult_t;
+
+typedef struct cm_recordedTrace_s {
+	idVec3 start;
+	idVec3 end;
+	int trmNum;										// -1 for a point translation
+	idMat3 trmAxis;
+	int contentMask;
+	cmHandle_t model;
+	idVec3 modelOrigin;
+	idMat3 modelAxis;
+	cm_traceResult_t result;
+} cm_recordedTrace_t;
+
+/*
+===============================================================================
+
 Collision Map
 
 ===============================================================================
@@ -325,6 +484,9 @@ public:
 	void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+	// translates a batch of points and reports the first collision for each of them
+	void			PointTranslations( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
 	// returns the contents the trm is stuck in or 0 if the trm is in free space
 	int				Contents( const idVec3 &start,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -344,6 +506,10 @@ public:
 	void			ListModels( void );
 	// write a collision model file for the map entity
 	bool			WriteCollisionModelForMapEntity( const idMapEntity *mapEnt, const char *filename, const bool testTraceModel = true );
+	// acquire a trace context for the calling thread
+	bool			AcquireTraceContext( void );
+	// release the trace context of the calling thread
+	void			ReleaseTraceContext( void );
 
 private:			// CollisionMap_translate.cpp
 	int				TranslateEdgeThroughEdge( idVec3 &cross, idPluecker &l1, idPluecker &l2, float *fraction );
@@ -383,6 +549,10 @@ private:			// CollisionMap_rotate.cpp
 									const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 									cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis );
 
+private:			// CollisionMap_rays.cpp
+	void			TranslateRaysThroughPolygon( cm_rayPacket_t *packet, const int *rays, const int numRays, cm_polygon_t *p );
+	void			TraceRaysThroughAxialBSPTree_r( cm_rayPacket_t *packet, cm_node_t *node, const cm_raySegment_t *segments, const int numSegments );
+
 private:			// CollisionMap_contents.cpp
 	bool			TestTrmVertsInBrush( cm_traceWork_t *tw, cm_brush_t *b );
 	bool			TestTrmInPolygon( cm_traceWork_t *tw, cm_polygon_t *p );
@@ -394,6 +564,8 @@ private:			// CollisionMap_contents.cpp
 									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
 
 private:			// CollisionMap_trace.cpp
+	cm_traceContext_t *GetTraceContext( void );
+	void			ClearTraceContexts( void );
 	void			TraceTrmThroughNode( cm_traceWork_t *tw, cm_node_t *node );
 	void			TraceThroughAxialBSPTree_r( cm_traceWork_t *tw, cm_node_t *node, float p1f, float p2f, idVec3 &p1, idVec3 &p2);
 	void			TraceThroughModel( cm_traceWork_t *tw );
@@ -464,6 +636,7 @@ private:			// CollisionMap_load.cpp
 	void			AccumulateModelInfo( cm_model_t *model );
 	void			RemapEdges( cm_node_t *node, int *edgeRemap );
 	void			OptimizeArrays( cm_model_t *model );
+	void			SetupPolygonPlueckers( cm_model_t *model );
 	void			FinishModel( cm_model_t *model );
 	void			BuildModels( const idMapFile *mapFile );
 	cmHandle_t		FindModel( const char *name );
@@ -498,6 +671,12 @@ private:			// CollisionMap_debug
 								const idVec3 &viewOrigin );
 	void			DrawNodePolygons( cm_model_t *model, cm_node_t *node, const idVec3 &origin, const idMat3 &axis,
 								const idVec3 &viewOrigin, const float radius );
+	void			TestParallelTraces( const idVec3 &start, const idTraceModel &trm, const idMat3 &trmAxis, const idVec3 *ends, int numTraces, cmHandle_t model );
+	void			TestPointTranslations( const char *name, const idVec3 *starts, const idVec3 *ends, int numTraces, cmHandle_t model );
+	void			RecordTrace( const idVec3 &start, const idVec3 &end, const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+	void			WriteTraceCorpus( void );
+	void			TestTraceCorpus( void );
 
 private:			// collision map data
 	idStr			mapName;
@@ -509,18 +688,19 @@ private:			// collision map data
 	int				maxModels;
 	int				numModels;
 	cm_model_t **	models;
-					// polygons and brush for trm model
-	cm_polygonRef_t*trmPolygons[MAX_TRACEMODEL_POLYS];
-	cm_brushRef_t *	trmBrushes[1];
+					// polygons and brush for the trm model of each trace context
+	cm_polygonRef_t*trmPolygons[CM_MAX_TRACE_CONTEXTS][MAX_TRACEMODEL_POLYS];
+	cm_brushRef_t *	trmBrushes[CM_MAX_TRACE_CONTEXTS];
 	const idMaterial *trmMaterial;
 					// for data pruning
 	int				numProcNodes;
 	cm_procNode_t *	procNodes;
-					// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t *	contacts;
-	int				maxContacts;
-	int				numContacts;
+					// per thread trace state
+	cm_traceContext_t traceContexts[CM_MAX_TRACE_CONTEXTS];
+					// trace corpus recording
+	int				numTracesToRecord;
+	idList<cm_recordedTrace_t> recordedTraces;
+	idList<idTraceModel> recordedTrms;
 };
 
 // for debugging
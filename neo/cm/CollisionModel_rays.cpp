@@ -0,0 +1,411 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+/*
+===============================================================================
+
+	Batched point traces through a polygonal model.
+
+	The rays of a packet walk the axial BSP tree together. Every ray visits
+	the nodes and polygons in the same order as a single point trace so the
+	results are exactly the same.
+
+===============================================================================
+*/
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "CollisionModel_local.h"
+
+/*
+================
+idCollisionModelManagerLocal::TranslateRaysThroughPolygon
+================
+*/
+void idCollisionModelManagerLocal::TranslateRaysThroughPolygon( cm_rayPacket_t *packet, const int *rays, const int numRays, cm_polygon_t *p ) {
+	int i, k, numTests;
+	float d, d1, d2, f;
+	uint64 flipped;
+	idVec3 endp;
+	cm_ray_t *ray;
+
+	// if this polygon does not have the right contents behind it
+	if ( !(p->contents & packet->contents) ) {
+		return;
+	}
+
+	// gather the rays that pass the same tests as a single point trace
+	numTests = 0;
+	for ( i = 0; i < numRays; i++ ) {
+		ray = &packet->rays[rays[i]];
+
+		// if already stuck in solid
+		if ( ray->trace.fraction == 0.0f ) {
+			continue;
+		}
+		// if the the ray bounds do not intersect the polygon bounds
+		if ( !ray->bounds.IntersectsBounds( p->bounds ) ) {
+			continue;
+		}
+		// only collide with the polygon if approaching at the front
+		if ( ( p->plane.Normal() * ray->dir ) > 0.0f ) {
+			continue;
+		}
+		// if the polygon is too far from the first heart plane
+		d = p->bounds.PlaneDistance( ray->heartPlane1 );
+		if ( idMath::Fabs(d) > CM_BOX_EPSILON ) {
+			continue;
+		}
+		// if the polygon is too far from the second heart plane
+		d = p->bounds.PlaneDistance( ray->heartPlane2 );
+		if ( idMath::Fabs(d) > CM_BOX_EPSILON ) {
+			continue;
+		}
+		packet->tests[numTests] = rays[i];
+		packet->testStarts[numTests] = ray->start;
+		packet->testEnds[numTests] = ray->endp;
+		numTests++;
+	}
+
+	if ( !numTests ) {
+		return;
+	}
+
+	// distances of all the ray start and end points to the polygon plane
+	SIMDProcessor->Dot( packet->startDists, p->plane, packet->testStarts, numTests );
+	SIMDProcessor->Dot( packet->endDists, p->plane, packet->testEnds, numTests );
+
+	flipped = 0;
+	for ( i = 0; i < p->numEdges; i++ ) {
+		if ( p->edges[i] < 0 ) {
+			flipped |= (uint64) 1 << i;
+		}
+	}
+
+	for ( i = 0; i < numTests; i++ ) {
+		ray = &packet->rays[packet->tests[i]];
+
+		// same as CM_TranslationPlaneFraction
+		d2 = packet->endDists[i] - CM_CLIP_EPSILON;
+		if ( FLOATSIGNBITNOTSET(d2) ) {
+			continue;
+		}
+		d1 = packet->startDists[i];
+		if ( FLOATSIGNBITSET(d1) ) {
+			continue;
+		}
+		d2 = d1 - packet->endDists[i];
+		if ( d2 <= 0.0f ) {
+			continue;
+		}
+		f = ( d1 - CM_CLIP_EPSILON ) / d2;
+		if ( f >= ray->trace.fraction ) {
+			continue;
+		}
+
+		// if the ray passes any of the polygon edges at the wrong side
+		if ( CM_InnerProductSides( ray->pl, p->plueckers, p->numEdges ) ^ flipped ) {
+			continue;
+		}
+
+		if ( f < 0.0f ) {
+			f = 0.0f;
+		}
+		ray->trace.fraction = f;
+		// collision plane is the polygon plane
+		ray->trace.c.normal = p->plane.Normal();
+		ray->trace.c.dist = p->plane.Dist();
+		ray->trace.c.contents = p->contents;
+		ray->trace.c.material = p->material;
+		ray->trace.c.type = CONTACT_TRMVERTEX;
+		ray->trace.c.modelFeature = *reinterpret_cast<int *>(&p);
+		ray->trace.c.trmFeature = 0;
+		ray->trace.c.point = ray->start + f * ( ray->endp - ray->start );
+
+		// decrease bounds
+		endp = ray->start + f * ray->dir;
+		for ( k = 0; k < 3; k++ ) {
+			if ( ray->start[k] < endp[k] ) {
+				ray->bounds[0][k] = ray->start[k] - CM_BOX_EPSILON;
+				ray->bounds[1][k] = endp[k] + CM_BOX_EPSILON;
+			}
+			else {
+				ray->bounds[0][k] = endp[k] - CM_BOX_EPSILON;
+				ray->bounds[1][k] = ray->start[k] + CM_BOX_EPSILON;
+			}
+		}
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::TraceRaysThroughAxialBSPTree_r
+
+  The segments closest to the ray starts are handled before the far segments so
+  every ray goes through the tree in the same order as TraceThroughAxialBSPTree_r.
+================
+*/
+void idCollisionModelManagerLocal::TraceRaysThroughAxialBSPTree_r( cm_rayPacket_t *packet, cm_node_t *node, const cm_raySegment_t *segments, const int numSegments ) {
+	int			i, numActive, side, numNear, numFar, firstNear1, firstFar1;
+	float		t1, t2, frac, frac2, idist;
+	int			active[CM_MAX_RAY_PACKET];
+	cm_raySegment_t nearSegments[CM_MAX_RAY_PACKET];
+	cm_raySegment_t farSegments[CM_MAX_RAY_PACKET];
+	const cm_raySegment_t *seg;
+	cm_raySegment_t *s;
+
+	if ( !node ) {
+		return;
+	}
+
+	// drop the rays that already hit something nearer
+	numActive = 0;
+	for ( i = 0; i < numSegments; i++ ) {
+		if ( packet->rays[segments[i].ray].trace.fraction > segments[i].p1f ) {
+			active[numActive++] = i;
+		}
+	}
+	if ( !numActive ) {
+		return;
+	}
+
+	// test the polygons in this node
+	if ( node->polygons ) {
+		cm_polygonRef_t *pref;
+		int rays[CM_MAX_RAY_PACKET];
+
+		for ( i = 0; i < numActive; i++ ) {
+			rays[i] = segments[active[i]].ray;
+		}
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			idCollisionModelManagerLocal::TranslateRaysThroughPolygon( packet, rays, numActive, pref->p );
+		}
+	}
+	// if this is a leaf node
+	if ( node->planeType == -1 ) {
+		return;
+	}
+
+	// split the segments, the near segments for the second child are stored from the end of the array
+	numNear = numFar = 0;
+	firstNear1 = firstFar1 = CM_MAX_RAY_PACKET;
+	for ( i = 0; i < numActive; i++ ) {
+		seg = &segments[active[i]];
+
+		// distance from plane for segment start and end
+		t1 = seg->p1[node->planeType] - node->planeDist;
+		t2 = seg->p2[node->planeType] - node->planeDist;
+		// see which sides we need to consider
+		if ( t1 >= CM_BOX_EPSILON && t2 >= CM_BOX_EPSILON ) {
+			nearSegments[numNear++] = *seg;
+			continue;
+		}
+		if ( t1 < -CM_BOX_EPSILON && t2 < -CM_BOX_EPSILON ) {
+			nearSegments[--firstNear1] = *seg;
+			continue;
+		}
+
+		if ( t1 < t2 ) {
+			idist = 1.0f / (t1-t2);
+			side = 1;
+			frac2 = (t1 + CM_BOX_EPSILON) * idist;
+			frac = (t1 - CM_BOX_EPSILON) * idist;
+		} else if (t1 > t2) {
+			idist = 1.0f / (t1-t2);
+			side = 0;
+			frac2 = (t1 - CM_BOX_EPSILON) * idist;
+			frac = (t1 + CM_BOX_EPSILON) * idist;
+		} else {
+			side = 0;
+			frac = 1.0f;
+			frac2 = 0.0f;
+		}
+
+		// move up to the node
+		if ( frac < 0.0f ) {
+			frac = 0.0f;
+		}
+		else if ( frac > 1.0f ) {
+			frac = 1.0f;
+		}
+		s = ( side == 0 ) ? &nearSegments[numNear++] : &nearSegments[--firstNear1];
+		s->ray = seg->ray;
+		s->p1f = seg->p1f;
+		s->p2f = seg->p1f + (seg->p2f - seg->p1f)*frac;
+		s->p1 = seg->p1;
+		s->p2[0] = seg->p1[0] + frac*(seg->p2[0] - seg->p1[0]);
+		s->p2[1] = seg->p1[1] + frac*(seg->p2[1] - seg->p1[1]);
+		s->p2[2] = seg->p1[2] + frac*(seg->p2[2] - seg->p1[2]);
+
+		// go past the node
+		if ( frac2 < 0.0f ) {
+			frac2 = 0.0f;
+		}
+		else if ( frac2 > 1.0f ) {
+			frac2 = 1.0f;
+		}
+		s = ( side == 1 ) ? &farSegments[numFar++] : &farSegments[--firstFar1];
+		s->ray = seg->ray;
+		s->p1f = seg->p1f + (seg->p2f - seg->p1f)*frac2;
+		s->p2f = seg->p2f;
+		s->p1[0] = seg->p1[0] + frac2*(seg->p2[0] - seg->p1[0]);
+		s->p1[1] = seg->p1[1] + frac2*(seg->p2[1] - seg->p1[1]);
+		s->p1[2] = seg->p1[2] + frac2*(seg->p2[2] - seg->p1[2]);
+		s->p2 = seg->p2;
+	}
+
+	// first the parts of the rays in front of the node plane
+	if ( numNear ) {
+		idCollisionModelManagerLocal::TraceRaysThroughAxialBSPTree_r( packet, node->children[0], nearSegments, numNear );
+	}
+	if ( firstNear1 < CM_MAX_RAY_PACKET ) {
+		idCollisionModelManagerLocal::TraceRaysThroughAxialBSPTree_r( packet, node->children[1], nearSegments + firstNear1, CM_MAX_RAY_PACKET - firstNear1 );
+	}
+	// then the parts of the rays that went past the node plane
+	if ( numFar ) {
+		idCollisionModelManagerLocal::TraceRaysThroughAxialBSPTree_r( packet, node->children[0], farSegments, numFar );
+	}
+	if ( firstFar1 < CM_MAX_RAY_PACKET ) {
+		idCollisionModelManagerLocal::TraceRaysThroughAxialBSPTree_r( packet, node->children[1], farSegments + firstFar1, CM_MAX_RAY_PACKET - firstFar1 );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::PointTranslations
+================
+*/
+void idCollisionModelManagerLocal::PointTranslations( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints, int contentMask,
+												cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	int i, j, first, last;
+	bool model_rotated;
+	idVec3 dir, normal1, normal2;
+	idMat3 invModelAxis;
+	cm_ray_t *ray;
+	cm_rayPacket_t *packet;
+	cm_raySegment_t segments[CM_MAX_RAY_PACKET];
+
+	if ( model < 0 || model >= CM_MAX_MODEL_HANDLES || model >= idCollisionModelManagerLocal::maxModels + CM_MAX_TRACE_CONTEXTS || !idCollisionModelManagerLocal::models[model] ) {
+		common->Printf("idCollisionModelManagerLocal::PointTranslations: invalid model\n");
+		memset( results, 0, numPoints * sizeof( results[0] ) );
+		return;
+	}
+
+	packet = &GetTraceContext()->rayPacket;
+	packet->model = idCollisionModelManagerLocal::models[model];
+	packet->contents = contentMask;
+
+	model_rotated = modelAxis.IsRotated();
+	if ( model_rotated ) {
+		invModelAxis = modelAxis.Transpose();
+	}
+
+	for ( first = 0; first < numPoints; first = last ) {
+		last = Min( first + CM_MAX_RAY_PACKET, numPoints );
+
+		// setup the rays
+		packet->numRays = 0;
+		for ( i = first; i < last; i++ ) {
+			// if special position test
+			if ( starts[i].Compare( ends[i] ) ) {
+				idCollisionModelManagerLocal::Translation( &results[i], starts[i], ends[i], NULL, mat3_identity, contentMask, model, modelOrigin, modelAxis );
+				continue;
+			}
+
+			ray = &packet->rays[packet->numRays];
+			ray->index = i;
+			ray->start = starts[i] - modelOrigin;
+			ray->end = ends[i] - modelOrigin;
+			ray->dir = ends[i] - starts[i];
+			if ( model_rotated ) {
+				// rotate trace instead of model
+				ray->start *= invModelAxis;
+				ray->end *= invModelAxis;
+				ray->dir *= invModelAxis;
+			}
+			ray->endp = ray->start + ray->dir;
+			ray->pl.FromRay( ray->start, ray->dir );
+
+			// ray bounds
+			for ( j = 0; j < 3; j++ ) {
+				if ( ray->start[j] < ray->end[j] ) {
+					ray->bounds[0][j] = ray->start[j] - CM_BOX_EPSILON;
+					ray->bounds[1][j] = ray->end[j] + CM_BOX_EPSILON;
+				}
+				else {
+					ray->bounds[0][j] = ray->end[j] - CM_BOX_EPSILON;
+					ray->bounds[1][j] = ray->start[j] + CM_BOX_EPSILON;
+				}
+			}
+
+			// ray heart planes
+			dir = ray->dir;
+			dir.Normalize();
+			dir.NormalVectors( normal1, normal2 );
+			ray->heartPlane1.SetNormal( normal1 );
+			ray->heartPlane1.FitThroughPoint( ray->start );
+			ray->heartPlane2.SetNormal( normal2 );
+			ray->heartPlane2.FitThroughPoint( ray->start );
+
+			memset( &ray->trace, 0, sizeof( ray->trace ) );
+			ray->trace.fraction = 1.0f;
+			ray->trace.c.type = CONTACT_NONE;
+
+			segments[packet->numRays].ray = packet->numRays;
+			segments[packet->numRays].p1f = 0.0f;
+			segments[packet->numRays].p2f = 1.0f;
+			segments[packet->numRays].p1 = ray->start;
+			segments[packet->numRays].p2 = ray->end;
+			packet->numRays++;
+		}
+
+		// trace all rays through the model at once
+		idCollisionModelManagerLocal::TraceRaysThroughAxialBSPTree_r( packet, packet->model->node, segments, packet->numRays );
+
+		// store results
+		for ( j = 0; j < packet->numRays; j++ ) {
+			ray = &packet->rays[j];
+			i = ray->index;
+			results[i] = ray->trace;
+			results[i].endpos = starts[i] + results[i].fraction * ( ends[i] - starts[i] );
+			results[i].endAxis = mat3_identity;
+
+			if ( results[i].fraction < 1.0f ) {
+				// rotate trace plane normal if there was a collision with a rotated model
+				if ( model_rotated ) {
+					results[i].c.normal *= modelAxis;
+					results[i].c.point *= modelAxis;
+				}
+				results[i].c.point += modelOrigin;
+				results[i].c.dist += modelOrigin * results[i].c.normal;
+			}
+		}
+	}
+}
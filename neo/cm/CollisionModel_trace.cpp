@@ -42,6 +42,91 @@ If you have questions concerning this license or the applicable additional terms
 /*
 ===============================================================================
 
+Trace contexts
+
+===============================================================================
+*/
+
+// trace context of the calling thread, the main thread owns context 0 and other threads have none until they acquire one
+static CM_THREAD_LOCAL int cm_threadTraceContext = -1;
+
+/*
+================
+idCollisionModelManagerLocal::GetTraceContext
+================
+*/
+cm_traceContext_t *idCollisionModelManagerLocal::GetTraceContext( void ) {
+	if ( cm_threadTraceContext < 0 ) {
+		common->FatalError( "idCollisionModelManager: trace from thread '%s' without a trace context", Sys_GetThreadName() );
+	}
+	return &traceContexts[cm_threadTraceContext];
+}
+
+/*
+================
+idCollisionModelManagerLocal::ClearTraceContexts
+
+  contexts stay owned by their threads, the calling thread is the main thread
+================
+*/
+void idCollisionModelManagerLocal::ClearTraceContexts( void ) {
+	int i;
+
+	for ( i = 0; i < CM_MAX_TRACE_CONTEXTS; i++ ) {
+		traceContexts[i].checkCount = 0;
+		traceContexts[i].getContacts = false;
+		traceContexts[i].contacts = NULL;
+		traceContexts[i].maxContacts = 0;
+		traceContexts[i].numContacts = 0;
+	}
+	traceContexts[0].inUse = true;
+	cm_threadTraceContext = 0;
+}
+
+/*
+================
+idCollisionModelManagerLocal::AcquireTraceContext
+================
+*/
+bool idCollisionModelManagerLocal::AcquireTraceContext( void ) {
+	int i;
+
+	if ( cm_threadTraceContext >= 0 ) {
+		return true;
+	}
+
+	Sys_EnterCriticalSection( CRITICAL_SECTION_TWO );
+	for ( i = 1; i < CM_MAX_TRACE_CONTEXTS; i++ ) {
+		if ( !traceContexts[i].inUse ) {
+			traceContexts[i].inUse = true;
+			cm_threadTraceContext = i;
+			break;
+		}
+	}
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_TWO );
+
+	return ( cm_threadTraceContext >= 0 );
+}
+
+/*
+================
+idCollisionModelManagerLocal::ReleaseTraceContext
+================
+*/
+void idCollisionModelManagerLocal::ReleaseTraceContext( void ) {
+	if ( cm_threadTraceContext <= 0 ) {
+		return;
+	}
+
+	Sys_EnterCriticalSection( CRITICAL_SECTION_TWO );
+	traceContexts[cm_threadTraceContext].inUse = false;
+	cm_threadTraceContext = -1;
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_TWO );
+}
+
+/*
+===============================================================================
+
 Trace through the spatial subdivision
 
 ===============================================================================
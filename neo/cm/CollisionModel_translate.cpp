@@ -39,6 +39,163 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "CollisionModel_local.h"
 
+#ifdef CM_SSE_PLUECKERS
+#include <xmmintrin.h>
+#endif
+
+/*
+===============================================================================
+
+Pluecker sidedness tests
+
+===============================================================================
+*/
+
+bool cm_scalarPlueckers = false;
+
+/*
+================
+CM_InnerProductSides
+
+  sign bits of plueckers[i].PermutedInnerProduct( pl )
+================
+*/
+uint64 CM_InnerProductSides( const float *plueckers, const int numPlueckers, const idPluecker &pl ) {
+	int i, stride;
+	uint64 sides;
+
+	assert( numPlueckers > 0 && numPlueckers <= 64 );
+
+	stride = CM_PLUECKER_STRIDE( numPlueckers );
+	sides = 0;
+
+#ifdef CM_SSE_PLUECKERS
+	if ( !cm_scalarPlueckers ) {
+		__m128 a0 = _mm_set1_ps( pl[0] );
+		__m128 a1 = _mm_set1_ps( pl[1] );
+		__m128 a2 = _mm_set1_ps( pl[2] );
+		__m128 a3 = _mm_set1_ps( pl[3] );
+		__m128 a4 = _mm_set1_ps( pl[4] );
+		__m128 a5 = _mm_set1_ps( pl[5] );
+
+		for ( i = 0; i < numPlueckers; i += 4 ) {
+			__m128 d;
+			// same order of operations as idPluecker::PermutedInnerProduct
+			d = _mm_mul_ps( _mm_loadu_ps( plueckers + 0 * stride + i ), a4 );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_loadu_ps( plueckers + 1 * stride + i ), a5 ) );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_loadu_ps( plueckers + 2 * stride + i ), a3 ) );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_loadu_ps( plueckers + 4 * stride + i ), a0 ) );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_loadu_ps( plueckers + 5 * stride + i ), a1 ) );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_loadu_ps( plueckers + 3 * stride + i ), a2 ) );
+			sides |= (uint64) _mm_movemask_ps( d ) << i;
+		}
+		return sides & ( ( (uint64) 2 << ( numPlueckers - 1 ) ) - 1 );
+	}
+#endif
+
+	for ( i = 0; i < numPlueckers; i++ ) {
+		float d = plueckers[0 * stride + i] * pl[4] + plueckers[1 * stride + i] * pl[5] + plueckers[2 * stride + i] * pl[3] +
+					plueckers[4 * stride + i] * pl[0] + plueckers[5 * stride + i] * pl[1] + plueckers[3 * stride + i] * pl[2];
+		sides |= (uint64) ( *reinterpret_cast<unsigned int *>(&d) >> 31 ) << i;
+	}
+
+	return sides & ( ( (uint64) 2 << ( numPlueckers - 1 ) ) - 1 );
+}
+
+/*
+================
+CM_InnerProductSides
+
+  sign bits of pl.PermutedInnerProduct( plueckers[i] )
+================
+*/
+uint64 CM_InnerProductSides( const idPluecker &pl, const float *plueckers, const int numPlueckers ) {
+	int i, stride;
+	uint64 sides;
+
+	assert( numPlueckers > 0 && numPlueckers <= 64 );
+
+	stride = CM_PLUECKER_STRIDE( numPlueckers );
+	sides = 0;
+
+#ifdef CM_SSE_PLUECKERS
+	if ( !cm_scalarPlueckers ) {
+		__m128 a0 = _mm_set1_ps( pl[0] );
+		__m128 a1 = _mm_set1_ps( pl[1] );
+		__m128 a2 = _mm_set1_ps( pl[2] );
+		__m128 a3 = _mm_set1_ps( pl[3] );
+		__m128 a4 = _mm_set1_ps( pl[4] );
+		__m128 a5 = _mm_set1_ps( pl[5] );
+
+		for ( i = 0; i < numPlueckers; i += 4 ) {
+			__m128 d;
+			// same order of operations as idPluecker::PermutedInnerProduct
+			d = _mm_mul_ps( a0, _mm_loadu_ps( plueckers + 4 * stride + i ) );
+			d = _mm_add_ps( d, _mm_mul_ps( a1, _mm_loadu_ps( plueckers + 5 * stride + i ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( a2, _mm_loadu_ps( plueckers + 3 * stride + i ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( a4, _mm_loadu_ps( plueckers + 0 * stride + i ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( a5, _mm_loadu_ps( plueckers + 1 * stride + i ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( a3, _mm_loadu_ps( plueckers + 2 * stride + i ) ) );
+			sides |= (uint64) _mm_movemask_ps( d ) << i;
+		}
+		return sides & ( ( (uint64) 2 << ( numPlueckers - 1 ) ) - 1 );
+	}
+#endif
+
+	for ( i = 0; i < numPlueckers; i++ ) {
+		float d = pl[0] * plueckers[4 * stride + i] + pl[1] * plueckers[5 * stride + i] + pl[2] * plueckers[3 * stride + i] +
+					pl[4] * plueckers[0 * stride + i] + pl[5] * plueckers[1 * stride + i] + pl[3] * plueckers[2 * stride + i];
+		sides |= (uint64) ( *reinterpret_cast<unsigned int *>(&d) >> 31 ) << i;
+	}
+
+	return sides & ( ( (uint64) 2 << ( numPlueckers - 1 ) ) - 1 );
+}
+
+/*
+================
+CM_SetupPolygonPlueckers
+================
+*/
+void CM_SetupPolygonPlueckers( const cm_model_t *model, cm_polygon_t *poly ) {
+	int i, j, stride;
+	cm_edge_t *edge;
+	idPluecker pl;
+
+	stride = CM_PLUECKER_STRIDE( poly->numEdges );
+	for ( i = 0; i < poly->numEdges; i++ ) {
+		edge = model->edges + abs( poly->edges[i] );
+		pl.FromLine( model->vertices[edge->vertexNum[0]].p, model->vertices[edge->vertexNum[1]].p );
+		for ( j = 0; j < 6; j++ ) {
+			poly->plueckers[j * stride + i] = pl[j];
+		}
+	}
+	for ( ; i < stride; i++ ) {
+		for ( j = 0; j < 6; j++ ) {
+			poly->plueckers[j * stride + i] = 0.0f;
+		}
+	}
+}
+
+/*
+================
+CM_PolygonEdgesFlipped
+
+  bit set for every polygon edge used in reverse direction
+================
+*/
+static ID_INLINE uint64 CM_PolygonEdgesFlipped( const cm_polygon_t *poly ) {
+	int i;
+	uint64 flipped;
+
+	flipped = 0;
+	for ( i = 0; i < poly->numEdges; i++ ) {
+		if ( poly->edges[i] < 0 ) {
+			flipped |= (uint64) 1 << i;
+		}
+	}
+	return flipped;
+}
+
 /*
 ===============================================================================
 
@@ -200,7 +357,7 @@ CM_SetVertexSidedness
   stores for the given model vertex at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+ID_INLINE void CM_SetVertexSidedness( cm_traceMark_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
 	if ( !(v->sideSet & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
@@ -209,66 +366,41 @@ ID_INLINE void CM_SetVertexSidedness( cm_vertex_t *v, const idPluecker &vpl, con
 	}
 }
 
-/*
-================
-CM_SetEdgeSidedness
-
-  stores for the given model edge at which side one of the trm vertices
-================
-*/
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
-	if ( !(edge->sideSet & (1<<bitNum)) ) {
-		float fl;
-		fl = vpl.PermutedInnerProduct( epl );
-		edge->side = (edge->side & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);
-		edge->sideSet |= (1 << bitNum);
-	}
-}
-
 /*
 ================
 idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon
 ================
 */
 void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmEdge_t *trmEdge ) {
-	int i, edgeNum;
+	int i, edgeNum, stride;
 	float f1, f2, dist, d1, d2;
+	uint64 edges, vertexSides;
 	idVec3 start, end, normal;
 	cm_edge_t *edge;
-	cm_vertex_t *v1, *v2;
-	idPluecker *pl, epsPl;
+	idPluecker pl, epsPl;
+
+	// polygon edges not yet checked which the trm edge start and end vertex pass at different sides
+	edges = ( tw->polygonEdgeSides[trmEdge->vertexNum[0]] ^ tw->polygonEdgeSides[trmEdge->vertexNum[1]] ) & tw->polygonEdgesToCheck;
+	if ( !edges ) {
+		return;
+	}
+	// only keep the polygon edges with start and end vertex passing the trm edge at different sides
+	vertexSides = CM_InnerProductSides( tw->polygonVertexPlueckers, poly->numEdges, trmEdge->pl );
+	edges &= vertexSides ^ ( ( vertexSides >> 1 ) | ( ( vertexSides & 1 ) << ( poly->numEdges - 1 ) ) );
+
+	stride = CM_PLUECKER_STRIDE( poly->numEdges );
 
 	// check edges for a collision
-	for ( i = 0; i < poly->numEdges; i++) {
-		edgeNum = poly->edges[i];
-		edge = tw->model->edges + abs(edgeNum);
-		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
-			continue;
-		}
-		// can never collide with internal edges
-		if ( edge->internal ) {
-			continue;
-		}
-		pl = &tw->polygonEdgePlueckerCache[i];
-		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
-		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if ( !(((edge->side >> trmEdge->vertexNum[0]) ^ (edge->side >> trmEdge->vertexNum[1])) & 1) ) {
-			continue;
-		}
-		// get the sides at which the polygon edge vertices pass the trm edge
-		v1 = tw->model->vertices + edge->vertexNum[INTSIGNBITSET(edgeNum)];
-		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
-		v2 = tw->model->vertices + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
-		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum );
-		// if the polygon edge start and end vertex do not pass the trm edge at different sides
-		if ( !((v1->side ^ v2->side) & (1<<trmEdge->bitNum)) ) {
+	for ( i = 0; edges; i++, edges >>= 1 ) {
+		if ( !( edges & 1 ) ) {
 			continue;
 		}
+		edgeNum = poly->edges[i];
+		edge = tw->model->edges + abs(edgeNum);
+		pl = idPluecker( poly->plueckers[0 * stride + i], poly->plueckers[1 * stride + i], poly->plueckers[2 * stride + i],
+							poly->plueckers[3 * stride + i], poly->plueckers[4 * stride + i], poly->plueckers[5 * stride + i] );
 		// if there is no possible collision between the trm edge and the polygon edge
-		if ( !idCollisionModelManagerLocal::TranslateEdgeThroughEdge( trmEdge->cross, trmEdge->pl, *pl, &f1 ) ) {
+		if ( !idCollisionModelManagerLocal::TranslateEdgeThroughEdge( trmEdge->cross, trmEdge->pl, pl, &f1 ) ) {
 			continue;
 		}
 		// if moving away from edge
@@ -394,20 +526,14 @@ idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon
 ================
 */
 void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum ) {
-	int i, edgeNum;
 	float f;
-	cm_edge_t *edge;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if ( f < tw->trace.fraction ) {
 
-		for ( i = 0; i < poly->numEdges; i++ ) {
-			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs(edgeNum);
-			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> bitNum) & 1) ) {
-				return;
-			}
+		// if the vertex passes any of the polygon edges at the wrong side
+		if ( tw->polygonEdgeSides[bitNum] ^ tw->polygonEdgesFlipped ) {
+			return;
 		}
 		if ( f < 0.0f ) {
 			f = 0.0f;
@@ -437,30 +563,14 @@ idCollisionModelManagerLocal::TranslatePointThroughPolygon
 ================
 */
 void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v ) {
-	int i, edgeNum;
 	float f;
-	cm_edge_t *edge;
-	idPluecker pl;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if ( f < tw->trace.fraction ) {
 
-		for ( i = 0; i < poly->numEdges; i++ ) {
-			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs(edgeNum);
-			// if we didn't yet calculate the sidedness for this edge
-			if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
-				pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
-				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = FLOATSIGNBITSET(fl);
-			}
-			// if the point passes the edge at the wrong side
-			//if ( (edgeNum > 0) == edge->side ) {
-			if ( INTSIGNBITSET(edgeNum) ^ edge->side ) {
-				return;
-			}
+		// if the point passes any of the polygon edges at the wrong side
+		if ( CM_InnerProductSides( v->pl, poly->plueckers, poly->numEdges ) ^ CM_PolygonEdgesFlipped( poly ) ) {
+			return;
 		}
 		if ( f < 0.0f ) {
 			f = 0.0f;
@@ -501,8 +611,8 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs(edgeNum);
 
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((v->side >> edge->bitNum) & 1) ) {
+			CM_SetVertexSidedness( &v->traceMarks[tw->traceContext], pl, edge->pl, edge->bitNum );
+			if ( INTSIGNBITSET(edgeNum) ^ ((v->traceMarks[tw->traceContext].side >> edge->bitNum) & 1) ) {
 				return;
 			}
 		}
@@ -534,7 +644,7 @@ idCollisionModelManagerLocal::TranslateTrmThroughPolygon
 ================
 */
 bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *p ) {
-	int i, j, k, edgeNum;
+	int i, j, k, edgeNum, stride;
 	float fraction, d;
 	idVec3 endp;
 	idPluecker *pl;
@@ -545,10 +655,10 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 	cm_edge_t *e;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->traceCheckcount[tw->traceContext] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->traceCheckcount[tw->traceContext] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -597,29 +707,46 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 				return false;
 		}
 
-		// calculate pluecker coordinates for the polygon edges and polygon vertices
+		// calculate pluecker coordinates for the polygon vertices and find the polygon edges to check
+		stride = CM_PLUECKER_STRIDE( p->numEdges );
+		tw->polygonEdgesFlipped = 0;
+		tw->polygonEdgesToCheck = 0;
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
-			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if ( e->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				e->sideSet = 0;
+			if ( edgeNum < 0 ) {
+				tw->polygonEdgesFlipped |= (uint64) 1 << i;
+			}
+			// edges checked for an earlier polygon and internal edges are skipped
+			if ( e->traceMarks[tw->traceContext].checkcount != tw->checkCount && !e->internal ) {
+				tw->polygonEdgesToCheck |= (uint64) 1 << i;
 			}
-			// pluecker coordinate for edge
-			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
-														tw->model->vertices[e->vertexNum[1]].p );
 
-			v = &tw->model->vertices[e->vertexNum[INTSIGNBITSET(edgeNum)]];
+			v = &tw->model->vertices[e->vertexNum[edgeNum < 0]];
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				v->sideSet = 0;
+			if ( v->traceMarks[tw->traceContext].checkcount != tw->checkCount ) {
+				v->traceMarks[tw->traceContext].sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
-			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
+			pl = &tw->polygonVertexPlueckerCache[i];
+			pl->FromRay( v->p, -tw->dir );
+			for ( j = 0; j < 6; j++ ) {
+				tw->polygonVertexPlueckers[j * stride + i] = (*pl)[j];
+			}
+		}
+		for ( ; i < stride; i++ ) {
+			for ( j = 0; j < 6; j++ ) {
+				tw->polygonVertexPlueckers[j * stride + i] = 0.0f;
+			}
 		}
 		// copy first to last so we can easily cycle through for the edges
 		tw->polygonVertexPlueckerCache[p->numEdges] = tw->polygonVertexPlueckerCache[0];
 
+		// get the sides at which the trm vertices pass the polygon edges
+		for ( i = 0; i < tw->numVerts; i++ ) {
+			tw->polygonEdgeSides[i] = CM_InnerProductSides( p->plueckers, p->numEdges, tw->vertices[i].pl );
+		}
+
 		// trace trm vertices through polygon
 		for ( i = 0; i < tw->numVerts; i++ ) {
 			bv = tw->vertices + i;
@@ -641,11 +768,11 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( e->traceMarks[tw->traceContext].checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			e->traceMarks[tw->traceContext].checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -655,11 +782,11 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( v->traceMarks[tw->traceContext].checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				v->traceMarks[tw->traceContext].checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -760,7 +887,7 @@ idCollisionModelManagerLocal::Translation
 ================
 */
 #ifdef _DEBUG
-static int entered = 0;
+static CM_THREAD_LOCAL int entered = 0;
 #endif
 
 void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
@@ -775,7 +902,8 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_traceContext_t *context = GetTraceContext();
+	cm_traceWork_t &tw = context->translationWork;
 
 	assert( ((byte *)&start) < ((byte *)results) || ((byte *)&start) >= (((byte *)results) + sizeof( trace_t )) );
 	assert( ((byte *)&end) < ((byte *)results) || ((byte *)&end) >= (((byte *)results) + sizeof( trace_t )) );
@@ -783,7 +911,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 
 	memset( results, 0, sizeof( *results ) );
 
-	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
+	if ( model < 0 || model >= CM_MAX_MODEL_HANDLES || model >= idCollisionModelManagerLocal::maxModels + CM_MAX_TRACE_CONTEXTS ) {
 		common->Printf("idCollisionModelManagerLocal::Translation: invalid model handle\n");
 		return;
 	}
@@ -798,11 +926,16 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 		return;
 	}
 
+	// record main thread translations for the trace corpus
+	if ( numTracesToRecord > 0 && context == traceContexts && !context->getContacts ) {
+		RecordTrace( start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+	}
+
 #ifdef _DEBUG
 	bool startsolid = false;
 	// test whether or not stuck to begin with
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
+		if ( !entered && !context->getContacts ) {
 			entered = 1;
 			// if already messed up to begin with
 			if ( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
@@ -813,8 +946,8 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
-
+	tw.traceContext = context - traceContexts;
+	tw.checkCount = ++context->checkCount;
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -823,9 +956,9 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = context->getContacts;
+	tw.contacts = context->contacts;
+	tw.maxContacts = context->maxContacts;
 	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
@@ -890,7 +1023,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 		return;
 	}
 
@@ -1077,7 +1210,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 	} else {
 		// store results
 		*results = tw.trace;
@@ -1102,7 +1235,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 #ifdef _DEBUG
 	// test for missed collisions
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
+		if ( !entered && !context->getContacts ) {
 			entered = 1;
 			// if the trm is stuck in the model
 			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
@@ -1532,7 +1532,12 @@ bool idEntity::UpdateRenderEntity( renderEntity_s *renderEntity, const renderVie
 		SetTimeState ts( timeGroup );
 #endif
 
-		return animator->CreateFrame( gameLocal.time, false );
+		if ( animator->CreateFrame( gameLocal.time, false ) ) {
+			animator->TakeFrameCreatedAhead();
+			return true;
+		}
+		// the animation stage may have created the frame already
+		return animator->TakeFrameCreatedAhead();
 	}
 
 	return false;
@@ -2962,6 +2967,10 @@ bool idEntity::CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const {
 	idVec3 	dest;
 	trace_t	tr;
 	idVec3 	midpoint;
+	idVec3	starts[6];
+	idVec3	ends[6];
+	trace_t	traces[6];
+	int		i;
 
 	// use the midpoint of the bounds instead of the origin, because
 	// bmodels may have their origin at 0,0,0
@@ -2974,57 +2983,29 @@ bool idEntity::CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const {
 		return true;
 	}
 
+	// trace the points around the midpoint together
 	// this should probably check in the plane of projection, rather than in world coordinate
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[2] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[2] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
+	for ( i = 0; i < 6; i++ ) {
+		starts[i] = origin;
+		ends[i] = midpoint;
+	}
+	ends[0][0] += 15.0;
+	ends[0][1] += 15.0;
+	ends[1][0] += 15.0;
+	ends[1][1] -= 15.0;
+	ends[2][0] -= 15.0;
+	ends[2][1] += 15.0;
+	ends[3][0] -= 15.0;
+	ends[3][1] -= 15.0;
+	ends[4][2] += 15.0;
+	ends[5][2] -= 15.0;
+
+	gameLocal.clip.TracePoints( traces, starts, ends, 6, MASK_SOLID, NULL );
+	for ( i = 0; i < 6; i++ ) {
+		if ( traces[i].fraction == 1.0 || ( gameLocal.GetTraceEntity( traces[i] ) == this ) ) {
+			damagePoint = traces[i].endpos;
+			return true;
+		}
 	}
 
 	return false;
@@ -338,6 +338,9 @@ void idGameLocal::Init( void ) {
 
 	InitConsoleCommands();
 
+	physicsIslands.Init();
+	animationStage.Init();
+
 
 #ifdef _D3XP
 	if(!g_xp_bind_run_once.GetBool()) {
@@ -416,6 +419,9 @@ void idGameLocal::Shutdown( void ) {
 
 	MapShutdown();
 
+	physicsIslands.Shutdown();
+	animationStage.Shutdown();
+
 	aasList.DeleteContents( true );
 	aasNames.Clear();
 
@@ -1263,6 +1269,7 @@ idGameLocal::MapPopulate
 ===================
 */
 void idGameLocal::MapPopulate( void ) {
+	int i;
 
 	if ( isMultiplayer ) {
 		cvarSystem->SetCVarBool( "r_skipSpecular", false );
@@ -1285,6 +1292,11 @@ void idGameLocal::MapPopulate( void ) {
 	// before the physics are run so entities can bind correctly
 	Printf( "==== Processing events ====\n" );
 	idEvent::ServiceEvents();
+
+	// doors and obstacles have set their initial area states by now
+	for ( i = 0; i < aasList.Num(); i++ ) {
+		aasList[ i ]->PrecomputeRoutingCache();
+	}
 }
 
 /*
@@ -1567,6 +1579,13 @@ bool idGameLocal::InitFromSaveGame( const char *mapName, idRenderWorld *renderWo
 
 	savegame.RestoreObjects();
 
+	idPhysics_RigidBody::RestoreSleepIslands();
+
+	// doors and obstacles have restored their area states by now
+	for ( i = 0; i < aasList.Num(); i++ ) {
+		aasList[ i ]->PrecomputeRoutingCache();
+	}
+
 	mpGame.Reset();
 
 	mpGame.Precache();
@@ -1644,6 +1663,7 @@ void idGameLocal::MapShutdown( void ) {
 	}
 
 	MapClear( true );
+	aiPathQueue.Clear();
 
 	// reset the script to the state it was before the map was started
 	program.Restart();
@@ -2482,6 +2502,12 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		timer_think.Clear();
 		timer_think.Start();
 
+		// predict the motion of independent rigid bodies on the job threads
+		physicsIslands.PredictMotion( activeEntities );
+
+		// start the AI moves that waited for the path search budget
+		aiPathQueue.RunFrame();
+
 		// let entities think
 		if ( g_timeentities.GetFloat() ) {
 			num = 0;
@@ -2529,6 +2555,11 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		RunTimeGroup2();
 #endif
 
+		physicsIslands.FinishPrediction();
+		idPhysics_RigidBody::UpdateSleepStatistics();
+		idAI::UpdateLODStatistics();
+		idAnimator::UpdateFrameStatistics();
+
 		// remove any entities that have stopped thinking
 		if ( numEntitiesToDeactivate ) {
 			idEntity *next_ent;
@@ -2560,6 +2591,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 
 		timer_events.Stop();
 
+		// create the animation frames of the entities in view on the job threads
+		animationStage.Run( activeEntities );
+
 		// free the player pvs
 		FreePlayerPVS();
 
@@ -2575,6 +2609,14 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				timer_think.Milliseconds(), timer_events.Milliseconds(), num );
 		}
 
+		// display how many event argument blocks were allocated during the frame
+		if ( g_showEventAllocs.GetBool() ) {
+			int numArgAllocs, numHeapAllocs, poolMemory;
+			idEvent::GetArgStats( numArgAllocs, numHeapAllocs, poolMemory );
+			Printf( "game %d: event args:%d heap allocs:%d pool:%dkB\n", time, numArgAllocs, numHeapAllocs, poolMemory >> 10 );
+		}
+		idEvent::ClearArgStats();
+
 		// build the return value
 		ret.consistencyHash = 0;
 		ret.sessionCommand[0] = 0;
@@ -3098,6 +3140,7 @@ void idGameLocal::SetAASAreaState( const idBounds &bounds, const int areaContent
 	for( i = 0; i < aasList.Num(); i++ ) {
 		aasList[ i ]->SetAreaState( bounds, areaContents, closed );
 	}
+	aiPathQueue.ClearReachable();
 }
 
 /*
@@ -3115,6 +3158,7 @@ aasHandle_t idGameLocal::AddAASObstacle( const idBounds &bounds ) {
 	}
 
 	obstacle = aasList[ 0 ]->AddObstacle( bounds );
+	aiPathQueue.ClearReachable();
 	for( i = 1; i < aasList.Num(); i++ ) {
 		check = aasList[ i ]->AddObstacle( bounds );
 		assert( check == obstacle );
@@ -3134,6 +3178,7 @@ void idGameLocal::RemoveAASObstacle( const aasHandle_t handle ) {
 	for( i = 0; i < aasList.Num(); i++ ) {
 		aasList[ i ]->RemoveObstacle( handle );
 	}
+	aiPathQueue.ClearReachable();
 }
 
 /*
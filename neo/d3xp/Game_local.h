@@ -101,9 +101,12 @@ void gameError( const char *fmt, ... );
 #include "anim/Anim.h"
 
 #include "ai/AAS.h"
+#include "ai/AI_pathqueue.h"
 
 #include "physics/Clip.h"
+#include "physics/Clip_Broadphase.h"
 #include "physics/Push.h"
+#include "physics/Islands.h"
 
 #include "Pvs.h"
 #include "MultiplayerGame.h"
@@ -295,6 +298,9 @@ public:
 
 	idClip					clip;					// collision detection
 	idPush					push;					// geometric pushing
+	idPhysicsIslands		physicsIslands;			// parallel rigid body motion prediction
+	idAnimationStage		animationStage;			// parallel creation of the animation frames in view
+	idAIPathQueue			aiPathQueue;			// per frame budget for AI path searches
 	idPVS					pvs;					// potential visible set
 
 	idTestModel *			testmodel;				// for development testing of models
@@ -53,11 +53,25 @@ private:
 	idRoutingCache *			time_next;				// next in time based list
 	idRoutingCache *			time_prev;				// previous in time based list
 	unsigned short				startTravelTime;		// travel time to start with
+	bool						precomputed;			// built up front and not in the time based list
+	float						buildTime;				// milliseconds it took to build the cache
 	unsigned char *				reachabilities;			// reachabilities used for routing
 	unsigned short *			travelTimes;			// travel time for every area
 };
 
 
+typedef struct routingCacheStats_s {
+	int							cluster;				// cluster the statistics are for
+	int							areaHits;				// area cache found
+	int							areaMisses;				// area cache built
+	float						areaBuildTime;			// milliseconds spent building area cache
+	int							portalHits;				// portal cache towards a goal in the cluster found
+	int							portalMisses;			// portal cache towards a goal in the cluster built
+	float						portalBuildTime;		// milliseconds spent building portal cache
+	int							evictions;				// cache evicted because of the memory budget
+} routingCacheStats_t;
+
+
 class idRoutingUpdate {
 	friend class idAASLocal;
 
@@ -90,6 +104,9 @@ public:
 	virtual bool				Init( const idStr &mapName, unsigned int mapFileCRC );
 	virtual void				Shutdown( void );
 	virtual void				Stats( void ) const;
+	virtual void				PrecomputeRoutingCache( void );
+	virtual void				RoutingCacheReport( bool all ) const;
+	virtual void				ResetRoutingCacheStats( void );
 	virtual void				Test( const idVec3 &origin );
 	virtual const idAASSettings *GetSettings( void ) const;
 	virtual int					PointAreaNum( const idVec3 &origin ) const;
@@ -136,8 +153,17 @@ private:	// routing data
 	mutable idRoutingCache *	cacheListStart;			// start of list with cache sorted from oldest to newest
 	mutable idRoutingCache *	cacheListEnd;			// end of list with cache sorted from oldest to newest
 	mutable int					totalCacheMemory;		// total cache memory used
+	mutable int					areaCacheMemory;		// memory used by the area cache in the time based list
+	mutable int					portalCacheMemory;		// memory used by the portal cache in the time based list
+	mutable int					precomputedCacheMemory;	// memory used by the precomputed cache
 	idList<idRoutingObstacle *>	obstacleList;			// list with obstacles
 
+	mutable int					numCacheBuilds;			// number of routing caches built on demand
+	mutable int					numRouteHitches;		// number of routes that had to build routing caches
+	mutable float				routeHitchTime;			// total time spent on those routes in milliseconds
+	mutable float				maxRouteHitchTime;		// longest time spent on one of those routes
+	mutable routingCacheStats_t *clusterCacheStats;		// cache statistics for each cluster
+
 private:	// routing
 	bool						SetupRouting( void );
 	void						ShutdownRouting( void );
@@ -151,13 +177,15 @@ private:	// routing
 	void						RoutingStats( void ) const;
 	void						LinkCache( idRoutingCache *cache ) const;
 	void						UnlinkCache( idRoutingCache *cache ) const;
-	void						DeleteOldestCache( void ) const;
+	void						EvictCache( void ) const;
 	idReachability *			GetAreaReachability( int areaNum, int reachabilityNum ) const;
 	int							ClusterAreaNum( int clusterNum, int areaNum ) const;
-	void						UpdateAreaRoutingCache( idRoutingCache *areaCache ) const;
+	void						UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingUpdate *update ) const;
+	idRoutingCache *			FindAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
 	idRoutingCache *			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
-	void						UpdatePortalRoutingCache( idRoutingCache *portalCache ) const;
+	bool						UpdatePortalRoutingCache( idRoutingCache *portalCache, idRoutingUpdate *update, bool precomputed ) const;
 	idRoutingCache *			GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
+	bool						FindRouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const;
 	void						RemoveRoutingCacheUsingArea( int areaNum );
 	void						DisableArea( int areaNum );
 	void						EnableArea( int areaNum );
@@ -165,6 +193,18 @@ private:	// routing
 	void						GetBoundsAreas_r( int nodeNum, const idBounds &bounds, idList<int> &areas ) const;
 	void						SetObstacleState( const idRoutingObstacle *obstacle, bool enable );
 
+private:	// routing cache precomputation
+	int							GoalAreaCluster( int areaNum ) const;
+	int							SelectPrecomputeTravelFlags( int *areaTravelFlags, int &numAreaFlags, int *portalTravelFlags, int &numPortalFlags ) const;
+	int							PrecomputeAreaRoutingCache( idParallelJobList &jobList, const int *travelFlags, int numTravelFlags );
+	int							PrecomputePortalRoutingCache( idParallelJobList &jobList, const int *travelFlags, int numTravelFlags );
+	unsigned int				RoutingStateChecksum( void ) const;
+	idStr						RoutingCacheFileName( void ) const;
+	bool						ReadRoutingCache( void );
+	void						WriteRoutingCache( void ) const;
+	static void					AreaRoutingCacheJob( void *data );
+	static void					PortalRoutingCacheJob( void *data );
+
 private:	// pathing
 	bool						EdgeSplitPoint( idVec3 &split, int edgeNum, const idPlane &plane ) const;
 	bool						FloorEdgeSplitPoint( idVec3 &split, int areaNum, const idPlane &splitPlane, const idPlane &frontPlane, bool closest ) const;
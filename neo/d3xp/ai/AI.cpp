@@ -276,6 +276,10 @@ bool idAASFindAttackPosition::TestArea( const idAAS *aas, int areaNum ) {
 	return self->GetAimDir( fromPos, target, self, dir );
 }
 
+int		idAI::lodThinkCount[ AI_LOD_NUM_LEVELS ];
+float	idAI::lodThinkTime[ AI_LOD_NUM_LEVELS ];
+int		idAI::lodDormantCount;
+
 /*
 =====================
 idAI::idAI
@@ -285,6 +289,19 @@ idAI::idAI() {
 	aas					= NULL;
 	travelFlags			= TFL_WALK|TFL_AIR;
 
+	thinkLOD			= AI_LOD_FULL;
+	lodSenseFrame		= true;
+	lodAnimTime			= gameLocal.time;
+	lodAvoidValid		= false;
+	lodAvoidGoal.Zero();
+	lodAvoidSeekPos.Zero();
+
+	pathQueryPending	= false;
+	pathQueryCommand	= MOVE_NONE;
+	pathQueryPos.Zero();
+	pathQueryRange		= 0.0f;
+	pathQueryAnim		= 0;
+
 	kickForce			= 2048.0f;
 	ignore_obstacles	= false;
 	blockedRadius		= 0.0f;
@@ -393,6 +410,7 @@ idAI::~idAI
 =====================
 */
 idAI::~idAI() {
+	gameLocal.aiPathQueue.Remove( this );
 	delete projectileClipModel;
 	DeconstructScriptObject();
 	scriptObject.Free();
@@ -419,6 +437,12 @@ void idAI::Save( idSaveGame *savefile ) const {
 	savefile->WriteInt( travelFlags );
 	move.Save( savefile );
 	savedMove.Save( savefile );
+	savefile->WriteBool( pathQueryPending );
+	savefile->WriteInt( pathQueryCommand );
+	pathQueryEntity.Save( savefile );
+	savefile->WriteVec3( pathQueryPos );
+	savefile->WriteFloat( pathQueryRange );
+	savefile->WriteInt( pathQueryAnim );
 	savefile->WriteFloat( kickForce );
 	savefile->WriteBool( ignore_obstacles );
 	savefile->WriteFloat( blockedRadius );
@@ -566,6 +590,12 @@ void idAI::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( travelFlags );
 	move.Restore( savefile );
 	savedMove.Restore( savefile );
+	savefile->ReadBool( pathQueryPending );
+	savefile->ReadInt( (int &)pathQueryCommand );
+	pathQueryEntity.Restore( savefile );
+	savefile->ReadVec3( pathQueryPos );
+	savefile->ReadFloat( pathQueryRange );
+	savefile->ReadInt( pathQueryAnim );
 	savefile->ReadFloat( kickForce );
 	savefile->ReadBool( ignore_obstacles );
 	savefile->ReadFloat( blockedRadius );
@@ -718,6 +748,16 @@ void idAI::Restore( idRestoreGame *savefile ) {
 		RestorePhysics( &physicsObj );
 	}
 
+	thinkLOD = AI_LOD_FULL;
+	lodSenseFrame = true;
+	lodAnimTime = gameLocal.time;
+	lodAvoidValid = false;
+
+	// queue the move that was waiting for the path search budget again
+	if ( pathQueryPending ) {
+		gameLocal.aiPathQueue.Wait( this );
+	}
+
 #ifdef _D3XP
 
 	//Clean up the emitters
@@ -1120,11 +1160,18 @@ idAI::Think
 =====================
 */
 void idAI::Think( void ) {
+	idTimer thinkTimer;
+
 	// if we are completely closed off from the player, don't do anything at all
 	if ( CheckDormant() ) {
+		lodDormantCount++;
 		return;
 	}
 
+	thinkTimer.Start();
+
+	UpdateThinkLOD();
+
 	if ( thinkFlags & TH_THINK ) {
 		// clear out the enemy when he dies or is hidden
 		idActor *enemyEnt = enemy.GetEntity();
@@ -1146,7 +1193,9 @@ void idAI::Think( void ) {
 			RunPhysics();
 		} else if ( !allowHiddenMovement && IsHidden() ) {
 			// hidden monsters
-			UpdateAIScript();
+			if ( lodSenseFrame ) {
+				UpdateAIScript();
+			}
 		} else {
 			// clear the ik before we do anything else so the skeleton doesn't get updated twice
 			walkIK.ClearJointMods();
@@ -1154,14 +1203,18 @@ void idAI::Think( void ) {
 			switch( move.moveType ) {
 			case MOVETYPE_DEAD :
 				// dead monsters
-				UpdateAIScript();
+				if ( lodSenseFrame ) {
+					UpdateAIScript();
+				}
 				DeadMove();
 				break;
 
 			case MOVETYPE_FLY :
 				// flying monsters
-				UpdateEnemyPosition();
-				UpdateAIScript();
+				if ( lodSenseFrame ) {
+					UpdateEnemyPosition();
+					UpdateAIScript();
+				}
 				FlyMove();
 				PlayChatter();
 				CheckBlink();
@@ -1169,8 +1222,10 @@ void idAI::Think( void ) {
 
 			case MOVETYPE_STATIC :
 				// static monsters
-				UpdateEnemyPosition();
-				UpdateAIScript();
+				if ( lodSenseFrame ) {
+					UpdateEnemyPosition();
+					UpdateAIScript();
+				}
 				StaticMove();
 				PlayChatter();
 				CheckBlink();
@@ -1178,8 +1233,10 @@ void idAI::Think( void ) {
 
 			case MOVETYPE_ANIM :
 				// animation based movement
-				UpdateEnemyPosition();
-				UpdateAIScript();
+				if ( lodSenseFrame ) {
+					UpdateEnemyPosition();
+					UpdateAIScript();
+				}
 				AnimMove();
 				PlayChatter();
 				CheckBlink();
@@ -1187,8 +1244,10 @@ void idAI::Think( void ) {
 
 			case MOVETYPE_SLIDE :
 				// velocity based movement
-				UpdateEnemyPosition();
-				UpdateAIScript();
+				if ( lodSenseFrame ) {
+					UpdateEnemyPosition();
+					UpdateAIScript();
+				}
 				SlideMove();
 				PlayChatter();
 				CheckBlink();
@@ -1201,9 +1260,11 @@ void idAI::Think( void ) {
 		}
 
 		// clear pain flag so that we recieve any damage between now and the next time we run the script
-		AI_PAIN = false;
-		AI_SPECIAL_DAMAGE = 0;
-		AI_PUSHED = false;
+		if ( lodSenseFrame ) {
+			AI_PAIN = false;
+			AI_SPECIAL_DAMAGE = 0;
+			AI_PUSHED = false;
+		}
 	} else if ( thinkFlags & TH_PHYSICS ) {
 		RunPhysics();
 	}
@@ -1223,7 +1284,15 @@ void idAI::Think( void ) {
 */
 
 	UpdateMuzzleFlash();
-	UpdateAnimation();
+	// nobody sees the animation of monsters outside the player PVS
+	if ( thinkLOD != AI_LOD_FAR || lodSenseFrame ) {
+		// call the frame commands of the frames the animation was not updated
+		if ( !fl.hidden && lodAnimTime < gameLocal.previousTime ) {
+			animator.ServiceAnims( lodAnimTime, gameLocal.previousTime );
+		}
+		UpdateAnimation();
+		lodAnimTime = gameLocal.time;
+	}
 	UpdateParticles();
 	Present();
 	UpdateDamageEffects();
@@ -1235,6 +1304,80 @@ void idAI::Think( void ) {
 		gameRenderWorld->DrawText( va( "%d", ( int )health), this->GetEyePosition()+aboveHead, 0.5f, colorWhite, gameLocal.GetLocalPlayer()->viewAngles.ToMat3() );
 	}
 #endif
+
+	thinkTimer.Stop();
+	lodThinkCount[ thinkLOD ]++;
+	lodThinkTime[ thinkLOD ] += thinkTimer.Milliseconds();
+}
+
+/*
+=====================
+idAI::InCombat
+
+The AI always thinks at full rate while it has an enemy, is hurt or pushed, or talks.
+=====================
+*/
+bool idAI::InCombat( void ) const {
+	return ( enemy.GetEntity() != NULL || AI_PAIN || AI_DAMAGE || AI_PUSHED || AI_TALK || num_cinematics > 0 );
+}
+
+/*
+=====================
+idAI::UpdateThinkLOD
+
+Selects the think level of detail from the distance to the player and the player PVS. A lower level
+of detail runs the script and senses every ai_lodNearInterval or ai_lodFarInterval frames, staggered
+over the frames by entity number. Movement and physics still run every frame.
+=====================
+*/
+void idAI::UpdateThinkLOD( void ) {
+	idPlayer *	player;
+	int			interval;
+
+	thinkLOD = AI_LOD_FULL;
+	if ( ai_thinkLOD.GetBool() && !gameLocal.isMultiplayer && !InCombat() ) {
+		player = gameLocal.GetLocalPlayer();
+		if ( player ) {
+			if ( !gameLocal.InPlayerPVS( this ) ) {
+				thinkLOD = AI_LOD_FAR;
+			} else if ( ( physicsObj.GetOrigin() - player->GetPhysics()->GetOrigin() ).LengthSqr() > Square( ai_lodDistance.GetFloat() ) ) {
+				thinkLOD = AI_LOD_NEAR;
+			}
+		}
+	}
+
+	switch( thinkLOD ) {
+	case AI_LOD_NEAR:
+		interval = ai_lodNearInterval.GetInteger();
+		break;
+	case AI_LOD_FAR:
+		interval = ai_lodFarInterval.GetInteger();
+		break;
+	default:
+		interval = 1;
+		break;
+	}
+
+	lodSenseFrame = ( interval <= 1 || ( ( gameLocal.framenum + entityNumber ) % interval ) == 0 );
+}
+
+/*
+=====================
+idAI::UpdateLODStatistics
+=====================
+*/
+void idAI::UpdateLODStatistics( void ) {
+	if ( ai_showThinkLOD.GetBool() && ( lodThinkCount[ AI_LOD_FULL ] || lodThinkCount[ AI_LOD_NEAR ] || lodThinkCount[ AI_LOD_FAR ] || lodDormantCount ) ) {
+		gameLocal.Printf( "%d: ai think %1.2f ms, %d full %1.2f ms, %d near %1.2f ms, %d far %1.2f ms, %d dormant\n", gameLocal.framenum,
+							lodThinkTime[ AI_LOD_FULL ] + lodThinkTime[ AI_LOD_NEAR ] + lodThinkTime[ AI_LOD_FAR ],
+							lodThinkCount[ AI_LOD_FULL ], lodThinkTime[ AI_LOD_FULL ],
+							lodThinkCount[ AI_LOD_NEAR ], lodThinkTime[ AI_LOD_NEAR ],
+							lodThinkCount[ AI_LOD_FAR ], lodThinkTime[ AI_LOD_FAR ], lodDormantCount );
+	}
+
+	memset( lodThinkCount, 0, sizeof( lodThinkCount ) );
+	memset( lodThinkTime, 0, sizeof( lodThinkTime ) );
+	lodDormantCount = 0;
 }
 
 /***********************************************************************
@@ -1495,10 +1638,134 @@ bool idAI::PathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int g
 		return false;
 	}
 
+	idTimer timer;
+	bool result;
+
+	timer.Start();
 	if ( move.moveType == MOVETYPE_FLY ) {
-		return aas->FlyPathToGoal( path, areaNum, org, goalAreaNum, goal, travelFlags );
+		result = aas->FlyPathToGoal( path, areaNum, org, goalAreaNum, goal, travelFlags );
 	} else {
-		return aas->WalkPathToGoal( path, areaNum, org, goalAreaNum, goal, travelFlags );
+		result = aas->WalkPathToGoal( path, areaNum, org, goalAreaNum, goal, travelFlags );
+	}
+	timer.Stop();
+	gameLocal.aiPathQueue.AddSearchTime( timer.Milliseconds() );
+
+	return result;
+}
+
+/*
+=====================
+idAI::QueryPathToGoal
+
+Returns whether the goal area can be reached, using the reachability cached in the path queue when
+possible. If canWait is set PATHQUERY_PENDING is returned when the frame budget for path searches is spent.
+=====================
+*/
+pathQueryResult_t idAI::QueryPathToGoal( int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, bool canWait ) const {
+	aasPath_t	path;
+	bool		reachable;
+
+	if ( !aas || !areaNum || !goalAreaNum ) {
+		return PATHQUERY_UNREACHABLE;
+	}
+
+	if ( !gameLocal.aiPathQueue.GetReachable( aas, areaNum, goalAreaNum, travelFlags, move.moveType == MOVETYPE_FLY, reachable ) ) {
+		if ( canWait && !gameLocal.aiPathQueue.Admit( this ) ) {
+			return PATHQUERY_PENDING;
+		}
+		reachable = PathToGoal( path, areaNum, origin, goalAreaNum, goalOrigin );
+		gameLocal.aiPathQueue.SetReachable( aas, areaNum, goalAreaNum, travelFlags, move.moveType == MOVETYPE_FLY, reachable );
+	}
+
+	return reachable ? PATHQUERY_REACHABLE : PATHQUERY_UNREACHABLE;
+}
+
+/*
+=====================
+idAI::FindNearestGoal
+=====================
+*/
+bool idAI::FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 &origin, const idVec3 &target, aasObstacle_t *obstacles, int numObstacles, idAASCallback &callback ) const {
+	idTimer timer;
+	bool result;
+
+	timer.Start();
+	result = aas->FindNearestGoal( goal, areaNum, origin, target, travelFlags, obstacles, numObstacles, callback );
+	timer.Stop();
+	gameLocal.aiPathQueue.AddSearchTime( timer.Milliseconds() );
+
+	return result;
+}
+
+/*
+=====================
+idAI::WaitForPath
+
+Puts the move in the path queue. The move is started on a later frame and until then the
+move status is MOVE_STATUS_WAITING so the scripts wait for it like for any other move.
+=====================
+*/
+bool idAI::WaitForPath( moveCommand_t command, idEntity *ent, const idVec3 &pos, float range, int anim ) {
+	pathQueryPending	= true;
+	pathQueryCommand	= command;
+	pathQueryEntity		= ent;
+	pathQueryPos		= pos;
+	pathQueryRange		= range;
+	pathQueryAnim		= anim;
+	gameLocal.aiPathQueue.Wait( this );
+
+	move.moveCommand	= MOVE_NONE;
+	move.moveStatus		= MOVE_STATUS_WAITING;
+	AI_MOVE_DONE		= false;
+	AI_DEST_UNREACHABLE = false;
+	AI_FORWARD			= false;
+
+	return false;
+}
+
+/*
+=====================
+idAI::ResumePathQuery
+
+Starts the move the same way the script event that issued it does.
+=====================
+*/
+void idAI::ResumePathQuery( void ) {
+	idEntity *ent;
+
+	if ( !pathQueryPending ) {
+		return;
+	}
+
+	ent = pathQueryEntity.GetEntity();
+	switch( pathQueryCommand ) {
+	case MOVE_TO_ENEMY:
+		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
+		MoveToEnemy();
+		break;
+	case MOVE_TO_ENTITY:
+		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
+		MoveToEntity( ent );
+		break;
+	case MOVE_TO_POSITION:
+		StopMove( MOVE_STATUS_DONE );
+		MoveToPosition( pathQueryPos );
+		break;
+	case MOVE_OUT_OF_RANGE:
+		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
+		MoveOutOfRange( ent, pathQueryRange );
+		break;
+	case MOVE_TO_ATTACK_POSITION:
+		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
+		MoveToAttackPosition( ent, pathQueryAnim );
+		break;
+	case MOVE_TO_COVER:
+		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
+		MoveToCover( ent, pathQueryPos );
+		break;
+	default:
+		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
+		break;
 	}
 }
 
@@ -1576,6 +1843,7 @@ idAI::StopMove
 =====================
 */
 void idAI::StopMove( moveStatus_t status ) {
+	pathQueryPending	= false;
 	AI_MOVE_DONE		= true;
 	AI_FORWARD			= false;
 	move.moveCommand	= MOVE_NONE;
@@ -1715,9 +1983,9 @@ idAI::MoveToEnemy
 =====================
 */
 bool idAI::MoveToEnemy( void ) {
-	int			areaNum;
-	aasPath_t	path;
-	idActor		*enemyEnt = enemy.GetEntity();
+	int					areaNum;
+	pathQueryResult_t	result;
+	idActor				*enemyEnt = enemy.GetEntity();
 
 	if ( !enemyEnt ) {
 		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
@@ -1742,7 +2010,11 @@ bool idAI::MoveToEnemy( void ) {
 		aas->PushPointIntoAreaNum( move.toAreaNum, pos );
 
 		areaNum	= PointReachableAreaNum( physicsObj.GetOrigin() );
-		if ( !PathToGoal( path, areaNum, physicsObj.GetOrigin(), move.toAreaNum, pos ) ) {
+		result = QueryPathToGoal( areaNum, physicsObj.GetOrigin(), move.toAreaNum, pos, move.moveCommand != MOVE_TO_ENEMY );
+		if ( result == PATHQUERY_PENDING ) {
+			return WaitForPath( MOVE_TO_ENEMY, NULL, pos, 0.0f, 0 );
+		}
+		if ( result != PATHQUERY_REACHABLE ) {
 			AI_DEST_UNREACHABLE = true;
 			return false;
 		}
@@ -1787,9 +2059,9 @@ idAI::MoveToEntity
 =====================
 */
 bool idAI::MoveToEntity( idEntity *ent ) {
-	int			areaNum;
-	aasPath_t	path;
-	idVec3		pos;
+	int					areaNum;
+	pathQueryResult_t	result;
+	idVec3				pos;
 
 	if ( !ent ) {
 		StopMove( MOVE_STATUS_DEST_NOT_FOUND );
@@ -1812,7 +2084,11 @@ bool idAI::MoveToEntity( idEntity *ent ) {
 		aas->PushPointIntoAreaNum( move.toAreaNum, pos );
 
 		areaNum	= PointReachableAreaNum( physicsObj.GetOrigin() );
-		if ( !PathToGoal( path, areaNum, physicsObj.GetOrigin(), move.toAreaNum, pos ) ) {
+		result = QueryPathToGoal( areaNum, physicsObj.GetOrigin(), move.toAreaNum, pos, move.moveCommand != MOVE_TO_ENTITY );
+		if ( result == PATHQUERY_PENDING ) {
+			return WaitForPath( MOVE_TO_ENTITY, ent, pos, 0.0f, 0 );
+		}
+		if ( result != PATHQUERY_REACHABLE ) {
 			AI_DEST_UNREACHABLE = true;
 			return false;
 		}
@@ -1882,8 +2158,12 @@ bool idAI::MoveOutOfRange( idEntity *ent, float range ) {
 		pos = ent->GetPhysics()->GetOrigin();
 	}
 
+	if ( !gameLocal.aiPathQueue.Admit( this ) ) {
+		return WaitForPath( MOVE_OUT_OF_RANGE, ent, pos, range, 0 );
+	}
+
 	idAASFindAreaOutOfRange findGoal( pos, range );
-	if ( !aas->FindNearestGoal( goal, areaNum, org, pos, travelFlags, &obstacle, 1, findGoal ) ) {
+	if ( !FindNearestGoal( goal, areaNum, org, pos, &obstacle, 1, findGoal ) ) {
 		StopMove( MOVE_STATUS_DEST_UNREACHABLE );
 		AI_DEST_UNREACHABLE = true;
 		return false;
@@ -1939,8 +2219,12 @@ bool idAI::MoveToAttackPosition( idEntity *ent, int attack_anim ) {
 		pos = ent->GetPhysics()->GetOrigin();
 	}
 
+	if ( !gameLocal.aiPathQueue.Admit( this ) ) {
+		return WaitForPath( MOVE_TO_ATTACK_POSITION, ent, pos, 0.0f, attack_anim );
+	}
+
 	idAASFindAttackPosition findGoal( this, physicsObj.GetGravityAxis(), ent, pos, missileLaunchOffset[ attack_anim ] );
-	if ( !aas->FindNearestGoal( goal, areaNum, org, pos, travelFlags, &obstacle, 1, findGoal ) ) {
+	if ( !FindNearestGoal( goal, areaNum, org, pos, &obstacle, 1, findGoal ) ) {
 		StopMove( MOVE_STATUS_DEST_UNREACHABLE );
 		AI_DEST_UNREACHABLE = true;
 		return false;
@@ -1967,9 +2251,9 @@ idAI::MoveToPosition
 =====================
 */
 bool idAI::MoveToPosition( const idVec3 &pos ) {
-	idVec3		org;
-	int			areaNum;
-	aasPath_t	path;
+	idVec3				org;
+	int					areaNum;
+	pathQueryResult_t	result;
 
 	if ( ReachedPos( pos, move.moveCommand ) ) {
 		StopMove( MOVE_STATUS_DONE );
@@ -1983,7 +2267,11 @@ bool idAI::MoveToPosition( const idVec3 &pos ) {
 		aas->PushPointIntoAreaNum( move.toAreaNum, org );
 
 		areaNum	= PointReachableAreaNum( physicsObj.GetOrigin() );
-		if ( !PathToGoal( path, areaNum, physicsObj.GetOrigin(), move.toAreaNum, org ) ) {
+		result = QueryPathToGoal( areaNum, physicsObj.GetOrigin(), move.toAreaNum, org, true );
+		if ( result == PATHQUERY_PENDING ) {
+			return WaitForPath( MOVE_TO_POSITION, NULL, pos, 0.0f, 0 );
+		}
+		if ( result != PATHQUERY_REACHABLE ) {
 			StopMove( MOVE_STATUS_DEST_UNREACHABLE );
 			AI_DEST_UNREACHABLE = true;
 			return false;
@@ -2032,8 +2320,12 @@ bool idAI::MoveToCover( idEntity *entity, const idVec3 &hideFromPos ) {
 	// consider the entity the monster tries to hide from as an obstacle
 	obstacle.absBounds = entity->GetPhysics()->GetAbsBounds();
 
+	if ( !gameLocal.aiPathQueue.Admit( this ) ) {
+		return WaitForPath( MOVE_TO_COVER, entity, hideFromPos, 0.0f, 0 );
+	}
+
 	idAASFindCover findCover( hideFromPos );
-	if ( !aas->FindNearestGoal( hideGoal, areaNum, org, hideFromPos, travelFlags, &obstacle, 1, findCover ) ) {
+	if ( !FindNearestGoal( hideGoal, areaNum, org, hideFromPos, &obstacle, 1, findCover ) ) {
 		StopMove( MOVE_STATUS_DEST_UNREACHABLE );
 		AI_DEST_UNREACHABLE = true;
 		return false;
@@ -2118,7 +2410,8 @@ idAI::MoveDone
 =====================
 */
 bool idAI::MoveDone( void ) const {
-	return ( move.moveCommand == MOVE_NONE );
+	// a move waiting in the path queue has not started yet
+	return ( move.moveCommand == MOVE_NONE && !pathQueryPending );
 }
 
 /*
@@ -2635,6 +2928,13 @@ void idAI::CheckObstacleAvoidance( const idVec3 &goalPos, idVec3 &newPos ) {
 		return;
 	}
 
+	// between the sense frames of a lower level of detail keep steering for the free path found last time
+	if ( !lodSenseFrame && lodAvoidValid && ( goalPos - lodAvoidGoal ).LengthSqr() < Square( 1.0f ) ) {
+		newPos = lodAvoidSeekPos;
+		move.obstacle = NULL;
+		return;
+	}
+
 	const idVec3 &origin = physicsObj.GetOrigin();
 
 	obstacle = NULL;
@@ -2706,6 +3006,10 @@ void idAI::CheckObstacleAvoidance( const idVec3 &goalPos, idVec3 &newPos ) {
 		newPos = path.seekPos;
 		move.obstacle = NULL;
 	}
+
+	lodAvoidValid = ( foundPath && !AI_OBSTACLE_IN_PATH );
+	lodAvoidGoal = goalPos;
+	lodAvoidSeekPos = newPos;
 }
 
 /*
@@ -3839,7 +4143,7 @@ void idAI::SetEnemyPosition( void ) {
 		} else {
 			const idVec3 &org = physicsObj.GetOrigin();
 			areaNum = PointReachableAreaNum( org );
-			if ( PathToGoal( path, areaNum, org, enemyAreaNum, pos ) ) {
+			if ( QueryPathToGoal( areaNum, org, enemyAreaNum, pos, false ) == PATHQUERY_REACHABLE ) {
 				lastVisibleReachableEnemyPos = pos;
 				lastVisibleReachableEnemyAreaNum = enemyAreaNum;
 				if ( move.moveCommand == MOVE_TO_ENEMY ) {
@@ -3911,7 +4215,7 @@ void idAI::UpdateEnemyPosition( void ) {
 			enemyAreaNum = PointReachableAreaNum( enemyPos, 1.0f );
 			if ( enemyAreaNum ) {
 				areaNum = PointReachableAreaNum( org );
-				if ( PathToGoal( path, areaNum, org, enemyAreaNum, enemyPos ) ) {
+				if ( QueryPathToGoal( areaNum, org, enemyAreaNum, enemyPos, false ) == PATHQUERY_REACHABLE ) {
 					lastReachableEnemyPos = enemyPos;
 				}
 			}
@@ -475,7 +475,6 @@ void idAI::Event_ClosestReachableEnemyOfEntity( idEntity *team_mate ) {
 	idVec3	delta;
 	int		areaNum;
 	int		enemyAreaNum;
-	aasPath_t path;
 
 	if ( !team_mate->IsType( idActor::Type ) ) {
 		gameLocal.Error( "Entity '%s' is not an AI character or player", team_mate->GetName() );
@@ -497,7 +496,7 @@ void idAI::Event_ClosestReachableEnemyOfEntity( idEntity *team_mate ) {
 		if ( distSquared < bestDistSquared ) {
 			const idVec3 &enemyPos = ent->GetPhysics()->GetOrigin();
 			enemyAreaNum = PointReachableAreaNum( enemyPos );
-			if ( ( areaNum != 0 ) && PathToGoal( path, areaNum, origin, enemyAreaNum, enemyPos ) ) {
+			if ( ( areaNum != 0 ) && QueryPathToGoal( areaNum, origin, enemyAreaNum, enemyPos, false ) == PATHQUERY_REACHABLE ) {
 				bestEnt = ent;
 				bestDistSquared = distSquared;
 			}
@@ -2734,13 +2733,12 @@ idAI::Event_CanReachPosition
 ================
 */
 void idAI::Event_CanReachPosition( const idVec3 &pos ) {
-	aasPath_t	path;
 	int			toAreaNum;
 	int			areaNum;
 
 	toAreaNum = PointReachableAreaNum( pos );
 	areaNum	= PointReachableAreaNum( physicsObj.GetOrigin() );
-	if ( !toAreaNum || !PathToGoal( path, areaNum, physicsObj.GetOrigin(), toAreaNum, pos ) ) {
+	if ( !toAreaNum || QueryPathToGoal( areaNum, physicsObj.GetOrigin(), toAreaNum, pos, false ) != PATHQUERY_REACHABLE ) {
 		idThread::ReturnInt( false );
 	} else {
 		idThread::ReturnInt( true );
@@ -2753,7 +2751,6 @@ idAI::Event_CanReachEntity
 ================
 */
 void idAI::Event_CanReachEntity( idEntity *ent ) {
-	aasPath_t	path;
 	int			toAreaNum;
 	int			areaNum;
 	idVec3		pos;
@@ -2784,7 +2781,7 @@ void idAI::Event_CanReachEntity( idEntity *ent ) {
 
 	const idVec3 &org = physicsObj.GetOrigin();
 	areaNum	= PointReachableAreaNum( org );
-	if ( !toAreaNum || !PathToGoal( path, areaNum, org, toAreaNum, pos ) ) {
+	if ( !toAreaNum || QueryPathToGoal( areaNum, org, toAreaNum, pos, false ) != PATHQUERY_REACHABLE ) {
 		idThread::ReturnInt( false );
 	} else {
 		idThread::ReturnInt( true );
@@ -2797,7 +2794,6 @@ idAI::Event_CanReachEnemy
 ================
 */
 void idAI::Event_CanReachEnemy( void ) {
-	aasPath_t	path;
 	int			toAreaNum;
 	int			areaNum;
 	idVec3		pos;
@@ -2827,7 +2823,7 @@ void idAI::Event_CanReachEnemy( void ) {
 
 	const idVec3 &org = physicsObj.GetOrigin();
 	areaNum	= PointReachableAreaNum( org );
-	if ( !PathToGoal( path, areaNum, org, toAreaNum, pos ) ) {
+	if ( QueryPathToGoal( areaNum, org, toAreaNum, pos, false ) != PATHQUERY_REACHABLE ) {
 		idThread::ReturnInt( false );
 	} else {
 		idThread::ReturnInt( true );
@@ -33,6 +33,27 @@ If you have questions concerning this license or the applicable additional terms
 
 bool idAnimManager::forceExport = false;
 
+#define MD5ANIM_BINARY_IDENT		( ( 'A' << 24 ) + ( '5' << 16 ) + ( 'D' << 8 ) + 'M' )
+#define MD5ANIM_BINARY_VERSION		1
+#define MD5ANIM_BINARY_EXT			"bmd5anim"
+
+// tracks that move less than this over the whole anim are folded into the base frame
+#define ANIM_CONSTANT_EPSILON		1e-5f
+
+/*
+====================
+NumAnimBitComponents
+====================
+*/
+static int NumAnimBitComponents( int animBits ) {
+	int num;
+
+	for ( num = 0; animBits; animBits >>= 1 ) {
+		num += animBits & 1;
+	}
+	return num;
+}
+
 /***********************************************************************
 
 	idMD5Anim
@@ -51,6 +72,10 @@ idMD5Anim::idMD5Anim() {
 	frameRate	= 24;
 	animLength	= 0;
 	totaldelta.Zero();
+
+	compressed			= false;
+	numSourceComponents	= 0;
+	compressionError	= 0.0f;
 }
 
 /*
@@ -79,6 +104,13 @@ void idMD5Anim::Free( void ) {
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+
+	compressed			= false;
+	numSourceComponents	= 0;
+	compressionError	= 0.0f;
+	quantizedFrames.Clear();
+	componentScale.Clear();
+	componentBias.Clear();
 }
 
 /*
@@ -137,7 +169,15 @@ bool idMD5Anim::Reload( void ) {
 	filename = name;
 	Free();
 
-	return LoadAnim( filename );
+	if ( !LoadAnim( filename ) ) {
+		return false;
+	}
+
+	if ( g_compressAnims.GetBool() ) {
+		Compress( g_compressAnimsMaxError.GetFloat() );
+	}
+
+	return true;
 }
 
 /*
@@ -147,9 +187,22 @@ idMD5Anim::Allocated
 */
 size_t idMD5Anim::Allocated( void ) const {
 	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size += quantizedFrames.Allocated() + componentScale.Allocated() + componentBias.Allocated();
 	return size;
 }
 
+/*
+====================
+idMD5Anim::SavedByCompression
+====================
+*/
+size_t idMD5Anim::SavedByCompression( void ) const {
+	if ( !compressed ) {
+		return 0;
+	}
+	return numSourceComponents * numFrames * sizeof( float ) - ( quantizedFrames.Allocated() + componentScale.Allocated() + componentBias.Allocated() );
+}
+
 /*
 ====================
 idMD5Anim::LoadAnim
@@ -161,6 +214,17 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	idToken	token;
 	int		i, j;
 	int		num;
+	int		sourceLength;
+	ID_TIME_T	sourceTime;
+
+	sourceLength = fileSystem->ReadFile( filename, NULL, &sourceTime );
+	if ( sourceLength > 0 && g_binaryAnims.GetBool() ) {
+		Free();
+		name = filename;
+		if ( LoadBinary( sourceLength, sourceTime ) ) {
+			return true;
+		}
+	}
 
 	if ( !parser.LoadFile( filename ) ) {
 		return false;
@@ -323,10 +387,325 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
+	numSourceComponents = numAnimatedComponents;
+
+	if ( sourceLength > 0 && g_binaryAnims.GetBool() ) {
+		WriteBinary( sourceLength, sourceTime );
+	}
+
 	// done
 	return true;
 }
 
+/*
+====================
+idMD5Anim::BinaryName
+====================
+*/
+idStr idMD5Anim::BinaryName( void ) const {
+	idStr binaryName = idStr( "generated/" ) + name;
+	binaryName.SetFileExtension( MD5ANIM_BINARY_EXT );
+	return binaryName;
+}
+
+/*
+====================
+idMD5Anim::WriteBinary
+
+Writes the parsed float frames, arrays are in native byte order since the
+file is a local cache.  Joints are stored by name because the joint name
+indexes depend on the load order.
+====================
+*/
+void idMD5Anim::WriteBinary( int sourceLength, ID_TIME_T sourceTime ) const {
+	idFile_Memory	data;
+	idFile			*file;
+	int				i;
+
+	data.WriteInt( numFrames );
+	data.WriteInt( frameRate );
+	data.WriteInt( animLength );
+	data.WriteInt( numJoints );
+	data.WriteInt( numAnimatedComponents );
+	data.WriteVec3( totaldelta );
+
+	for( i = 0; i < numJoints; i++ ) {
+		data.WriteString( animationLib.JointName( jointInfo[ i ].nameIndex ) );
+		data.WriteInt( jointInfo[ i ].parentNum );
+		data.WriteInt( jointInfo[ i ].animBits );
+		data.WriteInt( jointInfo[ i ].firstComponent );
+	}
+	data.Write( bounds.Ptr(), numFrames * sizeof( bounds[ 0 ] ) );
+	data.Write( baseFrame.Ptr(), numJoints * sizeof( baseFrame[ 0 ] ) );
+	data.Write( componentFrames.Ptr(), numAnimatedComponents * numFrames * sizeof( componentFrames[ 0 ] ) );
+
+	file = fileSystem->OpenFileWrite( BinaryName() );
+	if ( !file ) {
+		gameLocal.Warning( "couldn't write %s", BinaryName().c_str() );
+		return;
+	}
+
+	file->WriteInt( MD5ANIM_BINARY_IDENT );
+	file->WriteInt( MD5ANIM_BINARY_VERSION );
+	file->WriteInt( sourceLength );
+	file->WriteInt( (int) sourceTime );
+	file->WriteInt( data.Length() );
+	file->WriteInt( (int) CRC32_BlockChecksum( data.GetDataPtr(), data.Length() ) );
+	file->Write( data.GetDataPtr(), data.Length() );
+
+	fileSystem->CloseFile( file );
+}
+
+/*
+====================
+idMD5Anim::LoadBinary
+
+Loads the anim with a single read from the cache written by WriteBinary.
+Returns false if the cache is missing, out of date or damaged.
+====================
+*/
+bool idMD5Anim::LoadBinary( int sourceLength, ID_TIME_T sourceTime ) {
+	void	*buffer;
+	int		length;
+	int		ident, version, cachedLength, cachedTime, dataLength, crc;
+	int		i, size;
+	idStr	jointName;
+	bool	ok;
+
+	length = fileSystem->ReadFile( BinaryName(), &buffer );
+	if ( length <= 0 ) {
+		return false;
+	}
+
+	idFile_Memory file( BinaryName(), (const char *)buffer, length );
+
+	file.ReadInt( ident );
+	file.ReadInt( version );
+	file.ReadInt( cachedLength );
+	file.ReadInt( cachedTime );
+	file.ReadInt( dataLength );
+	file.ReadInt( crc );
+	if ( ident != MD5ANIM_BINARY_IDENT || version != MD5ANIM_BINARY_VERSION ||
+			cachedLength != sourceLength || cachedTime != (int) sourceTime ||
+			dataLength != length - file.Tell() || (unsigned long) crc != CRC32_BlockChecksum( (const byte *)buffer + file.Tell(), dataLength ) ) {
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	file.ReadInt( numFrames );
+	file.ReadInt( frameRate );
+	file.ReadInt( animLength );
+	file.ReadInt( numJoints );
+	file.ReadInt( numAnimatedComponents );
+	file.ReadVec3( totaldelta );
+
+	ok = ( numFrames > 0 && numJoints > 0 && frameRate >= 0 && numAnimatedComponents >= 0 && numAnimatedComponents <= numJoints * 6 );
+	if ( ok ) {
+		jointInfo.SetGranularity( 1 );
+		jointInfo.SetNum( numJoints );
+		for( i = 0; i < numJoints; i++ ) {
+			file.ReadString( jointName );
+			jointInfo[ i ].nameIndex = animationLib.JointIndex( jointName );
+			file.ReadInt( jointInfo[ i ].parentNum );
+			file.ReadInt( jointInfo[ i ].animBits );
+			file.ReadInt( jointInfo[ i ].firstComponent );
+		}
+
+		bounds.SetGranularity( 1 );
+		bounds.SetNum( numFrames );
+		size = numFrames * sizeof( bounds[ 0 ] );
+		ok = ok && file.Read( bounds.Ptr(), size ) == size;
+
+		baseFrame.SetGranularity( 1 );
+		baseFrame.SetNum( numJoints );
+		size = numJoints * sizeof( baseFrame[ 0 ] );
+		ok = ok && file.Read( baseFrame.Ptr(), size ) == size;
+
+		componentFrames.SetGranularity( 1 );
+		componentFrames.SetNum( numAnimatedComponents * numFrames );
+		size = numAnimatedComponents * numFrames * sizeof( componentFrames[ 0 ] );
+		ok = ok && file.Read( componentFrames.Ptr(), size ) == size;
+	}
+
+	fileSystem->FreeFile( buffer );
+
+	if ( !ok ) {
+		gameLocal.Warning( "%s is damaged, loading %s", BinaryName().c_str(), name.c_str() );
+		idStr filename = name;
+		Free();
+		name = filename;
+		return false;
+	}
+
+	numSourceComponents = numAnimatedComponents;
+
+	return true;
+}
+
+/*
+====================
+idMD5Anim::Compress
+
+Folds components that never change into the base frame and stores the remaining
+components as 16 bits per frame with a per component scale and bias.  Leaves the
+float frames alone if the quantization error would exceed maxError or if the
+anim has too few frames to get any smaller.
+====================
+*/
+bool idMD5Anim::Compress( float maxError ) {
+	int						i, j, bit, component;
+	int						numTracks;
+	float					value, range, error;
+	idList<float>			minValue;
+	idList<float>			maxValue;
+	idList<int>				remap;
+	idList<unsigned short>	newFrames;
+	idList<float>			newScale;
+	idList<float>			newBias;
+
+	if ( compressed ) {
+		return true;
+	}
+
+	if ( !numAnimatedComponents ) {
+		return false;
+	}
+
+	// find the range of every component
+	minValue.SetNum( numAnimatedComponents );
+	maxValue.SetNum( numAnimatedComponents );
+	for( i = 0; i < numAnimatedComponents; i++ ) {
+		minValue[ i ] = maxValue[ i ] = componentFrames[ i ];
+	}
+	for( j = 1; j < numFrames; j++ ) {
+		const float *frame = &componentFrames[ j * numAnimatedComponents ];
+		for( i = 0; i < numAnimatedComponents; i++ ) {
+			if ( frame[ i ] < minValue[ i ] ) {
+				minValue[ i ] = frame[ i ];
+			} else if ( frame[ i ] > maxValue[ i ] ) {
+				maxValue[ i ] = frame[ i ];
+			}
+		}
+	}
+
+	// constant components are dropped from the frames
+	error = 0.0f;
+	numTracks = 0;
+	remap.SetNum( numAnimatedComponents );
+	for( i = 0; i < numAnimatedComponents; i++ ) {
+		range = maxValue[ i ] - minValue[ i ];
+		if ( range <= ANIM_CONSTANT_EPSILON ) {
+			remap[ i ] = -1;
+			error = Max( error, range * 0.5f );
+		} else {
+			remap[ i ] = numTracks++;
+		}
+	}
+
+	if ( numTracks * ( numFrames * sizeof( unsigned short ) + 2 * sizeof( float ) ) >= numAnimatedComponents * numFrames * sizeof( float ) ) {
+		// not worth it
+		return false;
+	}
+
+	newScale.SetGranularity( 1 );
+	newScale.SetNum( numTracks );
+	newBias.SetGranularity( 1 );
+	newBias.SetNum( numTracks );
+	for( i = 0; i < numAnimatedComponents; i++ ) {
+		if ( remap[ i ] >= 0 ) {
+			newScale[ remap[ i ] ] = ( maxValue[ i ] - minValue[ i ] ) / 65535.0f;
+			newBias[ remap[ i ] ] = minValue[ i ];
+		}
+	}
+
+	// quantize the frames and check the error against the float frames
+	newFrames.SetGranularity( 1 );
+	newFrames.SetNum( numTracks * numFrames );
+	for( j = 0; j < numFrames; j++ ) {
+		const float *frame = &componentFrames[ j * numAnimatedComponents ];
+		unsigned short *quantized = &newFrames[ j * numTracks ];
+		for( i = 0; i < numAnimatedComponents; i++ ) {
+			component = remap[ i ];
+			if ( component < 0 ) {
+				continue;
+			}
+			int q = idMath::ClampInt( 0, 65535, idMath::FtoiFast( ( frame[ i ] - newBias[ component ] ) / newScale[ component ] + 0.5f ) );
+			quantized[ component ] = q;
+			error = Max( error, idMath::Fabs( newBias[ component ] + newScale[ component ] * q - frame[ i ] ) );
+		}
+	}
+
+	if ( error > maxError ) {
+		gameLocal.Warning( "Anim '%s' not compressed: error %f exceeds %f", name.c_str(), error, maxError );
+		return false;
+	}
+
+	// fold the constant components into the base frame and remap the joints
+	for( i = 0; i < numJoints; i++ ) {
+		jointAnimInfo_t &info = jointInfo[ i ];
+		int animBits = 0;
+		int firstComponent = -1;
+
+		component = info.firstComponent;
+		for( bit = 0; bit < 6; bit++ ) {
+			if ( !( info.animBits & BIT( bit ) ) ) {
+				continue;
+			}
+			if ( remap[ component ] < 0 ) {
+				value = ( minValue[ component ] + maxValue[ component ] ) * 0.5f;
+				if ( bit < 3 ) {
+					baseFrame[ i ].t[ bit ] = value;
+				} else {
+					baseFrame[ i ].q[ bit - 3 ] = value;
+				}
+			} else {
+				if ( firstComponent < 0 ) {
+					firstComponent = remap[ component ];
+				}
+				animBits |= BIT( bit );
+			}
+			component++;
+		}
+
+		if ( ( info.animBits & ~animBits ) & ( ANIM_QX | ANIM_QY | ANIM_QZ ) ) {
+			baseFrame[ i ].q.w = baseFrame[ i ].q.CalcW();
+		}
+
+		info.animBits = animBits;
+		info.firstComponent = ( firstComponent >= 0 ) ? firstComponent : 0;
+	}
+
+	quantizedFrames = newFrames;
+	componentScale = newScale;
+	componentBias = newBias;
+	componentFrames.Clear();
+
+	numAnimatedComponents = numTracks;
+	compressionError = error;
+	compressed = true;
+
+	return true;
+}
+
+/*
+====================
+idMD5Anim::GetFrameComponents
+
+Returns the components [firstComponent, firstComponent + numComponents) of a frame.
+Compressed anims are decoded into the decoded buffer.
+====================
+*/
+const float *idMD5Anim::GetFrameComponents( int framenum, int firstComponent, int numComponents, float *decoded ) const {
+	int offset = framenum * numAnimatedComponents + firstComponent;
+
+	if ( !compressed ) {
+		return &componentFrames[ offset ];
+	}
+
+	SIMDProcessor->DequantizeComponents( decoded, &quantizedFrames[ offset ], &componentScale[ firstComponent ], &componentBias[ firstComponent ], numComponents );
+	return decoded;
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -442,8 +821,10 @@ void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float decoded1[ 3 ], decoded2[ 3 ];
+	int numComponents = NumAnimBitComponents( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) );
+	const float *componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, numComponents, decoded1 );
+	const float *componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, numComponents, decoded2 );
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -484,8 +865,10 @@ void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount )
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float decoded1[ 6 ], decoded2[ 6 ];
+	int numComponents = NumAnimBitComponents( animBits );
+	const float	*jointframe1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, numComponents, decoded1 );
+	const float	*jointframe2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, numComponents, decoded2 );
 
 	if ( animBits & ANIM_TX ) {
 		jointframe1++;
@@ -598,8 +981,10 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	// origin position
 	offset = baseFrame[ 0 ].t;
 	if ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		float decoded1[ 3 ], decoded2[ 3 ];
+		int numComponents = NumAnimBitComponents( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) );
+		const float *componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, numComponents, decoded1 );
+		const float *componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, numComponents, decoded2 );
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -652,8 +1037,14 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	lerpIndex = (int *)_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 	numLerpJoints = 0;
 
-	frame1 = &componentFrames[ frame.frame1 * numAnimatedComponents ];
-	frame2 = &componentFrames[ frame.frame2 * numAnimatedComponents ];
+	if ( compressed ) {
+		float *decoded = (float *)_alloca16( 2 * numAnimatedComponents * sizeof( decoded[ 0 ] ) );
+		frame1 = GetFrameComponents( frame.frame1, 0, numAnimatedComponents, decoded );
+		frame2 = GetFrameComponents( frame.frame2, 0, numAnimatedComponents, decoded + numAnimatedComponents );
+	} else {
+		frame1 = &componentFrames[ frame.frame1 * numAnimatedComponents ];
+		frame2 = &componentFrames[ frame.frame2 * numAnimatedComponents ];
+	}
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -833,7 +1224,12 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 		return;
 	}
 
-	frame = &componentFrames[ framenum * numAnimatedComponents ];
+	if ( compressed ) {
+		float *decoded = (float *)_alloca16( numAnimatedComponents * sizeof( decoded[ 0 ] ) );
+		frame = GetFrameComponents( framenum, 0, numAnimatedComponents, decoded );
+	} else {
+		frame = &componentFrames[ framenum * numAnimatedComponents ];
+	}
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -972,6 +1368,8 @@ idMD5Anim *idAnimManager::GetAnim( const char *name ) {
 			gameLocal.Warning( "Couldn't load anim: '%s'", filename.c_str() );
 			delete anim;
 			anim = NULL;
+		} else if ( g_compressAnims.GetBool() ) {
+			anim->Compress( g_compressAnimsMaxError.GetFloat() );
 		}
 		animations.Set( filename, anim );
 	}
@@ -1037,18 +1435,26 @@ void idAnimManager::ListAnims( void ) const {
 	size_t		size;
 	size_t		s;
 	size_t		namesize;
+	size_t		saved;
 	int			num;
+	int			numCompressed;
 
 	num = 0;
+	numCompressed = 0;
 	size = 0;
+	saved = 0;
 	for( i = 0; i < animations.Num(); i++ ) {
 		animptr = animations.GetIndex( i );
 		if ( animptr && *animptr ) {
 			anim = *animptr;
 			s = anim->Size();
-			gameLocal.Printf( "%8zd bytes : %2d refs : %s\n", s, anim->NumRefs(), anim->Name() );
+			gameLocal.Printf( "%8zd bytes : %2d refs : %s%s\n", s, anim->NumRefs(), anim->Name(), anim->IsCompressed() ? " (compressed)" : "" );
 			size += s;
 			num++;
+			if ( anim->IsCompressed() ) {
+				saved += anim->SavedByCompression();
+				numCompressed++;
+			}
 		}
 	}
 
@@ -1058,9 +1464,185 @@ void idAnimManager::ListAnims( void ) const {
 	}
 
 	gameLocal.Printf( "\n%zd memory used in %d anims\n", size, num );
+	gameLocal.Printf( "%zd memory saved by %d compressed anims\n", saved, numCompressed );
 	gameLocal.Printf( "%zd memory used in %d joint names\n", namesize, jointnames.Num() );
 }
 
+/*
+================
+idAnimManager::TestCompression
+
+Decodes every loaded anim from float and from compressed frames and
+compares memory, decode time and the resulting joints.
+================
+*/
+void idAnimManager::TestCompression( int numLoops ) const {
+	int				i, j, k, loop;
+	idMD5Anim		**animptr;
+	frameBlend_t	frame;
+	idTimer			floatTimer, packedTimer;
+	double			totalFloatTime, totalPackedTime;
+	size_t			totalFloatSize, totalPackedSize;
+	float			maxError, totalMaxError;
+	int				numDecodes, numTested;
+
+	totalFloatTime = totalPackedTime = 0.0;
+	totalFloatSize = totalPackedSize = 0;
+	totalMaxError = 0.0f;
+	numDecodes = 0;
+	numTested = 0;
+
+	for( i = 0; i < animations.Num(); i++ ) {
+		animptr = animations.GetIndex( i );
+		if ( !animptr || !*animptr ) {
+			continue;
+		}
+
+		idMD5Anim floatAnim;
+		if ( !floatAnim.LoadAnim( ( *animptr )->Name() ) ) {
+			continue;
+		}
+		idMD5Anim packedAnim = floatAnim;
+		if ( !packedAnim.Compress( g_compressAnimsMaxError.GetFloat() ) ) {
+			gameLocal.Printf( "%s: not compressed\n", floatAnim.Name() );
+			continue;
+		}
+
+		int numJoints = floatAnim.NumJoints();
+		int numFrames = floatAnim.NumFrames();
+		int *index = (int *)_alloca16( numJoints * sizeof( index[ 0 ] ) );
+		idJointQuat *floatJoints = (idJointQuat *)_alloca16( numJoints * sizeof( floatJoints[ 0 ] ) );
+		idJointQuat *packedJoints = (idJointQuat *)_alloca16( numJoints * sizeof( packedJoints[ 0 ] ) );
+		for( j = 0; j < numJoints; j++ ) {
+			index[ j ] = j;
+		}
+
+		frame.cycleCount = 0;
+		frame.frontlerp = 0.5f;
+		frame.backlerp = 0.5f;
+
+		// check the error of every frame
+		maxError = 0.0f;
+		for( j = 0; j < numFrames; j++ ) {
+			frame.frame1 = j;
+			frame.frame2 = ( j + 1 ) % numFrames;
+			floatAnim.GetInterpolatedFrame( frame, floatJoints, index, numJoints );
+			packedAnim.GetInterpolatedFrame( frame, packedJoints, index, numJoints );
+			for( k = 0; k < numJoints; k++ ) {
+				maxError = Max( maxError, ( floatJoints[ k ].t - packedJoints[ k ].t ).LengthFast() );
+				for( int c = 0; c < 4; c++ ) {
+					maxError = Max( maxError, idMath::Fabs( floatJoints[ k ].q[ c ] - packedJoints[ k ].q[ c ] ) );
+				}
+			}
+		}
+
+		floatTimer.Clear();
+		floatTimer.Start();
+		for( loop = 0; loop < numLoops; loop++ ) {
+			for( j = 0; j < numFrames; j++ ) {
+				frame.frame1 = j;
+				frame.frame2 = ( j + 1 ) % numFrames;
+				floatAnim.GetInterpolatedFrame( frame, floatJoints, index, numJoints );
+			}
+		}
+		floatTimer.Stop();
+
+		packedTimer.Clear();
+		packedTimer.Start();
+		for( loop = 0; loop < numLoops; loop++ ) {
+			for( j = 0; j < numFrames; j++ ) {
+				frame.frame1 = j;
+				frame.frame2 = ( j + 1 ) % numFrames;
+				packedAnim.GetInterpolatedFrame( frame, packedJoints, index, numJoints );
+			}
+		}
+		packedTimer.Stop();
+
+		gameLocal.Printf( "%7zd -> %7zd bytes : error %.5f : %6.2f -> %6.2f us/frame : %s\n",
+			floatAnim.Allocated(), packedAnim.Allocated(), maxError,
+			floatTimer.Milliseconds() * 1000.0 / ( numLoops * numFrames ),
+			packedTimer.Milliseconds() * 1000.0 / ( numLoops * numFrames ), floatAnim.Name() );
+
+		totalFloatSize += floatAnim.Allocated();
+		totalPackedSize += packedAnim.Allocated();
+		totalFloatTime += floatTimer.Milliseconds();
+		totalPackedTime += packedTimer.Milliseconds();
+		totalMaxError = Max( totalMaxError, maxError );
+		numDecodes += numLoops * numFrames;
+		numTested++;
+	}
+
+	if ( !numDecodes ) {
+		gameLocal.Printf( "no anims to test\n" );
+		return;
+	}
+
+	gameLocal.Printf( "\n%d anims: %zd -> %zd bytes, max error %.5f\n", numTested, totalFloatSize, totalPackedSize, totalMaxError );
+	gameLocal.Printf( "float frames: %.0f frames/ms, compressed frames: %.0f frames/ms\n",
+		numDecodes / Max( totalFloatTime, 1e-3 ), numDecodes / Max( totalPackedTime, 1e-3 ) );
+}
+
+/*
+================
+idAnimManager::TestBinaryLoad
+
+Compares text and binary load times of the loaded anims.
+================
+*/
+void idAnimManager::TestBinaryLoad( const char *filter ) const {
+	int				i;
+	idMD5Anim		**animptr;
+	bool			binaryAnims;
+	idTimer			textTimer, binaryTimer;
+	double			totalText, totalBinary;
+	int				num;
+
+	binaryAnims = g_binaryAnims.GetBool();
+	totalText = totalBinary = 0.0;
+	num = 0;
+
+	gameLocal.Printf( "    text  binary\n" );
+	for( i = 0; i < animations.Num(); i++ ) {
+		animptr = animations.GetIndex( i );
+		if ( !animptr || !*animptr || idStr::Icmpn( ( *animptr )->Name(), filter, idStr::Length( filter ) ) != 0 ) {
+			continue;
+		}
+
+		idStr filename = ( *animptr )->Name();
+
+		// make sure the binary cache is up to date
+		g_binaryAnims.SetBool( true );
+		idMD5Anim *test = new idMD5Anim();
+		test->LoadAnim( filename );
+		delete test;
+
+		g_binaryAnims.SetBool( false );
+		textTimer.Clear();
+		textTimer.Start();
+		test = new idMD5Anim();
+		test->LoadAnim( filename );
+		textTimer.Stop();
+		delete test;
+
+		g_binaryAnims.SetBool( true );
+		binaryTimer.Clear();
+		binaryTimer.Start();
+		test = new idMD5Anim();
+		test->LoadAnim( filename );
+		binaryTimer.Stop();
+		delete test;
+
+		gameLocal.Printf( "%6.1fms %6.1fms %s\n", textTimer.Milliseconds(), binaryTimer.Milliseconds(), filename.c_str() );
+		totalText += textTimer.Milliseconds();
+		totalBinary += binaryTimer.Milliseconds();
+		num++;
+	}
+
+	g_binaryAnims.SetBool( binaryAnims );
+
+	gameLocal.Printf( "%d anims: %.1fms text, %.1fms binary\n", num, totalText, totalBinary );
+}
+
 /*
 ================
 idAnimManager::FlushUnusedAnims
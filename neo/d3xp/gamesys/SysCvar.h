@@ -52,8 +52,16 @@ extern idCVar   g_projectileLightLodBias;
 extern idCVar   g_muzzleFlashLightLodBias;
 
 extern idCVar	g_disasm;
+extern idCVar	g_scriptCache;
+extern idCVar	g_scriptProfileOpcodes;
 extern idCVar	g_debugBounds;
 extern idCVar	g_debugAnim;
+extern idCVar	g_binaryAnims;
+extern idCVar	g_compressAnims;
+extern idCVar	g_compressAnimsMaxError;
+extern idCVar	g_animPoseCache;
+extern idCVar	g_showAnimPoseCache;
+extern idCVar	g_parallelAnim;
 extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
@@ -77,6 +85,9 @@ extern idCVar	g_showCollisionWorld;
 extern idCVar	g_showCollisionModels;
 extern idCVar	g_showCollisionTraces;
 extern idCVar	g_maxShowDistance;
+extern idCVar	g_clipBroadphase;
+extern idCVar	g_parallelPhysics;
+extern idCVar	g_showPhysicsIslands;
 extern idCVar	g_showEntityInfo;
 extern idCVar	g_showviewpos;
 extern idCVar	g_showcamerainfo;
@@ -85,6 +96,7 @@ extern idCVar	g_showActiveEntities;
 extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
+extern idCVar	g_showEventAllocs;
 extern idCVar	g_timeentities;
 
 extern idCVar	ai_debugScript;
@@ -95,6 +107,13 @@ extern idCVar	ai_showCombatNodes;
 extern idCVar	ai_showPaths;
 extern idCVar	ai_showObstacleAvoidance;
 extern idCVar	ai_blockedFailSafe;
+extern idCVar	ai_pathBudget;
+extern idCVar	ai_showPathQueue;
+extern idCVar	ai_thinkLOD;
+extern idCVar	ai_lodDistance;
+extern idCVar	ai_lodNearInterval;
+extern idCVar	ai_lodFarInterval;
+extern idCVar	ai_showThinkLOD;
 #ifdef _D3XP
 extern idCVar	ai_showHealth;
 #endif
@@ -135,6 +154,7 @@ extern idCVar	af_useLinearTime;
 extern idCVar	af_useImpulseFriction;
 extern idCVar	af_useJointImpulseFriction;
 extern idCVar	af_useSymmetry;
+extern idCVar	af_lcpWarmStart;
 extern idCVar	af_skipSelfCollision;
 extern idCVar	af_skipLimits;
 extern idCVar	af_skipFriction;
@@ -168,6 +188,8 @@ extern idCVar	rb_showMass;
 extern idCVar	rb_showInertia;
 extern idCVar	rb_showVelocity;
 extern idCVar	rb_showActive;
+extern idCVar	rb_showSleep;
+extern idCVar	rb_sleepIslands;
 
 extern idCVar	pm_jumpheight;
 extern idCVar	pm_stepsize;
@@ -267,6 +289,11 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_precomputeRouting;
+extern idCVar	aas_precomputeMemory;
+extern idCVar	aas_writeRoutingCache;
+extern idCVar	aas_routingCacheMemory;
+extern idCVar	aas_showRouteHitches;
 
 extern idCVar	net_clientPredictGUI;
 
@@ -31,24 +31,6 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
-#define	MAX_SECTOR_DEPTH				12
-#define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
-
-typedef struct clipSector_s {
-	int						axis;		// -1 = leaf node
-	float					dist;
-	struct clipSector_s *	children[2];
-	struct clipLink_s *		clipLinks;
-} clipSector_t;
-
-typedef struct clipLink_s {
-	idClipModel *			clipModel;
-	struct clipSector_s *	sector;
-	struct clipLink_s *		prevInSector;
-	struct clipLink_s *		nextInSector;
-	struct clipLink_s *		nextLink;
-} clipLink_t;
-
 typedef struct trmCache_s {
 	idTraceModel			trm;
 	int						refCount;
@@ -59,9 +41,6 @@ typedef struct trmCache_s {
 
 idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
-idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
-
-
 /*
 ===============================================================
 
@@ -283,8 +262,11 @@ void idClipModel::Init( void ) {
 	collisionModelHandle = 0;
 	renderModelHandle = -1;
 	traceModelIndex = -1;
+	broadphase = NULL;
+	linked = false;
 	clipLinks = NULL;
 	touchCount = -1;
+	proxyId = -1;
 }
 
 /*
@@ -349,8 +331,11 @@ idClipModel::idClipModel( const idClipModel *model ) {
 		LoadModel( *GetCachedTraceModel( model->traceModelIndex ) );
 	}
 	renderModelHandle = model->renderModelHandle;
+	broadphase = NULL;
+	linked = false;
 	clipLinks = NULL;
 	touchCount = -1;
+	proxyId = -1;
 }
 
 /*
@@ -360,7 +345,12 @@ idClipModel::~idClipModel
 */
 idClipModel::~idClipModel( void ) {
 	// make sure the clip model is no longer linked
-	Unlink();
+	if ( linked ) {
+		gameLocal.clip.ClipModelChanged( this );
+	}
+	if ( broadphase ) {
+		broadphase->Remove( this );
+	}
 	if ( traceModelIndex != -1 ) {
 		FreeTraceModel( traceModelIndex );
 	}
@@ -389,7 +379,7 @@ void idClipModel::Save( idSaveGame *savefile ) const {
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
+	savefile->WriteBool( linked );
 	savefile->WriteInt( touchCount );
 }
 
@@ -428,8 +418,11 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
+	broadphase = NULL;
+	this->linked = false;
 	clipLinks = NULL;
 	touchCount = -1;
+	proxyId = -1;
 
 	if ( linked ) {
 		Link( gameLocal.clip, entity, id, origin, axis, renderModelHandle );
@@ -442,7 +435,7 @@ idClipModel::SetPosition
 ================
 */
 void idClipModel::SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis ) {
-	if ( clipLinks ) {
+	if ( linked ) {
 		Unlink();	// unlink from old position
 	}
 	origin = newOrigin;
@@ -489,52 +482,10 @@ idClipModel::Unlink
 ===============
 */
 void idClipModel::Unlink( void ) {
-	clipLink_t *link;
-
-	for ( link = clipLinks; link; link = clipLinks ) {
-		clipLinks = link->nextLink;
-		if ( link->prevInSector ) {
-			link->prevInSector->nextInSector = link->nextInSector;
-		} else {
-			link->sector->clipLinks = link->nextInSector;
-		}
-		if ( link->nextInSector ) {
-			link->nextInSector->prevInSector = link->prevInSector;
-		}
-		clipLinkAllocator.Free( link );
-	}
-}
-
-/*
-===============
-idClipModel::Link_r
-===============
-*/
-void idClipModel::Link_r( struct clipSector_s *node ) {
-	clipLink_t *link;
-
-	while( node->axis != -1 ) {
-		if ( absBounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( absBounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			Link_r( node->children[0] );
-			node = node->children[1];
-		}
-	}
-
-	link = clipLinkAllocator.Alloc();
-	link->clipModel = this;
-	link->sector = node;
-	link->nextInSector = node->clipLinks;
-	link->prevInSector = NULL;
-	if ( node->clipLinks ) {
-		node->clipLinks->prevInSector = link;
+	if ( linked ) {
+		gameLocal.clip.ClipModelChanged( this );
+		broadphase->Unlink( this );
 	}
-	node->clipLinks = link;
-	link->nextLink = clipLinks;
-	clipLinks = link;
 }
 
 /*
@@ -549,7 +500,7 @@ void idClipModel::Link( idClip &clp ) {
 		return;
 	}
 
-	if ( clipLinks ) {
+	if ( linked ) {
 		Unlink();	// unlink from old position
 	}
 
@@ -572,7 +523,48 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r( clp.clipSectors );
+	// drop data kept by a different broadphase
+	if ( broadphase && broadphase != clp.broadphase ) {
+		broadphase->Remove( this );
+	}
+	clp.broadphase->Link( this );
+	clp.ClipModelChanged( this );
+}
+
+/*
+===============
+idClipModel::Enable
+===============
+*/
+void idClipModel::Enable( void ) {
+	if ( !enabled && linked ) {
+		gameLocal.clip.ClipModelChanged( this );
+	}
+	enabled = true;
+}
+
+/*
+===============
+idClipModel::Disable
+===============
+*/
+void idClipModel::Disable( void ) {
+	if ( enabled && linked ) {
+		gameLocal.clip.ClipModelChanged( this );
+	}
+	enabled = false;
+}
+
+/*
+===============
+idClipModel::SetContents
+===============
+*/
+void idClipModel::SetContents( int newContents ) {
+	if ( contents != newContents && linked ) {
+		gameLocal.clip.ClipModelChanged( this );
+	}
+	contents = newContents;
 }
 
 /*
@@ -620,60 +612,11 @@ idClip::idClip
 ===============
 */
 idClip::idClip( void ) {
-	numClipSectors = 0;
-	clipSectors = NULL;
+	broadphase = NULL;
 	worldBounds.Zero();
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
-}
-
-/*
-===============
-idClip::CreateClipSectors_r
-
-Builds a uniformly subdivided tree for the given world size
-===============
-*/
-clipSector_t *idClip::CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector ) {
-	int				i;
-	clipSector_t	*anode;
-	idVec3			size;
-	idBounds		front, back;
-
-	anode = &clipSectors[idClip::numClipSectors];
-	idClip::numClipSectors++;
-
-	if ( depth == MAX_SECTOR_DEPTH ) {
-		anode->axis = -1;
-		anode->children[0] = anode->children[1] = NULL;
-
-		for ( i = 0; i < 3; i++ ) {
-			if ( bounds[1][i] - bounds[0][i] > maxSector[i] ) {
-				maxSector[i] = bounds[1][i] - bounds[0][i];
-			}
-		}
-		return anode;
-	}
-
-	size = bounds[1] - bounds[0];
-	if ( size[0] >= size[1] && size[0] >= size[2] ) {
-		anode->axis = 0;
-	} else if ( size[1] >= size[0] && size[1] >= size[2] ) {
-		anode->axis = 1;
-	} else {
-		anode->axis = 2;
-	}
-
-	anode->dist = 0.5f * ( bounds[1][anode->axis] + bounds[0][anode->axis] );
-
-	front = bounds;
-	back = bounds;
-
-	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
-
-	anode->children[0] = CreateClipSectors_r( depth+1, front, maxSector );
-	anode->children[1] = CreateClipSectors_r( depth+1, back, maxSector );
-
-	return anode;
+	trackChanges = false;
+	changedBounds.Clear();
 }
 
 /*
@@ -683,22 +626,18 @@ idClip::Init
 */
 void idClip::Init( void ) {
 	cmHandle_t h;
-	idVec3 size, maxSector = vec3_origin;
+	idVec3 size;
 
-	// clear clip sectors
-	clipSectors = new clipSector_t[MAX_SECTORS];
-	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
-	numClipSectors = 0;
-	touchCount = -1;
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap", false );
 	collisionModelManager->GetModelBounds( h, worldBounds );
-	// create world sectors
-	CreateClipSectors_r( 0, worldBounds, maxSector );
 
 	size = worldBounds[1] - worldBounds[0];
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
-	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
+
+	// create the broadphase
+	broadphase = idClipBroadphase::Alloc( g_clipBroadphase.GetInteger() );
+	broadphase->Init( worldBounds );
 
 	// initialize a default clip model
 	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
@@ -713,8 +652,13 @@ idClip::Shutdown
 ===============
 */
 void idClip::Shutdown( void ) {
-	delete[] clipSectors;
-	clipSectors = NULL;
+	EndChangeTracking();
+
+	if ( broadphase ) {
+		broadphase->Shutdown();
+		delete broadphase;
+		broadphase = NULL;
+	}
 
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
@@ -727,73 +671,71 @@ void idClip::Shutdown( void ) {
 		idClipModel::FreeTraceModel( defaultClipModel.traceModelIndex );
 		defaultClipModel.traceModelIndex = -1;
 	}
-
-	clipLinkAllocator.Shutdown();
 }
 
 /*
-====================
-idClip::ClipModelsTouchingBounds_r
-====================
+===============
+idClip::ConcurrentQueries
+===============
 */
-typedef struct listParms_s {
-	idBounds		bounds;
-	int				contentMask;
-	idClipModel	**	list;
-	int				count;
-	int				maxCount;
-} listParms_t;
-
-void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listParms_t &parms ) const {
-
-	while( node->axis != -1 ) {
-		if ( parms.bounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( parms.bounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			ClipModelsTouchingBounds_r( node->children[0], parms );
-			node = node->children[1];
-		}
-	}
-
-	for ( clipLink_t *link = node->clipLinks; link; link = link->nextInSector ) {
-		idClipModel	*check = link->clipModel;
+bool idClip::ConcurrentQueries( void ) const {
+	return ( broadphase != NULL && broadphase->ConcurrentQueries() );
+}
 
-		// if the clip model is enabled
-		if ( !check->enabled ) {
-			continue;
-		}
+/*
+===============
+idClip::BeginChangeTracking
+===============
+*/
+void idClip::BeginChangeTracking( void ) {
+	trackChanges = true;
+	changes.SetNum( 0, false );
+	changedBounds.Clear();
+}
 
-		// avoid duplicates in the list
-		if ( check->touchCount == touchCount ) {
-			continue;
-		}
+/*
+===============
+idClip::EndChangeTracking
+===============
+*/
+void idClip::EndChangeTracking( void ) {
+	trackChanges = false;
+	changes.SetNum( 0, false );
+	changedBounds.Clear();
+}
 
-		// if the clip model does not have any contents we are looking for
-		if ( !( check->contents & parms.contentMask ) ) {
-			continue;
-		}
+/*
+===============
+idClip::ClipModelChanged
+===============
+*/
+void idClip::ClipModelChanged( const idClipModel *mdl ) {
+	if ( !trackChanges ) {
+		return;
+	}
+	clipChange_t &change = changes.Alloc();
+	change.bounds = mdl->absBounds;
+	change.entity = mdl->entity;
+	changedBounds.AddBounds( mdl->absBounds );
+}
 
-		// if the bounds really do overlap
-		if (	check->absBounds[0][0] > parms.bounds[1][0] ||
-				check->absBounds[1][0] < parms.bounds[0][0] ||
-				check->absBounds[0][1] > parms.bounds[1][1] ||
-				check->absBounds[1][1] < parms.bounds[0][1] ||
-				check->absBounds[0][2] > parms.bounds[1][2] ||
-				check->absBounds[1][2] < parms.bounds[0][2] ) {
-			continue;
-		}
+/*
+===============
+idClip::ChangedSinceTracking
+===============
+*/
+bool idClip::ChangedSinceTracking( const idBounds &bounds, const idEntity *passEntity ) const {
+	int i;
 
-		if ( parms.count >= parms.maxCount ) {
-			gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
-			return;
+	if ( !changedBounds.IntersectsBounds( bounds ) ) {
+		return false;
+	}
+	for ( i = 0; i < changes.Num(); i++ ) {
+		if ( changes[i].entity != passEntity && changes[i].bounds.IntersectsBounds( bounds ) ) {
+			return true;
 		}
-
-		check->touchCount = touchCount;
-		parms.list[parms.count] = check;
-		parms.count++;
 	}
+	return false;
 }
 
 /*
@@ -802,7 +744,7 @@ idClip::ClipModelsTouchingBounds
 ================
 */
 int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
-	listParms_t parms;
+	idBounds expanded;
 
 	if (	bounds[0][0] > bounds[1][0] ||
 			bounds[0][1] > bounds[1][1] ||
@@ -812,17 +754,38 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 		return 0;
 	}
 
-	parms.bounds[0] = bounds[0] - vec3_boxEpsilon;
-	parms.bounds[1] = bounds[1] + vec3_boxEpsilon;
-	parms.contentMask = contentMask;
-	parms.list = clipModelList;
-	parms.count = 0;
-	parms.maxCount = maxCount;
+	expanded[0] = bounds[0] - vec3_boxEpsilon;
+	expanded[1] = bounds[1] + vec3_boxEpsilon;
 
-	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	return broadphase->ClipModelsTouchingBounds( expanded, contentMask, clipModelList, maxCount );
+}
+
+/*
+================
+idClip::ClipModelsTouchingBoundsBatch
+================
+*/
+int idClip::ClipModelsTouchingBoundsBatch( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int *boundsIndex, int maxCount ) const {
+	idBounds expanded[CLIP_BROADPHASE_MAX_BATCH];
+	int i, first, num, found, count;
+
+	count = 0;
+	for ( first = 0; first < numBounds; first += CLIP_BROADPHASE_MAX_BATCH ) {
+		num = Min( numBounds - first, CLIP_BROADPHASE_MAX_BATCH );
+		for ( i = 0; i < num; i++ ) {
+			// we should not go through the tree for degenerate or backwards bounds
+			assert( !( bounds[first+i][0][0] > bounds[first+i][1][0] || bounds[first+i][0][1] > bounds[first+i][1][1] || bounds[first+i][0][2] > bounds[first+i][1][2] ) );
+			expanded[i][0] = bounds[first+i][0] - vec3_boxEpsilon;
+			expanded[i][1] = bounds[first+i][1] + vec3_boxEpsilon;
+		}
+		found = broadphase->ClipModelsTouchingBoundsBatch( expanded, num, contentMask, clipModelList + count, boundsIndex + count, maxCount - count );
+		for ( i = 0; i < found; i++ ) {
+			boundsIndex[count+i] += first;
+		}
+		count += found;
+	}
 
-	return parms.count;
+	return count;
 }
 
 /*
@@ -1122,6 +1085,77 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	return ( results.fraction < 1.0f );
 }
 
+/*
+============
+idClip::TracePoints
+============
+*/
+void idClip::TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints,
+						int contentMask, const idEntity *passEntity ) {
+	int i, j, num;
+	idClipModel *touch, *clipModelList[MAX_GENTITIES];
+	idBounds traceBounds;
+	trace_t trace;
+
+	if ( numPoints <= 0 ) {
+		return;
+	}
+
+	if ( !passEntity || passEntity->entityNumber != ENTITYNUM_WORLD ) {
+		// test world with all points at once
+		idClip::numTranslations += numPoints;
+		collisionModelManager->PointTranslations( results, starts, ends, numPoints, contentMask, 0, vec3_origin, mat3_default );
+		for ( i = 0; i < numPoints; i++ ) {
+			results[i].c.entityNum = results[i].fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+		}
+	} else {
+		for ( i = 0; i < numPoints; i++ ) {
+			memset( &results[i], 0, sizeof( results[i] ) );
+			results[i].fraction = 1.0f;
+			results[i].endpos = ends[i];
+			results[i].endAxis = mat3_identity;
+		}
+	}
+
+	for ( i = 0; i < numPoints; i++ ) {
+		trace_t &result = results[i];
+
+		if ( result.fraction == 0.0f ) {
+			continue;		// blocked immediately by the world
+		}
+
+		traceBounds.FromPointTranslation( starts[i], result.endpos - starts[i] );
+
+		num = GetTraceClipModels( traceBounds, contentMask, passEntity, clipModelList );
+
+		for ( j = 0; j < num; j++ ) {
+			touch = clipModelList[j];
+
+			if ( !touch ) {
+				continue;
+			}
+
+			if ( touch->renderModelHandle != -1 ) {
+				idClip::numRenderModelTraces++;
+				TraceRenderModel( trace, starts[i], ends[i], 0.0f, mat3_identity, touch );
+			} else {
+				idClip::numTranslations++;
+				collisionModelManager->Translation( &trace, starts[i], ends[i], NULL, mat3_identity, contentMask,
+										touch->Handle(), touch->origin, touch->axis );
+			}
+
+			if ( trace.fraction < result.fraction ) {
+				result = trace;
+				result.c.entityNum = touch->entity->entityNumber;
+				result.c.id = touch->id;
+				if ( result.fraction == 0.0f ) {
+					break;
+				}
+			}
+		}
+	}
+}
+
 /*
 ============
 idClip::Rotation
@@ -1608,7 +1642,10 @@ idClip::PrintStatistics
 */
 void idClip::PrintStatistics( void ) {
 	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
-					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts );
+					numTranslations.load(), numRotations.load(), numMotions.load(), numRenderModelTraces.load(), numContents.load(), numContacts.load() );
+	if ( broadphase ) {
+		broadphase->PrintStatistics();
+	}
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
@@ -0,0 +1,120 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __ISLANDS_H__
+#define __ISLANDS_H__
+
+/*
+===============================================================================
+
+  Physics islands.
+
+  Groups the active entities into islands of entities that may touch each other
+  during the next frame based on their velocity expanded bounds. The rigid body
+  thinking first in an island that has no team or pusher is independent of all
+  other islands so its motion is predicted on the job threads before the
+  entities think. A rigid body only uses the predicted motion if its state is
+  unchanged and no clip model changed within the predicted motion bounds, so
+  the results are exactly the same as without prediction whatever the number of
+  threads.
+
+===============================================================================
+*/
+
+class idPhysics_RigidBody;
+
+class idPhysicsIslands {
+public:
+							idPhysicsIslands( void );
+							~idPhysicsIslands( void );
+
+	void					Init( void );
+	void					Shutdown( void );
+
+							// build the islands and predict the motion of independent rigid bodies
+	void					PredictMotion( idLinkList<idEntity> &activeEntities );
+							// stop using the predicted motion
+	void					FinishPrediction( void );
+
+	bool					IsPredicting( int predictionId ) const;
+	void					PredictionUsed( void );
+	void					PredictionRejected( void );
+
+private:
+	typedef struct islandEntity_s {
+		idEntity *			entity;
+		idBounds			bounds;				// velocity expanded absolute bounds
+		int					order;				// index in the active entity list
+		int					parent;				// union-find parent
+		bool				serial;				// team member or pusher
+	} islandEntity_t;
+
+	typedef struct predictionJob_s {
+		idPhysics_RigidBody *physics;
+		int					timeStepMSec;
+		int					predictionId;
+	} predictionJob_t;
+
+	idParallelJobList		jobList;
+	int						numThreads;			// number of job threads requested
+	idList<islandEntity_t>	entities;
+	idList<predictionJob_t>	jobs;
+	int						predictionId;
+	bool					predicting;
+
+							// statistics
+	int						numIslands;
+	int						numPredicted;
+	int						numUsed;
+	int						numRejected;
+
+	int						FindIsland( int i );
+	void					MergeIslands( int i, int j );
+	void					BuildIslands( idLinkList<idEntity> &activeEntities, int timeStepMSec );
+	void					UpdateThreads( void );
+
+	static int				SortOnMinX( const islandEntity_t *a, const islandEntity_t *b );
+	static void				PredictMotionJob( void *data );
+	static bool				JobThreadInit( void );
+	static void				JobThreadShutdown( void );
+};
+
+ID_INLINE bool idPhysicsIslands::IsPredicting( int id ) const {
+	return ( predicting && id == predictionId );
+}
+
+ID_INLINE void idPhysicsIslands::PredictionUsed( void ) {
+	numUsed++;
+}
+
+ID_INLINE void idPhysicsIslands::PredictionRejected( void ) {
+	numRejected++;
+}
+
+#endif /* !__ISLANDS_H__ */
@@ -60,6 +60,7 @@ const idVec6 vec6_lcp_epsilon				= idVec6( LCP_EPSILON, LCP_EPSILON, LCP_EPSILON
 static int lastTimerReset = 0;
 static int numArticulatedFigures = 0;
 static idTimer timer_total, timer_pc, timer_ac, timer_collision, timer_lcp;
+static int numLCPSolves = 0, numLCPWarmStarts = 0, numLCPIterations = 0;
 #endif
 
 
@@ -97,6 +98,13 @@ idAFConstraint::idAFConstraint( void ) {
 	boxIndex[4]			= -1;
 	boxIndex[5]			= -1;
 
+	lmSide[0]			= 0;
+	lmSide[1]			= 0;
+	lmSide[2]			= 0;
+	lmSide[3]			= 0;
+	lmSide[4]			= 0;
+	lmSide[5]			= 0;
+
 	firstIndex			= 0;
 
 	memset( &fl, 0, sizeof( fl ) );
@@ -5043,7 +5051,7 @@ idPhysics_AF::AuxiliaryForces
 ================
 */
 void idPhysics_AF::AuxiliaryForces( float timeStep ) {
-	int i, j, k, l, n, m, s, numAuxConstraints, *index, *boxIndex;
+	int i, j, k, l, n, m, s, numAuxConstraints, *index, *boxIndex, *side;
 	float *ptr, *j1, *j2, *dstPtr, *forcePtr;
 	float invStep, u;
 	idAFBody *body;
@@ -5176,6 +5184,7 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 	hi.SetData( numAuxConstraints, VECX_ALLOCA( numAuxConstraints ) );
 	lm.SetData( numAuxConstraints, VECX_ALLOCA( numAuxConstraints ) );
 	boxIndex = (int *) _alloca16( numAuxConstraints * sizeof( int ) );
+	side = (int *) _alloca16( numAuxConstraints * sizeof( int ) );
 
 	// set first index for special box constrained variables
 	for ( k = 0, i = 0; i < auxiliaryConstraints.Num(); i++ ) {
@@ -5216,6 +5225,10 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 				boxIndex[k] = -1;
 			}
 			jmk[k][k] += constraint->e[j] * invStep;
+
+			// guess the solution from the previous frame
+			lm[k] = constraint->lm[j];
+			side[k] = constraint->lmSide[j];
 		}
 	}
 
@@ -5224,12 +5237,22 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 #endif
 
 	// calculate lagrange multipliers for auxiliary constraints
-	if ( !lcp->Solve( jmk, lm, rhs, lo, hi, boxIndex ) ) {
-		return;		// bad monkey!
+	if ( af_lcpWarmStart.GetBool() ) {
+		if ( !lcp->SolveWarmStarted( jmk, lm, rhs, lo, hi, boxIndex, side ) ) {
+			return;		// bad monkey!
+		}
+	} else {
+		if ( !lcp->Solve( jmk, lm, rhs, lo, hi, boxIndex ) ) {
+			return;		// bad monkey!
+		}
+		idLCP::GetSides( lm, lo, hi, boxIndex, side );
 	}
 
 #ifdef AF_TIMINGS
 	timer_lcp.Stop();
+	numLCPSolves++;
+	numLCPWarmStarts += lcp->WasWarmStarted();
+	numLCPIterations += lcp->GetNumIterations();
 #endif
 
 	// calculate auxiliary constraint forces
@@ -5238,6 +5261,7 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 
 		for ( j = 0; j < constraint->J1.GetNumRows(); j++, k++ ) {
 			constraint->lm[j] = u = lm[k];
+			constraint->lmSide[j] = side[k];
 
 			j1 = constraint->J1[j];
 			ptr = constraint->body1->auxForce.ToFloatPtr();
@@ -6375,22 +6399,24 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	timer_total.Stop();
 
 	if ( af_showTimings.GetInteger() == 1 ) {
-		gameLocal.Printf( "%12s: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f cd %1.4f\n",
+		gameLocal.Printf( "%12s: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f (%d/%d warm, %d it) cd %1.4f\n",
 						self->name.c_str(),
 						timer_total.Milliseconds(),
 						numPrimary, timer_pc.Milliseconds(),
 						numAuxiliary, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
-						timer_lcp.Milliseconds(), timer_collision.Milliseconds() );
+						timer_lcp.Milliseconds(), numLCPWarmStarts, numLCPSolves, numLCPIterations,
+						timer_collision.Milliseconds() );
 	}
 	else if ( af_showTimings.GetInteger() == 2 ) {
 		numArticulatedFigures++;
 		if ( endTimeMSec > lastTimerReset ) {
-			gameLocal.Printf( "af %d: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f cd %1.4f\n",
+			gameLocal.Printf( "af %d: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f (%d/%d warm, %d it) cd %1.4f\n",
 							numArticulatedFigures,
 							timer_total.Milliseconds(),
 							numPrimary, timer_pc.Milliseconds(),
 							numAuxiliary, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
-							timer_lcp.Milliseconds(), timer_collision.Milliseconds() );
+							timer_lcp.Milliseconds(), numLCPWarmStarts, numLCPSolves, numLCPIterations,
+							timer_collision.Milliseconds() );
 		}
 	}
 
@@ -6402,6 +6428,9 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		timer_ac.Clear();
 		timer_collision.Clear();
 		timer_lcp.Clear();
+		numLCPSolves = 0;
+		numLCPWarmStarts = 0;
+		numLCPIterations = 0;
 	}
 #endif
 
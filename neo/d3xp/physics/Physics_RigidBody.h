@@ -63,6 +63,23 @@ typedef struct rigidBodyPState_s {
 	rigidBodyIState_t		i;							// state used for integration
 } rigidBodyPState_t;
 
+// motion predicted in parallel with other rigid bodies, see idPhysicsIslands
+typedef struct rigidBodyPrediction_s {
+	int						id;							// id of the prediction pass, -1 if none
+	int						timeStepMSec;				// time step the motion was predicted for
+	rigidBodyPState_t		start;						// state the motion was predicted from
+	idVec3					gravityVector;				// properties the motion depends on
+	float					mass;
+	float					linearFriction;
+	float					angularFriction;
+	int						clipMask;
+	idClipModel *			clipModel;
+	idBounds				bounds;						// bounds containing the collision queries
+	rigidBodyPState_t		next;						// state at the end of the time step or the moment of impact
+	trace_t					collision;
+	bool					collided;
+} rigidBodyPrediction_t;
+
 class idPhysics_RigidBody : public idPhysics_Base {
 
 public:
@@ -85,6 +102,9 @@ public:
 							// enable/disable activation by impact
 	void					EnableImpact( void );
 	void					DisableImpact( void );
+							// predict the motion for the next Evaluate, may be called from another thread
+	bool					CanPredictMotion( void ) const;
+	void					PredictMotion( int timeStepMSec, int predictionId );
 
 public:	// common physics interface
 	void					SetClipModel( idClipModel *model, float density, int id = 0, bool freeOld = true );
@@ -152,6 +172,11 @@ public:	// common physics interface
 	void					WriteToSnapshot( idBitMsgDelta &msg ) const;
 	void					ReadFromSnapshot( const idBitMsgDelta &msg );
 
+							// print the number of active, sleeping and woken rigid bodies each frame
+	static void				UpdateSleepStatistics( void );
+							// links the sleep islands of the restored rigid bodies again
+	static void				RestoreSleepIslands( void );
+
 private:
 	// state of the rigid body
 	rigidBodyPState_t		current;
@@ -181,15 +206,32 @@ private:
 	bool					hasMaster;
 	bool					isOrientated;
 
+	rigidBodyPrediction_t	prediction;
+
+	// sleeping together with the contact island
+	bool					restCandidate;				// passed the rest test and waits for the contact island to settle
+	int						contactCacheTime;			// time the contacts were evaluated, -1 if not cached
+	idVec3					contactCacheOrigin;			// position and orientation the contacts were evaluated at
+	idMat3					contactCacheAxis;
+	idPhysics_RigidBody *	sleepNext;					// ring of bodies that went to sleep together
+	idPhysics_RigidBody *	sleepPrev;
+	idEntity *				sleepRestoreNext;			// entity of sleepNext read from a savegame until the islands are restored
+
 private:
 	friend void				RigidBodyDerivatives( const float t, const void *clientData, const float *state, float *derivatives );
 	void					Integrate( const float deltaTime, rigidBodyPState_t &next );
 	bool					CheckForCollisions( const float deltaTime, rigidBodyPState_t &next, trace_t &collision );
+	bool					UsePredictedMotion( int timeStepMSec, rigidBodyPState_t &next, trace_t &collision, bool &collided );
 	bool					CollisionImpulse( const trace_t &collision, idVec3 &impulse );
 	void					ContactFriction( float deltaTime );
 	void					DropToFloorAndRest( void );
 	bool					TestIfAtRest( void ) const;
 	void					Rest( void );
+	bool					EvaluateCachedContacts( void );
+	bool					SleepIsland( void );
+	void					LinkSleepIsland( idPhysics_RigidBody *body );
+	void					UnlinkSleepIsland( void );
+	void					WakeSleepIsland( void );
 	void					DebugDraw( void );
 };
 
@@ -194,6 +194,23 @@ enum {
 	NUM_OPCODES
 };
 
+// superinstructions are never emitted by the compiler.  idProgram::DecodeStatements creates
+// them for a compare whose result is directly tested by the following OP_IFNOT.
+enum {
+	OP_EQ_F_IFNOT = NUM_OPCODES,
+	OP_EQ_E_IFNOT,
+	OP_NE_F_IFNOT,
+	OP_NE_E_IFNOT,
+	OP_LE_IFNOT,
+	OP_GE_IFNOT,
+	OP_LT_IFNOT,
+	OP_GT_IFNOT,
+	OP_NOT_BOOL_IFNOT,
+	OP_NOT_F_IFNOT,
+
+	NUM_INSTRUCTIONS
+};
+
 class idCompiler {
 private:
 	static bool		punctuationValid[ 256 ];
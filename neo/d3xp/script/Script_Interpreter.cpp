@@ -928,6 +928,162 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 	popParms = 0;
 }
 
+/*
+================================================================================================
+
+	Opcode profiling
+
+================================================================================================
+*/
+
+static int64	opcodeCounts[ NUM_OPCODES ];
+static int64	opcodePairCounts[ NUM_OPCODES ][ NUM_OPCODES ];
+static int		lastOpcode = -1;
+
+/*
+================
+CountOpcode
+
+Counts the statement at the instruction pointer, and the OP_IFNOT folded into it for superinstructions.
+================
+*/
+static void CountOpcode( int instructionPointer ) {
+	int i;
+	int count;
+	int op;
+
+	count = ( gameLocal.program.GetInstruction( instructionPointer ).op >= NUM_OPCODES ) ? 2 : 1;
+	for( i = 0; i < count; i++ ) {
+		op = gameLocal.program.GetStatement( instructionPointer + i ).op;
+		opcodeCounts[ op ]++;
+		if ( lastOpcode >= 0 ) {
+			opcodePairCounts[ lastOpcode ][ op ]++;
+		}
+		lastOpcode = op;
+	}
+}
+
+/*
+================
+idInterpreter::ClearOpcodeStats
+================
+*/
+void idInterpreter::ClearOpcodeStats( void ) {
+	memset( opcodeCounts, 0, sizeof( opcodeCounts ) );
+	memset( opcodePairCounts, 0, sizeof( opcodePairCounts ) );
+	lastOpcode = -1;
+}
+
+/*
+================
+idInterpreter::PrintOpcodeStats
+
+Prints every executed opcode and the most frequent pairs of consecutive opcodes.
+================
+*/
+void idInterpreter::PrintOpcodeStats( int numPairs ) {
+	int		i;
+	int		j;
+	int		k;
+	int64	total;
+	int64	best;
+	int		bestA;
+	int		bestB;
+	bool	used[ NUM_OPCODES ];
+	idList<int> printedPairs;
+
+	total = 0;
+	for( i = 0; i < NUM_OPCODES; i++ ) {
+		total += opcodeCounts[ i ];
+	}
+
+	if ( !total ) {
+		gameLocal.Printf( "No opcodes counted.  Set g_scriptProfileOpcodes to 1 to enable counting.\n" );
+		return;
+	}
+
+	gameLocal.Printf( "%lld opcodes executed\n\n", total );
+
+	memset( used, 0, sizeof( used ) );
+	for( i = 0; i < NUM_OPCODES; i++ ) {
+		best = 0;
+		bestA = -1;
+		for( j = 0; j < NUM_OPCODES; j++ ) {
+			if ( !used[ j ] && ( opcodeCounts[ j ] > best ) ) {
+				best = opcodeCounts[ j ];
+				bestA = j;
+			}
+		}
+		if ( bestA < 0 ) {
+			break;
+		}
+		used[ bestA ] = true;
+		gameLocal.Printf( "%12lld %6.2f%% %s\n", best, best * 100.0 / total, idCompiler::opcodes[ bestA ].opname );
+	}
+
+	gameLocal.Printf( "\nTop %d opcode pairs:\n", numPairs );
+	for( i = 0; i < numPairs; i++ ) {
+		best = 0;
+		bestA = -1;
+		bestB = -1;
+		for( j = 0; j < NUM_OPCODES; j++ ) {
+			for( k = 0; k < NUM_OPCODES; k++ ) {
+				if ( ( opcodePairCounts[ j ][ k ] > best ) && ( printedPairs.FindIndex( j * NUM_OPCODES + k ) < 0 ) ) {
+					best = opcodePairCounts[ j ][ k ];
+					bestA = j;
+					bestB = k;
+				}
+			}
+		}
+		if ( bestA < 0 ) {
+			break;
+		}
+		printedPairs.Append( bestA * NUM_OPCODES + bestB );
+		gameLocal.Printf( "%12lld %6.2f%% %s -> %s\n", best, best * 100.0 / total, idCompiler::opcodes[ bestA ].opname, idCompiler::opcodes[ bestB ].opname );
+	}
+}
+
+/*
+================================================================================================
+
+	Instruction dispatch
+
+	Execute runs the decoded instruction stream built by idProgram::DecodeStatements rather
+	than the statement list, so operands need no idVarDef indirection.  With GCC compatible
+	compilers every handler jumps straight to the handler of the next instruction through a
+	table of label addresses, other compilers use a regular switch.
+
+================================================================================================
+*/
+
+#if defined( __GNUC__ )
+#define SCRIPT_THREADED_DISPATCH
+#endif
+
+#define OPERAND_A		GetOperand( inst->a, inst->stackFlags & INSTRUCTION_STACK_A )
+#define OPERAND_B		GetOperand( inst->b, inst->stackFlags & INSTRUCTION_STACK_B )
+#define OPERAND_C		GetOperand( inst->c, inst->stackFlags & INSTRUCTION_STACK_C )
+
+#define SCRIPT_FETCH()														\
+	instructionPointer++;													\
+	if ( !--runaway ) {														\
+		Error( "runaway loop error" );										\
+	}																		\
+	inst = &gameLocal.program.GetInstruction( instructionPointer );			\
+	if ( profile ) {														\
+		CountOpcode( instructionPointer );									\
+	}
+
+#ifdef SCRIPT_THREADED_DISPATCH
+#define SCRIPT_CASE( op )	label_##op:
+#define SCRIPT_CASE_DEFAULT	label_default:
+#define SCRIPT_NEXT			if ( doneProcessing || threadDying ) { goto done; } SCRIPT_FETCH(); goto *dispatchTable[ inst->op ]
+#else
+#define SCRIPT_CASE( op )	case op:
+#define SCRIPT_CASE_DEFAULT	default:
+#define SCRIPT_NEXT			break
+#endif
+
 /*
 ====================
 idInterpreter::Execute
@@ -938,12 +1094,156 @@ bool idInterpreter::Execute( void ) {
 	varEval_t	var_b;
 	varEval_t	var_c;
 	varEval_t	var;
-	statement_t	*st;
+	const scriptInstruction_t *inst;
 	int 		runaway;
 	idThread	*newThread;
 	float		floatVal;
 	idScriptObject *obj;
 	const function_t *func;
+	bool		profile;
+
+#ifdef SCRIPT_THREADED_DISPATCH
+	static void *dispatchTable[ NUM_INSTRUCTIONS ];
+
+	if ( !dispatchTable[ 0 ] ) {
+		for( int i = 0; i < NUM_INSTRUCTIONS; i++ ) {
+			dispatchTable[ i ] = &&label_default;
+		}
+		dispatchTable[ OP_RETURN ] = &&label_OP_RETURN;
+		dispatchTable[ OP_THREAD ] = &&label_OP_THREAD;
+		dispatchTable[ OP_OBJTHREAD ] = &&label_OP_OBJTHREAD;
+		dispatchTable[ OP_CALL ] = &&label_OP_CALL;
+		dispatchTable[ OP_EVENTCALL ] = &&label_OP_EVENTCALL;
+		dispatchTable[ OP_OBJECTCALL ] = &&label_OP_OBJECTCALL;
+		dispatchTable[ OP_SYSCALL ] = &&label_OP_SYSCALL;
+		dispatchTable[ OP_IFNOT ] = &&label_OP_IFNOT;
+		dispatchTable[ OP_IF ] = &&label_OP_IF;
+		dispatchTable[ OP_GOTO ] = &&label_OP_GOTO;
+		dispatchTable[ OP_ADD_F ] = &&label_OP_ADD_F;
+		dispatchTable[ OP_ADD_V ] = &&label_OP_ADD_V;
+		dispatchTable[ OP_ADD_S ] = &&label_OP_ADD_S;
+		dispatchTable[ OP_ADD_FS ] = &&label_OP_ADD_FS;
+		dispatchTable[ OP_ADD_SF ] = &&label_OP_ADD_SF;
+		dispatchTable[ OP_ADD_VS ] = &&label_OP_ADD_VS;
+		dispatchTable[ OP_ADD_SV ] = &&label_OP_ADD_SV;
+		dispatchTable[ OP_SUB_F ] = &&label_OP_SUB_F;
+		dispatchTable[ OP_SUB_V ] = &&label_OP_SUB_V;
+		dispatchTable[ OP_MUL_F ] = &&label_OP_MUL_F;
+		dispatchTable[ OP_MUL_V ] = &&label_OP_MUL_V;
+		dispatchTable[ OP_MUL_FV ] = &&label_OP_MUL_FV;
+		dispatchTable[ OP_MUL_VF ] = &&label_OP_MUL_VF;
+		dispatchTable[ OP_DIV_F ] = &&label_OP_DIV_F;
+		dispatchTable[ OP_MOD_F ] = &&label_OP_MOD_F;
+		dispatchTable[ OP_BITAND ] = &&label_OP_BITAND;
+		dispatchTable[ OP_BITOR ] = &&label_OP_BITOR;
+		dispatchTable[ OP_GE ] = &&label_OP_GE;
+		dispatchTable[ OP_LE ] = &&label_OP_LE;
+		dispatchTable[ OP_GT ] = &&label_OP_GT;
+		dispatchTable[ OP_LT ] = &&label_OP_LT;
+		dispatchTable[ OP_AND ] = &&label_OP_AND;
+		dispatchTable[ OP_AND_BOOLF ] = &&label_OP_AND_BOOLF;
+		dispatchTable[ OP_AND_FBOOL ] = &&label_OP_AND_FBOOL;
+		dispatchTable[ OP_AND_BOOLBOOL ] = &&label_OP_AND_BOOLBOOL;
+		dispatchTable[ OP_OR ] = &&label_OP_OR;
+		dispatchTable[ OP_OR_BOOLF ] = &&label_OP_OR_BOOLF;
+		dispatchTable[ OP_OR_FBOOL ] = &&label_OP_OR_FBOOL;
+		dispatchTable[ OP_OR_BOOLBOOL ] = &&label_OP_OR_BOOLBOOL;
+		dispatchTable[ OP_NOT_BOOL ] = &&label_OP_NOT_BOOL;
+		dispatchTable[ OP_NOT_F ] = &&label_OP_NOT_F;
+		dispatchTable[ OP_NOT_V ] = &&label_OP_NOT_V;
+		dispatchTable[ OP_NOT_S ] = &&label_OP_NOT_S;
+		dispatchTable[ OP_NOT_ENT ] = &&label_OP_NOT_ENT;
+		dispatchTable[ OP_NEG_F ] = &&label_OP_NEG_F;
+		dispatchTable[ OP_NEG_V ] = &&label_OP_NEG_V;
+		dispatchTable[ OP_INT_F ] = &&label_OP_INT_F;
+		dispatchTable[ OP_EQ_F ] = &&label_OP_EQ_F;
+		dispatchTable[ OP_EQ_V ] = &&label_OP_EQ_V;
+		dispatchTable[ OP_EQ_S ] = &&label_OP_EQ_S;
+		dispatchTable[ OP_EQ_E ] = &&label_OP_EQ_E;
+		dispatchTable[ OP_EQ_EO ] = &&label_OP_EQ_EO;
+		dispatchTable[ OP_EQ_OE ] = &&label_OP_EQ_OE;
+		dispatchTable[ OP_EQ_OO ] = &&label_OP_EQ_OO;
+		dispatchTable[ OP_NE_F ] = &&label_OP_NE_F;
+		dispatchTable[ OP_NE_V ] = &&label_OP_NE_V;
+		dispatchTable[ OP_NE_S ] = &&label_OP_NE_S;
+		dispatchTable[ OP_NE_E ] = &&label_OP_NE_E;
+		dispatchTable[ OP_NE_EO ] = &&label_OP_NE_EO;
+		dispatchTable[ OP_NE_OE ] = &&label_OP_NE_OE;
+		dispatchTable[ OP_NE_OO ] = &&label_OP_NE_OO;
+		dispatchTable[ OP_UADD_F ] = &&label_OP_UADD_F;
+		dispatchTable[ OP_UADD_V ] = &&label_OP_UADD_V;
+		dispatchTable[ OP_USUB_F ] = &&label_OP_USUB_F;
+		dispatchTable[ OP_USUB_V ] = &&label_OP_USUB_V;
+		dispatchTable[ OP_UMUL_F ] = &&label_OP_UMUL_F;
+		dispatchTable[ OP_UMUL_V ] = &&label_OP_UMUL_V;
+		dispatchTable[ OP_UDIV_F ] = &&label_OP_UDIV_F;
+		dispatchTable[ OP_UDIV_V ] = &&label_OP_UDIV_V;
+		dispatchTable[ OP_UMOD_F ] = &&label_OP_UMOD_F;
+		dispatchTable[ OP_UOR_F ] = &&label_OP_UOR_F;
+		dispatchTable[ OP_UAND_F ] = &&label_OP_UAND_F;
+		dispatchTable[ OP_UINC_F ] = &&label_OP_UINC_F;
+		dispatchTable[ OP_UINCP_F ] = &&label_OP_UINCP_F;
+		dispatchTable[ OP_UDEC_F ] = &&label_OP_UDEC_F;
+		dispatchTable[ OP_UDECP_F ] = &&label_OP_UDECP_F;
+		dispatchTable[ OP_COMP_F ] = &&label_OP_COMP_F;
+		dispatchTable[ OP_STORE_F ] = &&label_OP_STORE_F;
+		dispatchTable[ OP_STORE_ENT ] = &&label_OP_STORE_ENT;
+		dispatchTable[ OP_STORE_BOOL ] = &&label_OP_STORE_BOOL;
+		dispatchTable[ OP_STORE_OBJENT ] = &&label_OP_STORE_OBJENT;
+		dispatchTable[ OP_STORE_OBJ ] = &&label_OP_STORE_OBJ;
+		dispatchTable[ OP_STORE_ENTOBJ ] = &&label_OP_STORE_ENTOBJ;
+		dispatchTable[ OP_STORE_S ] = &&label_OP_STORE_S;
+		dispatchTable[ OP_STORE_V ] = &&label_OP_STORE_V;
+		dispatchTable[ OP_STORE_FTOS ] = &&label_OP_STORE_FTOS;
+		dispatchTable[ OP_STORE_BTOS ] = &&label_OP_STORE_BTOS;
+		dispatchTable[ OP_STORE_VTOS ] = &&label_OP_STORE_VTOS;
+		dispatchTable[ OP_STORE_FTOBOOL ] = &&label_OP_STORE_FTOBOOL;
+		dispatchTable[ OP_STORE_BOOLTOF ] = &&label_OP_STORE_BOOLTOF;
+		dispatchTable[ OP_STOREP_F ] = &&label_OP_STOREP_F;
+		dispatchTable[ OP_STOREP_ENT ] = &&label_OP_STOREP_ENT;
+		dispatchTable[ OP_STOREP_FLD ] = &&label_OP_STOREP_FLD;
+		dispatchTable[ OP_STOREP_BOOL ] = &&label_OP_STOREP_BOOL;
+		dispatchTable[ OP_STOREP_S ] = &&label_OP_STOREP_S;
+		dispatchTable[ OP_STOREP_V ] = &&label_OP_STOREP_V;
+		dispatchTable[ OP_STOREP_FTOS ] = &&label_OP_STOREP_FTOS;
+		dispatchTable[ OP_STOREP_BTOS ] = &&label_OP_STOREP_BTOS;
+		dispatchTable[ OP_STOREP_VTOS ] = &&label_OP_STOREP_VTOS;
+		dispatchTable[ OP_STOREP_FTOBOOL ] = &&label_OP_STOREP_FTOBOOL;
+		dispatchTable[ OP_STOREP_BOOLTOF ] = &&label_OP_STOREP_BOOLTOF;
+		dispatchTable[ OP_STOREP_OBJ ] = &&label_OP_STOREP_OBJ;
+		dispatchTable[ OP_STOREP_OBJENT ] = &&label_OP_STOREP_OBJENT;
+		dispatchTable[ OP_ADDRESS ] = &&label_OP_ADDRESS;
+		dispatchTable[ OP_INDIRECT_F ] = &&label_OP_INDIRECT_F;
+		dispatchTable[ OP_INDIRECT_ENT ] = &&label_OP_INDIRECT_ENT;
+		dispatchTable[ OP_INDIRECT_BOOL ] = &&label_OP_INDIRECT_BOOL;
+		dispatchTable[ OP_INDIRECT_S ] = &&label_OP_INDIRECT_S;
+		dispatchTable[ OP_INDIRECT_V ] = &&label_OP_INDIRECT_V;
+		dispatchTable[ OP_INDIRECT_OBJ ] = &&label_OP_INDIRECT_OBJ;
+		dispatchTable[ OP_PUSH_F ] = &&label_OP_PUSH_F;
+		dispatchTable[ OP_PUSH_FTOS ] = &&label_OP_PUSH_FTOS;
+		dispatchTable[ OP_PUSH_BTOF ] = &&label_OP_PUSH_BTOF;
+		dispatchTable[ OP_PUSH_FTOB ] = &&label_OP_PUSH_FTOB;
+		dispatchTable[ OP_PUSH_VTOS ] = &&label_OP_PUSH_VTOS;
+		dispatchTable[ OP_PUSH_BTOS ] = &&label_OP_PUSH_BTOS;
+		dispatchTable[ OP_PUSH_ENT ] = &&label_OP_PUSH_ENT;
+		dispatchTable[ OP_PUSH_S ] = &&label_OP_PUSH_S;
+		dispatchTable[ OP_PUSH_V ] = &&label_OP_PUSH_V;
+		dispatchTable[ OP_PUSH_OBJ ] = &&label_OP_PUSH_OBJ;
+		dispatchTable[ OP_PUSH_OBJENT ] = &&label_OP_PUSH_OBJENT;
+		dispatchTable[ OP_BREAK ] = &&label_OP_BREAK;
+		dispatchTable[ OP_CONTINUE ] = &&label_OP_CONTINUE;
+		dispatchTable[ OP_EQ_F_IFNOT ] = &&label_OP_EQ_F_IFNOT;
+		dispatchTable[ OP_EQ_E_IFNOT ] = &&label_OP_EQ_E_IFNOT;
+		dispatchTable[ OP_NE_F_IFNOT ] = &&label_OP_NE_F_IFNOT;
+		dispatchTable[ OP_NE_E_IFNOT ] = &&label_OP_NE_E_IFNOT;
+		dispatchTable[ OP_LE_IFNOT ] = &&label_OP_LE_IFNOT;
+		dispatchTable[ OP_GE_IFNOT ] = &&label_OP_GE_IFNOT;
+		dispatchTable[ OP_LT_IFNOT ] = &&label_OP_LT_IFNOT;
+		dispatchTable[ OP_GT_IFNOT ] = &&label_OP_GT_IFNOT;
+		dispatchTable[ OP_NOT_BOOL_IFNOT ] = &&label_OP_NOT_BOOL_IFNOT;
+		dispatchTable[ OP_NOT_F_IFNOT ] = &&label_OP_NOT_F_IFNOT;
+	}
+#endif
 
 	if ( threadDying || !currentFunction ) {
 		return true;
@@ -955,38 +1255,40 @@ bool idInterpreter::Execute( void ) {
 	}
 
 	runaway = 5000000;
+	profile = g_scriptProfileOpcodes.GetBool();
 
 	doneProcessing = false;
-	while( !doneProcessing && !threadDying ) {
-		instructionPointer++;
 
-		if ( !--runaway ) {
-			Error( "runaway loop error" );
-		}
-
-		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
+#ifdef SCRIPT_THREADED_DISPATCH
+	SCRIPT_FETCH();
+	goto *dispatchTable[ inst->op ];
+	{
+		{
+#else
+	while( !doneProcessing && !threadDying ) {
+		SCRIPT_FETCH();
 
-		switch( st->op ) {
-		case OP_RETURN:
-			LeaveFunction( st->a );
-			break;
+		switch( inst->op ) {
+#endif
+		SCRIPT_CASE( OP_RETURN )
+			LeaveFunction( gameLocal.program.GetStatement( instructionPointer ).a );
+			SCRIPT_NEXT;
 
-		case OP_THREAD:
-			newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+		SCRIPT_CASE( OP_THREAD )
+			newThread = new idThread( this, inst->a.functionPtr, inst->b.argSize );
 			newThread->Start();
 
 			// return the thread number to the script
 			gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-			PopParms( st->b->value.argSize );
-			break;
+			PopParms( inst->b.argSize );
+			SCRIPT_NEXT;
 
-		case OP_OBJTHREAD:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_OBJTHREAD )
+			var_a = OPERAND_A;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-				assert( st->c->value.argSize == func->parmTotal );
+				func = obj->GetTypeDef()->GetFunction( inst->b.virtualFunction );
+				assert( inst->c.argSize == func->parmTotal );
 				newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
 				newThread->Start();
 
@@ -996,142 +1298,142 @@ bool idInterpreter::Execute( void ) {
 				// return a null thread to the script
 				gameLocal.program.ReturnFloat( 0.0f );
 			}
-			PopParms( st->c->value.argSize );
-			break;
+			PopParms( inst->c.argSize );
+			SCRIPT_NEXT;
 
-		case OP_CALL:
-			EnterFunction( st->a->value.functionPtr, false );
-			break;
+		SCRIPT_CASE( OP_CALL )
+			EnterFunction( inst->a.functionPtr, false );
+			SCRIPT_NEXT;
 
-		case OP_EVENTCALL:
-			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
+		SCRIPT_CASE( OP_EVENTCALL )
+			CallEvent( inst->a.functionPtr, inst->b.argSize );
+			SCRIPT_NEXT;
 
-		case OP_OBJECTCALL:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_OBJECTCALL )
+			var_a = OPERAND_A;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
+				func = obj->GetTypeDef()->GetFunction( inst->b.virtualFunction );
 				EnterFunction( func, false );
 			} else {
 				// return a 'safe' value
 				gameLocal.program.ReturnVector( vec3_zero );
 				gameLocal.program.ReturnString( "" );
-				PopParms( st->c->value.argSize );
+				PopParms( inst->c.argSize );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_SYSCALL:
-			CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
+		SCRIPT_CASE( OP_SYSCALL )
+			CallSysEvent( inst->a.functionPtr, inst->b.argSize );
+			SCRIPT_NEXT;
 
-		case OP_IFNOT:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_IFNOT )
+			var_a = OPERAND_A;
 			if ( *var_a.intPtr == 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+				NextInstruction( instructionPointer + inst->b.jumpOffset );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_IF:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_IF )
+			var_a = OPERAND_A;
 			if ( *var_a.intPtr != 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+				NextInstruction( instructionPointer + inst->b.jumpOffset );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_GOTO:
-			NextInstruction( instructionPointer + st->a->value.jumpOffset );
-			break;
+		SCRIPT_CASE( OP_GOTO )
+			NextInstruction( instructionPointer + inst->a.jumpOffset );
+			SCRIPT_NEXT;
 
-		case OP_ADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_ADD_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_ADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_ADD_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-			break;
-
-		case OP_ADD_S:
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_FS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, FloatToString( *var_a.floatPtr ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SF:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-			break;
-
-		case OP_ADD_VS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, var_a.vectorPtr->ToString() );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SV:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, var_b.vectorPtr->ToString() );
-			break;
-
-		case OP_SUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_ADD_S )
+			idStr::Copynz( OPERAND_C.stringPtr, OPERAND_A.stringPtr, MAX_STRING_LEN );
+			idStr::Append( OPERAND_C.stringPtr, MAX_STRING_LEN, OPERAND_B.stringPtr );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_ADD_FS )
+			var_a = OPERAND_A;
+			idStr::Copynz( OPERAND_C.stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
+			idStr::Append( OPERAND_C.stringPtr, MAX_STRING_LEN, OPERAND_B.stringPtr );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_ADD_SF )
+			var_b = OPERAND_B;
+			idStr::Copynz( OPERAND_C.stringPtr, OPERAND_A.stringPtr, MAX_STRING_LEN );
+			idStr::Append( OPERAND_C.stringPtr, MAX_STRING_LEN, FloatToString( *var_b.floatPtr ) );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_ADD_VS )
+			var_a = OPERAND_A;
+			idStr::Copynz( OPERAND_C.stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
+			idStr::Append( OPERAND_C.stringPtr, MAX_STRING_LEN, OPERAND_B.stringPtr );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_ADD_SV )
+			var_b = OPERAND_B;
+			idStr::Copynz( OPERAND_C.stringPtr, OPERAND_A.stringPtr, MAX_STRING_LEN );
+			idStr::Append( OPERAND_C.stringPtr, MAX_STRING_LEN, var_b.vectorPtr->ToString() );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_SUB_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_SUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_SUB_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_MUL_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_MUL_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_FV:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_MUL_FV )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_VF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_MUL_VF )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_DIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_DIV_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 
 			if ( *var_b.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1139,12 +1441,12 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable ( st->c );
+		SCRIPT_CASE( OP_MOD_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 
 			if ( *var_b.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1152,252 +1454,252 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_BITAND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_BITAND )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_BITOR:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_BITOR )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_GE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_GE )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_LE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_LE )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_GT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_GT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_LT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_LT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_AND )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_AND_BOOLF )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_AND_FBOOL )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_AND_BOOLBOOL )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_OR:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_OR )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_OR_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_OR_BOOLF )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_OR_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_OR_FBOOL )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_OR_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_OR_BOOLBOOL )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NOT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NOT_BOOL )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.intPtr == 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NOT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NOT_F )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NOT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NOT_V )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NOT_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-			break;
+		SCRIPT_CASE( OP_NOT_S )
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( strlen( OPERAND_A.stringPtr ) == 0 );
+			SCRIPT_NEXT;
 
-		case OP_NOT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NOT_ENT )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NEG_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NEG_F )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = -*var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NEG_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NEG_V )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.vectorPtr = -*var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_INT_F )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_EQ_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_EQ_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_EQ_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_EQ_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-			break;
-
-		case OP_EQ_S:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-			break;
-
-		case OP_EQ_E:
-		case OP_EQ_EO:
-		case OP_EQ_OE:
-		case OP_EQ_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_EQ_S )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( idStr::Cmp( OPERAND_A.stringPtr, OPERAND_B.stringPtr ) == 0 );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_EQ_E )
+		SCRIPT_CASE( OP_EQ_EO )
+		SCRIPT_CASE( OP_EQ_OE )
+		SCRIPT_CASE( OP_EQ_OO )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NE_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_NE_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-			break;
-
-		case OP_NE_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-			break;
-
-		case OP_NE_E:
-		case OP_NE_EO:
-		case OP_NE_OE:
-		case OP_NE_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_NE_S )
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( idStr::Cmp( OPERAND_A.stringPtr, OPERAND_B.stringPtr ) != 0 );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_NE_E )
+		SCRIPT_CASE( OP_NE_EO )
+		SCRIPT_CASE( OP_NE_OE )
+		SCRIPT_CASE( OP_NE_OO )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UADD_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.floatPtr += *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UADD_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.vectorPtr += *var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_USUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_USUB_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.floatPtr -= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_USUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_USUB_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.vectorPtr -= *var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UMUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UMUL_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.floatPtr *= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UMUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UMUL_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.vectorPtr *= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UDIV_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1405,11 +1707,11 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDIV_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UDIV_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1417,11 +1719,11 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UMOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UMOD_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1429,241 +1731,241 @@ bool idInterpreter::Execute( void ) {
 			} else {
 				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UOR_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UOR_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UAND_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_UAND_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UINC_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_UINC_F )
+			var_a = OPERAND_A;
 			( *var_a.floatPtr )++;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UINCP_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_UINCP_F )
+			var_a = OPERAND_A;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
 				( *var.floatPtr )++;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDEC_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_UDEC_F )
+			var_a = OPERAND_A;
 			( *var_a.floatPtr )--;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDECP_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_UDECP_F )
+			var_a = OPERAND_A;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
 				( *var.floatPtr )--;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_COMP_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_COMP_F )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STORE_F )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.floatPtr = *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_ENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STORE_ENT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_BOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STORE_BOOL )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.intPtr = *var_a.intPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_OBJENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STORE_OBJENT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( !obj ) {
 				*var_b.entityNumberPtr = 0;
-			} else if ( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) ) {
+			} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).b->TypeDef() ) ) {
 				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
 				*var_b.entityNumberPtr = 0;
 			} else {
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_OBJ:
-		case OP_STORE_ENTOBJ:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STORE_OBJ )
+		SCRIPT_CASE( OP_STORE_ENTOBJ )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_S:
-			SetString( st->b, GetString( st->a ) );
-			break;
+		SCRIPT_CASE( OP_STORE_S )
+			idStr::Copynz( OPERAND_B.stringPtr, OPERAND_A.stringPtr, MAX_STRING_LEN );
+			SCRIPT_NEXT;
 
-		case OP_STORE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STORE_V )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.vectorPtr = *var_a.vectorPtr;
-			break;
-
-		case OP_STORE_FTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, FloatToString( *var_a.floatPtr ) );
-			break;
-
-		case OP_STORE_BTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, *var_a.intPtr ? "true" : "false" );
-			break;
-
-		case OP_STORE_VTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, var_a.vectorPtr->ToString() );
-			break;
-
-		case OP_STORE_FTOBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_STORE_FTOS )
+			var_a = OPERAND_A;
+			idStr::Copynz( OPERAND_B.stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_STORE_BTOS )
+			var_a = OPERAND_A;
+			idStr::Copynz( OPERAND_B.stringPtr, *var_a.intPtr ? "true" : "false", MAX_STRING_LEN );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_STORE_VTOS )
+			var_a = OPERAND_A;
+			idStr::Copynz( OPERAND_B.stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_STORE_FTOBOOL )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			if ( *var_a.floatPtr != 0.0f ) {
 				*var_b.intPtr = 1;
 			} else {
 				*var_b.intPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_BOOLTOF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STORE_BOOLTOF )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
 			*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_F:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_F )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				*var_b.evalPtr->floatPtr = *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_ENT:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_ENT )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_FLD:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_FLD )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				*var_b.evalPtr->intPtr = *var_a.intPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_BOOL:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_BOOL )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				*var_b.evalPtr->intPtr = *var_a.intPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_S:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_S )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
+				idStr::Copynz( var_b.evalPtr->stringPtr, OPERAND_A.stringPtr, MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_V:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_V )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_FTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_FTOS )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_BTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_BTOS )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				if ( *var_a.floatPtr != 0.0f ) {
 					idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
 				} else {
 					idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
 				}
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_VTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_VTOS )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_FTOBOOL:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_FTOBOOL )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				if ( *var_a.floatPtr != 0.0f ) {
 					*var_b.evalPtr->intPtr = 1;
 				} else {
 					*var_b.evalPtr->intPtr = 0;
 				}
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_BOOLTOF:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_BOOLTOF )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_OBJ:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_OBJ )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_OBJENT:
-			var_b = GetVariable( st->b );
+		SCRIPT_CASE( OP_STOREP_OBJENT )
+			var_b = OPERAND_B;
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = OPERAND_A;
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if ( !obj ) {
 					*var_b.evalPtr->entityNumberPtr = 0;
@@ -1671,165 +1973,286 @@ bool idInterpreter::Execute( void ) {
 				// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
 				// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
 				// comes from an entity
-				} else if ( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) ) {
+				} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).c->TypeDef() ) ) {
 					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
 					*var_b.evalPtr->entityNumberPtr = 0;
 				} else {
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_ADDRESS:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_ADDRESS )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var_c.evalPtr->bytePtr = &obj->data[ inst->b.ptrOffset ];
 			} else {
 				var_c.evalPtr->bytePtr = NULL;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_INDIRECT_F )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
 				*var_c.floatPtr = *var.floatPtr;
 			} else {
 				*var_c.floatPtr = 0.0f;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_INDIRECT_ENT )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
 				*var_c.entityNumberPtr = *var.entityNumberPtr;
 			} else {
 				*var_c.entityNumberPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_INDIRECT_BOOL )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
 				*var_c.intPtr = *var.intPtr;
 			} else {
 				*var_c.intPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_S:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_INDIRECT_S )
+			var_a = OPERAND_A;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				SetString( st->c, var.stringPtr );
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
+				idStr::Copynz( OPERAND_C.stringPtr, var.stringPtr, MAX_STRING_LEN );
 			} else {
-				SetString( st->c, "" );
+				idStr::Copynz( OPERAND_C.stringPtr, "", MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_INDIRECT_V )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
 				*var_c.vectorPtr = *var.vectorPtr;
 			} else {
 				var_c.vectorPtr->Zero();
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_OBJ:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_CASE( OP_INDIRECT_OBJ )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( !obj ) {
 				*var_c.entityNumberPtr = 0;
 			} else {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ inst->b.ptrOffset ];
 				*var_c.entityNumberPtr = *var.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_F )
+			var_a = OPERAND_A;
 			Push( *var_a.intPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_FTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_FTOS )
+			var_a = OPERAND_A;
 			PushString( FloatToString( *var_a.floatPtr ) );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_BTOF:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_BTOF )
+			var_a = OPERAND_A;
 			floatVal = *var_a.intPtr;
 			Push( *reinterpret_cast<int *>( &floatVal ) );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_FTOB:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_FTOB )
+			var_a = OPERAND_A;
 			if ( *var_a.floatPtr != 0.0f ) {
 				Push( 1 );
 			} else {
 				Push( 0 );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_VTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_VTOS )
+			var_a = OPERAND_A;
 			PushString( var_a.vectorPtr->ToString() );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_BTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_BTOS )
+			var_a = OPERAND_A;
 			PushString( *var_a.intPtr ? "true" : "false" );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_ENT:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_ENT )
+			var_a = OPERAND_A;
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_S:
-			PushString( GetString( st->a ) );
-			break;
+		SCRIPT_CASE( OP_PUSH_S )
+			PushString( OPERAND_A.stringPtr );
+			SCRIPT_NEXT;
 
-		case OP_PUSH_V:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_V )
+			var_a = OPERAND_A;
 			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->x ) );
 			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->y ) );
 			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->z ) );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_OBJ:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_OBJ )
+			var_a = OPERAND_A;
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_OBJENT:
-			var_a = GetVariable( st->a );
+		SCRIPT_CASE( OP_PUSH_OBJENT )
+			var_a = OPERAND_A;
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_BREAK:
-		case OP_CONTINUE:
-		default:
-			Error( "Bad opcode %i", st->op );
-			break;
+		// compare followed by an OP_IFNOT that tests the result
+		SCRIPT_CASE( OP_EQ_F_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_EQ_E_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_NE_F_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_NE_E_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_LE_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_GE_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_LT_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_GT_IFNOT )
+			var_a = OPERAND_A;
+			var_b = OPERAND_B;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_NOT_BOOL_IFNOT )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.intPtr == 0 );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_NOT_F_IFNOT )
+			var_a = OPERAND_A;
+			var_c = OPERAND_C;
+			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
+			instructionPointer++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + inst[ 1 ].b.jumpOffset );
+			}
+			SCRIPT_NEXT;
+
+		SCRIPT_CASE( OP_BREAK )
+		SCRIPT_CASE( OP_CONTINUE )
+		SCRIPT_CASE_DEFAULT
+			Error( "Bad opcode %i", inst->op );
+			SCRIPT_NEXT;
 		}
 	}
 
+#ifdef SCRIPT_THREADED_DISPATCH
+done:
+#endif
 	return threadDying;
 }
+
+#undef OPERAND_A
+#undef OPERAND_B
+#undef OPERAND_C
+#undef SCRIPT_FETCH
+#undef SCRIPT_CASE
+#undef SCRIPT_CASE_DEFAULT
+#undef SCRIPT_NEXT
+
@@ -1684,6 +1684,73 @@ void idProgram::Disassemble( void ) const {
 	fileSystem->CloseFile( file );
 }
 
+/*
+==============
+DecodeOperand
+==============
+*/
+static void DecodeOperand( const idVarDef *def, varEval_t &operand, unsigned short &stackFlags, int stackFlag ) {
+	if ( !def ) {
+		memset( &operand, 0, sizeof( operand ) );
+	} else if ( def->initialized == idVarDef::stackVariable ) {
+		memset( &operand, 0, sizeof( operand ) );
+		operand.stackOffset = def->value.stackOffset;
+		stackFlags |= stackFlag;
+	} else {
+		operand = def->value;
+	}
+}
+
+/*
+==============
+idProgram::DecodeStatements
+
+Builds the instructions executed by the interpreter.  Has to be called whenever statements
+were added or removed.  A compare followed by an OP_IFNOT on its result is turned into a
+superinstruction.  The OP_IFNOT is still decoded on its own, so jumps to it keep working.
+==============
+*/
+void idProgram::DecodeStatements( void ) {
+	int i;
+
+	instructions.SetGranularity( 1024 );
+	instructions.SetNum( statements.Num(), false );
+
+	for( i = 0; i < statements.Num(); i++ ) {
+		const statement_t &st = statements[ i ];
+		scriptInstruction_t &inst = instructions[ i ];
+
+		inst.op			= st.op;
+		inst.stackFlags	= 0;
+		DecodeOperand( st.a, inst.a, inst.stackFlags, INSTRUCTION_STACK_A );
+		DecodeOperand( st.b, inst.b, inst.stackFlags, INSTRUCTION_STACK_B );
+		DecodeOperand( st.c, inst.c, inst.stackFlags, INSTRUCTION_STACK_C );
+
+		if ( ( i + 1 >= statements.Num() ) || ( statements[ i + 1 ].op != OP_IFNOT ) || !st.c || ( statements[ i + 1 ].a != st.c ) ) {
+			continue;
+		}
+
+		switch( st.op ) {
+		case OP_EQ_F:		inst.op = OP_EQ_F_IFNOT; break;
+		case OP_EQ_E:
+		case OP_EQ_EO:
+		case OP_EQ_OE:
+		case OP_EQ_OO:		inst.op = OP_EQ_E_IFNOT; break;
+		case OP_NE_F:		inst.op = OP_NE_F_IFNOT; break;
+		case OP_NE_E:
+		case OP_NE_EO:
+		case OP_NE_OE:
+		case OP_NE_OO:		inst.op = OP_NE_E_IFNOT; break;
+		case OP_LE:			inst.op = OP_LE_IFNOT; break;
+		case OP_GE:			inst.op = OP_GE_IFNOT; break;
+		case OP_LT:			inst.op = OP_LT_IFNOT; break;
+		case OP_GT:			inst.op = OP_GT_IFNOT; break;
+		case OP_NOT_BOOL:	inst.op = OP_NOT_BOOL_IFNOT; break;
+		case OP_NOT_F:		inst.op = OP_NOT_F_IFNOT; break;
+		}
+	}
+}
+
 /*
 ==============
 idProgram::FinishCompilation
@@ -1706,6 +1773,8 @@ void idProgram::FinishCompilation( void ) {
 	for( i = 0; i < numVariables; i++ ) {
 		variableDefaults[ i ] = variables[ i ];
 	}
+
+	DecodeStatements();
 }
 
 /*
@@ -1794,6 +1863,7 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 	}
 
 	catch( idCompileError &err ) {
+		DecodeStatements();
 		if ( console ) {
 			gameLocal.Printf( "%s\n", err.error );
 			return false;
@@ -1802,6 +1872,8 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 		}
 	};
 
+	DecodeStatements();
+
 	if ( !console ) {
 		CompileStats();
 	}
@@ -1856,6 +1928,596 @@ void idProgram::CompileFile( const char *filename ) {
 	}
 }
 
+/***********************************************************************
+
+  idProgram script cache
+
+  The compiled default script is written to a binary cache file so that
+  later startups can restore it without parsing and type checking the
+  script source again.  The cache is keyed by a checksum over all script
+  source files, the script event definitions and the opcode table.
+
+***********************************************************************/
+
+#define SCRIPT_CACHE_IDENT			( ( 'C' << 24 ) + ( 'S' << 16 ) + ( 'D' << 8 ) + 'I' )
+#define SCRIPT_CACHE_VERSION		1
+
+// built-in types and defs aren't allocated by the program, so they are referenced by negative indices
+static idTypeDef * const scriptCacheTypes[] = {
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+
+static idVarDef * const scriptCacheDefs[] = {
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+
+static const int NUM_SCRIPT_CACHE_TYPES = sizeof( scriptCacheTypes ) / sizeof( scriptCacheTypes[ 0 ] );
+static const int NUM_SCRIPT_CACHE_DEFS = sizeof( scriptCacheDefs ) / sizeof( scriptCacheDefs[ 0 ] );
+
+// how the value of a var def is stored in the cache
+typedef enum {
+	CACHEVALUE_INT,
+	CACHEVALUE_GLOBAL,
+	CACHEVALUE_FUNCTION
+} cacheValue_t;
+
+/*
+================
+ReadCacheInt
+
+Throws an idCompileError on a truncated cache file, which makes the program fall back to compiling.
+================
+*/
+static int ReadCacheInt( idFile *file ) {
+	int value;
+
+	if ( file->ReadInt( value ) != sizeof( value ) ) {
+		throw idCompileError( "unexpected end of file" );
+	}
+	return value;
+}
+
+/*
+================
+ReadCacheString
+================
+*/
+static void ReadCacheString( idFile *file, idStr &string ) {
+	int len;
+
+	len = ReadCacheInt( file );
+	if ( len < 0 || len > file->Length() - file->Tell() ) {
+		throw idCompileError( "bad string length" );
+	}
+	string.Fill( ' ', len );
+	if ( len > 0 && file->Read( &string[ 0 ], len ) != len ) {
+		throw idCompileError( "unexpected end of file" );
+	}
+}
+
+/*
+================
+idProgram::ScriptCacheChecksum
+
+Checksum of everything the compiled program depends on.  Files in the script directory are
+always included, so that files which only contain defines still invalidate the cache.
+================
+*/
+unsigned long idProgram::ScriptCacheChecksum( const idStrList &sourceFiles ) {
+	unsigned long		crc;
+	idStrList			files;
+	idFileList			*scriptFiles;
+	const idEventDef	*ev;
+	const opcode_t		*op;
+	void				*buffer;
+	int					length;
+	int					i;
+
+	CRC32_InitChecksum( crc );
+
+	i = SCRIPT_CACHE_VERSION;
+	CRC32_UpdateChecksum( crc, &i, sizeof( i ) );
+	i = sizeof( void * );
+	CRC32_UpdateChecksum( crc, &i, sizeof( i ) );
+
+	for( op = idCompiler::opcodes; op->name; op++ ) {
+		CRC32_UpdateChecksum( crc, op->opname, strlen( op->opname ) + 1 );
+	}
+
+	for( i = 0; i < idEventDef::NumEventCommands(); i++ ) {
+		ev = idEventDef::GetEventCommand( i );
+		CRC32_UpdateChecksum( crc, ev->GetName(), strlen( ev->GetName() ) + 1 );
+		CRC32_UpdateChecksum( crc, ev->GetArgFormat(), strlen( ev->GetArgFormat() ) + 1 );
+		length = ev->GetReturnType();
+		CRC32_UpdateChecksum( crc, &length, sizeof( length ) );
+	}
+
+	scriptFiles = fileSystem->ListFiles( "script", ".script", true, true );
+	for( i = 0; i < scriptFiles->GetNumFiles(); i++ ) {
+		files.AddUnique( scriptFiles->GetFile( i ) );
+	}
+	fileSystem->FreeFileList( scriptFiles );
+
+	for( i = 0; i < sourceFiles.Num(); i++ ) {
+		files.AddUnique( sourceFiles[ i ] );
+	}
+	files.Sort();
+
+	for( i = 0; i < files.Num(); i++ ) {
+		CRC32_UpdateChecksum( crc, files[ i ].c_str(), files[ i ].Length() + 1 );
+		length = fileSystem->ReadFile( files[ i ], &buffer, NULL );
+		CRC32_UpdateChecksum( crc, &length, sizeof( length ) );
+		if ( length > 0 ) {
+			CRC32_UpdateChecksum( crc, buffer, length );
+		}
+		if ( buffer ) {
+			fileSystem->FreeFile( buffer );
+		}
+	}
+
+	CRC32_FinishChecksum( crc );
+
+	return crc;
+}
+
+/*
+================
+idProgram::CacheTypeIndex
+================
+*/
+int idProgram::CacheTypeIndex( const idTypeDef *type ) const {
+	int i;
+
+	if ( !type ) {
+		return -1;
+	}
+	for( i = 0; i < NUM_SCRIPT_CACHE_TYPES; i++ ) {
+		if ( type == scriptCacheTypes[ i ] ) {
+			return -2 - i;
+		}
+	}
+	i = types.FindIndex( const_cast<idTypeDef *>( type ) );
+	if ( i < 0 ) {
+		throw idCompileError( va( "type '%s' is not part of the program", type->Name() ) );
+	}
+	return i;
+}
+
+/*
+================
+idProgram::CacheDefIndex
+================
+*/
+int idProgram::CacheDefIndex( const idVarDef *def ) const {
+	int i;
+
+	if ( !def ) {
+		return -1;
+	}
+	for( i = 0; i < NUM_SCRIPT_CACHE_DEFS; i++ ) {
+		if ( def == scriptCacheDefs[ i ] ) {
+			return -2 - i;
+		}
+	}
+	if ( def->num < 0 || def->num >= varDefs.Num() || varDefs[ def->num ] != def ) {
+		throw idCompileError( va( "def '%s' is not part of the program", def->Name() ) );
+	}
+	return def->num;
+}
+
+/*
+================
+idProgram::CacheFunctionIndex
+================
+*/
+int idProgram::CacheFunctionIndex( const function_t *func ) const {
+	int i;
+
+	if ( !func ) {
+		return -1;
+	}
+	i = func - &functions[ 0 ];
+	if ( i < 0 || i >= functions.Num() ) {
+		throw idCompileError( va( "function '%s' is not part of the program", func->Name() ) );
+	}
+	return i;
+}
+
+/*
+================
+idProgram::CacheType
+================
+*/
+idTypeDef *idProgram::CacheType( int index ) {
+	if ( index == -1 ) {
+		return NULL;
+	}
+	if ( index < -1 ) {
+		index = -2 - index;
+		if ( index >= NUM_SCRIPT_CACHE_TYPES ) {
+			throw idCompileError( "bad type index" );
+		}
+		return scriptCacheTypes[ index ];
+	}
+	if ( index >= types.Num() ) {
+		throw idCompileError( "bad type index" );
+	}
+	return types[ index ];
+}
+
+/*
+================
+idProgram::CacheDef
+================
+*/
+idVarDef *idProgram::CacheDef( int index ) {
+	if ( index == -1 ) {
+		return NULL;
+	}
+	if ( index < -1 ) {
+		index = -2 - index;
+		if ( index >= NUM_SCRIPT_CACHE_DEFS ) {
+			throw idCompileError( "bad def index" );
+		}
+		return scriptCacheDefs[ index ];
+	}
+	if ( index >= varDefs.Num() ) {
+		throw idCompileError( "bad def index" );
+	}
+	return varDefs[ index ];
+}
+
+/*
+================
+idProgram::CacheFunction
+================
+*/
+function_t *idProgram::CacheFunction( int index ) {
+	if ( index == -1 ) {
+		return NULL;
+	}
+	if ( index < -1 || index >= functions.Num() ) {
+		throw idCompileError( "bad function index" );
+	}
+	return &functions[ index ];
+}
+
+/*
+================
+idProgram::WriteScriptCache
+================
+*/
+bool idProgram::WriteScriptCache( const char *cacheName, int compileTime ) const {
+	idFile				*file;
+	const idTypeDef		*type;
+	const idVarDef		*def;
+	const function_t	*func;
+	const statement_t	*st;
+	int					i, j;
+	int					valueType;
+	int					value;
+
+	file = fileSystem->OpenFileWrite( cacheName );
+	if ( !file ) {
+		gameLocal.Warning( "Couldn't open script cache '%s' for writing", cacheName );
+		return false;
+	}
+
+	try {
+		file->WriteInt( SCRIPT_CACHE_IDENT );
+		file->WriteInt( SCRIPT_CACHE_VERSION );
+		file->WriteInt( ( int )ScriptCacheChecksum( fileList ) );
+		file->WriteInt( compileTime );
+
+		file->WriteInt( fileList.Num() );
+		for( i = 0; i < fileList.Num(); i++ ) {
+			file->WriteString( fileList[ i ] );
+		}
+
+		file->WriteInt( types.Num() );
+		file->WriteInt( varDefs.Num() );
+		file->WriteInt( functions.Num() );
+		file->WriteInt( statements.Num() );
+
+		file->WriteInt( numVariables );
+		file->Write( variables, numVariables );
+
+		for( i = 0; i < types.Num(); i++ ) {
+			type = types[ i ];
+			file->WriteInt( type->type );
+			file->WriteString( type->name );
+			file->WriteInt( type->size );
+			file->WriteInt( CacheDefIndex( type->def ) );
+			file->WriteInt( CacheTypeIndex( type->auxType ) );
+			file->WriteInt( type->parmTypes.Num() );
+			for( j = 0; j < type->parmTypes.Num(); j++ ) {
+				file->WriteInt( CacheTypeIndex( type->parmTypes[ j ] ) );
+				file->WriteString( type->parmNames[ j ] );
+			}
+			file->WriteInt( type->functions.Num() );
+			for( j = 0; j < type->functions.Num(); j++ ) {
+				file->WriteInt( CacheFunctionIndex( type->functions[ j ] ) );
+			}
+		}
+
+		for( i = 0; i < varDefs.Num(); i++ ) {
+			def = varDefs[ i ];
+
+			// jump offsets, arg sizes and virtual function indices of immediates overwrite part of
+			// the global pointer they were allocated with, so classify by type before looking at pointers
+			etype_t etype = def->Type();
+			if ( etype == ev_jumpoffset || etype == ev_argsize || etype == ev_virtualfunction || def->initialized == idVarDef::stackVariable ) {
+				valueType = CACHEVALUE_INT;
+				value = def->value.argSize;
+			} else if ( etype == ev_function && def->value.functionPtr ) {
+				valueType = CACHEVALUE_FUNCTION;
+				value = CacheFunctionIndex( def->value.functionPtr );
+			} else if ( def->value.bytePtr >= variables && def->value.bytePtr <= &variables[ numVariables ] ) {
+				valueType = CACHEVALUE_GLOBAL;
+				value = def->value.bytePtr - variables;
+			} else if ( ( intptr_t )def->value.bytePtr == ( intptr_t )( unsigned int )def->value.ptrOffset ) {
+				valueType = CACHEVALUE_INT;
+				value = def->value.ptrOffset;
+			} else {
+				throw idCompileError( va( "can't store value of '%s'", def->GlobalName() ) );
+			}
+
+			file->WriteString( def->Name() );
+			file->WriteInt( CacheTypeIndex( def->TypeDef() ) );
+			file->WriteInt( CacheDefIndex( def->scope ) );
+			file->WriteInt( def->numUsers );
+			file->WriteInt( def->initialized );
+			file->WriteInt( valueType );
+			file->WriteInt( value );
+		}
+
+		for( i = 0; i < functions.Num(); i++ ) {
+			func = &functions[ i ];
+			file->WriteString( func->Name() );
+			file->WriteString( func->eventdef ? func->eventdef->GetName() : "" );
+			file->WriteInt( CacheDefIndex( func->def ) );
+			file->WriteInt( CacheTypeIndex( func->type ) );
+			file->WriteInt( func->firstStatement );
+			file->WriteInt( func->numStatements );
+			file->WriteInt( func->parmTotal );
+			file->WriteInt( func->locals );
+			file->WriteInt( func->filenum );
+			file->WriteInt( func->parmSize.Num() );
+			for( j = 0; j < func->parmSize.Num(); j++ ) {
+				file->WriteInt( func->parmSize[ j ] );
+			}
+		}
+
+		for( i = 0; i < statements.Num(); i++ ) {
+			st = &statements[ i ];
+			file->WriteUnsignedShort( st->op );
+			file->WriteInt( CacheDefIndex( st->a ) );
+			file->WriteInt( CacheDefIndex( st->b ) );
+			file->WriteInt( CacheDefIndex( st->c ) );
+			file->WriteUnsignedShort( st->linenumber );
+			file->WriteUnsignedShort( st->file );
+		}
+
+		file->WriteInt( CacheDefIndex( returnDef ) );
+		file->WriteInt( CacheDefIndex( returnStringDef ) );
+		file->WriteInt( CacheDefIndex( sysDef ) );
+		file->WriteInt( SCRIPT_CACHE_IDENT );
+	}
+
+	catch( idCompileError &err ) {
+		gameLocal.Warning( "Couldn't write script cache '%s': %s", cacheName, err.error );
+		fileSystem->CloseFile( file );
+		fileSystem->RemoveFile( cacheName );
+		return false;
+	}
+
+	fileSystem->CloseFile( file );
+
+	return true;
+}
+
+/*
+================
+idProgram::ReadScriptCache
+
+Restores the program from the script cache.  Returns false if the cache is missing or
+out of date, in which case the program is left empty and has to be compiled from source.
+================
+*/
+bool idProgram::ReadScriptCache( const char *cacheName, int &compileTime ) {
+	idFile			*file;
+	idTypeDef		*type;
+	idVarDef		*def;
+	function_t		*func;
+	statement_t		*st;
+	idStr			name;
+	idStr			eventName;
+	int				i, j, num;
+	int				numTypes, numDefs, numFunctions, numStatements;
+	int				valueType;
+	int				value;
+	unsigned short	us;
+
+	file = fileSystem->OpenFileRead( cacheName );
+	if ( !file ) {
+		return false;
+	}
+
+	FreeData();
+
+	try {
+		if ( ReadCacheInt( file ) != SCRIPT_CACHE_IDENT || ReadCacheInt( file ) != SCRIPT_CACHE_VERSION ) {
+			throw idCompileError( "wrong version" );
+		}
+		unsigned long checksum = ( unsigned int )ReadCacheInt( file );
+		compileTime = ReadCacheInt( file );
+
+		num = ReadCacheInt( file );
+		for( i = 0; i < num; i++ ) {
+			ReadCacheString( file, name );
+			fileList.Append( name );
+		}
+
+		if ( ( unsigned int )ScriptCacheChecksum( fileList ) != checksum ) {
+			throw idCompileError( "script source changed" );
+		}
+
+		numTypes		= ReadCacheInt( file );
+		numDefs			= ReadCacheInt( file );
+		numFunctions	= ReadCacheInt( file );
+		numStatements	= ReadCacheInt( file );
+		numVariables	= ReadCacheInt( file );
+
+		if ( numTypes < 0 || numDefs < 0 || numFunctions < 0 || numFunctions > functions.Max() ||
+			numStatements < 1 || numStatements > statements.Max() || numVariables < 0 || numVariables > ( int )sizeof( variables ) ) {
+			throw idCompileError( "bad header" );
+		}
+
+		if ( file->Read( variables, numVariables ) != numVariables ) {
+			throw idCompileError( "unexpected end of file" );
+		}
+
+		// allocate everything up front so that references can be resolved while reading
+		for( i = 0; i < numTypes; i++ ) {
+			AllocType( ev_void, NULL, "", 0, NULL );
+		}
+		for( i = 0; i < numDefs; i++ ) {
+			def = new idVarDef();
+			def->num = varDefs.Append( def );
+		}
+		functions.SetNum( numFunctions );
+
+		for( i = 0; i < numTypes; i++ ) {
+			type = types[ i ];
+			type->type		= ( etype_t )ReadCacheInt( file );
+			ReadCacheString( file, type->name );
+			type->size		= ReadCacheInt( file );
+			type->def		= CacheDef( ReadCacheInt( file ) );
+			type->auxType	= CacheType( ReadCacheInt( file ) );
+			num = ReadCacheInt( file );
+			for( j = 0; j < num; j++ ) {
+				type->parmTypes.Append( CacheType( ReadCacheInt( file ) ) );
+				ReadCacheString( file, name );
+				type->parmNames.Append( name );
+			}
+			num = ReadCacheInt( file );
+			for( j = 0; j < num; j++ ) {
+				func = CacheFunction( ReadCacheInt( file ) );
+				if ( !func ) {
+					throw idCompileError( "bad function index" );
+				}
+				type->functions.Append( func );
+			}
+		}
+
+		// the defs are added to the name lists in allocation order, so that defs with the same name end up in the same order
+		for( i = 0; i < numDefs; i++ ) {
+			def = varDefs[ i ];
+			ReadCacheString( file, name );
+			def->SetTypeDef( CacheType( ReadCacheInt( file ) ) );
+			def->scope			= CacheDef( ReadCacheInt( file ) );
+			def->numUsers		= ReadCacheInt( file );
+			def->initialized	= ( idVarDef::initialized_t )ReadCacheInt( file );
+			valueType			= ReadCacheInt( file );
+			value				= ReadCacheInt( file );
+
+			if ( !def->TypeDef() || !def->scope ) {
+				throw idCompileError( "bad def" );
+			}
+
+			switch( valueType ) {
+			case CACHEVALUE_INT :
+				def->value.ptrOffset = value;
+				break;
+
+			case CACHEVALUE_GLOBAL :
+				if ( value < 0 || value > numVariables ) {
+					throw idCompileError( "bad global offset" );
+				}
+				def->value.bytePtr = &variables[ value ];
+				break;
+
+			case CACHEVALUE_FUNCTION :
+				def->value.functionPtr = CacheFunction( value );
+				break;
+
+			default :
+				throw idCompileError( "bad def value" );
+			}
+
+			AddDefToNameList( def, name );
+		}
+
+		for( i = 0; i < numFunctions; i++ ) {
+			func = &functions[ i ];
+			func->Clear();
+			ReadCacheString( file, name );
+			func->SetName( name );
+			ReadCacheString( file, eventName );
+			if ( eventName.Length() ) {
+				func->eventdef = idEventDef::FindEvent( eventName );
+				if ( !func->eventdef ) {
+					throw idCompileError( va( "unknown event '%s'", eventName.c_str() ) );
+				}
+			}
+			func->def				= CacheDef( ReadCacheInt( file ) );
+			func->type				= CacheType( ReadCacheInt( file ) );
+			func->firstStatement	= ReadCacheInt( file );
+			func->numStatements		= ReadCacheInt( file );
+			func->parmTotal			= ReadCacheInt( file );
+			func->locals			= ReadCacheInt( file );
+			func->filenum			= ReadCacheInt( file );
+			if ( func->firstStatement < 0 || func->numStatements < 0 || func->firstStatement + func->numStatements > numStatements ) {
+				throw idCompileError( "bad function statements" );
+			}
+			func->parmSize.SetGranularity( 1 );
+			num = ReadCacheInt( file );
+			for( j = 0; j < num; j++ ) {
+				func->parmSize.Append( ReadCacheInt( file ) );
+			}
+		}
+
+		for( i = 0; i < numStatements; i++ ) {
+			st = AllocStatement();
+			if ( file->ReadUnsignedShort( us ) != sizeof( us ) ) {
+				throw idCompileError( "unexpected end of file" );
+			}
+			st->op			= us;
+			st->a			= CacheDef( ReadCacheInt( file ) );
+			st->b			= CacheDef( ReadCacheInt( file ) );
+			st->c			= CacheDef( ReadCacheInt( file ) );
+			file->ReadUnsignedShort( st->linenumber );
+			if ( file->ReadUnsignedShort( st->file ) != sizeof( st->file ) ) {
+				throw idCompileError( "unexpected end of file" );
+			}
+			if ( st->op >= NUM_OPCODES || st->file >= fileList.Num() ) {
+				throw idCompileError( "bad statement" );
+			}
+		}
+
+		returnDef		= CacheDef( ReadCacheInt( file ) );
+		returnStringDef	= CacheDef( ReadCacheInt( file ) );
+		sysDef			= CacheDef( ReadCacheInt( file ) );
+
+		if ( ReadCacheInt( file ) != SCRIPT_CACHE_IDENT || !returnDef || !returnStringDef || !sysDef ) {
+			throw idCompileError( "bad trailer" );
+		}
+	}
+
+	catch( idCompileError &err ) {
+		gameLocal.DPrintf( "Ignoring script cache '%s': %s\n", cacheName, err.error );
+		fileSystem->CloseFile( file );
+		FreeData();
+		return false;
+	}
+
+	fileSystem->CloseFile( file );
+
+	return true;
+}
+
 /*
 ================
 idProgram::FreeData
@@ -1889,6 +2551,7 @@ void idProgram::FreeData( void ) {
 	filename.Clear();
 	fileList.Clear();
 	statements.Clear();
+	instructions.Clear();
 	functions.Clear();
 
 	top_functions	= 0;
@@ -1916,7 +2579,32 @@ void idProgram::Startup( const char *defaultScript ) {
 
 	// load the default script
 	if ( defaultScript && *defaultScript ) {
-		CompileFile( defaultScript );
+		idTimer	timer;
+		idStr	cacheName;
+		int		compileTime;
+
+		cacheName = "generated/";
+		cacheName += defaultScript;
+		cacheName.SetFileExtension( ".bin" );
+
+		timer.Start();
+		if ( g_scriptCache.GetBool() && ReadScriptCache( cacheName, compileTime ) ) {
+			timer.Stop();
+			CompileStats();
+			if ( g_disasm.GetBool() ) {
+				Disassemble();
+			}
+			gameLocal.Printf( "Restored compiled script from %s in %d msec (compiling took %d msec, saved %d msec)\n",
+				cacheName.c_str(), ( int )timer.Milliseconds(), compileTime, compileTime - ( int )timer.Milliseconds() );
+		} else {
+			BeginCompilation();
+			CompileFile( defaultScript );
+			timer.Stop();
+			compileTime = ( int )timer.Milliseconds();
+			if ( g_scriptCache.GetBool() && WriteScriptCache( cacheName, compileTime ) ) {
+				gameLocal.Printf( "Compiled script in %d msec, wrote %s\n", compileTime, cacheName.c_str() );
+			}
+		}
 	}
 
 	FinishCompilation();
@@ -2082,6 +2770,8 @@ void idProgram::Restart( void ) {
 	fileList.SetNum( top_files, false );
 	filename.Clear();
 
+	DecodeStatements();
+
 	// reset the variables to their default values
 	numVariables = variableDefaults.Num();
 	for( i = 0; i < numVariables; i++ ) {
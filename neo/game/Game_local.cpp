@@ -296,6 +296,9 @@ void idGameLocal::Init( void ) {
 
 	InitConsoleCommands();
 
+	physicsIslands.Init();
+	animationStage.Init();
+
 	// load default scripts
 	program.Startup( SCRIPT_DEFAULT );
 
@@ -342,6 +345,9 @@ void idGameLocal::Shutdown( void ) {
 
 	MapShutdown();
 
+	physicsIslands.Shutdown();
+	animationStage.Shutdown();
+
 	aasList.DeleteContents( true );
 	aasNames.Clear();
 
@@ -1127,6 +1133,7 @@ idGameLocal::MapPopulate
 ===================
 */
 void idGameLocal::MapPopulate( void ) {
+	int i;
 
 	if ( isMultiplayer ) {
 		cvarSystem->SetCVarBool( "r_skipSpecular", false );
@@ -1149,6 +1156,11 @@ void idGameLocal::MapPopulate( void ) {
 	// before the physics are run so entities can bind correctly
 	Printf( "==== Processing events ====\n" );
 	idEvent::ServiceEvents();
+
+	// doors and obstacles have set their initial area states by now
+	for ( i = 0; i < aasList.Num(); i++ ) {
+		aasList[ i ]->PrecomputeRoutingCache();
+	}
 }
 
 /*
@@ -1398,6 +1410,13 @@ bool idGameLocal::InitFromSaveGame( const char *mapName, idRenderWorld *renderWo
 
 	savegame.RestoreObjects();
 
+	idPhysics_RigidBody::RestoreSleepIslands();
+
+	// doors and obstacles have restored their area states by now
+	for ( i = 0; i < aasList.Num(); i++ ) {
+		aasList[ i ]->PrecomputeRoutingCache();
+	}
+
 	mpGame.Reset();
 
 	mpGame.Precache();
@@ -1475,6 +1494,7 @@ void idGameLocal::MapShutdown( void ) {
 	}
 
 	MapClear( true );
+	aiPathQueue.Clear();
 
 	// reset the script to the state it was before the map was started
 	program.Restart();
@@ -2234,6 +2254,12 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		timer_think.Clear();
 		timer_think.Start();
 
+		// predict the motion of independent rigid bodies on the job threads
+		physicsIslands.PredictMotion( activeEntities );
+
+		// start the AI moves that waited for the path search budget
+		aiPathQueue.RunFrame();
+
 		// let entities think
 		if ( g_timeentities.GetFloat() ) {
 			num = 0;
@@ -2272,6 +2298,11 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			}
 		}
 
+		physicsIslands.FinishPrediction();
+		idPhysics_RigidBody::UpdateSleepStatistics();
+		idAI::UpdateLODStatistics();
+		idAnimator::UpdateFrameStatistics();
+
 		// remove any entities that have stopped thinking
 		if ( numEntitiesToDeactivate ) {
 			idEntity *next_ent;
@@ -2296,6 +2327,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 
 		timer_events.Stop();
 
+		// create the animation frames of the entities in view on the job threads
+		animationStage.Run( activeEntities );
+
 		// free the player pvs
 		FreePlayerPVS();
 
@@ -2311,6 +2345,14 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				timer_think.Milliseconds(), timer_events.Milliseconds(), num );
 		}
 
+		// display how many event argument blocks were allocated during the frame
+		if ( g_showEventAllocs.GetBool() ) {
+			int numArgAllocs, numHeapAllocs, poolMemory;
+			idEvent::GetArgStats( numArgAllocs, numHeapAllocs, poolMemory );
+			Printf( "game %d: event args:%d heap allocs:%d pool:%dkB\n", time, numArgAllocs, numHeapAllocs, poolMemory >> 10 );
+		}
+		idEvent::ClearArgStats();
+
 		// build the return value
 		ret.consistencyHash = 0;
 		ret.sessionCommand[0] = 0;
@@ -2834,6 +2876,7 @@ void idGameLocal::SetAASAreaState( const idBounds &bounds, const int areaContent
 	for( i = 0; i < aasList.Num(); i++ ) {
 		aasList[ i ]->SetAreaState( bounds, areaContents, closed );
 	}
+	aiPathQueue.ClearReachable();
 }
 
 /*
@@ -2851,6 +2894,7 @@ aasHandle_t idGameLocal::AddAASObstacle( const idBounds &bounds ) {
 	}
 
 	obstacle = aasList[ 0 ]->AddObstacle( bounds );
+	aiPathQueue.ClearReachable();
 	for( i = 1; i < aasList.Num(); i++ ) {
 		check = aasList[ i ]->AddObstacle( bounds );
 		assert( check == obstacle );
@@ -2870,6 +2914,7 @@ void idGameLocal::RemoveAASObstacle( const aasHandle_t handle ) {
 	for( i = 0; i < aasList.Num(); i++ ) {
 		aasList[ i ]->RemoveObstacle( handle );
 	}
+	aiPathQueue.ClearReachable();
 }
 
 /*
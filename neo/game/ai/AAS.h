@@ -80,6 +80,12 @@ public:
 	virtual bool				Init( const idStr &mapName, unsigned int mapFileCRC ) = 0;
 								// Print AAS stats.
 	virtual void				Stats( void ) const = 0;
+								// Build the routing caches up front, or load them from the routing cache file.
+	virtual void				PrecomputeRoutingCache( void ) = 0;
+								// Print the routing cache budget and the cache use per cluster.
+	virtual void				RoutingCacheReport( bool all ) const = 0;
+								// Clear the routing cache hit, miss and build time counters.
+	virtual void				ResetRoutingCacheStats( void ) = 0;
 								// Test from the given origin.
 	virtual void				Test( const idVec3 &origin ) = 0;
 								// Get the AAS settings.
@@ -0,0 +1,597 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "AAS_local.h"
+#include "../Game_local.h"		// for print and error
+
+#define CACHETYPE_AREA				1
+#define CACHETYPE_PORTAL			2
+
+#define ROUTINGCACHE_IDENT			( ( 'C' << 24 ) + ( 'R' << 16 ) + ( 'S' << 8 ) + 'A' )
+#define ROUTINGCACHE_VERSION		1
+
+#define MAX_PRECOMPUTE_THREADS		8
+#define PORTAL_CACHE_JOB_SIZE		64
+
+// travel flags used by the monsters in the order they are precomputed
+static const int precomputeTravelFlags[] = {
+	TFL_WALK|TFL_AIR,
+	TFL_WALK|TFL_AIR|TFL_FLY
+};
+
+static const int NUM_PRECOMPUTE_TRAVEL_FLAGS = sizeof( precomputeTravelFlags ) / sizeof( precomputeTravelFlags[0] );
+
+typedef struct routingCacheJob_s {
+	const idAASLocal *		aas;
+	idRoutingCache **		caches;
+	int						firstCache;
+	int						numCaches;
+	idRoutingUpdate *		update;
+	int						updateSize;
+	bool *					failed;
+} routingCacheJob_t;
+
+/*
+============
+idAASLocal::AreaRoutingCacheJob
+============
+*/
+void idAASLocal::AreaRoutingCacheJob( void *data ) {
+	routingCacheJob_t *job = (routingCacheJob_t *) data;
+
+	for ( int i = 0; i < job->numCaches; i++ ) {
+		job->aas->UpdateAreaRoutingCache( job->caches[i], job->update );
+	}
+}
+
+/*
+============
+idAASLocal::PortalRoutingCacheJob
+============
+*/
+void idAASLocal::PortalRoutingCacheJob( void *data ) {
+	routingCacheJob_t *job = (routingCacheJob_t *) data;
+
+	for ( int i = 0; i < job->numCaches; i++ ) {
+		job->failed[i] = !job->aas->UpdatePortalRoutingCache( job->caches[i], job->update, true );
+		if ( job->failed[i] ) {
+			// the update list was left behind half way
+			memset( job->update, 0, job->updateSize * sizeof( idRoutingUpdate ) );
+		}
+	}
+}
+
+/*
+============
+idAASLocal::GoalAreaCluster
+
+  Returns the cluster the portal cache towards the area is calculated in, or 0 if the area cannot be a goal.
+============
+*/
+int idAASLocal::GoalAreaCluster( int areaNum ) const {
+	int clusterNum;
+
+	if ( !( file->GetArea( areaNum ).flags & ( AREA_REACHABLE_WALK | AREA_REACHABLE_FLY ) ) ) {
+		return 0;
+	}
+	clusterNum = file->GetArea( areaNum ).cluster;
+	if ( clusterNum < 0 ) {
+		// just assume the goal area is part of the front cluster
+		clusterNum = file->GetPortal( -clusterNum ).clusters[0];
+	}
+	if ( clusterNum <= 0 || ClusterAreaNum( clusterNum, areaNum ) >= file->GetCluster( clusterNum ).numReachableAreas ) {
+		return 0;
+	}
+	return clusterNum;
+}
+
+/*
+============
+idAASLocal::SelectPrecomputeTravelFlags
+
+  Selects the travel flags to precompute the area and portal cache for within the
+  memory budget and returns the estimated memory.
+============
+*/
+int idAASLocal::SelectPrecomputeTravelFlags( int *areaTravelFlags, int &numAreaFlags, int *portalTravelFlags, int &numPortalFlags ) const {
+	int i, n, budget, total, areaCacheSize, portalCacheSize;
+
+	budget = aas_precomputeMemory.GetInteger() << 10;
+
+	areaCacheSize = 0;
+	for ( i = 0; i < file->GetNumClusters(); i++ ) {
+		n = file->GetCluster( i ).numReachableAreas;
+		areaCacheSize += n * ( sizeof( idRoutingCache ) + n * ( sizeof( unsigned short ) + sizeof( byte ) ) );
+	}
+
+	portalCacheSize = 0;
+	for ( i = 1; i < file->GetNumAreas(); i++ ) {
+		if ( GoalAreaCluster( i ) ) {
+			portalCacheSize += sizeof( idRoutingCache ) + file->GetNumPortals() * ( sizeof( unsigned short ) + sizeof( byte ) );
+		}
+	}
+
+	total = 0;
+	numAreaFlags = numPortalFlags = 0;
+
+	// the area cache comes first because the portal cache is built from it
+	for ( i = 0; i < NUM_PRECOMPUTE_TRAVEL_FLAGS; i++ ) {
+		if ( total + areaCacheSize <= budget ) {
+			areaTravelFlags[numAreaFlags++] = precomputeTravelFlags[i];
+			total += areaCacheSize;
+		}
+	}
+	for ( i = 0; i < numAreaFlags; i++ ) {
+		if ( total + portalCacheSize <= budget ) {
+			portalTravelFlags[numPortalFlags++] = areaTravelFlags[i];
+			total += portalCacheSize;
+		}
+	}
+
+	return total;
+}
+
+/*
+============
+idAASLocal::PrecomputeAreaRoutingCache
+
+  Builds the area cache for all areas in all clusters with one job per cluster.
+============
+*/
+int idAASLocal::PrecomputeAreaRoutingCache( idParallelJobList &jobList, const int *travelFlags, int numTravelFlags ) {
+	int i, j, n, clusterNum, side, numReachableAreas;
+	int **clusterAreas;
+	byte *bytePtr;
+	const aasArea_t *area;
+	const aasPortal_t *portal;
+	idRoutingCache *cache;
+	idList<idRoutingCache *> caches;
+	idList<routingCacheJob_t> jobs;
+
+	if ( !numTravelFlags ) {
+		return 0;
+	}
+
+	// find the area number for each area within each cluster
+	clusterAreas = (int **) Mem_ClearedAlloc( file->GetNumClusters() * sizeof( int * ) + areaCacheIndexSize * sizeof( int ) );
+	bytePtr = ((byte *)clusterAreas) + file->GetNumClusters() * sizeof( int * );
+	for ( i = 0; i < file->GetNumClusters(); i++ ) {
+		clusterAreas[i] = (int *) bytePtr;
+		bytePtr += file->GetCluster( i ).numReachableAreas * sizeof( int );
+	}
+	for ( i = 1; i < file->GetNumAreas(); i++ ) {
+		area = &file->GetArea( i );
+		if ( area->cluster > 0 ) {
+			if ( area->clusterAreaNum < file->GetCluster( area->cluster ).numReachableAreas ) {
+				clusterAreas[area->cluster][area->clusterAreaNum] = i;
+			}
+		} else if ( area->cluster < 0 ) {
+			portal = &file->GetPortal( -area->cluster );
+			for ( side = 0; side < 2; side++ ) {
+				clusterNum = portal->clusters[side];
+				if ( clusterNum > 0 && portal->clusterAreaNum[side] < file->GetCluster( clusterNum ).numReachableAreas ) {
+					clusterAreas[clusterNum][portal->clusterAreaNum[side]] = i;
+				}
+			}
+		}
+	}
+
+	// allocate the cache here because the jobs may not allocate memory
+	for ( n = 0; n < numTravelFlags; n++ ) {
+		for ( i = 1; i < file->GetNumClusters(); i++ ) {
+			numReachableAreas = file->GetCluster( i ).numReachableAreas;
+
+			routingCacheJob_t &job = jobs.Alloc();
+			job.aas = this;
+			job.caches = NULL;
+			job.firstCache = caches.Num();
+			job.numCaches = 0;
+			job.update = NULL;
+			job.updateSize = numReachableAreas;
+			job.failed = NULL;
+
+			for ( j = 0; j < numReachableAreas; j++ ) {
+				if ( !clusterAreas[i][j] || FindAreaRoutingCache( i, clusterAreas[i][j], travelFlags[n] ) ) {
+					continue;
+				}
+				cache = new idRoutingCache( numReachableAreas );
+				cache->type = CACHETYPE_AREA;
+				cache->cluster = i;
+				cache->areaNum = clusterAreas[i][j];
+				cache->startTravelTime = 1;
+				cache->travelFlags = travelFlags[n];
+				cache->precomputed = true;
+				cache->prev = NULL;
+				cache->next = areaCacheIndex[i][j];
+				if ( cache->next ) {
+					cache->next->prev = cache;
+				}
+				areaCacheIndex[i][j] = cache;
+				precomputedCacheMemory += cache->Size();
+				caches.Append( cache );
+				job.numCaches++;
+			}
+
+			if ( !job.numCaches ) {
+				jobs.RemoveIndex( jobs.Num() - 1 );
+				continue;
+			}
+			job.update = (idRoutingUpdate *) Mem_ClearedAlloc( numReachableAreas * sizeof( idRoutingUpdate ) );
+		}
+	}
+
+	for ( i = 0; i < jobs.Num(); i++ ) {
+		jobs[i].caches = caches.Ptr() + jobs[i].firstCache;
+		jobList.AddJob( AreaRoutingCacheJob, &jobs[i] );
+	}
+	jobList.Run();
+
+	for ( i = 0; i < jobs.Num(); i++ ) {
+		Mem_Free( jobs[i].update );
+	}
+	Mem_Free( clusterAreas );
+
+	return caches.Num();
+}
+
+/*
+============
+idAASLocal::PrecomputePortalRoutingCache
+
+  Builds the portal cache towards all goal areas from the precomputed area cache.
+============
+*/
+int idAASLocal::PrecomputePortalRoutingCache( idParallelJobList &jobList, const int *travelFlags, int numTravelFlags ) {
+	int i, n, clusterNum, numBuilt;
+	idRoutingCache *cache;
+	idList<idRoutingCache *> caches;
+	idList<bool> failed;
+	idList<routingCacheJob_t> jobs;
+
+	if ( !numTravelFlags ) {
+		return 0;
+	}
+
+	// allocate the cache here because the jobs may not allocate memory
+	for ( n = 0; n < numTravelFlags; n++ ) {
+		for ( i = 1; i < file->GetNumAreas(); i++ ) {
+			clusterNum = GoalAreaCluster( i );
+			if ( !clusterNum ) {
+				continue;
+			}
+			for ( cache = portalCacheIndex[i]; cache; cache = cache->next ) {
+				if ( cache->travelFlags == travelFlags[n] ) {
+					break;
+				}
+			}
+			if ( cache ) {
+				continue;
+			}
+			cache = new idRoutingCache( file->GetNumPortals() );
+			cache->type = CACHETYPE_PORTAL;
+			cache->cluster = clusterNum;
+			cache->areaNum = i;
+			cache->startTravelTime = 1;
+			cache->travelFlags = travelFlags[n];
+			cache->precomputed = true;
+			cache->prev = NULL;
+			cache->next = portalCacheIndex[i];
+			if ( cache->next ) {
+				cache->next->prev = cache;
+			}
+			portalCacheIndex[i] = cache;
+			precomputedCacheMemory += cache->Size();
+			caches.Append( cache );
+		}
+	}
+
+	failed.SetNum( caches.Num() );
+
+	for ( i = 0; i < caches.Num(); i += PORTAL_CACHE_JOB_SIZE ) {
+		routingCacheJob_t &job = jobs.Alloc();
+		job.aas = this;
+		job.firstCache = i;
+		job.numCaches = Min( PORTAL_CACHE_JOB_SIZE, caches.Num() - i );
+		job.updateSize = file->GetNumPortals() + 1;
+		job.update = (idRoutingUpdate *) Mem_ClearedAlloc( job.updateSize * sizeof( idRoutingUpdate ) );
+	}
+
+	for ( i = 0; i < jobs.Num(); i++ ) {
+		jobs[i].caches = caches.Ptr() + jobs[i].firstCache;
+		jobs[i].failed = failed.Ptr() + jobs[i].firstCache;
+		jobList.AddJob( PortalRoutingCacheJob, &jobs[i] );
+	}
+	jobList.Run();
+
+	for ( i = 0; i < jobs.Num(); i++ ) {
+		Mem_Free( jobs[i].update );
+	}
+
+	// remove the cache that could not be built from the precomputed area cache
+	numBuilt = caches.Num();
+	for ( i = 0; i < caches.Num(); i++ ) {
+		if ( !failed[i] ) {
+			continue;
+		}
+		cache = caches[i];
+		if ( cache->next ) {
+			cache->next->prev = cache->prev;
+		}
+		if ( cache->prev ) {
+			cache->prev->next = cache->next;
+		} else {
+			portalCacheIndex[cache->areaNum] = cache->next;
+		}
+		UnlinkCache( cache );
+		delete cache;
+		numBuilt--;
+	}
+
+	return numBuilt;
+}
+
+/*
+============
+idAASLocal::RoutingStateChecksum
+
+  Checksum of the area and reachability state the routing cache depends on.
+============
+*/
+unsigned int idAASLocal::RoutingStateChecksum( void ) const {
+	int i;
+	unsigned long crc;
+	const idReachability *reach;
+
+	CRC32_InitChecksum( crc );
+	for ( i = 0; i < file->GetNumAreas(); i++ ) {
+		CRC32_UpdateChecksum( crc, &file->GetArea( i ).travelFlags, sizeof( file->GetArea( i ).travelFlags ) );
+		for ( reach = file->GetArea( i ).reach; reach; reach = reach->next ) {
+			CRC32_UpdateChecksum( crc, &reach->travelType, sizeof( reach->travelType ) );
+		}
+	}
+	CRC32_FinishChecksum( crc );
+	return (unsigned int) crc;
+}
+
+/*
+============
+idAASLocal::RoutingCacheFileName
+============
+*/
+idStr idAASLocal::RoutingCacheFileName( void ) const {
+	return idStr( "generated/" ) + file->GetName() + ".rcache";
+}
+
+/*
+============
+idAASLocal::ReadRoutingCache
+
+  Returns true if the whole routing cache file was loaded.
+============
+*/
+bool idAASLocal::ReadRoutingCache( void ) {
+	int i, j, ident, version, crc, stateCrc, numCaches, type, clusterNum, areaNum, travelFlags, size;
+	unsigned short startTravelTime;
+	idRoutingCache *cache, **first;
+	idFile *f;
+	bool ok;
+
+	f = fileSystem->OpenFileRead( RoutingCacheFileName() );
+	if ( !f ) {
+		return false;
+	}
+
+	f->ReadInt( ident );
+	f->ReadInt( version );
+	f->ReadInt( crc );
+	f->ReadInt( stateCrc );
+	f->ReadInt( numCaches );
+	if ( ident != ROUTINGCACHE_IDENT || version != ROUTINGCACHE_VERSION ||
+			(unsigned int) crc != file->GetCRC() || (unsigned int) stateCrc != RoutingStateChecksum() ) {
+		fileSystem->CloseFile( f );
+		return false;
+	}
+
+	ok = true;
+	for ( i = 0; i < numCaches; i++ ) {
+		f->ReadInt( type );
+		f->ReadInt( clusterNum );
+		f->ReadInt( areaNum );
+		f->ReadInt( travelFlags );
+		f->ReadInt( size );
+		f->ReadUnsignedShort( startTravelTime );
+
+		if ( areaNum <= 0 || areaNum >= file->GetNumAreas() || clusterNum <= 0 || clusterNum >= file->GetNumClusters() ) {
+			ok = false;
+			break;
+		}
+		if ( type == CACHETYPE_AREA ) {
+			j = ClusterAreaNum( clusterNum, areaNum );
+			if ( size != file->GetCluster( clusterNum ).numReachableAreas || j >= size ) {
+				ok = false;
+				break;
+			}
+			first = &areaCacheIndex[clusterNum][j];
+		} else if ( type == CACHETYPE_PORTAL ) {
+			if ( size != file->GetNumPortals() ) {
+				ok = false;
+				break;
+			}
+			first = &portalCacheIndex[areaNum];
+		} else {
+			ok = false;
+			break;
+		}
+
+		cache = new idRoutingCache( size );
+		cache->type = type;
+		cache->cluster = clusterNum;
+		cache->areaNum = areaNum;
+		cache->startTravelTime = startTravelTime;
+		cache->travelFlags = travelFlags;
+		cache->precomputed = true;
+		if ( f->Read( cache->reachabilities, size ) != size ||
+				f->Read( cache->travelTimes, size * sizeof( cache->travelTimes[0] ) ) != size * (int)sizeof( cache->travelTimes[0] ) ) {
+			delete cache;
+			ok = false;
+			break;
+		}
+		for ( j = 0; j < size; j++ ) {
+			cache->travelTimes[j] = LittleShort( cache->travelTimes[j] );
+		}
+
+		cache->prev = NULL;
+		cache->next = *first;
+		if ( cache->next ) {
+			cache->next->prev = cache;
+		}
+		*first = cache;
+		precomputedCacheMemory += cache->Size();
+	}
+
+	fileSystem->CloseFile( f );
+
+	if ( !ok ) {
+		gameLocal.Warning( "%s: bad routing cache %d, computing the remaining cache", RoutingCacheFileName().c_str(), i );
+	}
+	return ok;
+}
+
+/*
+============
+idAASLocal::WriteRoutingCache
+============
+*/
+void idAASLocal::WriteRoutingCache( void ) const {
+	int i, j, k, numCaches;
+	idRoutingCache *cache;
+	idList<idRoutingCache *> caches;
+	idList<unsigned short> travelTimes;
+	idFile *f;
+
+	for ( i = 0; i < file->GetNumClusters(); i++ ) {
+		for ( j = 0; j < file->GetCluster( i ).numReachableAreas; j++ ) {
+			for ( cache = areaCacheIndex[i][j]; cache; cache = cache->next ) {
+				if ( cache->precomputed ) {
+					caches.Append( cache );
+				}
+			}
+		}
+	}
+	for ( i = 0; i < file->GetNumAreas(); i++ ) {
+		for ( cache = portalCacheIndex[i]; cache; cache = cache->next ) {
+			if ( cache->precomputed ) {
+				caches.Append( cache );
+			}
+		}
+	}
+
+	f = fileSystem->OpenFileWrite( RoutingCacheFileName() );
+	if ( !f ) {
+		gameLocal.Warning( "couldn't write %s", RoutingCacheFileName().c_str() );
+		return;
+	}
+
+	numCaches = caches.Num();
+	f->WriteInt( ROUTINGCACHE_IDENT );
+	f->WriteInt( ROUTINGCACHE_VERSION );
+	f->WriteInt( (int) file->GetCRC() );
+	f->WriteInt( (int) RoutingStateChecksum() );
+	f->WriteInt( numCaches );
+
+	for ( i = 0; i < numCaches; i++ ) {
+		cache = caches[i];
+		f->WriteInt( cache->type );
+		f->WriteInt( cache->cluster );
+		f->WriteInt( cache->areaNum );
+		f->WriteInt( cache->travelFlags );
+		f->WriteInt( cache->size );
+		f->WriteUnsignedShort( cache->startTravelTime );
+		f->Write( cache->reachabilities, cache->size );
+		travelTimes.SetNum( cache->size, false );
+		for ( k = 0; k < cache->size; k++ ) {
+			travelTimes[k] = LittleShort( cache->travelTimes[k] );
+		}
+		f->Write( travelTimes.Ptr(), cache->size * sizeof( travelTimes[0] ) );
+	}
+
+	fileSystem->CloseFile( f );
+
+	gameLocal.Printf( "wrote %d routing caches to %s\n", numCaches, RoutingCacheFileName().c_str() );
+}
+
+/*
+============
+idAASLocal::PrecomputeRoutingCache
+
+  Builds the area and portal routing cache up front for the travel flags that fit
+  in the memory budget. The cache is calculated with the area states at the time
+  of the call and the cache of the clusters touched by a later area state change
+  is rebuilt on demand as before.
+============
+*/
+void idAASLocal::PrecomputeRoutingCache( void ) {
+	int areaTravelFlags[NUM_PRECOMPUTE_TRAVEL_FLAGS], portalTravelFlags[NUM_PRECOMPUTE_TRAVEL_FLAGS];
+	int numAreaFlags, numPortalFlags, numThreads, numBuilt;
+	idParallelJobList jobList;
+	idTimer timer;
+
+	if ( !file || !aas_precomputeRouting.GetBool() ) {
+		return;
+	}
+
+	timer.Start();
+
+	if ( ReadRoutingCache() ) {
+		timer.Stop();
+		gameLocal.Printf( "%s: loaded %d KB routing cache in %1.0f ms\n", file->GetName(), precomputedCacheMemory >> 10, timer.Milliseconds() );
+		return;
+	}
+
+	SelectPrecomputeTravelFlags( areaTravelFlags, numAreaFlags, portalTravelFlags, numPortalFlags );
+
+	numThreads = idMath::ClampInt( 0, MAX_PRECOMPUTE_THREADS, idParallelJobList::NumHardwareThreads() - 1 );
+	jobList.Init( numThreads );
+
+	numBuilt = PrecomputeAreaRoutingCache( jobList, areaTravelFlags, numAreaFlags );
+	numBuilt += PrecomputePortalRoutingCache( jobList, portalTravelFlags, numPortalFlags );
+
+	jobList.Shutdown();
+
+	timer.Stop();
+
+	gameLocal.Printf( "%s: precomputed %d routing caches (%d KB, %d area and %d portal travel flags) on %d threads in %1.0f ms\n",
+						file->GetName(), numBuilt, precomputedCacheMemory >> 10, numAreaFlags, numPortalFlags, numThreads + 1, timer.Milliseconds() );
+
+	if ( aas_writeRoutingCache.GetBool() ) {
+		WriteRoutingCache();
+	}
+}
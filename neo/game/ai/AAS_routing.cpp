@@ -35,7 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 #define CACHETYPE_AREA				1
 #define CACHETYPE_PORTAL			2
 
-#define MAX_ROUTING_CACHE_MEMORY	(2*1024*1024)
+#define EVICTION_CANDIDATES			8		// number of oldest cache considered for eviction
 
 #define LEDGE_TRAVELTIME_PANALTY	250
 
@@ -51,6 +51,8 @@ idRoutingCache::idRoutingCache( int size ) {
 	time_next = time_prev = NULL;
 	travelFlags = 0;
 	startTravelTime = 0;
+	precomputed = false;
+	buildTime = 0.0f;
 	type = 0;
 	this->size = size;
 	reachabilities = new byte[size];
@@ -212,6 +214,12 @@ void idAASLocal::SetupRoutingCache( void ) {
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+	areaCacheMemory = 0;
+	portalCacheMemory = 0;
+	precomputedCacheMemory = 0;
+
+	clusterCacheStats = (routingCacheStats_t *) Mem_Alloc( file->GetNumClusters() * sizeof( routingCacheStats_t ) );
+	ResetRoutingCacheStats();
 }
 
 /*
@@ -276,9 +284,14 @@ void idAASLocal::ShutdownRoutingCache( void ) {
 	portalUpdate = NULL;
 	Mem_Free( goalAreaTravelTimes );
 	goalAreaTravelTimes = NULL;
+	Mem_Free( clusterCacheStats );
+	clusterCacheStats = NULL;
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+	areaCacheMemory = 0;
+	portalCacheMemory = 0;
+	precomputedCacheMemory = 0;
 }
 
 /*
@@ -327,9 +340,117 @@ void idAASLocal::RoutingStats( void ) const {
 	gameLocal.Printf( "%6d area cache (%d KB)\n", numAreaCache, totalAreaCacheMemory >> 10 );
 	gameLocal.Printf( "%6d portal cache (%d KB)\n", numPortalCache, totalPortalCacheMemory >> 10 );
 	gameLocal.Printf( "%6d total cache (%d KB)\n", numAreaCache + numPortalCache, totalCacheMemory >> 10 );
+	gameLocal.Printf( "       precomputed cache (%d KB)\n", precomputedCacheMemory >> 10 );
 	gameLocal.Printf( "%6d area travel times (%zd KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%zd KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%zd KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
+	gameLocal.Printf( "%6d routing caches built on demand\n", numCacheBuilds );
+	if ( numRouteHitches ) {
+		gameLocal.Printf( "%6d routes building cache (%1.2f ms average, %1.2f ms max)\n", numRouteHitches, routeHitchTime / numRouteHitches, maxRouteHitchTime );
+	}
+}
+
+/*
+============
+idAASLocal::ResetRoutingCacheStats
+============
+*/
+void idAASLocal::ResetRoutingCacheStats( void ) {
+	int i;
+
+	if ( !clusterCacheStats ) {
+		return;
+	}
+
+	memset( clusterCacheStats, 0, file->GetNumClusters() * sizeof( routingCacheStats_t ) );
+	for ( i = 0; i < file->GetNumClusters(); i++ ) {
+		clusterCacheStats[i].cluster = i;
+	}
+
+	numCacheBuilds = 0;
+	numRouteHitches = 0;
+	routeHitchTime = 0.0f;
+	maxRouteHitchTime = 0.0f;
+}
+
+/*
+============
+SortClusterCacheStats
+
+  Sorts the clusters with the most time spent building cache first.
+============
+*/
+static int SortClusterCacheStats( const routingCacheStats_t *a, const routingCacheStats_t *b ) {
+	float ta, tb;
+
+	ta = a->areaBuildTime + a->portalBuildTime;
+	tb = b->areaBuildTime + b->portalBuildTime;
+	if ( ta > tb ) {
+		return -1;
+	}
+	if ( ta < tb ) {
+		return 1;
+	}
+	return a->cluster - b->cluster;
+}
+
+/*
+============
+idAASLocal::RoutingCacheReport
+
+  Portal build times include the time spent building the area cache the portal cache needed.
+============
+*/
+void idAASLocal::RoutingCacheReport( bool all ) const {
+	int i, numShown, hits, misses;
+	float buildTime;
+	routingCacheStats_t total;
+	idList<routingCacheStats_t> stats;
+
+	if ( !file ) {
+		return;
+	}
+
+	memset( &total, 0, sizeof( total ) );
+	for ( i = 1; i < file->GetNumClusters(); i++ ) {
+		const routingCacheStats_t &s = clusterCacheStats[i];
+		total.areaHits += s.areaHits;
+		total.areaMisses += s.areaMisses;
+		total.areaBuildTime += s.areaBuildTime;
+		total.portalHits += s.portalHits;
+		total.portalMisses += s.portalMisses;
+		total.portalBuildTime += s.portalBuildTime;
+		total.evictions += s.evictions;
+		if ( all || s.areaMisses || s.portalMisses || s.evictions ) {
+			stats.Append( s );
+		}
+	}
+	stats.Sort( SortClusterCacheStats );
+
+	hits = total.areaHits + total.portalHits;
+	misses = total.areaMisses + total.portalMisses;
+	buildTime = total.areaBuildTime + total.portalBuildTime;
+
+	gameLocal.Printf( "[%s] routing cache\n", file->GetName() );
+	gameLocal.Printf( "budget %d KB, used %d KB (area %d KB, portal %d KB), precomputed %d KB\n",
+						aas_routingCacheMemory.GetInteger(), totalCacheMemory >> 10, areaCacheMemory >> 10, portalCacheMemory >> 10, precomputedCacheMemory >> 10 );
+	gameLocal.Printf( "%d hits, %d misses (%1.1f%% hit), %d evictions, %1.2f ms building, %1.3f ms per build\n",
+						hits, misses, hits + misses ? 100.0f * hits / ( hits + misses ) : 0.0f, total.evictions, buildTime, misses ? buildTime / misses : 0.0f );
+
+	if ( !stats.Num() ) {
+		return;
+	}
+
+	gameLocal.Printf( "cluster areas |  area hit  miss       ms | portal hit  miss       ms | evict\n" );
+	numShown = all ? stats.Num() : Min( stats.Num(), 20 );
+	for ( i = 0; i < numShown; i++ ) {
+		const routingCacheStats_t &s = stats[i];
+		gameLocal.Printf( "%7d %5d | %9d %5d %8.2f | %10d %5d %8.2f | %5d\n", s.cluster, file->GetCluster( s.cluster ).numReachableAreas,
+							s.areaHits, s.areaMisses, s.areaBuildTime, s.portalHits, s.portalMisses, s.portalBuildTime, s.evictions );
+	}
+	if ( numShown < stats.Num() ) {
+		gameLocal.Printf( "%d more clusters, use 'aasCacheStats all' to list them\n", stats.Num() - numShown );
+	}
 }
 
 /*
@@ -596,12 +717,22 @@ idAASLocal::LinkCache
 */
 void idAASLocal::LinkCache( idRoutingCache *cache ) const {
 
+	// precomputed cache is never deleted because it is old
+	if ( cache->precomputed ) {
+		return;
+	}
+
 	// if the cache is already linked
 	if ( cache->time_next || cache->time_prev || cacheListStart == cache ) {
 		UnlinkCache( cache );
 	}
 
 	totalCacheMemory += cache->Size();
+	if ( cache->type == CACHETYPE_AREA ) {
+		areaCacheMemory += cache->Size();
+	} else {
+		portalCacheMemory += cache->Size();
+	}
 
 	// add cache to the end of the list
 	cache->time_next = NULL;
@@ -622,7 +753,17 @@ idAASLocal::UnlinkCache
 */
 void idAASLocal::UnlinkCache( idRoutingCache *cache ) const {
 
+	if ( cache->precomputed ) {
+		precomputedCacheMemory -= cache->Size();
+		return;
+	}
+
 	totalCacheMemory -= cache->Size();
+	if ( cache->type == CACHETYPE_AREA ) {
+		areaCacheMemory -= cache->Size();
+	} else {
+		portalCacheMemory -= cache->Size();
+	}
 
 	// unlink the cache
 	if ( cache->time_next ) {
@@ -640,16 +781,27 @@ void idAASLocal::UnlinkCache( idRoutingCache *cache ) const {
 
 /*
 ============
-idAASLocal::DeleteOldestCache
+idAASLocal::EvictCache
+
+  Deletes the cache that was quickest to build from the oldest cache in the time based list.
 ============
 */
-void idAASLocal::DeleteOldestCache( void ) const {
-	idRoutingCache *cache;
+void idAASLocal::EvictCache( void ) const {
+	int i;
+	idRoutingCache *cache, *c;
 
 	assert( cacheListStart );
 
-	// unlink the oldest cache
 	cache = cacheListStart;
+	for ( i = 1, c = cache->time_next; i < EVICTION_CANDIDATES && c; i++, c = c->time_next ) {
+		if ( c->buildTime < cache->buildTime ) {
+			cache = c;
+		}
+	}
+
+	clusterCacheStats[cache->cluster].evictions++;
+
+	// unlink the cache
 	UnlinkCache( cache );
 
 	// unlink the oldest cache from the area or portal cache index
@@ -708,7 +860,7 @@ ID_INLINE int idAASLocal::ClusterAreaNum( int clusterNum, int areaNum ) const {
 idAASLocal::UpdateAreaRoutingCache
 ============
 */
-void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
+void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingUpdate *update ) const {
 	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
 	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
 	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
@@ -729,7 +881,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
 
 	// initialize first update
-	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate = &update[clusterAreaNum];
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
 	curUpdate->tmpTravelTime = areaCache->startTravelTime;
@@ -791,7 +943,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 
 				areaCache->travelTimes[clusterAreaNum] = t;
 				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				nextUpdate = &areaUpdate[clusterAreaNum];
+				nextUpdate = &update[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -821,6 +973,23 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 	}
 }
 
+/*
+============
+idAASLocal::FindAreaRoutingCache
+============
+*/
+idRoutingCache *idAASLocal::FindAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const {
+	idRoutingCache *cache;
+
+	// check if cache without undesired travel flags already exists
+	for ( cache = areaCacheIndex[clusterNum][ClusterAreaNum( clusterNum, areaNum )]; cache; cache = cache->next ) {
+		if ( cache->travelFlags == travelFlags ) {
+			break;
+		}
+	}
+	return cache;
+}
+
 /*
 ============
 idAASLocal::GetAreaRoutingCache
@@ -835,13 +1004,11 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 	// pointer to the cache for the area in the cluster
 	clusterCache = areaCacheIndex[clusterNum][clusterAreaNum];
 	// check if cache without undesired travel flags already exists
-	for ( cache = clusterCache; cache; cache = cache->next ) {
-		if ( cache->travelFlags == travelFlags ) {
-			break;
-		}
-	}
+	cache = FindAreaRoutingCache( clusterNum, areaNum, travelFlags );
 	// if no cache found
 	if ( !cache ) {
+		idTimer timer;
+		timer.Start();
 		cache = new idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
 		cache->type = CACHETYPE_AREA;
 		cache->cluster = clusterNum;
@@ -854,7 +1021,14 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 			clusterCache->prev = cache;
 		}
 		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache( cache );
+		UpdateAreaRoutingCache( cache, areaUpdate );
+		timer.Stop();
+		cache->buildTime = timer.Milliseconds();
+		clusterCacheStats[clusterNum].areaMisses++;
+		clusterCacheStats[clusterNum].areaBuildTime += cache->buildTime;
+		numCacheBuilds++;
+	} else {
+		clusterCacheStats[clusterNum].areaHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -863,9 +1037,11 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 /*
 ============
 idAASLocal::UpdatePortalRoutingCache
+
+  When precomputing only the existing area cache is used and false is returned if any is missing.
 ============
 */
-void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
+bool idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache, idRoutingUpdate *update, bool precomputed ) const {
 	int i, portalNum, clusterAreaNum;
 	unsigned short t;
 	const aasPortal_t *portal;
@@ -873,7 +1049,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 	idRoutingCache *cache;
 	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
 
-	curUpdate = &portalUpdate[ file->GetNumPortals() ];
+	curUpdate = &update[ file->GetNumPortals() ];
 	curUpdate->cluster = portalCache->cluster;
 	curUpdate->areaNum = portalCache->areaNum;
 	curUpdate->tmpTravelTime = portalCache->startTravelTime;
@@ -900,7 +1076,14 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 		curUpdate->isInList = false;
 
 		cluster = &file->GetCluster( curUpdate->cluster );
-		cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+		if ( precomputed ) {
+			cache = FindAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+			if ( !cache ) {
+				return false;
+			}
+		} else {
+			cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+		}
 
 		// take all portals of the cluster
 		for ( i = 0; i < cluster->numPortals; i++ ) {
@@ -923,7 +1106,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 
 				portalCache->travelTimes[portalNum] = t;
 				portalCache->reachabilities[portalNum] = cache->reachabilities[clusterAreaNum];
-				nextUpdate = &portalUpdate[portalNum];
+				nextUpdate = &update[portalNum];
 				if ( portal->clusters[0] == curUpdate->cluster ) {
 					nextUpdate->cluster = portal->clusters[1];
 				}
@@ -950,6 +1133,8 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 			}
 		}
 	}
+
+	return true;
 }
 
 /*
@@ -968,6 +1153,8 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 	}
 	// if no cache found
 	if ( !cache ) {
+		idTimer timer;
+		timer.Start();
 		cache = new idRoutingCache( file->GetNumPortals() );
 		cache->type = CACHETYPE_PORTAL;
 		cache->cluster = clusterNum;
@@ -980,7 +1167,14 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 			portalCacheIndex[areaNum]->prev = cache;
 		}
 		portalCacheIndex[areaNum] = cache;
-		UpdatePortalRoutingCache( cache );
+		UpdatePortalRoutingCache( cache, portalUpdate, false );
+		timer.Stop();
+		cache->buildTime = timer.Milliseconds();
+		clusterCacheStats[clusterNum].portalMisses++;
+		clusterCacheStats[clusterNum].portalBuildTime += cache->buildTime;
+		numCacheBuilds++;
+	} else {
+		clusterCacheStats[clusterNum].portalHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -989,9 +1183,48 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 /*
 ============
 idAASLocal::RouteToGoalArea
+
+  Measures the routes that have to build routing cache when aas_showRouteHitches is set.
 ============
 */
 bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const {
+	idTimer timer;
+	int numBuilds;
+	float ms;
+	bool result;
+
+	if ( aas_showRouteHitches.GetFloat() <= 0.0f ) {
+		return FindRouteToGoalArea( areaNum, origin, goalAreaNum, travelFlags, travelTime, reach );
+	}
+
+	numBuilds = numCacheBuilds;
+
+	timer.Start();
+	result = FindRouteToGoalArea( areaNum, origin, goalAreaNum, travelFlags, travelTime, reach );
+	timer.Stop();
+
+	if ( numCacheBuilds != numBuilds ) {
+		ms = timer.Milliseconds();
+		numRouteHitches++;
+		routeHitchTime += ms;
+		if ( ms > maxRouteHitchTime ) {
+			maxRouteHitchTime = ms;
+		}
+		if ( ms >= aas_showRouteHitches.GetFloat() ) {
+			gameLocal.Printf( "%s: route from area %d to area %d built %d routing caches in %1.2f ms\n",
+								file->GetName(), areaNum, goalAreaNum, numCacheBuilds - numBuilds, ms );
+		}
+	}
+
+	return result;
+}
+
+/*
+============
+idAASLocal::FindRouteToGoalArea
+============
+*/
+bool idAASLocal::FindRouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const {
 	int clusterNum, goalClusterNum, portalNum, i, clusterAreaNum;
 	unsigned short int t, bestTime;
 	const aasPortal_t *portal;
@@ -1019,8 +1252,8 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		return false;
 	}
 
-	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY ) {
-		DeleteOldestCache();
+	while( totalCacheMemory > ( aas_routingCacheMemory.GetInteger() << 10 ) && cacheListStart ) {
+		EvictCache();
 	}
 
 	clusterNum = file->GetArea( areaNum ).cluster;
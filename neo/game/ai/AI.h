@@ -105,8 +105,23 @@ typedef enum {
 	MOVE_STATUS_BLOCKED_BY_MONSTER
 } moveStatus_t;
 
+// result of a path query that may have to wait for the frame budget
+typedef enum {
+	PATHQUERY_UNREACHABLE,
+	PATHQUERY_REACHABLE,
+	PATHQUERY_PENDING
+} pathQueryResult_t;
+
 #define	DI_NODIR	-1
 
+// think level of detail
+typedef enum {
+	AI_LOD_FULL,			// in combat or close to the player, everything runs every frame
+	AI_LOD_NEAR,			// in the player PVS but far away
+	AI_LOD_FAR,				// outside the player PVS
+	AI_LOD_NUM_LEVELS
+} aiThinkLOD_t;
+
 // obstacle avoidance
 typedef struct obstaclePath_s {
 	idVec3				seekPos;					// seek position avoiding obstacles
@@ -256,8 +271,15 @@ public:
 
 	void					TouchedByFlashlight( idActor *flashlight_owner );
 
+							// Returns true while a move waits in the path queue.
+	bool					IsWaitingForPath( void ) const;
+							// Starts the move that waited in the path queue.
+	void					ResumePathQuery( void );
+
 							// Outputs a list of all monsters to the console.
 	static void				List_f( const idCmdArgs &args );
+							// Prints the AI think cost of the last frame per level of detail.
+	static void				UpdateLODStatistics( void );
 
 							// Finds a path around dynamic obstacles.
 	static bool				FindPathAroundObstacles( const idPhysics *physics, const idAAS *aas, const idEntity *ignore, const idVec3 &startPos, const idVec3 &seekPos, obstaclePath_t &path );
@@ -278,6 +300,26 @@ protected:
 	idMoveState				move;
 	idMoveState				savedMove;
 
+	// think level of detail
+	aiThinkLOD_t			thinkLOD;
+	bool					lodSenseFrame;			// the script and senses run this frame
+	int						lodAnimTime;			// time the frame commands were serviced up to
+	bool					lodAvoidValid;			// last obstacle avoidance found a free path
+	idVec3					lodAvoidGoal;
+	idVec3					lodAvoidSeekPos;
+
+	static int				lodThinkCount[ AI_LOD_NUM_LEVELS ];
+	static float			lodThinkTime[ AI_LOD_NUM_LEVELS ];
+	static int				lodDormantCount;
+
+	// move waiting in the path queue
+	bool					pathQueryPending;
+	moveCommand_t			pathQueryCommand;
+	idEntityPtr<idEntity>	pathQueryEntity;
+	idVec3					pathQueryPos;
+	float					pathQueryRange;
+	int						pathQueryAnim;
+
 	float					kickForce;
 	bool					ignore_obstacles;
 	float					blockedRadius;
@@ -459,10 +501,15 @@ protected:
 	float					TravelDistance( const idVec3 &start, const idVec3 &end ) const;
 	int						PointReachableAreaNum( const idVec3 &pos, const float boundsScale = 2.0f ) const;
 	bool					PathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin ) const;
+	pathQueryResult_t		QueryPathToGoal( int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, bool canWait ) const;
+	bool					FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 &origin, const idVec3 &target, aasObstacle_t *obstacles, int numObstacles, idAASCallback &callback ) const;
+	bool					WaitForPath( moveCommand_t command, idEntity *ent, const idVec3 &pos, float range, int anim );
 	void					DrawRoute( void ) const;
 	bool					GetMovePos( idVec3 &seekPos );
 	bool					MoveDone( void ) const;
 	bool					EntityCanSeePos( idActor *actor, const idVec3 &actorOrigin, const idVec3 &pos );
+	bool					InCombat( void ) const;
+	void					UpdateThinkLOD( void );
 	void					BlockedFailSafe( void );
 
 	// movement control
@@ -688,4 +735,13 @@ private:
 	void				Event_MarkUsed( void );
 };
 
+/*
+=====================
+idAI::IsWaitingForPath
+=====================
+*/
+ID_INLINE bool idAI::IsWaitingForPath( void ) const {
+	return pathQueryPending;
+}
+
 #endif /* !__AI_H__ */
@@ -0,0 +1,204 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "../Game_local.h"
+
+#define REACHABLE_CACHE_MSEC		500			// time the reachability of a goal area is reused
+#define MAX_REACHABLE_CACHE			1024
+
+/*
+================
+idAIPathQueue::idAIPathQueue
+================
+*/
+idAIPathQueue::idAIPathQueue( void ) {
+	resuming = NULL;
+	searchTime = 0.0f;
+	numSearches = 0;
+	numWaits = 0;
+	numResumed = 0;
+	numCacheHits = 0;
+}
+
+/*
+================
+idAIPathQueue::Clear
+================
+*/
+void idAIPathQueue::Clear( void ) {
+	waiting.Clear();
+	resuming = NULL;
+	searchTime = 0.0f;
+	ClearReachable();
+}
+
+/*
+================
+idAIPathQueue::RunFrame
+================
+*/
+void idAIPathQueue::RunFrame( void ) {
+	float budget;
+	idAI *ai;
+
+	if ( ai_showPathQueue.GetBool() && ( numSearches || numWaits || numResumed ) ) {
+		gameLocal.Printf( "%d: path queue %d searches %1.2f ms, %d waited, %d resumed, %d still waiting, %d cache hits\n",
+							gameLocal.framenum, numSearches, searchTime, numWaits, numResumed, waiting.Num(), numCacheHits );
+	}
+
+	searchTime = 0.0f;
+	numSearches = 0;
+	numWaits = 0;
+	numResumed = 0;
+	numCacheHits = 0;
+
+	// start the waiting moves in the order the monsters arrived, at least one each frame
+	budget = ai_pathBudget.GetFloat();
+	while( waiting.Num() && ( !numResumed || budget <= 0.0f || searchTime < budget ) ) {
+		ai = waiting[ 0 ];
+		waiting.RemoveIndex( 0 );
+		if ( !ai->IsWaitingForPath() ) {
+			continue;
+		}
+		resuming = ai;
+		ai->ResumePathQuery();
+		resuming = NULL;
+		numResumed++;
+	}
+}
+
+/*
+================
+idAIPathQueue::Admit
+================
+*/
+bool idAIPathQueue::Admit( const idAI *ai ) const {
+	float budget;
+
+	if ( ai == resuming ) {
+		return true;
+	}
+	budget = ai_pathBudget.GetFloat();
+	return ( budget <= 0.0f || searchTime < budget );
+}
+
+/*
+================
+idAIPathQueue::Wait
+================
+*/
+void idAIPathQueue::Wait( idAI *ai ) {
+	// a monster asking again keeps its place in the queue
+	waiting.AddUnique( ai );
+	numWaits++;
+}
+
+/*
+================
+idAIPathQueue::Remove
+================
+*/
+void idAIPathQueue::Remove( idAI *ai ) {
+	waiting.Remove( ai );
+	if ( resuming == ai ) {
+		resuming = NULL;
+	}
+}
+
+/*
+================
+idAIPathQueue::FindReachable
+================
+*/
+int idAIPathQueue::FindReachable( const idAAS *aas, int areaNum, int goalAreaNum, int travelFlags, bool fly ) const {
+	int i;
+
+	for ( i = reachableHash.First( goalAreaNum ); i != -1; i = reachableHash.Next( i ) ) {
+		const reachableCache_t &r = reachableCache[ i ];
+		if ( r.goalAreaNum == goalAreaNum && r.areaNum == areaNum && r.travelFlags == travelFlags && r.fly == fly && r.aas == aas ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idAIPathQueue::GetReachable
+================
+*/
+bool idAIPathQueue::GetReachable( const idAAS *aas, int areaNum, int goalAreaNum, int travelFlags, bool fly, bool &reachable ) {
+	int i;
+
+	i = FindReachable( aas, areaNum, goalAreaNum, travelFlags, fly );
+	if ( i == -1 || gameLocal.time - reachableCache[ i ].time > REACHABLE_CACHE_MSEC ) {
+		return false;
+	}
+	reachable = reachableCache[ i ].reachable;
+	numCacheHits++;
+	return true;
+}
+
+/*
+================
+idAIPathQueue::SetReachable
+================
+*/
+void idAIPathQueue::SetReachable( const idAAS *aas, int areaNum, int goalAreaNum, int travelFlags, bool fly, bool reachable ) {
+	int i;
+
+	i = FindReachable( aas, areaNum, goalAreaNum, travelFlags, fly );
+	if ( i == -1 ) {
+		if ( reachableCache.Num() >= MAX_REACHABLE_CACHE ) {
+			ClearReachable();
+		}
+		i = reachableCache.Num();
+		reachableCache_t &r = reachableCache.Alloc();
+		r.aas = aas;
+		r.areaNum = areaNum;
+		r.goalAreaNum = goalAreaNum;
+		r.travelFlags = travelFlags;
+		r.fly = fly;
+		reachableHash.Add( goalAreaNum, i );
+	}
+	reachableCache[ i ].time = gameLocal.time;
+	reachableCache[ i ].reachable = reachable;
+}
+
+/*
+================
+idAIPathQueue::ClearReachable
+================
+*/
+void idAIPathQueue::ClearReachable( void ) {
+	reachableCache.SetNum( 0, false );
+	reachableHash.Clear();
+}
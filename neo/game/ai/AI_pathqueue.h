@@ -0,0 +1,102 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __AI_PATHQUEUE_H__
+#define __AI_PATHQUEUE_H__
+
+/*
+===============================================================================
+
+  AI path queue.
+
+  Caps the time the AI spends on path and goal searches each game frame. A
+  monster that starts a move after the frame budget is spent waits in the queue
+  with MOVE_STATUS_WAITING, and the move is started on a later frame in the order
+  the monsters arrived. Whether a goal area can be reached from an area is cached
+  per goal area for a short while, so monsters chasing the same goal share the
+  search.
+
+===============================================================================
+*/
+
+class idAI;
+
+class idAIPathQueue {
+public:
+							idAIPathQueue( void );
+
+	void					Clear( void );
+							// reset the frame budget and start the moves that waited for it
+	void					RunFrame( void );
+
+							// returns true if the monster may start a search now
+	bool					Admit( const idAI *ai ) const;
+							// queue the monster until the next frame with budget left
+	void					Wait( idAI *ai );
+	void					Remove( idAI *ai );
+	void					AddSearchTime( float ms );
+
+							// returns true if the reachability is cached, fly is set for flying monsters
+	bool					GetReachable( const idAAS *aas, int areaNum, int goalAreaNum, int travelFlags, bool fly, bool &reachable );
+	void					SetReachable( const idAAS *aas, int areaNum, int goalAreaNum, int travelFlags, bool fly, bool reachable );
+							// forget all reachability, called when an area state changes
+	void					ClearReachable( void );
+
+private:
+	typedef struct reachableCache_s {
+		const idAAS *		aas;
+		int					areaNum;
+		int					goalAreaNum;
+		int					travelFlags;
+		bool				fly;				// flying monsters search with FlyPathToGoal
+		int					time;
+		bool				reachable;
+	} reachableCache_t;
+
+	idList<idAI *>			waiting;			// monsters waiting for budget in the order they arrived
+	idAI *					resuming;			// monster currently started from the queue
+	float					searchTime;			// milliseconds spent searching this frame
+
+	idList<reachableCache_t> reachableCache;
+	idHashIndex				reachableHash;		// reachability hashed on the goal area
+
+							// statistics
+	int						numSearches;
+	int						numWaits;
+	int						numResumed;
+	int						numCacheHits;
+
+	int						FindReachable( const idAAS *aas, int areaNum, int goalAreaNum, int travelFlags, bool fly ) const;
+};
+
+ID_INLINE void idAIPathQueue::AddSearchTime( float ms ) {
+	searchTime += ms;
+	numSearches++;
+}
+
+#endif /* !__AI_PATHQUEUE_H__ */
@@ -232,6 +232,19 @@ private:
 	idVec3					totaldelta;
 	mutable int				ref_count;
 
+							// quantized frames, used instead of componentFrames when compressed
+	bool					compressed;
+	int						numSourceComponents;	// animated components before constant tracks were folded into baseFrame
+	float					compressionError;		// largest absolute error of a quantized component
+	idList<unsigned short>	quantizedFrames;
+	idList<float>			componentScale;
+	idList<float>			componentBias;
+
+	const float *			GetFrameComponents( int framenum, int firstComponent, int numComponents, float *decoded ) const;
+	idStr					BinaryName( void ) const;
+	bool					LoadBinary( int sourceLength, ID_TIME_T sourceTime );
+	void					WriteBinary( int sourceLength, ID_TIME_T sourceTime ) const;
+
 public:
 							idMD5Anim();
 							~idMD5Anim();
@@ -241,6 +254,10 @@ public:
 	size_t					Allocated( void ) const;
 	size_t					Size( void ) const { return sizeof( *this ) + Allocated(); };
 	bool					LoadAnim( const char *filename );
+	bool					Compress( float maxError );
+	bool					IsCompressed( void ) const { return compressed; }
+	size_t					SavedByCompression( void ) const;
+	float					CompressionError( void ) const { return compressionError; }
 
 	void					IncreaseRefs( void ) const;
 	void					DecreaseRefs( void ) const;
@@ -375,6 +392,19 @@ private:
 ==============================================================================================
 */
 
+// everything idAnimBlend::BlendAnim depends on at a given time, compared between frames
+// to tell whether a channel's blended pose has changed
+typedef struct animBlendKey_s {
+	int							animNum;
+	int							frame;
+	int							cycle;
+	int							animTime;
+	float						weight;
+	float						animWeights[ ANIM_MaxSyncedAnims ];
+	bool						active;
+	bool						allowMove;
+} animBlendKey_t;
+
 class idAnimBlend {
 private:
 	const class idDeclModelDef	*modelDef;
@@ -403,6 +433,7 @@ private:
 	void						CycleAnim( const idDeclModelDef *modelDef, int animnum, int currenttime, int blendtime );
 	void						PlayAnim( const idDeclModelDef *modelDef, int animnum, int currenttime, int blendtime );
 	bool						BlendAnim( int currentTime, int channel, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOrigin, bool overrideBlend, bool printInfo ) const;
+	void						GetBlendKey( int currentTime, animBlendKey_t &key ) const;
 	void						BlendOrigin( int currentTime, idVec3 &blendPos, float &blendWeight, bool removeOriginOffset ) const;
 	void						BlendDelta( int fromtime, int totime, idVec3 &blendDelta, float &blendWeight ) const;
 	void						BlendDeltaRotation( int fromtime, int totime, idQuat &blendDelta, float &blendWeight ) const;
@@ -515,6 +546,10 @@ public:
 	void						ForceUpdate( void );
 	void						ClearForceUpdate( void );
 	bool						CreateFrame( int animtime, bool force );
+	bool						CreateFrameAhead( int animtime );
+	bool						TakeFrameCreatedAhead( void );
+	void						AddFrameStatistics( void ) const;
+	static void					UpdateFrameStatistics( void );
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3 &delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3 &delta ) const;
@@ -562,6 +597,13 @@ public:
 private:
 	void						FreeData( void );
 	void						PushAnims( int channel, int currentTime, int blendTime );
+	bool						BuildFrame( int currentTime, bool force );
+	bool						TimedBuildFrame( int currentTime, bool force );
+	bool						BlendChannel( int channelNum, int currentTime, idJointQuat *blendFrame, float &blendWeight, bool overrideBlend, bool debugInfo ) const;
+	bool						BlendCachedPose( int currentTime, const idJointQuat *defaultPose, idJointQuat *jointFrame, bool *jointDirty );
+
+	static void					ModifyRootJoint( idJointMat &joint, const jointMod_t *jointMod );
+	static void					ModifyJoint( idJointMat &joint, const idJointMat &parent, const jointMod_t *jointMod );
 
 private:
 	const idDeclModelDef *		modelDef;
@@ -585,6 +627,27 @@ private:
 	idList<idJointQuat>			AFPoseJointFrame;
 	idBounds					AFPoseBounds;
 	int							AFPoseTime;
+
+								// local pose cache, lets CreateFrame reblend and retransform only the
+								// channels and sub-trees that changed since the last frame
+	bool						poseCacheValid;
+	float						poseBaseBlend;
+	bool						poseHasAnim[ ANIM_NumAnimChannels ];
+	animBlendKey_t				poseKeys[ ANIM_NumAnimChannels ][ ANIM_MaxAnimsPerChannel ];
+	idList<idJointQuat>			poseAllChannel;			// local pose after blending the all channel
+	idList<idJointQuat>			poseLocal;				// local pose after blending every channel
+	idList<jointMod_t>			poseJointMods;			// joint modifiers applied to the cached pose
+
+	bool						frameCreatedAhead;		// frame created by the animation stage that the renderer didn't pick up yet
+	bool						lastFramePartial;		// statistics of the last frame created
+	int							lastJointsTransformed;
+	float						lastFrameTime;
+
+	static int					frameCount;
+	static float				frameTime;
+	static int					framePartialCount;
+	static int					frameJointsTransformed;
+	static int					frameJointsTotal;
 };
 
 /*
@@ -606,6 +669,8 @@ public:
 	idMD5Anim *					GetAnim( const char *name );
 	void						ReloadAnims( void );
 	void						ListAnims( void ) const;
+	void						TestCompression( int numLoops ) const;
+	void						TestBinaryLoad( const char *filter ) const;
 	int							JointIndex( const char *name );
 	const char *				JointName( int index ) const;
 
@@ -618,4 +683,44 @@ private:
 	idHashIndex					jointnamesHash;
 };
 
+/*
+==============================================================================================
+
+	idAnimationStage
+
+	Creates the frames of the animated entities in the player PVS on the job threads once
+	all entities thought, so the render callbacks only have to pick up the joints. A job
+	only touches its own animator and the anims are read-only, so the joints come out the
+	same as when the callbacks create the frames.
+
+==============================================================================================
+*/
+
+class idAnimationStage {
+public:
+								idAnimationStage( void );
+								~idAnimationStage( void );
+
+	void						Init( void );
+	void						Shutdown( void );
+
+								// create the frames of the active entities in view
+	void						Run( idLinkList<idEntity> &activeEntities );
+
+private:
+	typedef struct animationJob_s {
+		idAnimator *			animator;
+		int						time;
+		bool					created;
+	} animationJob_t;
+
+	idParallelJobList			jobList;
+	int							numThreads;				// number of job threads requested
+	idList<animationJob_t>		jobs;
+
+	void						UpdateThreads( void );
+
+	static void					CreateFrameJob( void *data );
+};
+
 #endif /* !__ANIM_H__ */
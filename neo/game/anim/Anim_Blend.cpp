@@ -1849,6 +1849,36 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 	return true;
 }
 
+/*
+=====================
+idAnimBlend::GetBlendKey
+
+Fills in the values BlendAnim uses at the given time.  Two equal keys blend to the same pose.
+=====================
+*/
+void idAnimBlend::GetBlendKey( int currentTime, animBlendKey_t &key ) const {
+	int i;
+
+	// clear the padding as well so keys can be compared with memcmp
+	memset( &key, 0, sizeof( key ) );
+
+	const idAnim *anim = Anim();
+	if ( !anim ) {
+		return;
+	}
+
+	key.animNum		= animNum;
+	key.frame		= frame;
+	key.cycle		= cycle;
+	key.animTime	= AnimTime( currentTime );
+	key.weight		= GetWeight( currentTime );
+	key.active		= ( endtime < 0 ) || ( currentTime < endtime );
+	key.allowMove	= allowMove;
+	for( i = 0; i < ANIM_MaxSyncedAnims; i++ ) {
+		key.animWeights[ i ] = animWeights[ i ];
+	}
+}
+
 /*
 =====================
 idAnimBlend::BlendOrigin
@@ -2993,6 +3023,12 @@ const idVec3 &idDeclModelDef::GetVisualOffset( void ) const {
 
 ***********************************************************************/
 
+int		idAnimator::frameCount;
+float	idAnimator::frameTime;
+int		idAnimator::framePartialCount;
+int		idAnimator::frameJointsTransformed;
+int		idAnimator::frameJointsTotal;
+
 /*
 =====================
 idAnimator::idAnimator
@@ -3009,6 +3045,12 @@ idAnimator::idAnimator() {
 	stoppedAnimatingUpdate	= false;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
+	poseCacheValid			= false;
+	poseBaseBlend			= 0.0f;
+	frameCreatedAhead		= false;
+	lastFramePartial		= false;
+	lastJointsTransformed	= 0;
+	lastFrameTime			= 0.0f;
 
 	frameBounds.Clear();
 
@@ -3043,6 +3085,7 @@ size_t idAnimator::Allocated( void ) const {
 	size_t	size;
 
 	size = jointMods.Allocated() + numJoints * sizeof( joints[0] ) + jointMods.Num() * sizeof( jointMods[ 0 ] ) + AFPoseJointMods.Allocated() + AFPoseJointFrame.Allocated() + AFPoseJoints.Allocated();
+	size += poseAllChannel.Allocated() + poseLocal.Allocated() + poseJointMods.Allocated();
 
 	return size;
 }
@@ -3197,6 +3240,8 @@ void idAnimator::Restore( idRestoreGame *savefile ) {
 			channels[ i ][ j ].Restore( savefile, modelDef );
 		}
 	}
+
+	poseCacheValid = false;
 }
 
 /*
@@ -3225,6 +3270,12 @@ void idAnimator::FreeData( void ) {
 
 	modelDef = NULL;
 
+	poseCacheValid = false;
+	frameCreatedAhead = false;
+	poseAllChannel.Clear();
+	poseLocal.Clear();
+	poseJointMods.Clear();
+
 	ForceUpdate();
 }
 
@@ -3326,6 +3377,9 @@ idAnimator::RemoveOriginOffset
 =====================
 */
 void idAnimator::RemoveOriginOffset( bool remove ) {
+	if ( remove != removeOriginOffset ) {
+		poseCacheValid = false;
+	}
 	removeOriginOffset = remove;
 }
 
@@ -4167,14 +4221,331 @@ idAnimator::CreateFrame
 =====================
 */
 bool idAnimator::CreateFrame( int currentTime, bool force ) {
+	if ( !TimedBuildFrame( currentTime, force ) ) {
+		return false;
+	}
+
+	AddFrameStatistics();
+	return true;
+}
+
+/*
+=====================
+idAnimator::CreateFrameAhead
+
+Creates the frame before the render callback asks for it.  Only touches this animator,
+so frames of different animators can be created on the job threads at the same time.
+=====================
+*/
+bool idAnimator::CreateFrameAhead( int currentTime ) {
+	if ( !TimedBuildFrame( currentTime, false ) ) {
+		return false;
+	}
+
+	frameCreatedAhead = true;
+	return true;
+}
+
+/*
+=====================
+idAnimator::TakeFrameCreatedAhead
+
+Returns true once for a frame created by CreateFrameAhead, so the render callback
+still reports the new joints to the renderer.
+=====================
+*/
+bool idAnimator::TakeFrameCreatedAhead( void ) {
+	if ( !frameCreatedAhead ) {
+		return false;
+	}
+
+	frameCreatedAhead = false;
+	return true;
+}
+
+/*
+=====================
+idAnimator::TimedBuildFrame
+=====================
+*/
+bool idAnimator::TimedBuildFrame( int currentTime, bool force ) {
+	idTimer	timer;
+	bool	created;
+
+	if ( !g_showAnimPoseCache.GetBool() ) {
+		lastFrameTime = 0.0f;
+		return BuildFrame( currentTime, force );
+	}
+
+	timer.Start();
+	created = BuildFrame( currentTime, force );
+	timer.Stop();
+
+	lastFrameTime = timer.Milliseconds();
+	return created;
+}
+
+/*
+=====================
+idAnimator::AddFrameStatistics
+
+Adds the last created frame to the statistics printed by UpdateFrameStatistics.
+=====================
+*/
+void idAnimator::AddFrameStatistics( void ) const {
+	frameCount++;
+	frameTime += lastFrameTime;
+	if ( lastFramePartial ) {
+		framePartialCount++;
+	}
+	frameJointsTransformed += lastJointsTransformed;
+	frameJointsTotal += numJoints;
+}
+
+/*
+=====================
+idAnimator::UpdateFrameStatistics
+=====================
+*/
+void idAnimator::UpdateFrameStatistics( void ) {
+	if ( g_showAnimPoseCache.GetBool() && frameCount ) {
+		gameLocal.Printf( "%d: anim %d frames %1.2f ms (%1.3f ms per entity), %d partial, %d of %d joints transformed\n", gameLocal.framenum,
+							frameCount, frameTime, frameTime / frameCount, framePartialCount, frameJointsTransformed, frameJointsTotal );
+	}
+
+	frameCount = 0;
+	frameTime = 0.0f;
+	framePartialCount = 0;
+	frameJointsTransformed = 0;
+	frameJointsTotal = 0;
+}
+
+/*
+=====================
+idAnimator::BlendChannel
+=====================
+*/
+bool idAnimator::BlendChannel( int channelNum, int currentTime, idJointQuat *blendFrame, float &blendWeight, bool overrideBlend, bool debugInfo ) const {
+	int					j;
+	bool				hasAnim;
+	const idAnimBlend *	blend;
+
+	hasAnim = false;
+	blend = channels[ channelNum ];
+	for( j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++ ) {
+		if ( blend->BlendAnim( currentTime, channelNum, modelDef->Joints().Num(), blendFrame, blendWeight, removeOriginOffset, overrideBlend, debugInfo ) ) {
+			hasAnim = true;
+			if ( blendWeight >= 1.0f ) {
+				// fully blended
+				break;
+			}
+		}
+	}
+
+	return hasAnim;
+}
+
+/*
+=====================
+idAnimator::BlendCachedPose
+
+Blends the local pose, reusing the cached pose for every channel whose blend inputs have not
+changed since the last frame.  Joints that were reblended are flagged in jointDirty.
+=====================
+*/
+bool idAnimator::BlendCachedPose( int currentTime, const idJointQuat *defaultPose, idJointQuat *jointFrame, bool *jointDirty ) {
+	int				i, j;
+	int				num;
+	const int *		index;
+	float			blendWeight;
+	bool			hasAnim;
+	bool			channelChanged[ ANIM_NumAnimChannels ];
+	animBlendKey_t	key;
+
+	num = modelDef->Joints().Num();
+	if ( poseLocal.Num() != num ) {
+		poseCacheValid = false;
+	}
+
+	for( i = ANIMCHANNEL_ALL; i < ANIM_NumAnimChannels; i++ ) {
+		channelChanged[ i ] = !poseCacheValid;
+		for( j = 0; j < ANIM_MaxAnimsPerChannel; j++ ) {
+			channels[ i ][ j ].GetBlendKey( currentTime, key );
+			if ( memcmp( &key, &poseKeys[ i ][ j ], sizeof( key ) ) ) {
+				memcpy( &poseKeys[ i ][ j ], &key, sizeof( key ) );
+				channelChanged[ i ] = true;
+			}
+		}
+	}
+
+	if ( channelChanged[ ANIMCHANNEL_ALL ] ) {
+		// every joint starts from the all channel, so everything has to be blended again
+		poseAllChannel.SetNum( num, false );
+		poseLocal.SetNum( num, false );
+
+		SIMDProcessor->Memcpy( jointFrame, defaultPose, num * sizeof( jointFrame[0] ) );
+		poseBaseBlend = 0.0f;
+		poseHasAnim[ ANIMCHANNEL_ALL ] = BlendChannel( ANIMCHANNEL_ALL, currentTime, jointFrame, poseBaseBlend, false, false );
+		SIMDProcessor->Memcpy( poseAllChannel.Ptr(), jointFrame, num * sizeof( jointFrame[0] ) );
+
+		memset( jointDirty, 1, num * sizeof( jointDirty[0] ) );
+		for( i = ANIMCHANNEL_ALL + 1; i < ANIM_NumAnimChannels; i++ ) {
+			channelChanged[ i ] = true;
+		}
+	} else {
+		SIMDProcessor->Memcpy( jointFrame, poseLocal.Ptr(), num * sizeof( jointFrame[0] ) );
+		memset( jointDirty, 0, num * sizeof( jointDirty[0] ) );
+	}
+
+	// the other channels only touch their own joints, so each one can be reblended over the all channel pose on its own
+	for( i = ANIMCHANNEL_ALL + 1; i < ANIM_NumAnimChannels; i++ ) {
+		if ( !channelChanged[ i ] ) {
+			continue;
+		}
+
+		poseHasAnim[ i ] = false;
+
+		num = modelDef->NumJointsOnChannel( i );
+		if ( !num ) {
+			continue;
+		}
+
+		index = modelDef->GetChannelJoints( i );
+		for( j = 0; j < num; j++ ) {
+			jointFrame[ index[ j ] ] = poseAllChannel[ index[ j ] ];
+			jointDirty[ index[ j ] ] = true;
+		}
+
+		// eyelids blend over any previous anims, the other channels only if there's enough space to blend into
+		if ( ( i == ANIMCHANNEL_EYELIDS ) || ( poseBaseBlend < 1.0f ) ) {
+			blendWeight = poseBaseBlend;
+			poseHasAnim[ i ] = BlendChannel( i, currentTime, jointFrame, blendWeight, ( i == ANIMCHANNEL_EYELIDS ), false );
+		}
+	}
+
+	SIMDProcessor->Memcpy( poseLocal.Ptr(), jointFrame, poseLocal.Num() * sizeof( jointFrame[0] ) );
+	poseCacheValid = true;
+
+	hasAnim = false;
+	for( i = ANIMCHANNEL_ALL; i < ANIM_NumAnimChannels; i++ ) {
+		if ( poseHasAnim[ i ] ) {
+			hasAnim = true;
+		}
+	}
+
+	return hasAnim;
+}
+
+/*
+=====================
+idAnimator::ModifyRootJoint
+=====================
+*/
+void idAnimator::ModifyRootJoint( idJointMat &joint, const jointMod_t *jointMod ) {
+	switch( jointMod->transform_axis ) {
+		case JOINTMOD_NONE:
+			break;
+
+		case JOINTMOD_LOCAL:
+			joint.SetRotation( jointMod->mat * joint.ToMat3() );
+			break;
+
+		case JOINTMOD_WORLD:
+			joint.SetRotation( joint.ToMat3() * jointMod->mat );
+			break;
+
+		case JOINTMOD_LOCAL_OVERRIDE:
+		case JOINTMOD_WORLD_OVERRIDE:
+			joint.SetRotation( jointMod->mat );
+			break;
+	}
+
+	switch( jointMod->transform_pos ) {
+		case JOINTMOD_NONE:
+			break;
+
+		case JOINTMOD_LOCAL:
+			joint.SetTranslation( joint.ToVec3() + jointMod->pos );
+			break;
+
+		case JOINTMOD_LOCAL_OVERRIDE:
+		case JOINTMOD_WORLD:
+		case JOINTMOD_WORLD_OVERRIDE:
+			joint.SetTranslation( jointMod->pos );
+			break;
+	}
+}
+
+/*
+=====================
+idAnimator::ModifyJoint
+
+Transforms a joint by its parent while applying the joint modification.
+=====================
+*/
+void idAnimator::ModifyJoint( idJointMat &joint, const idJointMat &parent, const jointMod_t *jointMod ) {
+	// modify the axis
+	switch( jointMod->transform_axis ) {
+		case JOINTMOD_NONE:
+			joint.SetRotation( joint.ToMat3() * parent.ToMat3() );
+			break;
+
+		case JOINTMOD_LOCAL:
+			joint.SetRotation( jointMod->mat * ( joint.ToMat3() * parent.ToMat3() ) );
+			break;
+
+		case JOINTMOD_LOCAL_OVERRIDE:
+			joint.SetRotation( jointMod->mat * parent.ToMat3() );
+			break;
+
+		case JOINTMOD_WORLD:
+			joint.SetRotation( ( joint.ToMat3() * parent.ToMat3() ) * jointMod->mat );
+			break;
+
+		case JOINTMOD_WORLD_OVERRIDE:
+			joint.SetRotation( jointMod->mat );
+			break;
+	}
+
+	// modify the position
+	switch( jointMod->transform_pos ) {
+		case JOINTMOD_NONE:
+			joint.SetTranslation( parent.ToVec3() + joint.ToVec3() * parent.ToMat3() );
+			break;
+
+		case JOINTMOD_LOCAL:
+			joint.SetTranslation( parent.ToVec3() + ( joint.ToVec3() + jointMod->pos ) * parent.ToMat3() );
+			break;
+
+		case JOINTMOD_LOCAL_OVERRIDE:
+			joint.SetTranslation( parent.ToVec3() + jointMod->pos * parent.ToMat3() );
+			break;
+
+		case JOINTMOD_WORLD:
+			joint.SetTranslation( parent.ToVec3() + joint.ToVec3() * parent.ToMat3() + jointMod->pos );
+			break;
+
+		case JOINTMOD_WORLD_OVERRIDE:
+			joint.SetTranslation( jointMod->pos );
+			break;
+	}
+}
+
+/*
+=====================
+idAnimator::BuildFrame
+=====================
+*/
+bool idAnimator::BuildFrame( int currentTime, bool force ) {
 	int					i, j;
 	int					numJoints;
-	int					parentNum;
+	int					numDirty;
 	bool				hasAnim;
 	bool				debugInfo;
+	bool				useCache;
 	float				baseBlend;
 	float				blendWeight;
-	const idAnimBlend *	blend;
+	bool *				jointDirty;
 	const int *			jointParent;
 	const jointMod_t *	jointMod;
 	const idJointQuat *	defaultPose;
@@ -4219,119 +4590,150 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 
 	if ( !defaultPose ) {
 		//gameLocal.Warning( "idAnimator::CreateFrame: no defaultPose on '%s'", modelDef->Name() );
+		poseCacheValid = false;
 		return false;
 	}
 
 	numJoints = modelDef->Joints().Num();
 	idJointQuat *jointFrame = ( idJointQuat * )_alloca16( numJoints * sizeof( jointFrame[0] ) );
-	SIMDProcessor->Memcpy( jointFrame, defaultPose, numJoints * sizeof( jointFrame[0] ) );
 
-	hasAnim = false;
+	// the pose cache relies on joints[] still holding last frame's result, so it isn't used
+	// while an articulated figure drives the pose or while printing the blend info
+	useCache = g_animPoseCache.GetBool() && !AFPoseJoints.Num() && !debugInfo;
+	jointDirty = NULL;
 
-	// blend the all channel
-	baseBlend = 0.0f;
-	blend = channels[ ANIMCHANNEL_ALL ];
-	for( j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++ ) {
-		if ( blend->BlendAnim( currentTime, ANIMCHANNEL_ALL, numJoints, jointFrame, baseBlend, removeOriginOffset, false, debugInfo ) ) {
-			hasAnim = true;
-			if ( baseBlend >= 1.0f ) {
-				break;
-			}
-		}
-	}
+	if ( useCache ) {
+		jointDirty = ( bool * )_alloca( numJoints * sizeof( jointDirty[0] ) );
+		hasAnim = BlendCachedPose( currentTime, defaultPose, jointFrame, jointDirty );
+	} else {
+		poseCacheValid = false;
 
-	// only blend other channels if there's enough space to blend into
-	if ( baseBlend < 1.0f ) {
-		for( i = ANIMCHANNEL_ALL + 1; i < ANIM_NumAnimChannels; i++ ) {
-			if ( !modelDef->NumJointsOnChannel( i ) ) {
-				continue;
-			}
-			if ( i == ANIMCHANNEL_EYELIDS ) {
-				// eyelids blend over any previous anims, so skip it and blend it later
-				continue;
-			}
-			blendWeight = baseBlend;
-			blend = channels[ i ];
-			for( j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++ ) {
-				if ( blend->BlendAnim( currentTime, i, numJoints, jointFrame, blendWeight, removeOriginOffset, false, debugInfo ) ) {
+		SIMDProcessor->Memcpy( jointFrame, defaultPose, numJoints * sizeof( jointFrame[0] ) );
+
+		// blend the all channel
+		baseBlend = 0.0f;
+		hasAnim = BlendChannel( ANIMCHANNEL_ALL, currentTime, jointFrame, baseBlend, false, debugInfo );
+
+		// only blend other channels if there's enough space to blend into
+		if ( baseBlend < 1.0f ) {
+			for( i = ANIMCHANNEL_ALL + 1; i < ANIM_NumAnimChannels; i++ ) {
+				if ( !modelDef->NumJointsOnChannel( i ) ) {
+					continue;
+				}
+				if ( i == ANIMCHANNEL_EYELIDS ) {
+					// eyelids blend over any previous anims, so skip it and blend it later
+					continue;
+				}
+				blendWeight = baseBlend;
+				if ( BlendChannel( i, currentTime, jointFrame, blendWeight, false, debugInfo ) ) {
 					hasAnim = true;
-					if ( blendWeight >= 1.0f ) {
-						// fully blended
-						break;
-					}
 				}
-			}
 
-			if ( debugInfo && !AFPoseJoints.Num() && !blendWeight ) {
-				gameLocal.Printf( "%d: %s using default pose in model '%s'\n", gameLocal.time, channelNames[ i ], modelDef->GetModelName() );
+				if ( debugInfo && !AFPoseJoints.Num() && !blendWeight ) {
+					gameLocal.Printf( "%d: %s using default pose in model '%s'\n", gameLocal.time, channelNames[ i ], modelDef->GetModelName() );
+				}
 			}
 		}
-	}
 
-	// blend in the eyelids
-	if ( modelDef->NumJointsOnChannel( ANIMCHANNEL_EYELIDS ) ) {
-		blend = channels[ ANIMCHANNEL_EYELIDS ];
-		blendWeight = baseBlend;
-		for( j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++ ) {
-			if ( blend->BlendAnim( currentTime, ANIMCHANNEL_EYELIDS, numJoints, jointFrame, blendWeight, removeOriginOffset, true, debugInfo ) ) {
+		// blend in the eyelids
+		if ( modelDef->NumJointsOnChannel( ANIMCHANNEL_EYELIDS ) ) {
+			blendWeight = baseBlend;
+			if ( BlendChannel( ANIMCHANNEL_EYELIDS, currentTime, jointFrame, blendWeight, true, debugInfo ) ) {
 				hasAnim = true;
-				if ( blendWeight >= 1.0f ) {
-					// fully blended
-					break;
-				}
 			}
 		}
-	}
 
-	// blend the articulated figure pose
-	if ( BlendAFPose( jointFrame ) ) {
-		hasAnim = true;
+		// blend the articulated figure pose
+		if ( BlendAFPose( jointFrame ) ) {
+			hasAnim = true;
+		}
 	}
 
 	if ( !hasAnim && !jointMods.Num() ) {
 		// no animations were updated
+		poseCacheValid = false;
 		return false;
 	}
 
-	// convert the joint quaternions to rotation matrices
-	SIMDProcessor->ConvertJointQuatsToJointMats( joints, jointFrame, numJoints );
+	// pointer to joint info
+	jointParent = modelDef->JointParents();
 
-	// check if we need to modify the origin
-	if ( jointMods.Num() && ( jointMods[0]->jointnum == 0 ) ) {
-		jointMod = jointMods[0];
+	if ( useCache ) {
+		// joint modifications that changed since the last frame dirty their joint
+		if ( jointMods.Num() != poseJointMods.Num() ) {
+			memset( jointDirty, 1, numJoints * sizeof( jointDirty[0] ) );
+		} else {
+			for( j = 0; j < jointMods.Num(); j++ ) {
+				if ( jointMods[ j ]->jointnum != poseJointMods[ j ].jointnum ) {
+					memset( jointDirty, 1, numJoints * sizeof( jointDirty[0] ) );
+					break;
+				}
+				if ( memcmp( jointMods[ j ], &poseJointMods[ j ], sizeof( jointMod_t ) ) ) {
+					jointDirty[ jointMods[ j ]->jointnum ] = true;
+				}
+			}
+		}
 
-		switch( jointMod->transform_axis ) {
-			case JOINTMOD_NONE:
-				break;
+		poseJointMods.SetNum( jointMods.Num(), false );
+		for( j = 0; j < jointMods.Num(); j++ ) {
+			poseJointMods[ j ] = *jointMods[ j ];
+		}
 
-			case JOINTMOD_LOCAL:
-				joints[0].SetRotation( jointMod->mat * joints[0].ToMat3() );
-				break;
+		// a joint has to be transformed again if any of its parents was
+		numDirty = jointDirty[ 0 ] ? 1 : 0;
+		for( i = 1; i < numJoints; i++ ) {
+			if ( jointDirty[ jointParent[ i ] ] ) {
+				jointDirty[ i ] = true;
+			}
+			if ( jointDirty[ i ] ) {
+				numDirty++;
+			}
+		}
 
-			case JOINTMOD_WORLD:
-				joints[0].SetRotation( joints[0].ToMat3() * jointMod->mat );
-				break;
+		if ( numDirty < numJoints ) {
+			// only transform the dirty sub-trees, joints[] still holds the rest from the last frame
+			lastFramePartial = true;
+			lastJointsTransformed = numDirty;
 
-			case JOINTMOD_LOCAL_OVERRIDE:
-			case JOINTMOD_WORLD_OVERRIDE:
-				joints[0].SetRotation( jointMod->mat );
-				break;
-		}
+			for( i = 0, j = 0; i < numJoints; i++ ) {
+				while( ( j < jointMods.Num() ) && ( jointMods[ j ]->jointnum < i ) ) {
+					j++;
+				}
+				if ( !jointDirty[ i ] ) {
+					continue;
+				}
 
-		switch( jointMod->transform_pos ) {
-			case JOINTMOD_NONE:
-				break;
+				jointMod = ( ( j < jointMods.Num() ) && ( jointMods[ j ]->jointnum == i ) ) ? jointMods[ j ] : NULL;
 
-			case JOINTMOD_LOCAL:
-				joints[0].SetTranslation( joints[0].ToVec3() + jointMod->pos );
-				break;
+				joints[ i ].SetRotation( jointFrame[ i ].q.ToMat3() );
+				joints[ i ].SetTranslation( jointFrame[ i ].t );
 
-			case JOINTMOD_LOCAL_OVERRIDE:
-			case JOINTMOD_WORLD:
-			case JOINTMOD_WORLD_OVERRIDE:
-				joints[0].SetTranslation( jointMod->pos );
-				break;
+				if ( i == 0 ) {
+					if ( jointMod ) {
+						ModifyRootJoint( joints[ 0 ], jointMod );
+					}
+					// add in the model offset
+					joints[ 0 ].SetTranslation( joints[ 0 ].ToVec3() + modelDef->GetVisualOffset() );
+				} else if ( jointMod ) {
+					ModifyJoint( joints[ i ], joints[ jointParent[ i ] ], jointMod );
+				} else {
+					joints[ i ] *= joints[ jointParent[ i ] ];
+				}
+			}
+
+			return true;
 		}
+	}
+
+	lastFramePartial = false;
+	lastJointsTransformed = numJoints;
+
+	// convert the joint quaternions to rotation matrices
+	SIMDProcessor->ConvertJointQuatsToJointMats( joints, jointFrame, numJoints );
+
+	// check if we need to modify the origin
+	if ( jointMods.Num() && ( jointMods[0]->jointnum == 0 ) ) {
+		ModifyRootJoint( joints[0], jointMods[0] );
 		j = 1;
 	} else {
 		j = 0;
@@ -4340,9 +4742,6 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	// add in the model offset
 	joints[0].SetTranslation( joints[0].ToVec3() + modelDef->GetVisualOffset() );
 
-	// pointer to joint info
-	jointParent = modelDef->JointParents();
-
 	// add in any joint modifications
 	for( i = 1; j < jointMods.Num(); j++, i++ ) {
 		jointMod = jointMods[j];
@@ -4351,53 +4750,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		SIMDProcessor->TransformJoints( joints, jointParent, i, jointMod->jointnum - 1 );
 		i = jointMod->jointnum;
 
-		parentNum = jointParent[i];
-
-		// modify the axis
-		switch( jointMod->transform_axis ) {
-			case JOINTMOD_NONE:
-				joints[i].SetRotation( joints[i].ToMat3() * joints[ parentNum ].ToMat3() );
-				break;
-
-			case JOINTMOD_LOCAL:
-				joints[i].SetRotation( jointMod->mat * ( joints[i].ToMat3() * joints[parentNum].ToMat3() ) );
-				break;
-
-			case JOINTMOD_LOCAL_OVERRIDE:
-				joints[i].SetRotation( jointMod->mat * joints[parentNum].ToMat3() );
-				break;
-
-			case JOINTMOD_WORLD:
-				joints[i].SetRotation( ( joints[i].ToMat3() * joints[parentNum].ToMat3() ) * jointMod->mat );
-				break;
-
-			case JOINTMOD_WORLD_OVERRIDE:
-				joints[i].SetRotation( jointMod->mat );
-				break;
-		}
-
-		// modify the position
-		switch( jointMod->transform_pos ) {
-			case JOINTMOD_NONE:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + joints[i].ToVec3() * joints[parentNum].ToMat3() );
-				break;
-
-			case JOINTMOD_LOCAL:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + ( joints[i].ToVec3() + jointMod->pos ) * joints[parentNum].ToMat3() );
-				break;
-
-			case JOINTMOD_LOCAL_OVERRIDE:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + jointMod->pos * joints[parentNum].ToMat3() );
-				break;
-
-			case JOINTMOD_WORLD:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + joints[i].ToVec3() * joints[parentNum].ToMat3() + jointMod->pos );
-				break;
-
-			case JOINTMOD_WORLD_OVERRIDE:
-				joints[i].SetTranslation( jointMod->pos );
-				break;
-		}
+		ModifyJoint( joints[i], joints[ jointParent[i] ], jointMod );
 	}
 
 	// transform the rest of the hierarchy
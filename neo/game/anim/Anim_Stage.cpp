@@ -0,0 +1,167 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#include "../../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "../Game_local.h"
+
+#define MAX_ANIMATION_THREADS		3
+
+/*
+=====================
+idAnimationStage::idAnimationStage
+=====================
+*/
+idAnimationStage::idAnimationStage( void ) {
+	numThreads = 0;
+}
+
+/*
+=====================
+idAnimationStage::~idAnimationStage
+=====================
+*/
+idAnimationStage::~idAnimationStage( void ) {
+	Shutdown();
+}
+
+/*
+=====================
+idAnimationStage::Init
+=====================
+*/
+void idAnimationStage::Init( void ) {
+	UpdateThreads();
+}
+
+/*
+=====================
+idAnimationStage::Shutdown
+=====================
+*/
+void idAnimationStage::Shutdown( void ) {
+	jobList.Shutdown();
+	numThreads = 0;
+	jobs.Clear();
+}
+
+/*
+=====================
+idAnimationStage::UpdateThreads
+=====================
+*/
+void idAnimationStage::UpdateThreads( void ) {
+	int num;
+
+	num = idMath::ClampInt( 0, MAX_ANIMATION_THREADS, g_parallelAnim.GetInteger() );
+	num = Min( num, idParallelJobList::NumHardwareThreads() - 1 );
+	if ( num == numThreads ) {
+		return;
+	}
+	numThreads = num;
+	jobList.Init( numThreads );
+}
+
+/*
+=====================
+idAnimationStage::CreateFrameJob
+=====================
+*/
+void idAnimationStage::CreateFrameJob( void *data ) {
+	animationJob_t *job = (animationJob_t *) data;
+
+	job->created = job->animator->CreateFrameAhead( job->time );
+}
+
+/*
+=====================
+idAnimationStage::Run
+=====================
+*/
+void idAnimationStage::Run( idLinkList<idEntity> &activeEntities ) {
+	int				i, numCreated;
+	idEntity *		ent;
+	idAnimator *	animator;
+	idTimer			timer;
+
+	UpdateThreads();
+	if ( numThreads == 0 || jobList.GetNumThreads() == 0 ) {
+		return;
+	}
+
+	// the frames print their blend info while they are created
+	if ( g_debugAnim.GetInteger() != -1 ) {
+		return;
+	}
+
+	if ( gameLocal.inCinematic && gameLocal.skipCinematic ) {
+		return;
+	}
+
+	timer.Start();
+
+	jobs.SetNum( 0, false );
+	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( ent->GetModelDefHandle() == -1 || ent->IsHidden() ) {
+			continue;
+		}
+		animator = ent->GetAnimator();
+		if ( !animator || !animator->ModelHandle() ) {
+			continue;
+		}
+		if ( !gameLocal.InPlayerPVS( ent ) ) {
+			continue;
+		}
+
+		animationJob_t &job = jobs.Alloc();
+		job.animator = animator;
+		job.time = gameLocal.time;
+		job.created = false;
+	}
+
+	for( i = 0; i < jobs.Num(); i++ ) {
+		jobList.AddJob( CreateFrameJob, &jobs[i] );
+	}
+	jobList.Run();
+
+	numCreated = 0;
+	for( i = 0; i < jobs.Num(); i++ ) {
+		if ( jobs[i].created ) {
+			jobs[i].animator->AddFrameStatistics();
+			numCreated++;
+		}
+	}
+
+	timer.Stop();
+
+	if ( g_showAnimPoseCache.GetBool() && jobs.Num() ) {
+		gameLocal.Printf( "%d: anim stage %d entities, %d frames created, %1.2f ms\n", gameLocal.framenum, jobs.Num(), numCreated, timer.Milliseconds() );
+	}
+}
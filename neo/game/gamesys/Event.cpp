@@ -206,19 +206,338 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 	return NULL;
 }
 
-/***********************************************************************
+/*
+================================================================================================
 
-  idEvent
+	idEventHeap
 
-***********************************************************************/
+	Binary min heap of pending events ordered by time and, for events with the same time, by
+	the order in which they were scheduled.
+	Scheduling and removing an event are O(log n).  Scheduled events are also chained by
+	object in EventObjectHash so CancelEvents only visits the events of a single object.
+
+================================================================================================
+*/
+
+#define EVENT_OBJECT_HASH_SIZE		1024
+
+class idEventHeap {
+public:
+	void					Clear( void );
+	int						Num( void ) const { return num; }
+	idEvent *				First( void ) const { return num ? events[ 1 ] : NULL; }
+	void					Add( idEvent *event );
+	void					Remove( idEvent *event );
+	void					GetSortedEvents( idList<idEvent *> &list ) const;
+
+	static bool				Before( const idEvent *a, const idEvent *b );
+
+private:
+	idEvent *				events[ MAX_EVENTS + 1 ];		// 1 based
+	int						num;
+
+	void					MoveUp( int index );
+	void					MoveDown( int index );
+	void					Set( int index, idEvent *event );
+};
 
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
+static idEventHeap EventQueue;
+static idEvent *EventObjectHash[ EVENT_OBJECT_HASH_SIZE ];
+static int EventSequence;
 static idEvent EventPool[ MAX_EVENTS ];
 
-bool idEvent::initialized = false;
+/*
+================
+EventObjectHashKey
+================
+*/
+static ID_INLINE int EventObjectHashKey( const idClass *obj ) {
+	return ( int )( reinterpret_cast<size_t>( obj ) >> 4 ) & ( EVENT_OBJECT_HASH_SIZE - 1 );
+}
+
+/*
+================
+idEventHeap::Clear
+================
+*/
+void idEventHeap::Clear( void ) {
+	num = 0;
+}
+
+/*
+================
+idEventHeap::Before
+================
+*/
+ID_INLINE bool idEventHeap::Before( const idEvent *a, const idEvent *b ) {
+	if ( a->time != b->time ) {
+		return a->time < b->time;
+	}
+	return ( a->sequence - b->sequence ) < 0;
+}
+
+/*
+================
+idEventHeap::Set
+================
+*/
+ID_INLINE void idEventHeap::Set( int index, idEvent *event ) {
+	events[ index ] = event;
+	event->heapIndex = index;
+}
+
+/*
+================
+idEventHeap::MoveUp
+================
+*/
+void idEventHeap::MoveUp( int index ) {
+	idEvent *event;
+	int parent;
+
+	event = events[ index ];
+	while( index > 1 ) {
+		parent = index >> 1;
+		if ( !Before( event, events[ parent ] ) ) {
+			break;
+		}
+		Set( index, events[ parent ] );
+		index = parent;
+	}
+	Set( index, event );
+}
+
+/*
+================
+idEventHeap::MoveDown
+================
+*/
+void idEventHeap::MoveDown( int index ) {
+	idEvent *event;
+	int child;
 
-idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
+	event = events[ index ];
+	while( ( child = index << 1 ) <= num ) {
+		if ( ( child < num ) && Before( events[ child + 1 ], events[ child ] ) ) {
+			child++;
+		}
+		if ( !Before( events[ child ], event ) ) {
+			break;
+		}
+		Set( index, events[ child ] );
+		index = child;
+	}
+	Set( index, event );
+}
+
+/*
+================
+idEventHeap::Add
+================
+*/
+void idEventHeap::Add( idEvent *event ) {
+	assert( num < MAX_EVENTS );
+	num++;
+	Set( num, event );
+	MoveUp( num );
+}
+
+/*
+================
+idEventHeap::Remove
+================
+*/
+void idEventHeap::Remove( idEvent *event ) {
+	int index;
+
+	index = event->heapIndex;
+	assert( ( index >= 1 ) && ( index <= num ) && ( events[ index ] == event ) );
+
+	event->heapIndex = 0;
+	if ( index == num ) {
+		num--;
+		return;
+	}
+
+	Set( index, events[ num ] );
+	num--;
+	if ( ( index > 1 ) && Before( events[ index ], events[ index >> 1 ] ) ) {
+		MoveUp( index );
+	} else {
+		MoveDown( index );
+	}
+}
+
+/*
+================
+EventSortCompare
+================
+*/
+static int EventSortCompare( idEvent * const *a, idEvent * const *b ) {
+	if ( idEventHeap::Before( *a, *b ) ) {
+		return -1;
+	}
+	if ( idEventHeap::Before( *b, *a ) ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+idEventHeap::GetSortedEvents
+
+Lists the pending events in the order they will be serviced.
+================
+*/
+void idEventHeap::GetSortedEvents( idList<idEvent *> &list ) const {
+	int i;
+
+	list.SetNum( num, false );
+	for( i = 0; i < num; i++ ) {
+		list[ i ] = events[ i + 1 ];
+	}
+	list.Sort( EventSortCompare );
+}
+
+/*
+================================================================================================
+
+	Event argument storage
+
+	Argument blocks are taken from the free list of the smallest size class that fits.  A size
+	class gets a new page when its free list runs dry and pages are kept until the event system
+	shuts down, so once the free lists have grown to the number of events in flight, posting
+	and servicing events doesn't allocate any memory.
+
+================================================================================================
+*/
+
+#define EVENT_ARGS_MIN_SIZE_SHIFT	4			// smallest size class holds 16 bytes
+#define EVENT_ARGS_NUM_SIZE_CLASSES	7			// largest size class holds 1024 bytes
+#define EVENT_ARGS_PAGE_SIZE		( 16 * 1024 )
+#define EVENT_ARGS_PAGE_HEADER		16			// keeps the blocks in a page 16 byte aligned
+
+typedef struct eventArgBlock_s {
+	struct eventArgBlock_s *	next;
+} eventArgBlock_t;
+
+typedef struct eventArgPage_s {
+	struct eventArgPage_s *		next;
+} eventArgPage_t;
+
+static eventArgBlock_t *	EventArgFreeLists[ EVENT_ARGS_NUM_SIZE_CLASSES ];
+static eventArgPage_t *		EventArgPages;
+static int					EventArgPoolMemory;
+static int					EventArgAllocs;
+static int					EventArgHeapAllocs;
+
+/*
+================
+EventArgSizeClass
+
+Returns the size class for a block of the given size, or -1 when the block is larger than the largest size class.
+================
+*/
+static int EventArgSizeClass( int size ) {
+	int sizeClass;
+
+	for( sizeClass = 0; sizeClass < EVENT_ARGS_NUM_SIZE_CLASSES; sizeClass++ ) {
+		if ( size <= ( 1 << ( sizeClass + EVENT_ARGS_MIN_SIZE_SHIFT ) ) ) {
+			return sizeClass;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+AllocEventArgs
+================
+*/
+static byte *AllocEventArgs( int size ) {
+	int					sizeClass;
+	int					blockSize;
+	int					offset;
+	eventArgPage_t *	page;
+	eventArgBlock_t *	block;
+
+	EventArgAllocs++;
+
+	sizeClass = EventArgSizeClass( size );
+	if ( sizeClass < 0 ) {
+		EventArgHeapAllocs++;
+		return ( byte * )Mem_Alloc( size );
+	}
+
+	if ( !EventArgFreeLists[ sizeClass ] ) {
+		EventArgHeapAllocs++;
+
+		page = ( eventArgPage_t * )Mem_Alloc( EVENT_ARGS_PAGE_SIZE );
+		page->next = EventArgPages;
+		EventArgPages = page;
+		EventArgPoolMemory += EVENT_ARGS_PAGE_SIZE;
+
+		blockSize = 1 << ( sizeClass + EVENT_ARGS_MIN_SIZE_SHIFT );
+		for( offset = EVENT_ARGS_PAGE_HEADER; offset + blockSize <= EVENT_ARGS_PAGE_SIZE; offset += blockSize ) {
+			block = reinterpret_cast<eventArgBlock_t *>( reinterpret_cast<byte *>( page ) + offset );
+			block->next = EventArgFreeLists[ sizeClass ];
+			EventArgFreeLists[ sizeClass ] = block;
+		}
+	}
+
+	block = EventArgFreeLists[ sizeClass ];
+	EventArgFreeLists[ sizeClass ] = block->next;
+
+	return reinterpret_cast<byte *>( block );
+}
+
+/*
+================
+FreeEventArgs
+================
+*/
+static void FreeEventArgs( byte *data, int size ) {
+	int					sizeClass;
+	eventArgBlock_t *	block;
+
+	sizeClass = EventArgSizeClass( size );
+	if ( sizeClass < 0 ) {
+		Mem_Free( data );
+		return;
+	}
+
+	block = reinterpret_cast<eventArgBlock_t *>( data );
+	block->next = EventArgFreeLists[ sizeClass ];
+	EventArgFreeLists[ sizeClass ] = block;
+}
+
+/*
+================
+FreeEventArgPages
+================
+*/
+static void FreeEventArgPages( void ) {
+	eventArgPage_t *next;
+
+	while( EventArgPages ) {
+		next = EventArgPages->next;
+		Mem_Free( EventArgPages );
+		EventArgPages = next;
+	}
+
+	memset( EventArgFreeLists, 0, sizeof( EventArgFreeLists ) );
+	EventArgPoolMemory = 0;
+}
+
+/***********************************************************************
+
+  idEvent
+
+***********************************************************************/
+
+bool idEvent::initialized = false;
 
 /*
 ================
@@ -258,7 +577,7 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 
 	size = evdef->GetArgSize();
 	if ( size ) {
-		ev->data = eventDataAllocator.Alloc( size );
+		ev->data = AllocEventArgs( size );
 		memset( ev->data, 0, size );
 	} else {
 		ev->data = NULL;
@@ -359,8 +678,10 @@ idEvent::Free
 ================
 */
 void idEvent::Free( void ) {
+	Unschedule();
+
 	if ( data ) {
-		eventDataAllocator.Free( data );
+		FreeEventArgs( data, eventdef->GetArgSize() );
 		data = NULL;
 	}
 
@@ -386,24 +707,68 @@ void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 		return;
 	}
 
+	Unschedule();
+	eventNode.Remove();
+
 	object = obj;
 	typeinfo = type;
 
 	// wraps after 24 days...like I care. ;)
 	this->time = gameLocal.time + time;
 
-	eventNode.Remove();
+	Enqueue( EventQueue );
+}
+
+/*
+================
+idEvent::Enqueue
+
+Adds the event to a pending event heap and to the chain of its object.
+================
+*/
+void idEvent::Enqueue( idEventHeap &queue ) {
+	int hash;
+
+	assert( !heap );
+
+	sequence = EventSequence++;
+	heap = &queue;
+	queue.Add( this );
 
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
+	hash = EventObjectHashKey( object );
+	objectPrev = NULL;
+	objectNext = EventObjectHash[ hash ];
+	if ( objectNext ) {
+		objectNext->objectPrev = this;
+	}
+	EventObjectHash[ hash ] = this;
+}
+
+/*
+================
+idEvent::Unschedule
+
+Removes the event from its pending event heap and from the chain of its object.
+================
+*/
+void idEvent::Unschedule( void ) {
+	if ( !heap ) {
+		return;
 	}
 
-	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
+	heap->Remove( this );
+	heap = NULL;
+
+	if ( objectPrev ) {
+		objectPrev->objectNext = objectNext;
 	} else {
-		eventNode.AddToEnd( EventQueue );
+		EventObjectHash[ EventObjectHashKey( object ) ] = objectNext;
+	}
+	if ( objectNext ) {
+		objectNext->objectPrev = objectPrev;
 	}
+	objectNext = NULL;
+	objectPrev = NULL;
 }
 
 /*
@@ -419,8 +784,8 @@ void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
+	for( event = EventObjectHash[ EventObjectHashKey( obj ) ]; event != NULL; event = next ) {
+		next = event->objectNext;
 		if ( event->object == obj ) {
 			if ( !evdef || ( evdef == event->eventdef ) ) {
 				event->Free();
@@ -442,11 +807,17 @@ void idEvent::ClearEventList( void ) {
 	//
 	FreeEvents.Clear();
 	EventQueue.Clear();
+	memset( EventObjectHash, 0, sizeof( EventObjectHash ) );
+	EventSequence = 0;
 
 	//
 	// add the events to the free list
 	//
 	for( i = 0; i < MAX_EVENTS; i++ ) {
+		EventPool[ i ].heap = NULL;
+		EventPool[ i ].heapIndex = 0;
+		EventPool[ i ].objectNext = NULL;
+		EventPool[ i ].objectPrev = NULL;
 		EventPool[ i ].Free();
 	}
 }
@@ -470,8 +841,8 @@ void idEvent::ServiceEvents( void ) {
 	const char  *materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
+	while( EventQueue.Num() ) {
+		event = EventQueue.First();
 		assert( event );
 
 		if ( event->time > gameLocal.time ) {
@@ -524,9 +895,9 @@ void idEvent::ServiceEvents( void ) {
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from the queue so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->Unschedule();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -570,7 +941,6 @@ void idEvent::Init( void ) {
 
 	ClearEventList();
 
-	eventDataAllocator.Init();
 
 	gameLocal.Printf( "...%i event definitions\n", idEventDef::NumEventCommands() );
 
@@ -593,29 +963,54 @@ void idEvent::Shutdown( void ) {
 
 	ClearEventList();
 
-	eventDataAllocator.Shutdown();
+	FreeEventArgPages();
 
 	// say it is now shutdown
 	initialized = false;
 }
 
+/*
+================
+idEvent::GetArgStats
+================
+*/
+void idEvent::GetArgStats( int &numAllocs, int &numHeapAllocs, int &poolMemory ) {
+	numAllocs = EventArgAllocs;
+	numHeapAllocs = EventArgHeapAllocs;
+	poolMemory = EventArgPoolMemory;
+}
+
+/*
+================
+idEvent::ClearArgStats
+================
+*/
+void idEvent::ClearArgStats( void ) {
+	EventArgAllocs = 0;
+	EventArgHeapAllocs = 0;
+}
+
 /*
 ================
 idEvent::Save
 ================
 */
 void idEvent::Save( idSaveGame *savefile ) {
-	int i, size;
+	int i, j, size;
 	idEvent	*event;
 	byte *dataPtr;
 	bool validTrace;
 	const char	*format;
 	idStr str;
+	idList<idEvent *> sortedEvents;
 
-	savefile->WriteInt( EventQueue.Num() );
+	// events are written in the order they will be serviced, so restoring them in
+	// the same order keeps events scheduled for the same time in their original order
+	EventQueue.GetSortedEvents( sortedEvents );
+	savefile->WriteInt( sortedEvents.Num() );
 
-	event = EventQueue.Next();
-	while( event != NULL ) {
+	for( j = 0; j < sortedEvents.Num(); j++ ) {
+		event = sortedEvents[ j ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -665,7 +1060,6 @@ void idEvent::Save( idSaveGame *savefile ) {
 			}
 		}
 		assert( size == event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 }
 
@@ -691,7 +1085,6 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -710,6 +1103,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 		}
 
 		savefile->ReadObject( event->object );
+		event->Enqueue( EventQueue );
 
 		// read the args
 		savefile->ReadInt( argsize );
@@ -717,7 +1111,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 			savefile->Error( "idEvent::Restore: arg size (%zd) doesn't match saved arg size(%d) on event '%s'", event->eventdef->GetArgSize(), argsize, event->eventdef->GetName() );
 		}
 		if ( argsize ) {
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->data = AllocEventArgs( argsize );
 			format = event->eventdef->GetArgFormat();
 			assert( format );
 			for ( j = 0, size = 0; j < event->eventdef->GetNumArgs(); ++j) {
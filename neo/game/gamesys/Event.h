@@ -83,19 +83,28 @@ public:
 
 class idSaveGame;
 class idRestoreGame;
+class idEventHeap;
 
 class idEvent {
+	friend class idEventHeap;
+
 private:
 	const idEventDef			*eventdef;
 	byte						*data;
 	int							time;
+	int							sequence;		// orders events scheduled for the same time
 	idClass						*object;
 	const idTypeInfo			*typeinfo;
 
-	idLinkList<idEvent>			eventNode;
+	idLinkList<idEvent>			eventNode;		// free list
 
-	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
+	idEventHeap *				heap;			// pending event heap the event is scheduled in, NULL when not scheduled
+	int							heapIndex;
+	idEvent *					objectNext;		// chain of scheduled events with the same object hash
+	idEvent *					objectPrev;
 
+	void						Enqueue( idEventHeap &queue );
+	void						Unschedule( void );
 
 public:
 	static bool					initialized;
@@ -115,6 +124,10 @@ public:
 	static void					Init( void );
 	static void					Shutdown( void );
 
+	// argument storage statistics since the last call to ClearArgStats
+	static void					GetArgStats( int &numAllocs, int &numHeapAllocs, int &poolMemory );
+	static void					ClearArgStats( void );
+
 	// save games
 	static void					Save( idSaveGame *savefile );					// archives object for save game file
 	static void					Restore( idRestoreGame *savefile );				// unarchives object from save game file
@@ -808,6 +808,55 @@ void Cmd_Spawn_f( const idCmdArgs &args ) {
 	gameLocal.SpawnEntityDef( dict );
 }
 
+/*
+===================
+Cmd_TestRagdolls_f
+
+Spawns a grid of ragdolls in front of the player to benchmark the articulated figure solver.
+===================
+*/
+void Cmd_TestRagdolls_f( const idCmdArgs &args ) {
+	int			i, count, rowSize;
+	float		yaw, spacing;
+	idVec3		org, forward, right;
+	idPlayer	*player;
+	idDict		dict;
+
+	player = gameLocal.GetLocalPlayer();
+	if ( !player || !gameLocal.CheatsOk( false ) ) {
+		return;
+	}
+
+	if ( args.Argc() < 2 ) {
+		gameLocal.Printf( "usage: testRagdolls classname [count] [spacing]\n" );
+		return;
+	}
+
+	count = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 32;
+	spacing = ( args.Argc() > 3 ) ? atof( args.Argv( 3 ) ) : 48.0f;
+	if ( count <= 0 ) {
+		return;
+	}
+
+	yaw = player->viewAngles.yaw;
+	idAngles( 0, yaw, 0 ).ToVectors( &forward, &right );
+	rowSize = idMath::Ftoi( idMath::Ceil( idMath::Sqrt( (float) count ) ) );
+
+	for ( i = 0; i < count; i++ ) {
+		dict.Clear();
+		dict.Set( "classname", args.Argv( 1 ) );
+		dict.Set( "angle", va( "%f", yaw + 180 ) );
+		org = player->GetPhysics()->GetOrigin() + forward * ( 80 + ( i / rowSize ) * spacing ) +
+				right * ( ( i % rowSize ) - ( rowSize - 1 ) * 0.5f ) * spacing + idVec3( 0, 0, 1 );
+		dict.Set( "origin", org.ToString() );
+		if ( !gameLocal.SpawnEntityDef( dict ) ) {
+			break;
+		}
+	}
+
+	gameLocal.Printf( "spawned %d ragdolls, set af_showTimings 2 for the solver time and iterations\n", i );
+}
+
 /*
 ==================
 Cmd_Damage_f
@@ -1391,6 +1440,31 @@ static void Cmd_ReloadAnims_f( const idCmdArgs &args ) {
 	animationLib.ReloadAnims();
 }
 
+/*
+==================
+Cmd_TestAnimCompression_f
+==================
+*/
+static void Cmd_TestAnimCompression_f( const idCmdArgs &args ) {
+	int numLoops;
+
+	numLoops = 10;
+	if ( args.Argc() > 1 ) {
+		numLoops = Max( atoi( args.Argv( 1 ) ), 1 );
+	}
+
+	animationLib.TestCompression( numLoops );
+}
+
+/*
+==================
+Cmd_TestBinaryAnims_f
+==================
+*/
+static void Cmd_TestBinaryAnims_f( const idCmdArgs &args ) {
+	animationLib.TestBinaryLoad( ( args.Argc() > 1 ) ? args.Argv( 1 ) : "models/md5/monsters/" );
+}
+
 /*
 ==================
 Cmd_ListAnims_f
@@ -1463,6 +1537,29 @@ static void Cmd_AASStats_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_AASCacheStats_f
+==================
+*/
+static void Cmd_AASCacheStats_f( const idCmdArgs &args ) {
+	int aasNum;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	aasNum = aas_test.GetInteger();
+	idAAS *aas = gameLocal.GetAAS( aasNum );
+	if ( !aas ) {
+		gameLocal.Printf( "No aas #%d loaded\n", aasNum );
+	} else if ( !idStr::Icmp( args.Argv( 1 ), "reset" ) ) {
+		aas->ResetRoutingCacheStats();
+	} else {
+		aas->RoutingCacheReport( !idStr::Icmp( args.Argv( 1 ), "all" ) );
+	}
+}
+
 /*
 ==================
 Cmd_TestDamage_f
@@ -1976,6 +2073,209 @@ static void Cmd_DisasmScript_f( const idCmdArgs &args ) {
 	gameLocal.program.Disassemble();
 }
 
+/*
+==================
+Cmd_ScriptOpcodeStats_f
+==================
+*/
+static void Cmd_ScriptOpcodeStats_f( const idCmdArgs &args ) {
+	if ( !idStr::Icmp( args.Argv( 1 ), "reset" ) ) {
+		idInterpreter::ClearOpcodeStats();
+		return;
+	}
+	idInterpreter::PrintOpcodeStats( args.Argc() > 1 ? atoi( args.Argv( 1 ) ) : 20 );
+}
+
+/*
+==================
+Cmd_ScriptBenchmark_f
+
+Runs a fixed set of script functions and reports the time spent in each of them.
+Each function stays well below the interpreter's runaway limit so it finishes in a single Execute.
+==================
+*/
+static const char *scriptBenchmarkText =
+	"void scriptBench_arithmetic() {\n"
+	"	float i; float x; float y;\n"
+	"	for( i = 0; i < 20000; i++ ) { x = x + i * 2 - y / 3; y = ( x % 7 ) + i; x = -x; }\n"
+	"}\n"
+	"void scriptBench_vector() {\n"
+	"	float i; vector v; vector w; float d;\n"
+	"	w = '1 2 3';\n"
+	"	for( i = 0; i < 20000; i++ ) { v = v + w * 0.5; d = v * w; v_x = d - v_y; v = v - w; }\n"
+	"}\n"
+	"void scriptBench_conditions() {\n"
+	"	float i; float n; entity e;\n"
+	"	for( i = 0; i < 20000; i++ ) {\n"
+	"		if ( i == 5 ) { n++; } else if ( i != 7 ) { n--; }\n"
+	"		if ( i <= n ) { n++; } if ( i > 10 ) { n++; } if ( !n ) { n++; }\n"
+	"		if ( e == $null_entity ) { n++; }\n"
+	"	}\n"
+	"}\n"
+	"float scriptBench_add( float a, float b ) {\n"
+	"	return a + b;\n"
+	"}\n"
+	"void scriptBench_calls() {\n"
+	"	float i; float x;\n"
+	"	for( i = 0; i < 20000; i++ ) { x = scriptBench_add( x, i ); x = scriptBench_add( x, -i ); }\n"
+	"}\n"
+	"void scriptBench_strings() {\n"
+	"	float i; string s;\n"
+	"	for( i = 0; i < 20000; i++ ) { s = \"bench\"; s = s + i; if ( s == \"bench\" ) { s = \"\"; } }\n"
+	"}\n"
+	"void scriptBench_events() {\n"
+	"	float i; float t;\n"
+	"	for( i = 0; i < 20000; i++ ) { t = t + sys.getTime() + sys.random( 1 ); }\n"
+	"}\n";
+
+static void Cmd_ScriptBenchmark_f( const idCmdArgs &args ) {
+	static const char *benchFunctions[] = { "scriptBench_arithmetic", "scriptBench_vector", "scriptBench_conditions", "scriptBench_calls", "scriptBench_strings", "scriptBench_events" };
+	const int	numBenchFunctions = sizeof( benchFunctions ) / sizeof( benchFunctions[ 0 ] );
+	const function_t *func;
+	idThread	*thread;
+	idTimer		timer;
+	double		total;
+	int			repetitions;
+	int			i;
+	int			j;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	repetitions = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 10;
+	if ( repetitions < 1 ) {
+		repetitions = 1;
+	}
+
+	if ( !gameLocal.program.FindFunction( benchFunctions[ 0 ] ) ) {
+		if ( !gameLocal.program.CompileText( "scriptBenchmark", scriptBenchmarkText, true ) ) {
+			return;
+		}
+	}
+
+	total = 0.0;
+	for( i = 0; i < numBenchFunctions; i++ ) {
+		func = gameLocal.program.FindFunction( benchFunctions[ i ] );
+		if ( !func ) {
+			gameLocal.Warning( "scriptBenchmark: couldn't find '%s'", benchFunctions[ i ] );
+			continue;
+		}
+
+		timer.Clear();
+		timer.Start();
+		for( j = 0; j < repetitions; j++ ) {
+			thread = new idThread( func );
+			thread->Start();
+		}
+		timer.Stop();
+
+		total += timer.Milliseconds();
+		gameLocal.Printf( "%-24s %8.2f msec\n", benchFunctions[ i ], timer.Milliseconds() / repetitions );
+	}
+	gameLocal.Printf( "%-24s %8.2f msec\n", "total", total / repetitions );
+}
+
+/*
+==================
+Cmd_EventBenchmark_f
+
+Stress tests the event queue with events no entity responds to.  Every round schedules a batch
+of events at random times spread over the spawned entities, cancels them per entity, then
+schedules another batch for the current time and services it.
+==================
+*/
+static const idEventDef EV_EventBenchmark( "<eventBenchmark>" );
+
+static void Cmd_EventBenchmark_f( const idCmdArgs &args ) {
+	idList<idEntity *> entities;
+	idEntity	*ent;
+	idRandom	random;
+	idTimer		scheduleTimer;
+	idTimer		cancelTimer;
+	idTimer		serviceTimer;
+	int			rounds;
+	int			batch;
+	int			i;
+	int			j;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	rounds = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 16;
+	if ( rounds < 1 ) {
+		rounds = 1;
+	}
+
+	for( ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
+		entities.Append( ent );
+	}
+	if ( !entities.Num() ) {
+		gameLocal.Printf( "eventBenchmark: no entities\n" );
+		return;
+	}
+
+	// leave room for the events already pending and stay below the per frame service limit
+	batch = MAX_EVENTS / 2;
+
+	scheduleTimer.Clear();
+	cancelTimer.Clear();
+	serviceTimer.Clear();
+	for( i = 0; i < rounds; i++ ) {
+		scheduleTimer.Start();
+		for( j = 0; j < batch; j++ ) {
+			entities[ j % entities.Num() ]->PostEventMS( &EV_EventBenchmark, 1 + random.RandomInt( 60000 ) );
+		}
+		scheduleTimer.Stop();
+
+		cancelTimer.Start();
+		for( j = 0; j < entities.Num(); j++ ) {
+			entities[ j ]->CancelEvents( &EV_EventBenchmark );
+		}
+		cancelTimer.Stop();
+
+		serviceTimer.Start();
+		for( j = 0; j < batch; j++ ) {
+			entities[ j % entities.Num() ]->PostEventMS( &EV_EventBenchmark, 0 );
+		}
+		idEvent::ServiceEvents();
+		serviceTimer.Stop();
+	}
+
+	gameLocal.Printf( "%d events on %d entities\n", rounds * batch * 2, entities.Num() );
+	gameLocal.Printf( "schedule: %8.2f msec\n", scheduleTimer.Milliseconds() );
+	gameLocal.Printf( "cancel:   %8.2f msec\n", cancelTimer.Milliseconds() );
+	gameLocal.Printf( "service:  %8.2f msec (including scheduling)\n", serviceTimer.Milliseconds() );
+}
+
+/*
+==================
+Cmd_ClipBenchmark_f
+
+Compares the clip model broadphases with boxes moving through the world bounds of the current map.
+==================
+*/
+static void Cmd_ClipBenchmark_f( const idCmdArgs &args ) {
+	int numClipModels;
+	int numFrames;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	numClipModels = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 2000;
+	numFrames = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 60;
+	if ( numClipModels < 1 ) {
+		numClipModels = 1;
+	}
+	if ( numFrames < 1 ) {
+		numFrames = 1;
+	}
+
+	idClipBroadphase::Benchmark( gameLocal.clip.GetWorldBounds(), numClipModels, numFrames );
+}
+
 /*
 ==================
 Cmd_TestSave_f
@@ -2318,6 +2618,7 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "teleport",				Cmd_Teleport_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"teleports the player to an entity location", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "trigger",				Cmd_Trigger_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"triggers an entity", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "spawn",					Cmd_Spawn_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"spawns a game entity", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
+	cmdSystem->AddCommand( "testRagdolls",			Cmd_TestRagdolls_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"spawns a grid of ragdolls", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "damage",				Cmd_Damage_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"apply damage to an entity", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "remove",				Cmd_Remove_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"removes an entity", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "killMonsters",			Cmd_KillMonsters_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"removes all monsters" );
@@ -2354,7 +2655,10 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
+	cmdSystem->AddCommand( "testBinaryAnims",		Cmd_TestBinaryAnims_f,		CMD_FL_GAME,				"compares text and binary load times of the loaded anims" );
+	cmdSystem->AddCommand( "testAnimCompression",	Cmd_TestAnimCompression_f,	CMD_FL_GAME,				"compares memory, error and decode time of float and compressed animation frames" );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats" );
+	cmdSystem->AddCommand( "aasCacheStats",			Cmd_AASCacheStats_f,		CMD_FL_GAME,				"shows AAS routing cache use per cluster, 'all' lists every cluster, 'reset' clears the counters" );
 	cmdSystem->AddCommand( "testDamage",			Cmd_TestDamage_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "weaponSplat",			Cmd_WeaponSplat_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"projects a blood splat on the player weapon" );
 	cmdSystem->AddCommand( "saveSelected",			Cmd_SaveSelected_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"saves the selected entity to the .map file" );
@@ -2370,6 +2674,10 @@ void idGameLocal::InitConsoleCommands( void ) {
 
 #ifndef	ID_DEMO_BUILD
 	cmdSystem->AddCommand( "disasmScript",			Cmd_DisasmScript_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"disassembles script" );
+	cmdSystem->AddCommand( "scriptOpcodeStats",		Cmd_ScriptOpcodeStats_f,	CMD_FL_GAME,				"lists script opcode counts gathered with g_scriptProfileOpcodes, scriptOpcodeStats [numPairs | reset]" );
+	cmdSystem->AddCommand( "scriptBenchmark",		Cmd_ScriptBenchmark_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"times the script interpreter on a fixed set of functions, scriptBenchmark [repetitions]" );
+	cmdSystem->AddCommand( "eventBenchmark",		Cmd_EventBenchmark_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"stress tests scheduling, cancelling and servicing events, eventBenchmark [rounds]" );
+	cmdSystem->AddCommand( "clipBenchmark",		Cmd_ClipBenchmark_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"compares link and query times of the clip model broadphases, clipBenchmark [numClipModels] [numFrames]" );
 	cmdSystem->AddCommand( "recordViewNotes",		Cmd_RecordViewNotes_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"record the current view position with notes" );
 	cmdSystem->AddCommand( "showViewNotes",			Cmd_ShowViewNotes_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"show any view notes for the current map, successive calls will cycle to the next note" );
 	cmdSystem->AddCommand( "closeViewNotes",		Cmd_CloseViewNotes_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"close the view showing any notes for this map" );
@@ -111,8 +111,16 @@ idCVar g_projectileLightLodBias(    "g_projectileLightLodBias",  "2",
 idCVar g_muzzleFlashLightLodBias(   "g_muzzleFlashLightLodBias", "2",           CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "shadow mapping lod bias for muzzle flashes" );
 
 idCVar g_disasm(					"g_disasm",					"0",			CVAR_GAME | CVAR_BOOL, "disassemble script into base/script/disasm.txt on the local drive when script is compiled" );
+idCVar g_scriptCache(				"g_scriptCache",			"1",			CVAR_GAME | CVAR_BOOL, "restore the compiled default script from generated/script/ instead of compiling it when the script source is unchanged" );
+idCVar g_scriptProfileOpcodes(		"g_scriptProfileOpcodes",	"0",			CVAR_GAME | CVAR_BOOL, "count executed script opcodes and opcode pairs, listed with scriptOpcodeStats" );
 idCVar g_debugBounds(				"g_debugBounds",			"0",			CVAR_GAME | CVAR_BOOL, "checks for models with bounds > 2048" );
 idCVar g_debugAnim(					"g_debugAnim",				"-1",			CVAR_GAME | CVAR_INTEGER, "displays information on which animations are playing on the specified entity number.  set to -1 to disable." );
+idCVar g_binaryAnims(				"g_binaryAnims",			"1",			CVAR_GAME | CVAR_BOOL, "load md5 anims from binary caches under generated/ and write the caches when they are missing or out of date" );
+idCVar g_compressAnims(				"g_compressAnims",			"0",			CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE, "store animation frames quantized to 16 bits with constant tracks folded into the base frame.  applies to anims loaded afterwards or reloaded with reloadanims" );
+idCVar g_compressAnimsMaxError(		"g_compressAnimsMaxError",	"0.01",			CVAR_GAME | CVAR_FLOAT | CVAR_ARCHIVE, "largest absolute error allowed for a compressed animation component, anims exceeding it are kept as floats" );
+idCVar g_animPoseCache(				"g_animPoseCache",			"1",			CVAR_GAME | CVAR_BOOL, "cache the blended local pose of each animator and only reblend and transform the channels and joint sub-trees that changed since the last frame" );
+idCVar g_showAnimPoseCache(			"g_showAnimPoseCache",		"0",			CVAR_GAME | CVAR_BOOL, "print the time spent creating animation frames and how many joints were transformed each game frame" );
+idCVar g_parallelAnim(				"g_parallelAnim",			"2",			CVAR_GAME | CVAR_INTEGER, "number of job threads creating the animation frames of the entities in view after all entities thought, 0 = create them from the render callbacks", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 idCVar g_debugMove(					"g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugDamage(				"g_debugDamage",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugWeapon(				"g_debugWeapon",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -137,6 +145,9 @@ idCVar g_showTriggers(				"g_showTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "dra
 idCVar g_showCollisionWorld(		"g_showCollisionWorld",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionModels(		"g_showCollisionModels",	"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionTraces(		"g_showCollisionTraces",	"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_clipBroadphase(			"g_clipBroadphase",			"1",			CVAR_GAME | CVAR_INTEGER, "broadphase used to find the clip models touching a bounds, takes effect on the next map load. 0 = clip sectors, 1 = dynamic bounding volume tree", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1> );
+idCVar g_parallelPhysics(			"g_parallelPhysics",		"2",			CVAR_GAME | CVAR_INTEGER, "number of job threads predicting the motion of independent rigid bodies, 0 = no prediction", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
+idCVar g_showPhysicsIslands(		"g_showPhysicsIslands",		"0",			CVAR_GAME | CVAR_BOOL, "print the number of physics islands and predicted rigid bodies each frame" );
 idCVar g_maxShowDistance(			"g_maxShowDistance",		"128",			CVAR_GAME | CVAR_FLOAT, "" );
 idCVar g_showEntityInfo(			"g_showEntityInfo",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showviewpos(				"g_showviewpos",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -146,6 +157,7 @@ idCVar g_showActiveEntities(		"g_showActiveEntities",		"0",			CVAR_GAME | CVAR_B
 idCVar g_showEnemies(				"g_showEnemies",			"0",			CVAR_GAME | CVAR_BOOL, "draws boxes around monsters that have targeted the the player" );
 
 idCVar g_frametime(					"g_frametime",				"0",			CVAR_GAME | CVAR_BOOL, "displays timing information for each game frame" );
+idCVar g_showEventAllocs(			"g_showEventAllocs",		"0",			CVAR_GAME | CVAR_BOOL, "displays the number of event argument blocks and heap allocations made by the event system for each game frame" );
 idCVar g_timeentities(				"g_timeEntities",			"0",			CVAR_GAME | CVAR_FLOAT, "when non-zero, shows entities whose think functions exceeded the # of milliseconds specified" );
 
 idCVar ai_debugScript(				"ai_debugScript",			"-1",			CVAR_GAME | CVAR_INTEGER, "displays script calls for the specified monster entity number" );
@@ -156,6 +168,13 @@ idCVar ai_showCombatNodes(			"ai_showCombatNodes",		"0",			CVAR_GAME | CVAR_BOOL
 idCVar ai_showPaths(				"ai_showPaths",				"0",			CVAR_GAME | CVAR_BOOL, "draws path_* entities" );
 idCVar ai_showObstacleAvoidance(	"ai_showObstacleAvoidance",	"0",			CVAR_GAME | CVAR_INTEGER, "draws obstacle avoidance information for monsters.  if 2, draws obstacles for player, as well", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar ai_blockedFailSafe(			"ai_blockedFailSafe",		"1",			CVAR_GAME | CVAR_BOOL, "enable blocked fail safe handling" );
+idCVar ai_pathBudget(				"ai_pathBudget",			"2",			CVAR_GAME | CVAR_FLOAT, "milliseconds per frame the AI may spend starting path and goal searches, monsters over budget wait for a later frame, 0 = no limit" );
+idCVar ai_showPathQueue(			"ai_showPathQueue",			"0",			CVAR_GAME | CVAR_BOOL, "print the AI path search time and the monsters waiting for the budget each frame" );
+idCVar ai_thinkLOD(					"ai_thinkLOD",				"1",			CVAR_GAME | CVAR_BOOL, "run the script and senses of monsters out of combat less often when they are far away or outside the player PVS" );
+idCVar ai_lodDistance(				"ai_lodDistance",			"1024",			CVAR_GAME | CVAR_FLOAT, "distance from the player beyond which monsters in the player PVS think at the near level of detail" );
+idCVar ai_lodNearInterval(			"ai_lodNearInterval",		"2",			CVAR_GAME | CVAR_INTEGER, "frames between script and sense updates of monsters far away in the player PVS", 1, 16 );
+idCVar ai_lodFarInterval(			"ai_lodFarInterval",		"4",			CVAR_GAME | CVAR_INTEGER, "frames between script, sense and animation updates of monsters outside the player PVS", 1, 16 );
+idCVar ai_showThinkLOD(				"ai_showThinkLOD",			"0",			CVAR_GAME | CVAR_BOOL, "print the AI think time per level of detail each frame" );
 
 idCVar g_dvTime(					"g_dvTime",					"1",			CVAR_GAME | CVAR_FLOAT, "" );
 idCVar g_dvAmplitude(				"g_dvAmplitude",			"0.001",		CVAR_GAME | CVAR_FLOAT, "" );
@@ -195,6 +214,7 @@ idCVar af_useLinearTime(			"af_useLinearTime",			"1",			CVAR_GAME | CVAR_BOOL, "
 idCVar af_useImpulseFriction(		"af_useImpulseFriction",	"0",			CVAR_GAME | CVAR_BOOL, "use impulse based contact friction" );
 idCVar af_useJointImpulseFriction(	"af_useJointImpulseFriction","0",			CVAR_GAME | CVAR_BOOL, "use impulse based joint friction" );
 idCVar af_useSymmetry(				"af_useSymmetry",			"1",			CVAR_GAME | CVAR_BOOL, "use constraint matrix symmetry" );
+idCVar af_lcpWarmStart(			"af_lcpWarmStart",			"1",			CVAR_GAME | CVAR_BOOL, "start the lcp solver from the previous frame's solution" );
 idCVar af_skipSelfCollision(		"af_skipSelfCollision",		"0",			CVAR_GAME | CVAR_BOOL, "skip self collision detection" );
 idCVar af_skipLimits(				"af_skipLimits",			"0",			CVAR_GAME | CVAR_BOOL, "skip joint limits" );
 idCVar af_skipFriction(				"af_skipFriction",			"0",			CVAR_GAME | CVAR_BOOL, "skip friction" );
@@ -206,7 +226,7 @@ idCVar af_jointFrictionScale(		"af_jointFrictionScale",	"0",			CVAR_GAME | CVAR_
 idCVar af_contactFrictionScale(		"af_contactFrictionScale",	"0",			CVAR_GAME | CVAR_FLOAT, "scales the contact friction" );
 idCVar af_highlightBody(			"af_highlightBody",			"",				CVAR_GAME, "name of the body to highlight" );
 idCVar af_highlightConstraint(		"af_highlightConstraint",	"",				CVAR_GAME, "name of the constraint to highlight" );
-idCVar af_showTimings(				"af_showTimings",			"0",			CVAR_GAME | CVAR_BOOL, "show articulated figure cpu usage" );
+idCVar af_showTimings(				"af_showTimings",			"0",			CVAR_GAME | CVAR_INTEGER, "show articulated figure cpu usage, 1 = per figure, 2 = summed over all figures per frame" );
 idCVar af_showConstraints(			"af_showConstraints",		"0",			CVAR_GAME | CVAR_BOOL, "show constraints" );
 idCVar af_showConstraintNames(		"af_showConstraintNames",	"0",			CVAR_GAME | CVAR_BOOL, "show constraint names" );
 idCVar af_showConstrainedBodies(	"af_showConstrainedBodies",	"0",			CVAR_GAME | CVAR_BOOL, "show the two bodies contrained by the highlighted constraint" );
@@ -228,6 +248,8 @@ idCVar rb_showMass(					"rb_showMass",				"0",			CVAR_GAME | CVAR_BOOL, "show th
 idCVar rb_showInertia(				"rb_showInertia",			"0",			CVAR_GAME | CVAR_BOOL, "show the inertia tensor of each rigid body" );
 idCVar rb_showVelocity(				"rb_showVelocity",			"0",			CVAR_GAME | CVAR_BOOL, "show the velocity of each rigid body" );
 idCVar rb_showActive(				"rb_showActive",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid bodies that are not at rest" );
+idCVar rb_showSleep(				"rb_showSleep",				"0",			CVAR_GAME | CVAR_BOOL, "print the number of active, sleeping and woken rigid bodies each frame" );
+idCVar rb_sleepIslands(			"rb_sleepIslands",			"1",			CVAR_GAME | CVAR_BOOL, "put rigid bodies to sleep together with their contact island" );
 
 // The default values for player movement cvars are set in def/player.def
 idCVar pm_jumpheight(				"pm_jumpheight",			"48",			CVAR_GAME | CVAR_NETWORKSYNC | CVAR_FLOAT, "approximate hieght the player can jump" );
@@ -307,6 +329,11 @@ idCVar aas_pullPlayer(				"aas_pullPlayer",			"0",			CVAR_GAME | CVAR_INTEGER, "
 idCVar aas_randomPullPlayer(		"aas_randomPullPlayer",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar aas_goalArea(				"aas_goalArea",				"0",			CVAR_GAME | CVAR_INTEGER, "" );
 idCVar aas_showPushIntoArea(		"aas_showPushIntoArea",		"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar aas_precomputeRouting(		"aas_precomputeRouting",	"0",			CVAR_GAME | CVAR_BOOL, "build the routing cache at map load on worker threads instead of on demand" );
+idCVar aas_precomputeMemory(		"aas_precomputeMemory",		"16384",		CVAR_GAME | CVAR_INTEGER, "memory budget in KB for the precomputed routing cache" );
+idCVar aas_writeRoutingCache(		"aas_writeRoutingCache",	"0",			CVAR_GAME | CVAR_BOOL, "write the precomputed routing cache to generated/<aasfile>.rcache" );
+idCVar aas_routingCacheMemory(		"aas_routingCacheMemory",	"2048",			CVAR_GAME | CVAR_INTEGER, "memory budget in KB for the routing cache built on demand" );
+idCVar aas_showRouteHitches(		"aas_showRouteHitches",		"0",			CVAR_GAME | CVAR_FLOAT, "print routes that build routing cache and take at least this many milliseconds" );
 
 idCVar g_password(					"g_password",				"",				CVAR_GAME | CVAR_ARCHIVE, "game password" );
 idCVar password(					"password",					"",				CVAR_GAME | CVAR_NOCHEAT, "client password used when connecting" );
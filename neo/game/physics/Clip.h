@@ -29,6 +29,8 @@ If you have questions concerning this license or the applicable additional terms
 #ifndef __CLIP_H__
 #define __CLIP_H__
 
+#include <atomic>
+
 /*
 ===============================================================================
 
@@ -42,6 +44,7 @@ If you have questions concerning this license or the applicable additional terms
 
 class idClip;
 class idClipModel;
+class idClipBroadphase;
 class idEntity;
 
 
@@ -54,6 +57,9 @@ class idEntity;
 class idClipModel {
 
 	friend class idClip;
+	friend class idClipBroadphase;
+	friend class idClipSectors;
+	friend class idClipTree;
 
 public:
 							idClipModel( void );
@@ -72,7 +78,7 @@ public:
 
 	void					Link( idClip &clp );				// must have been linked with an entity and id before
 	void					Link( idClip &clp, idEntity *ent, int newId, const idVec3 &newOrigin, const idMat3 &newAxis, int renderModelHandle = -1 );
-	void					Unlink( void );						// unlink from sectors
+	void					Unlink( void );						// unlink from the broadphase
 	void					SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis );	// unlinks the clip model
 	void					Translate( const idVec3 &translation );							// unlinks the clip model
 	void					Rotate( const idRotation &rotation );							// unlinks the clip model
@@ -123,11 +129,13 @@ private:
 	int						traceModelIndex;		// trace model used for collision detection
 	int						renderModelHandle;		// render model def handle
 
+	idClipBroadphase *		broadphase;				// broadphase with data for this clip model
+	bool					linked;					// true if linked into the broadphase
 	struct clipLink_s *		clipLinks;				// links into sectors
 	int						touchCount;
+	int						proxyId;				// leaf in the broadphase tree
 
 	void					Init( void );			// initialize
-	void					Link_r( struct clipSector_s *node );
 
 	static int				AllocTraceModel( const idTraceModel &trm );
 	static void				FreeTraceModel( int traceModelIndex );
@@ -147,14 +155,6 @@ ID_INLINE void idClipModel::Rotate( const idRotation &rotation ) {
 	axis *= rotation.ToMat3();
 }
 
-ID_INLINE void idClipModel::Enable( void ) {
-	enabled = true;
-}
-
-ID_INLINE void idClipModel::Disable( void ) {
-	enabled = false;
-}
-
 ID_INLINE void idClipModel::SetMaterial( const idMaterial *m ) {
 	material = m;
 }
@@ -163,10 +163,6 @@ ID_INLINE const idMaterial * idClipModel::GetMaterial( void ) const {
 	return material;
 }
 
-ID_INLINE void idClipModel::SetContents( int newContents ) {
-	contents = newContents;
-}
-
 ID_INLINE int idClipModel::GetContents( void ) const {
 	return contents;
 }
@@ -220,7 +216,7 @@ ID_INLINE bool idClipModel::IsTraceModel( void ) const {
 }
 
 ID_INLINE bool idClipModel::IsLinked( void ) const {
-	return ( clipLinks != NULL );
+	return linked;
 }
 
 ID_INLINE bool idClipModel::IsEnabled( void ) const {
@@ -272,6 +268,9 @@ public:
 								int contentMask, const idEntity *passEntity );
 	bool					TraceBounds( trace_t &results, const idVec3 &start, const idVec3 &end, const idBounds &bounds,
 								int contentMask, const idEntity *passEntity );
+							// traces a batch of points, gives the same results as a TracePoint for every start/end pair
+	void					TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints,
+								int contentMask, const idEntity *passEntity );
 
 	// clip versus a specific model
 	void					TranslationModel( trace_t &results, const idVec3 &start, const idVec3 &end,
@@ -297,33 +296,49 @@ public:
 	// get entities/clip models within or touching the given bounds
 	int						EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const;
 	int						ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
+							// get clip models touching any of the bounds in a single pass, clipModelList[i] touches bounds[boundsIndex[i]]
+	int						ClipModelsTouchingBoundsBatch( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int *boundsIndex, int maxCount ) const;
 
 	const idBounds &		GetWorldBounds( void ) const;
 	idClipModel *			DefaultClipModel( void );
 
+							// true if the clip model queries and traces can be used from several threads at once
+	bool					ConcurrentQueries( void ) const;
+
+							// keep track of where clip models are linked, unlinked, enabled, disabled or change contents
+	void					BeginChangeTracking( void );
+	void					EndChangeTracking( void );
+							// true if a clip model of another entity than passEntity changed within the bounds since tracking began
+	bool					ChangedSinceTracking( const idBounds &bounds, const idEntity *passEntity ) const;
+
 							// stats and debug drawing
 	void					PrintStatistics( void );
 	void					DrawClipModels( const idVec3 &eye, const float radius, const idEntity *passEntity );
 	bool					DrawModelContactFeature( const contactInfo_t &contact, const idClipModel *clipModel, int lifetime ) const;
 
 private:
-	int						numClipSectors;
-	struct clipSector_s *	clipSectors;
+	idClipBroadphase *		broadphase;
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
-	mutable int				touchCount;
-							// statistics
-	int						numTranslations;
-	int						numRotations;
-	int						numMotions;
-	int						numRenderModelTraces;
-	int						numContents;
-	int						numContacts;
+							// statistics, also counted by the motion prediction threads
+	std::atomic<int>		numTranslations;
+	std::atomic<int>		numRotations;
+	std::atomic<int>		numMotions;
+	std::atomic<int>		numRenderModelTraces;
+	std::atomic<int>		numContents;
+	std::atomic<int>		numContacts;
+							// change tracking
+	typedef struct clipChange_s {
+		idBounds			bounds;
+		const idEntity *	entity;
+	} clipChange_t;
+	bool					trackChanges;
+	idList<clipChange_t>	changes;
+	idBounds				changedBounds;		// bounds of all changes
 
 private:
-	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
-	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
+	void					ClipModelChanged( const idClipModel *mdl );
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
@@ -0,0 +1,1042 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#include "../../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "../Game_local.h"
+
+#define	MAX_SECTOR_DEPTH				12
+#define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
+
+#define CLIP_TREE_MARGIN				8.0f		// leaf bounds are expanded with this margin
+#define CLIP_TREE_STACK_SIZE			256
+
+/*
+===============================================================
+
+	idClipBroadphase
+
+===============================================================
+*/
+
+/*
+================
+idClipBroadphase::Alloc
+================
+*/
+idClipBroadphase *idClipBroadphase::Alloc( int type ) {
+	if ( type == CLIP_BROADPHASE_SECTORS ) {
+		return new idClipSectors;
+	}
+	return new idClipTree;
+}
+
+/*
+================
+idClipBroadphase::ClipModelTouches
+================
+*/
+ID_INLINE bool idClipBroadphase::ClipModelTouches( const idClipModel *clipModel, const idBounds &bounds, int contentMask ) {
+	// if the clip model is linked and enabled
+	if ( !clipModel->linked || !clipModel->enabled ) {
+		return false;
+	}
+	// if the clip model does not have any contents we are looking for
+	if ( !( clipModel->contents & contentMask ) ) {
+		return false;
+	}
+	// if the bounds really do overlap
+	return BoundsTouch( clipModel->absBounds, bounds );
+}
+
+/*
+================
+idClipBroadphase::SetBroadphase
+================
+*/
+void idClipBroadphase::SetBroadphase( idClipModel *clipModel, idClipBroadphase *broadphase, bool linked ) {
+	clipModel->broadphase = broadphase;
+	clipModel->linked = linked;
+}
+
+/*
+================
+idClipBroadphase::ClipModelsTouchingBoundsBatch
+================
+*/
+int idClipBroadphase::ClipModelsTouchingBoundsBatch( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int *boundsIndex, int maxCount ) const {
+	int i, j, num, count;
+
+	count = 0;
+	for ( i = 0; i < numBounds; i++ ) {
+		num = ClipModelsTouchingBounds( bounds[i], contentMask, clipModelList + count, maxCount - count );
+		for ( j = 0; j < num; j++ ) {
+			boundsIndex[count+j] = i;
+		}
+		count += num;
+	}
+	return count;
+}
+
+/*
+================
+idClipBroadphase::Benchmark
+
+Moves boxes through the world in a random walk and times relinking
+them and querying the bounds around each of them.
+================
+*/
+void idClipBroadphase::Benchmark( const idBounds &worldBounds, int numClipModels, int numFrames ) {
+	int					i, j, k, type, num, numTouches, numBatchTouches;
+	idRandom			random;
+	idTimer				linkTimer, queryTimer, batchTimer;
+	idClipBroadphase *	broadphase;
+	idList<idClipModel *> clipModels;
+	idClipModel *		clipModelList[MAX_GENTITIES];
+	int					boundsIndex[MAX_GENTITIES];
+	idBounds			queryBounds[CLIP_BROADPHASE_MAX_BATCH];
+	idVec3				size, origin, move;
+
+	size = worldBounds[1] - worldBounds[0];
+
+	gameLocal.Printf( "%d clip models moving for %d frames\n", numClipModels, numFrames );
+
+	for ( type = CLIP_BROADPHASE_SECTORS; type <= CLIP_BROADPHASE_TREE; type++ ) {
+		broadphase = Alloc( type );
+		broadphase->Init( worldBounds );
+
+		// use the same boxes and moves for every broadphase
+		random.SetSeed( 0 );
+
+		linkTimer.Clear();
+		queryTimer.Clear();
+		batchTimer.Clear();
+		numTouches = 0;
+		numBatchTouches = 0;
+
+		clipModels.SetNum( numClipModels );
+		for ( i = 0; i < numClipModels; i++ ) {
+			clipModels[i] = new idClipModel();
+			origin.x = worldBounds[0].x + random.RandomFloat() * size.x;
+			origin.y = worldBounds[0].y + random.RandomFloat() * size.y;
+			origin.z = worldBounds[0].z + random.RandomFloat() * size.z;
+			clipModels[i]->bounds = idBounds( vec3_origin ).Expand( 8.0f + random.RandomFloat() * 24.0f );
+			clipModels[i]->absBounds = clipModels[i]->bounds + origin;
+		}
+
+		linkTimer.Start();
+		for ( i = 0; i < numClipModels; i++ ) {
+			broadphase->Link( clipModels[i] );
+		}
+		linkTimer.Stop();
+
+		for ( j = 0; j < numFrames; j++ ) {
+			linkTimer.Start();
+			for ( i = 0; i < numClipModels; i++ ) {
+				move.x = random.CRandomFloat() * 8.0f;
+				move.y = random.CRandomFloat() * 8.0f;
+				move.z = random.CRandomFloat() * 8.0f;
+				broadphase->Unlink( clipModels[i] );
+				clipModels[i]->absBounds += move;
+				broadphase->Link( clipModels[i] );
+			}
+			linkTimer.Stop();
+
+			queryTimer.Start();
+			for ( i = 0; i < numClipModels; i++ ) {
+				numTouches += broadphase->ClipModelsTouchingBounds( clipModels[i]->absBounds.Expand( 16.0f ), -1, clipModelList, MAX_GENTITIES );
+			}
+			queryTimer.Stop();
+
+			batchTimer.Start();
+			for ( i = 0; i < numClipModels; i += num ) {
+				num = Min( numClipModels - i, CLIP_BROADPHASE_MAX_BATCH );
+				for ( k = 0; k < num; k++ ) {
+					queryBounds[k] = clipModels[i+k]->absBounds.Expand( 16.0f );
+				}
+				numBatchTouches += broadphase->ClipModelsTouchingBoundsBatch( queryBounds, num, -1, clipModelList, boundsIndex, MAX_GENTITIES );
+			}
+			batchTimer.Stop();
+		}
+
+		gameLocal.Printf( "%-8s link %8.2f msec, query %8.2f msec, batched query %8.2f msec, %d touches\n", broadphase->GetName(),
+							linkTimer.Milliseconds(), queryTimer.Milliseconds(), batchTimer.Milliseconds(), numTouches );
+		if ( numBatchTouches != numTouches ) {
+			gameLocal.Warning( "%s batched queries found %d touches", broadphase->GetName(), numBatchTouches );
+		}
+
+		clipModels.DeleteContents( true );
+		broadphase->Shutdown();
+		delete broadphase;
+	}
+}
+
+
+/*
+===============================================================
+
+	idClipSectors
+
+===============================================================
+*/
+
+/*
+===============
+idClipSectors::idClipSectors
+===============
+*/
+idClipSectors::idClipSectors( void ) {
+	numClipSectors = 0;
+	clipSectors = NULL;
+	maxSector.Zero();
+	touchCount = -1;
+}
+
+/*
+===============
+idClipSectors::~idClipSectors
+===============
+*/
+idClipSectors::~idClipSectors( void ) {
+	Shutdown();
+}
+
+/*
+===============
+idClipSectors::CreateClipSectors_r
+
+Builds a uniformly subdivided tree for the given world size
+===============
+*/
+clipSector_t *idClipSectors::CreateClipSectors_r( const int depth, const idBounds &bounds ) {
+	int				i;
+	clipSector_t	*anode;
+	idVec3			size;
+	idBounds		front, back;
+
+	anode = &clipSectors[numClipSectors];
+	numClipSectors++;
+
+	if ( depth == MAX_SECTOR_DEPTH ) {
+		anode->axis = -1;
+		anode->children[0] = anode->children[1] = NULL;
+
+		for ( i = 0; i < 3; i++ ) {
+			if ( bounds[1][i] - bounds[0][i] > maxSector[i] ) {
+				maxSector[i] = bounds[1][i] - bounds[0][i];
+			}
+		}
+		return anode;
+	}
+
+	size = bounds[1] - bounds[0];
+	if ( size[0] >= size[1] && size[0] >= size[2] ) {
+		anode->axis = 0;
+	} else if ( size[1] >= size[0] && size[1] >= size[2] ) {
+		anode->axis = 1;
+	} else {
+		anode->axis = 2;
+	}
+
+	anode->dist = 0.5f * ( bounds[1][anode->axis] + bounds[0][anode->axis] );
+
+	front = bounds;
+	back = bounds;
+
+	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
+
+	anode->children[0] = CreateClipSectors_r( depth+1, front );
+	anode->children[1] = CreateClipSectors_r( depth+1, back );
+
+	return anode;
+}
+
+/*
+===============
+idClipSectors::Init
+===============
+*/
+void idClipSectors::Init( const idBounds &worldBounds ) {
+	// clear clip sectors
+	clipSectors = new clipSector_t[MAX_SECTORS];
+	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
+	numClipSectors = 0;
+	maxSector.Zero();
+	touchCount = -1;
+	// create world sectors
+	CreateClipSectors_r( 0, worldBounds );
+}
+
+/*
+===============
+idClipSectors::Shutdown
+===============
+*/
+void idClipSectors::Shutdown( void ) {
+	int i;
+	clipLink_t *link;
+
+	if ( !clipSectors ) {
+		return;
+	}
+
+	// clip models that are still linked no longer reference the sectors
+	for ( i = 0; i < numClipSectors; i++ ) {
+		for ( link = clipSectors[i].clipLinks; link; link = link->nextInSector ) {
+			link->clipModel->clipLinks = NULL;
+			SetBroadphase( link->clipModel, NULL, false );
+		}
+	}
+
+	delete[] clipSectors;
+	clipSectors = NULL;
+	numClipSectors = 0;
+
+	clipLinkAllocator.Shutdown();
+}
+
+/*
+===============
+idClipSectors::Link_r
+===============
+*/
+void idClipSectors::Link_r( idClipModel *clipModel, clipSector_t *node ) {
+	clipLink_t *link;
+	const idBounds &absBounds = clipModel->absBounds;
+
+	while( node->axis != -1 ) {
+		if ( absBounds[0][node->axis] > node->dist ) {
+			node = node->children[0];
+		} else if ( absBounds[1][node->axis] < node->dist ) {
+			node = node->children[1];
+		} else {
+			Link_r( clipModel, node->children[0] );
+			node = node->children[1];
+		}
+	}
+
+	link = clipLinkAllocator.Alloc();
+	link->clipModel = clipModel;
+	link->sector = node;
+	link->nextInSector = node->clipLinks;
+	link->prevInSector = NULL;
+	if ( node->clipLinks ) {
+		node->clipLinks->prevInSector = link;
+	}
+	node->clipLinks = link;
+	link->nextLink = clipModel->clipLinks;
+	clipModel->clipLinks = link;
+}
+
+/*
+===============
+idClipSectors::Link
+===============
+*/
+void idClipSectors::Link( idClipModel *clipModel ) {
+	Link_r( clipModel, clipSectors );
+	SetBroadphase( clipModel, this, true );
+}
+
+/*
+===============
+idClipSectors::Unlink
+===============
+*/
+void idClipSectors::Unlink( idClipModel *clipModel ) {
+	clipLink_t *link;
+
+	for ( link = clipModel->clipLinks; link; link = clipModel->clipLinks ) {
+		clipModel->clipLinks = link->nextLink;
+		if ( link->prevInSector ) {
+			link->prevInSector->nextInSector = link->nextInSector;
+		} else {
+			link->sector->clipLinks = link->nextInSector;
+		}
+		if ( link->nextInSector ) {
+			link->nextInSector->prevInSector = link->prevInSector;
+		}
+		clipLinkAllocator.Free( link );
+	}
+	SetBroadphase( clipModel, NULL, false );
+}
+
+/*
+===============
+idClipSectors::Remove
+===============
+*/
+void idClipSectors::Remove( idClipModel *clipModel ) {
+	Unlink( clipModel );
+}
+
+/*
+====================
+idClipSectors::ClipModelsTouchingBounds_r
+====================
+*/
+typedef struct listParms_s {
+	idBounds		bounds;
+	int				contentMask;
+	idClipModel	**	list;
+	int				count;
+	int				maxCount;
+} listParms_t;
+
+void idClipSectors::ClipModelsTouchingBounds_r( const clipSector_t *node, listParms_t &parms ) const {
+
+	while( node->axis != -1 ) {
+		if ( parms.bounds[0][node->axis] > node->dist ) {
+			node = node->children[0];
+		} else if ( parms.bounds[1][node->axis] < node->dist ) {
+			node = node->children[1];
+		} else {
+			ClipModelsTouchingBounds_r( node->children[0], parms );
+			node = node->children[1];
+		}
+	}
+
+	for ( clipLink_t *link = node->clipLinks; link; link = link->nextInSector ) {
+		idClipModel	*check = link->clipModel;
+
+		// avoid duplicates in the list
+		if ( check->touchCount == touchCount ) {
+			continue;
+		}
+
+		if ( !ClipModelTouches( check, parms.bounds, parms.contentMask ) ) {
+			continue;
+		}
+
+		if ( parms.count >= parms.maxCount ) {
+			gameLocal.Warning( "idClipSectors::ClipModelsTouchingBounds_r: max count" );
+			return;
+		}
+
+		check->touchCount = touchCount;
+		parms.list[parms.count] = check;
+		parms.count++;
+	}
+}
+
+/*
+================
+idClipSectors::ClipModelsTouchingBounds
+================
+*/
+int idClipSectors::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
+	listParms_t parms;
+
+	parms.bounds = bounds;
+	parms.contentMask = contentMask;
+	parms.list = clipModelList;
+	parms.count = 0;
+	parms.maxCount = maxCount;
+
+	touchCount++;
+	ClipModelsTouchingBounds_r( clipSectors, parms );
+
+	return parms.count;
+}
+
+/*
+================
+idClipSectors::PrintStatistics
+================
+*/
+void idClipSectors::PrintStatistics( void ) {
+	gameLocal.Printf( "clip sectors = %d, max clip sector is (%1.1f, %1.1f, %1.1f)\n", numClipSectors, maxSector[0], maxSector[1], maxSector[2] );
+}
+
+
+/*
+===============================================================
+
+	idClipTree
+
+===============================================================
+*/
+
+/*
+================
+ClipTreeSurfaceArea
+================
+*/
+static ID_INLINE float ClipTreeSurfaceArea( const idBounds &bounds ) {
+	idVec3 size = bounds[1] - bounds[0];
+	return 2.0f * ( size.x * size.y + size.y * size.z + size.z * size.x );
+}
+
+/*
+================
+ClipTreeContains
+================
+*/
+static ID_INLINE bool ClipTreeContains( const idBounds &outer, const idBounds &inner ) {
+	return	inner[0][0] >= outer[0][0] && inner[1][0] <= outer[1][0] &&
+			inner[0][1] >= outer[0][1] && inner[1][1] <= outer[1][1] &&
+			inner[0][2] >= outer[0][2] && inner[1][2] <= outer[1][2];
+}
+
+/*
+================
+idClipTree::idClipTree
+================
+*/
+idClipTree::idClipTree( void ) {
+	root = -1;
+	freeNodes = -1;
+	numLeaves = 0;
+	numRelinks = 0;
+	numFastLinks = 0;
+}
+
+/*
+================
+idClipTree::~idClipTree
+================
+*/
+idClipTree::~idClipTree( void ) {
+	Shutdown();
+}
+
+/*
+================
+idClipTree::Init
+================
+*/
+void idClipTree::Init( const idBounds &worldBounds ) {
+	nodes.SetGranularity( 1024 );
+	nodes.Clear();
+	root = -1;
+	freeNodes = -1;
+	numLeaves = 0;
+	numRelinks = 0;
+	numFastLinks = 0;
+}
+
+/*
+================
+idClipTree::Shutdown
+================
+*/
+void idClipTree::Shutdown( void ) {
+	int i;
+
+	// clip models that are still in the tree no longer reference it
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		if ( nodes[i].height == 0 && nodes[i].clipModel ) {
+			nodes[i].clipModel->proxyId = -1;
+			SetBroadphase( nodes[i].clipModel, NULL, false );
+		}
+	}
+
+	nodes.Clear();
+	root = -1;
+	freeNodes = -1;
+	numLeaves = 0;
+}
+
+/*
+================
+idClipTree::AllocNode
+================
+*/
+int idClipTree::AllocNode( void ) {
+	int nodeNum;
+
+	if ( freeNodes == -1 ) {
+		nodeNum = nodes.Num();
+		nodes.Alloc();
+	} else {
+		nodeNum = freeNodes;
+		freeNodes = nodes[nodeNum].parent;
+	}
+
+	clipTreeNode_t &node = nodes[nodeNum];
+	node.bounds.Clear();
+	node.parent = -1;
+	node.children[0] = node.children[1] = -1;
+	node.height = 0;
+	node.clipModel = NULL;
+
+	return nodeNum;
+}
+
+/*
+================
+idClipTree::FreeNode
+================
+*/
+void idClipTree::FreeNode( int nodeNum ) {
+	nodes[nodeNum].parent = freeNodes;
+	nodes[nodeNum].height = -1;
+	nodes[nodeNum].clipModel = NULL;
+	freeNodes = nodeNum;
+}
+
+/*
+================
+idClipTree::Balance
+
+Performs a left or right rotation if node A is imbalanced and returns the new root of the sub tree.
+================
+*/
+int idClipTree::Balance( int iA ) {
+	int iB, iC, iF, iG, iD, iE;
+
+	clipTreeNode_t *A = &nodes[iA];
+	if ( A->children[0] == -1 || A->height < 2 ) {
+		return iA;
+	}
+
+	iB = A->children[0];
+	iC = A->children[1];
+	clipTreeNode_t *B = &nodes[iB];
+	clipTreeNode_t *C = &nodes[iC];
+
+	int balance = C->height - B->height;
+
+	// rotate C up
+	if ( balance > 1 ) {
+		iF = C->children[0];
+		iG = C->children[1];
+		clipTreeNode_t *F = &nodes[iF];
+		clipTreeNode_t *G = &nodes[iG];
+
+		// swap A and C
+		C->children[0] = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		// A's old parent should point to C
+		if ( C->parent != -1 ) {
+			if ( nodes[C->parent].children[0] == iA ) {
+				nodes[C->parent].children[0] = iC;
+			} else {
+				nodes[C->parent].children[1] = iC;
+			}
+		} else {
+			root = iC;
+		}
+
+		// rotate
+		if ( F->height > G->height ) {
+			C->children[1] = iF;
+			A->children[1] = iG;
+			G->parent = iA;
+			A->bounds = B->bounds + G->bounds;
+			C->bounds = A->bounds + F->bounds;
+			A->height = 1 + Max( B->height, G->height );
+			C->height = 1 + Max( A->height, F->height );
+		} else {
+			C->children[1] = iG;
+			A->children[1] = iF;
+			F->parent = iA;
+			A->bounds = B->bounds + F->bounds;
+			C->bounds = A->bounds + G->bounds;
+			A->height = 1 + Max( B->height, F->height );
+			C->height = 1 + Max( A->height, G->height );
+		}
+		return iC;
+	}
+
+	// rotate B up
+	if ( balance < -1 ) {
+		iD = B->children[0];
+		iE = B->children[1];
+		clipTreeNode_t *D = &nodes[iD];
+		clipTreeNode_t *E = &nodes[iE];
+
+		// swap A and B
+		B->children[0] = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		// A's old parent should point to B
+		if ( B->parent != -1 ) {
+			if ( nodes[B->parent].children[0] == iA ) {
+				nodes[B->parent].children[0] = iB;
+			} else {
+				nodes[B->parent].children[1] = iB;
+			}
+		} else {
+			root = iB;
+		}
+
+		// rotate
+		if ( D->height > E->height ) {
+			B->children[1] = iD;
+			A->children[0] = iE;
+			E->parent = iA;
+			A->bounds = C->bounds + E->bounds;
+			B->bounds = A->bounds + D->bounds;
+			A->height = 1 + Max( C->height, E->height );
+			B->height = 1 + Max( A->height, D->height );
+		} else {
+			B->children[1] = iE;
+			A->children[0] = iD;
+			D->parent = iA;
+			A->bounds = C->bounds + D->bounds;
+			B->bounds = A->bounds + E->bounds;
+			A->height = 1 + Max( C->height, D->height );
+			B->height = 1 + Max( A->height, E->height );
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
+/*
+================
+idClipTree::InsertLeaf
+================
+*/
+void idClipTree::InsertLeaf( int leaf ) {
+	int index, sibling, oldParent, newParent, child0, child1;
+	float area, combinedArea, cost, inheritanceCost, cost0, cost1;
+	idBounds leafBounds;
+
+	if ( root == -1 ) {
+		root = leaf;
+		nodes[root].parent = -1;
+		return;
+	}
+
+	// find the best sibling for the leaf
+	leafBounds = nodes[leaf].bounds;
+	index = root;
+	while ( nodes[index].children[0] != -1 ) {
+		const clipTreeNode_t &node = nodes[index];
+		child0 = node.children[0];
+		child1 = node.children[1];
+
+		area = ClipTreeSurfaceArea( node.bounds );
+		combinedArea = ClipTreeSurfaceArea( node.bounds + leafBounds );
+
+		// cost of creating a new parent for this node and the new leaf
+		cost = 2.0f * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		inheritanceCost = 2.0f * ( combinedArea - area );
+
+		// cost of descending into a child
+		cost0 = ClipTreeSurfaceArea( leafBounds + nodes[child0].bounds ) + inheritanceCost;
+		if ( nodes[child0].children[0] != -1 ) {
+			cost0 -= ClipTreeSurfaceArea( nodes[child0].bounds );
+		}
+		cost1 = ClipTreeSurfaceArea( leafBounds + nodes[child1].bounds ) + inheritanceCost;
+		if ( nodes[child1].children[0] != -1 ) {
+			cost1 -= ClipTreeSurfaceArea( nodes[child1].bounds );
+		}
+
+		if ( cost < cost0 && cost < cost1 ) {
+			break;
+		}
+
+		index = ( cost0 < cost1 ) ? child0 : child1;
+	}
+	sibling = index;
+
+	// create a new parent
+	oldParent = nodes[sibling].parent;
+	newParent = AllocNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].bounds = leafBounds + nodes[sibling].bounds;
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].children[0] = sibling;
+	nodes[newParent].children[1] = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if ( oldParent != -1 ) {
+		if ( nodes[oldParent].children[0] == sibling ) {
+			nodes[oldParent].children[0] = newParent;
+		} else {
+			nodes[oldParent].children[1] = newParent;
+		}
+	} else {
+		root = newParent;
+	}
+
+	// walk back up the tree fixing heights and bounds
+	for ( index = nodes[leaf].parent; index != -1; index = nodes[index].parent ) {
+		index = Balance( index );
+
+		child0 = nodes[index].children[0];
+		child1 = nodes[index].children[1];
+
+		nodes[index].height = 1 + Max( nodes[child0].height, nodes[child1].height );
+		nodes[index].bounds = nodes[child0].bounds + nodes[child1].bounds;
+	}
+}
+
+/*
+================
+idClipTree::RemoveLeaf
+================
+*/
+void idClipTree::RemoveLeaf( int leaf ) {
+	int index, parent, grandParent, sibling, child0, child1;
+
+	if ( leaf == root ) {
+		root = -1;
+		return;
+	}
+
+	parent = nodes[leaf].parent;
+	grandParent = nodes[parent].parent;
+	sibling = ( nodes[parent].children[0] == leaf ) ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	if ( grandParent == -1 ) {
+		root = sibling;
+		nodes[sibling].parent = -1;
+		FreeNode( parent );
+		return;
+	}
+
+	// destroy the parent and connect the sibling to the grand parent
+	if ( nodes[grandParent].children[0] == parent ) {
+		nodes[grandParent].children[0] = sibling;
+	} else {
+		nodes[grandParent].children[1] = sibling;
+	}
+	nodes[sibling].parent = grandParent;
+	FreeNode( parent );
+
+	// adjust ancestor bounds
+	for ( index = grandParent; index != -1; index = nodes[index].parent ) {
+		index = Balance( index );
+
+		child0 = nodes[index].children[0];
+		child1 = nodes[index].children[1];
+
+		nodes[index].bounds = nodes[child0].bounds + nodes[child1].bounds;
+		nodes[index].height = 1 + Max( nodes[child0].height, nodes[child1].height );
+	}
+}
+
+/*
+================
+idClipTree::Link
+================
+*/
+void idClipTree::Link( idClipModel *clipModel ) {
+	int leaf;
+
+	leaf = clipModel->proxyId;
+	if ( leaf != -1 ) {
+		assert( clipModel->broadphase == this );
+
+		// the clip model didn't leave the expanded bounds of its leaf
+		if ( ClipTreeContains( nodes[leaf].bounds, clipModel->absBounds ) ) {
+			numFastLinks++;
+			SetBroadphase( clipModel, this, true );
+			return;
+		}
+		RemoveLeaf( leaf );
+	} else {
+		leaf = AllocNode();
+		nodes[leaf].clipModel = clipModel;
+		clipModel->proxyId = leaf;
+		numLeaves++;
+	}
+
+	nodes[leaf].bounds = clipModel->absBounds;
+	nodes[leaf].bounds.ExpandSelf( CLIP_TREE_MARGIN );
+	InsertLeaf( leaf );
+	numRelinks++;
+
+	SetBroadphase( clipModel, this, true );
+}
+
+/*
+================
+idClipTree::Unlink
+
+The leaf is kept so the clip model can be relinked at a nearby position without changing the tree.
+================
+*/
+void idClipTree::Unlink( idClipModel *clipModel ) {
+	SetBroadphase( clipModel, this, false );
+}
+
+/*
+================
+idClipTree::Remove
+================
+*/
+void idClipTree::Remove( idClipModel *clipModel ) {
+	if ( clipModel->proxyId != -1 ) {
+		RemoveLeaf( clipModel->proxyId );
+		FreeNode( clipModel->proxyId );
+		clipModel->proxyId = -1;
+		numLeaves--;
+	}
+	SetBroadphase( clipModel, NULL, false );
+}
+
+/*
+================
+idClipTree::ClipModelsTouchingBounds
+================
+*/
+int idClipTree::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
+	int stack[CLIP_TREE_STACK_SIZE];
+	int stackSize, count;
+
+	if ( root == -1 ) {
+		return 0;
+	}
+
+	count = 0;
+	stack[0] = root;
+	stackSize = 1;
+	while ( stackSize > 0 ) {
+		const clipTreeNode_t &node = nodes[stack[--stackSize]];
+
+		if ( !BoundsTouch( node.bounds, bounds ) ) {
+			continue;
+		}
+
+		if ( node.children[0] == -1 ) {
+			if ( !ClipModelTouches( node.clipModel, bounds, contentMask ) ) {
+				continue;
+			}
+			if ( count >= maxCount ) {
+				gameLocal.Warning( "idClipTree::ClipModelsTouchingBounds: max count" );
+				return count;
+			}
+			clipModelList[count++] = node.clipModel;
+			continue;
+		}
+
+		if ( stackSize + 2 > CLIP_TREE_STACK_SIZE ) {
+			gameLocal.Warning( "idClipTree::ClipModelsTouchingBounds: stack overflow" );
+			return count;
+		}
+		stack[stackSize++] = node.children[1];
+		stack[stackSize++] = node.children[0];
+	}
+
+	return count;
+}
+
+/*
+================
+idClipTree::ClipModelsTouchingBoundsBatch
+
+Walks the tree once for all bounds with a bit mask of the bounds that touch each node.
+================
+*/
+int idClipTree::ClipModelsTouchingBoundsBatch( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int *boundsIndex, int maxCount ) const {
+	int stack[CLIP_TREE_STACK_SIZE];
+	unsigned int stackMask[CLIP_TREE_STACK_SIZE];
+	int i, stackSize, count;
+	unsigned int mask, touchMask;
+
+	assert( numBounds <= CLIP_BROADPHASE_MAX_BATCH );
+
+	if ( root == -1 || numBounds <= 0 ) {
+		return 0;
+	}
+
+	count = 0;
+	stack[0] = root;
+	stackMask[0] = ( numBounds >= 32 ) ? 0xFFFFFFFF : ( ( 1u << numBounds ) - 1 );
+	stackSize = 1;
+	while ( stackSize > 0 ) {
+		stackSize--;
+		const clipTreeNode_t &node = nodes[stack[stackSize]];
+		mask = stackMask[stackSize];
+
+		touchMask = 0;
+		for ( i = 0; mask; i++, mask >>= 1 ) {
+			if ( ( mask & 1 ) && BoundsTouch( node.bounds, bounds[i] ) ) {
+				touchMask |= 1u << i;
+			}
+		}
+		if ( !touchMask ) {
+			continue;
+		}
+
+		if ( node.children[0] == -1 ) {
+			for ( i = 0; touchMask; i++, touchMask >>= 1 ) {
+				if ( !( touchMask & 1 ) || !ClipModelTouches( node.clipModel, bounds[i], contentMask ) ) {
+					continue;
+				}
+				if ( count >= maxCount ) {
+					gameLocal.Warning( "idClipTree::ClipModelsTouchingBoundsBatch: max count" );
+					return count;
+				}
+				clipModelList[count] = node.clipModel;
+				boundsIndex[count] = i;
+				count++;
+			}
+			continue;
+		}
+
+		if ( stackSize + 2 > CLIP_TREE_STACK_SIZE ) {
+			gameLocal.Warning( "idClipTree::ClipModelsTouchingBoundsBatch: stack overflow" );
+			return count;
+		}
+		stack[stackSize] = node.children[1];
+		stackMask[stackSize] = touchMask;
+		stackSize++;
+		stack[stackSize] = node.children[0];
+		stackMask[stackSize] = touchMask;
+		stackSize++;
+	}
+
+	return count;
+}
+
+/*
+================
+idClipTree::GetHeight
+================
+*/
+int idClipTree::GetHeight( void ) const {
+	if ( root == -1 ) {
+		return 0;
+	}
+	return nodes[root].height;
+}
+
+/*
+================
+idClipTree::PrintStatistics
+================
+*/
+void idClipTree::PrintStatistics( void ) {
+	gameLocal.Printf( "clip tree leaves = %d, nodes = %d, height = %d, reinserted = %d, kept = %d\n", numLeaves, nodes.Num(), GetHeight(), numRelinks, numFastLinks );
+	numRelinks = numFastLinks = 0;
+}
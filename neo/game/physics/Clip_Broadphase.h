@@ -0,0 +1,207 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __CLIP_BROADPHASE_H__
+#define __CLIP_BROADPHASE_H__
+
+/*
+===============================================================================
+
+  Broadphase used by idClip to find the clip models touching a bounds.
+
+  The broadphase only looks at the absolute bounds of the clip models.  A clip
+  model is linked with up to date absolute bounds.  Unlinking may keep data
+  around for the clip model to make relinking at a nearby position cheap,
+  Remove frees all data for the clip model.
+
+===============================================================================
+*/
+
+#define CLIP_BROADPHASE_MAX_BATCH		32		// maximum number of bounds for a single ClipModelsTouchingBoundsBatch
+
+enum {
+	CLIP_BROADPHASE_SECTORS,		// fixed depth axial tree, clip models are linked into every leaf sector they touch
+	CLIP_BROADPHASE_TREE			// dynamic bounding volume tree with a single leaf per clip model
+};
+
+class idClipBroadphase {
+public:
+	virtual					~idClipBroadphase( void ) {}
+
+	static idClipBroadphase *Alloc( int type );
+
+	virtual const char *	GetName( void ) const = 0;
+							// true if ClipModelsTouchingBounds can be called from several threads at once
+	virtual bool			ConcurrentQueries( void ) const = 0;
+	virtual void			Init( const idBounds &worldBounds ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+	virtual void			Link( idClipModel *clipModel ) = 0;
+	virtual void			Unlink( idClipModel *clipModel ) = 0;
+	virtual void			Remove( idClipModel *clipModel ) = 0;
+
+							// the bounds should already be expanded with vec3_boxEpsilon
+	virtual int				ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const = 0;
+							// finds the clip models touching any of at most CLIP_BROADPHASE_MAX_BATCH bounds, clipModelList[i] touches bounds[boundsIndex[i]]
+	virtual int				ClipModelsTouchingBoundsBatch( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int *boundsIndex, int maxCount ) const;
+
+	virtual void			PrintStatistics( void ) = 0;
+
+							// compares the link and query costs of the broadphases with moving clip models
+	static void				Benchmark( const idBounds &worldBounds, int numClipModels, int numFrames );
+
+protected:
+	static bool				BoundsTouch( const idBounds &a, const idBounds &b );
+	static bool				ClipModelTouches( const idClipModel *clipModel, const idBounds &bounds, int contentMask );
+	static void				SetBroadphase( idClipModel *clipModel, idClipBroadphase *broadphase, bool linked );
+};
+
+/*
+================
+idClipBroadphase::BoundsTouch
+================
+*/
+ID_INLINE bool idClipBroadphase::BoundsTouch( const idBounds &a, const idBounds &b ) {
+	return !(	a[0][0] > b[1][0] || a[1][0] < b[0][0] ||
+				a[0][1] > b[1][1] || a[1][1] < b[0][1] ||
+				a[0][2] > b[1][2] || a[1][2] < b[0][2] );
+}
+
+
+/*
+===============================================================================
+
+	idClipSectors
+
+===============================================================================
+*/
+
+typedef struct clipSector_s {
+	int						axis;		// -1 = leaf node
+	float					dist;
+	struct clipSector_s *	children[2];
+	struct clipLink_s *		clipLinks;
+} clipSector_t;
+
+typedef struct clipLink_s {
+	idClipModel *			clipModel;
+	struct clipSector_s *	sector;
+	struct clipLink_s *		prevInSector;
+	struct clipLink_s *		nextInSector;
+	struct clipLink_s *		nextLink;
+} clipLink_t;
+
+class idClipSectors : public idClipBroadphase {
+public:
+							idClipSectors( void );
+	virtual					~idClipSectors( void );
+
+	virtual const char *	GetName( void ) const { return "sectors"; }
+	virtual bool			ConcurrentQueries( void ) const { return false; }	// uses touch counts on the clip models
+	virtual void			Init( const idBounds &worldBounds );
+	virtual void			Shutdown( void );
+
+	virtual void			Link( idClipModel *clipModel );
+	virtual void			Unlink( idClipModel *clipModel );
+	virtual void			Remove( idClipModel *clipModel );
+
+	virtual int				ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
+
+	virtual void			PrintStatistics( void );
+
+private:
+	int						numClipSectors;
+	clipSector_t *			clipSectors;
+	idVec3					maxSector;
+	mutable int				touchCount;
+	idBlockAlloc<clipLink_t, 1024> clipLinkAllocator;
+
+	clipSector_t *			CreateClipSectors_r( const int depth, const idBounds &bounds );
+	void					Link_r( idClipModel *clipModel, clipSector_t *node );
+	void					ClipModelsTouchingBounds_r( const clipSector_t *node, struct listParms_s &parms ) const;
+};
+
+
+/*
+===============================================================================
+
+	idClipTree
+
+	Dynamic bounding volume tree.  Every clip model has a single leaf with bounds
+	that are expanded by a margin, so a clip model that moves a little stays in
+	its leaf.  Leaves are inserted next to the sibling that least increases the
+	surface area of the tree and the tree is kept balanced with rotations.
+
+===============================================================================
+*/
+
+typedef struct clipTreeNode_s {
+	idBounds				bounds;				// leaf bounds are expanded by a margin
+	int						parent;				// next free node for unused nodes
+	int						children[2];		// -1 for leaves
+	int						height;				// 0 for leaves
+	idClipModel *			clipModel;			// clip model of a leaf
+} clipTreeNode_t;
+
+class idClipTree : public idClipBroadphase {
+public:
+							idClipTree( void );
+	virtual					~idClipTree( void );
+
+	virtual const char *	GetName( void ) const { return "tree"; }
+	virtual bool			ConcurrentQueries( void ) const { return true; }
+	virtual void			Init( const idBounds &worldBounds );
+	virtual void			Shutdown( void );
+
+	virtual void			Link( idClipModel *clipModel );
+	virtual void			Unlink( idClipModel *clipModel );
+	virtual void			Remove( idClipModel *clipModel );
+
+	virtual int				ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
+	virtual int				ClipModelsTouchingBoundsBatch( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int *boundsIndex, int maxCount ) const;
+
+	virtual void			PrintStatistics( void );
+
+private:
+	idList<clipTreeNode_t>	nodes;
+	int						root;
+	int						freeNodes;
+	int						numLeaves;
+	int						numRelinks;			// links that required a leaf to be reinserted
+	int						numFastLinks;		// links that kept the existing leaf
+
+	int						AllocNode( void );
+	void					FreeNode( int nodeNum );
+	void					InsertLeaf( int leaf );
+	void					RemoveLeaf( int leaf );
+	int						Balance( int nodeNum );
+	int						GetHeight( void ) const;
+};
+
+#endif /* !__CLIP_BROADPHASE_H__ */
@@ -0,0 +1,319 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "../Game_local.h"
+
+#define MAX_PHYSICS_THREADS			3		// one less than the number of collision model trace contexts
+#define ISLAND_BOUNDS_EPSILON		CM_BOX_EPSILON
+
+/*
+================
+idPhysicsIslands::idPhysicsIslands
+================
+*/
+idPhysicsIslands::idPhysicsIslands( void ) {
+	numThreads = 0;
+	predictionId = 0;
+	predicting = false;
+	numIslands = numPredicted = numUsed = numRejected = 0;
+}
+
+/*
+================
+idPhysicsIslands::~idPhysicsIslands
+================
+*/
+idPhysicsIslands::~idPhysicsIslands( void ) {
+	Shutdown();
+}
+
+/*
+================
+idPhysicsIslands::Init
+================
+*/
+void idPhysicsIslands::Init( void ) {
+	predicting = false;
+	UpdateThreads();
+}
+
+/*
+================
+idPhysicsIslands::Shutdown
+================
+*/
+void idPhysicsIslands::Shutdown( void ) {
+	predicting = false;
+	jobList.Shutdown();
+	numThreads = 0;
+	entities.Clear();
+	jobs.Clear();
+}
+
+/*
+================
+idPhysicsIslands::JobThreadInit
+================
+*/
+bool idPhysicsIslands::JobThreadInit( void ) {
+	return collisionModelManager->AcquireTraceContext();
+}
+
+/*
+================
+idPhysicsIslands::JobThreadShutdown
+================
+*/
+void idPhysicsIslands::JobThreadShutdown( void ) {
+	collisionModelManager->ReleaseTraceContext();
+}
+
+/*
+================
+idPhysicsIslands::UpdateThreads
+================
+*/
+void idPhysicsIslands::UpdateThreads( void ) {
+	int num;
+
+	num = idMath::ClampInt( 0, MAX_PHYSICS_THREADS, g_parallelPhysics.GetInteger() );
+	num = Min( num, idParallelJobList::NumHardwareThreads() - 1 );
+	if ( num == numThreads ) {
+		return;
+	}
+	numThreads = num;
+	jobList.Init( numThreads, JobThreadInit, JobThreadShutdown );
+}
+
+/*
+================
+idPhysicsIslands::FindIsland
+================
+*/
+int idPhysicsIslands::FindIsland( int i ) {
+	while ( entities[i].parent != i ) {
+		entities[i].parent = entities[entities[i].parent].parent;
+		i = entities[i].parent;
+	}
+	return i;
+}
+
+/*
+================
+idPhysicsIslands::MergeIslands
+================
+*/
+void idPhysicsIslands::MergeIslands( int i, int j ) {
+	i = FindIsland( i );
+	j = FindIsland( j );
+	if ( i == j ) {
+		return;
+	}
+	// the root keeps the first entity in the active list
+	if ( entities[j].order < entities[i].order ) {
+		entities[i].parent = j;
+		entities[j].serial |= entities[i].serial;
+	} else {
+		entities[j].parent = i;
+		entities[i].serial |= entities[j].serial;
+	}
+}
+
+/*
+================
+idPhysicsIslands::SortOnMinX
+================
+*/
+int idPhysicsIslands::SortOnMinX( const islandEntity_t *a, const islandEntity_t *b ) {
+	if ( a->bounds[0][0] < b->bounds[0][0] ) {
+		return -1;
+	}
+	if ( a->bounds[0][0] > b->bounds[0][0] ) {
+		return 1;
+	}
+	return a->order - b->order;
+}
+
+/*
+================
+idPhysicsIslands::BuildIslands
+
+  Merges the entities with touching velocity expanded bounds into islands and
+  adds a job for the first rigid body that can be predicted in each island
+  without a team or pusher.
+================
+*/
+void idPhysicsIslands::BuildIslands( idLinkList<idEntity> &activeEntities, int timeStepMSec ) {
+	int i, j, order;
+	idEntity *ent;
+	idPhysics *phys;
+	idPhysics_RigidBody *rigidBody;
+	idVec3 move;
+
+	entities.SetNum( 0, false );
+	jobs.SetNum( 0, false );
+
+	order = 0;
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next(), order++ ) {
+		phys = ent->GetPhysics();
+		if ( !phys || phys->GetNumClipModels() == 0 ) {
+			continue;
+		}
+		const idBounds &absBounds = phys->GetAbsBounds();
+		if ( absBounds.IsCleared() ) {
+			continue;
+		}
+
+		islandEntity_t &island = entities.Alloc();
+		island.entity = ent;
+		island.order = order;
+		island.serial = ( ent->GetTeamMaster() != NULL ||
+							phys->IsType( idPhysics_Parametric::Type ) || phys->IsType( idPhysics_Actor::Type ) );
+
+		move = phys->GetLinearVelocity() * MS2SEC( timeStepMSec );
+		island.bounds = absBounds;
+		island.bounds.AddBounds( idBounds( absBounds[0] + move, absBounds[1] + move ) );
+		island.bounds.ExpandSelf( ISLAND_BOUNDS_EPSILON );
+	}
+
+	// sweep along the x-axis and merge the entities with touching bounds
+	entities.Sort( SortOnMinX );
+	for ( i = 0; i < entities.Num(); i++ ) {
+		entities[i].parent = i;
+	}
+	for ( i = 0; i < entities.Num(); i++ ) {
+		const idBounds &bounds = entities[i].bounds;
+		for ( j = i + 1; j < entities.Num(); j++ ) {
+			if ( entities[j].bounds[0][0] > bounds[1][0] ) {
+				break;
+			}
+			if ( bounds.IntersectsBounds( entities[j].bounds ) ) {
+				MergeIslands( i, j );
+			}
+		}
+	}
+
+	// predict the root of each island without teams or pushers if it is a rigid body
+	numIslands = 0;
+	for ( i = 0; i < entities.Num(); i++ ) {
+		if ( entities[i].parent != i ) {
+			continue;
+		}
+		numIslands++;
+		if ( entities[i].serial ) {
+			continue;
+		}
+		phys = entities[i].entity->GetPhysics();
+		if ( !phys->IsType( idPhysics_RigidBody::Type ) ) {
+			continue;
+		}
+		rigidBody = static_cast<idPhysics_RigidBody *>( phys );
+		if ( !rigidBody->CanPredictMotion() ) {
+			continue;
+		}
+		predictionJob_t &job = jobs.Alloc();
+		job.physics = rigidBody;
+		job.timeStepMSec = timeStepMSec;
+		job.predictionId = predictionId;
+	}
+}
+
+/*
+================
+idPhysicsIslands::PredictMotionJob
+================
+*/
+void idPhysicsIslands::PredictMotionJob( void *data ) {
+	predictionJob_t *job = (predictionJob_t *) data;
+
+	job->physics->PredictMotion( job->timeStepMSec, job->predictionId );
+}
+
+/*
+================
+idPhysicsIslands::PredictMotion
+================
+*/
+void idPhysicsIslands::PredictMotion( idLinkList<idEntity> &activeEntities ) {
+	int i, timeStepMSec;
+
+	FinishPrediction();
+
+	UpdateThreads();
+	if ( numThreads == 0 || jobList.GetNumThreads() == 0 ) {
+		return;
+	}
+
+	// the clip model queries of the sector broadphase are not thread safe
+	if ( !gameLocal.clip.ConcurrentQueries() ) {
+		return;
+	}
+
+	timeStepMSec = gameLocal.time - gameLocal.previousTime;
+	if ( timeStepMSec <= 0 ) {
+		return;
+	}
+
+	predictionId++;
+
+	BuildIslands( activeEntities, timeStepMSec );
+
+	numPredicted = jobs.Num();
+	if ( !numPredicted ) {
+		return;
+	}
+
+	for ( i = 0; i < jobs.Num(); i++ ) {
+		jobList.AddJob( PredictMotionJob, &jobs[i] );
+	}
+	jobList.Run();
+
+	gameLocal.clip.BeginChangeTracking();
+	predicting = true;
+}
+
+/*
+================
+idPhysicsIslands::FinishPrediction
+================
+*/
+void idPhysicsIslands::FinishPrediction( void ) {
+	if ( predicting ) {
+		predicting = false;
+		gameLocal.clip.EndChangeTracking();
+	}
+
+	if ( numIslands && g_showPhysicsIslands.GetBool() ) {
+		gameLocal.Printf( "%d: %d entities, %d islands, %d predicted, %d used, %d rejected\n",
+							gameLocal.time, entities.Num(), numIslands, numPredicted, numUsed, numRejected );
+	}
+	numIslands = numPredicted = numUsed = numRejected = 0;
+}
@@ -133,6 +133,7 @@ protected:
 	idMatX					J;							// transformed constraint matrix
 	idVecX					s;							// temp solution
 	idVecX					lm;							// lagrange multipliers
+	int						lmSide[6];					// boundary of the lagrange multipliers in the last lcp solution
 	int						firstIndex;					// index of the first constraint row in the lcp matrix
 
 	struct constraintFlags_s {
@@ -35,6 +35,17 @@ CLASS_DECLARATION( idPhysics_Base, idPhysics_RigidBody )
 END_CLASS
 
 const float STOP_SPEED		= 10.0f;
+const float WAKE_SPEED		= 20.0f;		// speed at which a body waiting for its contact island to settle is moving again
+const float CONTACT_CACHE_EPSILON	= 0.05f;		// distance a body may move before the cached contacts are evaluated again
+const int CONTACT_CACHE_MSEC	= 250;			// maximum age of cached contacts
+
+#define MAX_SLEEP_ISLAND_BODIES	256
+
+// sleep statistics
+static int numIslandsSlept = 0;
+static int numBodiesSlept = 0;
+static int numBodiesWoken = 0;
+static int numCachedContacts = 0;
 
 
 #undef RB_TIMINGS
@@ -206,6 +217,109 @@ bool idPhysics_RigidBody::CheckForCollisions( const float deltaTime, rigidBodyPS
 	return collided;
 }
 
+/*
+================
+idPhysics_RigidBody::CanPredictMotion
+
+  True if the next Evaluate integrates and checks for collisions.
+================
+*/
+bool idPhysics_RigidBody::CanPredictMotion( void ) const {
+	if ( hasMaster || dropToFloor || current.atRest >= 0 ) {
+		return false;
+	}
+	if ( !clipModel || !clipModel->IsTraceModel() ) {
+		return false;
+	}
+	// render model traces are not thread safe
+	if ( clipMask & CONTENTS_RENDERMODEL ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+idPhysics_RigidBody::PredictMotion
+
+  Integrates and checks for collisions the same way Evaluate does without changing
+  anything but the prediction. Evaluate uses the predicted motion if the state of
+  the body is unchanged and no clip model changed within the prediction bounds.
+  Only reads the clip models so it can run on another thread.
+================
+*/
+void idPhysics_RigidBody::PredictMotion( int timeStepMSec, int predictionId ) {
+	float timeStep, lastTimeStep;
+
+	timeStep = MS2SEC( timeStepMSec );
+
+	// Evaluate sets the last time step before integrating
+	lastTimeStep = current.lastTimeStep;
+	current.lastTimeStep = timeStep;
+
+	prediction.timeStepMSec = timeStepMSec;
+	prediction.start = current;
+	prediction.gravityVector = gravityVector;
+	prediction.mass = mass;
+	prediction.linearFriction = linearFriction;
+	prediction.angularFriction = angularFriction;
+	prediction.clipMask = clipMask;
+	prediction.clipModel = clipModel;
+
+	prediction.next = current;
+	Integrate( timeStep, prediction.next );
+
+	// the motion is clipped against everything touching the trace model swept from the start to the end position
+	prediction.bounds.Clear();
+	prediction.bounds.AddPoint( current.i.position );
+	prediction.bounds.AddPoint( prediction.next.i.position );
+	prediction.bounds.ExpandSelf( clipModel->GetBounds().GetRadius() + CM_BOX_EPSILON );
+
+	prediction.collided = CheckForCollisions( timeStep, prediction.next, prediction.collision );
+
+	current.lastTimeStep = lastTimeStep;
+
+	prediction.id = predictionId;
+}
+
+/*
+================
+idPhysics_RigidBody::UsePredictedMotion
+================
+*/
+bool idPhysics_RigidBody::UsePredictedMotion( int timeStepMSec, rigidBodyPState_t &next, trace_t &collision, bool &collided ) {
+	bool valid;
+
+	if ( prediction.id == -1 ) {
+		return false;
+	}
+	valid = gameLocal.physicsIslands.IsPredicting( prediction.id );
+	prediction.id = -1;
+	if ( !valid ) {
+		return false;
+	}
+
+	if ( timeStepMSec != prediction.timeStepMSec ||
+			memcmp( &current, &prediction.start, sizeof( current ) ) != 0 ||
+				gravityVector != prediction.gravityVector ||
+					mass != prediction.mass ||
+						linearFriction != prediction.linearFriction ||
+							angularFriction != prediction.angularFriction ||
+								clipMask != prediction.clipMask ||
+									clipModel != prediction.clipModel ||
+										gameLocal.clip.ChangedSinceTracking( prediction.bounds, self ) ) {
+		gameLocal.physicsIslands.PredictionRejected();
+		return false;
+	}
+
+	next = prediction.next;
+	collision = prediction.collision;
+	collided = prediction.collided;
+
+	gameLocal.physicsIslands.PredictionUsed();
+	return true;
+}
+
 /*
 ================
 idPhysics_RigidBody::ContactFriction
@@ -273,7 +387,7 @@ idPhysics_RigidBody::TestIfAtRest
 */
 bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	int i;
-	float gv;
+	float gv, stopSpeed;
 	idVec3 v, av, normal, point;
 	idMat3 inverseWorldInertiaTensor;
 	idFixedWinding contactWinding;
@@ -322,6 +436,9 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 		return false;
 	}
 
+	// a body waiting for its contact island to settle has to move faster before it is no longer considered at rest
+	stopSpeed = restCandidate ? WAKE_SPEED : STOP_SPEED;
+
 	// linear velocity of body
 	v = inverseMass * current.i.linearMomentum;
 	// linear velocity in gravity direction
@@ -330,11 +447,11 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	v -= gv * gravityNormal;
 
 	// if too much velocity orthogonal to gravity direction
-	if ( v.Length() > STOP_SPEED ) {
+	if ( v.Length() > stopSpeed ) {
 		return false;
 	}
 	// if too much velocity in gravity direction
-	if ( gv > 2.0f * STOP_SPEED || gv < -2.0f * STOP_SPEED ) {
+	if ( gv > 2.0f * stopSpeed || gv < -2.0f * stopSpeed ) {
 		return false;
 	}
 
@@ -343,7 +460,7 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	av = inverseWorldInertiaTensor * current.i.angularMomentum;
 
 	// if too much rotational velocity
-	if ( av.LengthSqr() > STOP_SPEED ) {
+	if ( av.LengthSqr() > stopSpeed ) {
 		return false;
 	}
 
@@ -469,6 +586,15 @@ idPhysics_RigidBody::idPhysics_RigidBody( void ) {
 	hasMaster = false;
 	isOrientated = false;
 
+	prediction.id = -1;
+
+	restCandidate = false;
+	contactCacheTime = -1;
+	contactCacheOrigin.Zero();
+	contactCacheAxis.Identity();
+	sleepNext = sleepPrev = this;
+	sleepRestoreNext = NULL;
+
 #ifdef RB_TIMINGS
 	lastTimerReset = 0;
 #endif
@@ -480,6 +606,7 @@ idPhysics_RigidBody::~idPhysics_RigidBody
 ================
 */
 idPhysics_RigidBody::~idPhysics_RigidBody( void ) {
+	UnlinkSleepIsland();
 	if ( clipModel ) {
 		delete clipModel;
 		clipModel = NULL;
@@ -556,6 +683,8 @@ void idPhysics_RigidBody::Save( idSaveGame *savefile ) const {
 
 	savefile->WriteBool( hasMaster );
 	savefile->WriteBool( isOrientated );
+
+	savefile->WriteObject( sleepNext != this ? sleepNext->self : NULL );
 }
 
 /*
@@ -587,6 +716,13 @@ void idPhysics_RigidBody::Restore( idRestoreGame *savefile ) {
 
 	savefile->ReadBool( hasMaster );
 	savefile->ReadBool( isOrientated );
+
+	savefile->ReadObject( reinterpret_cast<idClass *&>( sleepRestoreNext ) );
+
+	prediction.id = -1;
+
+	restCandidate = false;
+	contactCacheTime = -1;
 }
 
 /*
@@ -720,12 +856,212 @@ idPhysics_RigidBody::Rest
 ================
 */
 void idPhysics_RigidBody::Rest( void ) {
+	restCandidate = false;
 	current.atRest = gameLocal.time;
 	current.i.linearMomentum.Zero();
 	current.i.angularMomentum.Zero();
 	self->BecomeInactive( TH_PHYSICS );
 }
 
+/*
+================
+idPhysics_RigidBody::EvaluateCachedContacts
+
+  Reuses the contacts while a body waiting for its contact island to settle hardly moves.
+================
+*/
+bool idPhysics_RigidBody::EvaluateCachedContacts( void ) {
+
+	if ( restCandidate && contactCacheTime >= 0 && gameLocal.time - contactCacheTime < CONTACT_CACHE_MSEC && contacts.Num() >= 3 ) {
+		if ( ( current.i.position - contactCacheOrigin ).LengthSqr() < Square( CONTACT_CACHE_EPSILON ) &&
+				current.i.orientation.Compare( contactCacheAxis, CONTACT_CACHE_EPSILON * 0.01f ) ) {
+			numCachedContacts++;
+			return true;
+		}
+	}
+
+	contactCacheTime = gameLocal.time;
+	contactCacheOrigin = current.i.position;
+	contactCacheAxis = current.i.orientation;
+	return false;
+}
+
+/*
+================
+idPhysics_RigidBody::SleepIsland
+
+  Puts this body to sleep together with all rigid bodies in its contact island
+  if they all passed the rest test. Returns false if the island is still moving.
+================
+*/
+bool idPhysics_RigidBody::SleepIsland( void ) {
+	int i, j, k, numBodies;
+	idPhysics_RigidBody *island[MAX_SLEEP_ISLAND_BODIES];
+	idPhysics_RigidBody *body, *other;
+	idPhysics *phys;
+	idEntity *ent;
+
+	island[0] = this;
+	numBodies = 1;
+
+	for ( i = 0; i < numBodies && numBodies < MAX_SLEEP_ISLAND_BODIES; i++ ) {
+		body = island[i];
+
+		// bodies this body rests on and bodies resting on this body
+		for ( j = 0; j < body->contacts.Num() + body->contactEntities.Num(); j++ ) {
+			if ( j < body->contacts.Num() ) {
+				if ( body->contacts[j].entityNum == ENTITYNUM_WORLD ) {
+					continue;
+				}
+				ent = gameLocal.entities[ body->contacts[j].entityNum ];
+			} else {
+				ent = body->contactEntities[j - body->contacts.Num()].GetEntity();
+			}
+			if ( !ent ) {
+				continue;
+			}
+			phys = ent->GetPhysics();
+			if ( !phys || !phys->IsType( idPhysics_RigidBody::Type ) ) {
+				continue;
+			}
+			other = static_cast<idPhysics_RigidBody *>( phys );
+			if ( other->current.atRest >= 0 || other->hasMaster ) {
+				continue;
+			}
+			if ( !other->restCandidate ) {
+				return false;
+			}
+			for ( k = 0; k < numBodies; k++ ) {
+				if ( island[k] == other ) {
+					break;
+				}
+			}
+			if ( k < numBodies ) {
+				continue;
+			}
+			island[numBodies++] = other;
+			if ( numBodies >= MAX_SLEEP_ISLAND_BODIES ) {
+				break;
+			}
+		}
+	}
+
+	UnlinkSleepIsland();
+	for ( i = 0; i < numBodies; i++ ) {
+		island[i]->Rest();
+		if ( i > 0 ) {
+			LinkSleepIsland( island[i] );
+		}
+	}
+
+	numIslandsSlept++;
+	numBodiesSlept += numBodies;
+
+	return true;
+}
+
+/*
+================
+idPhysics_RigidBody::LinkSleepIsland
+================
+*/
+void idPhysics_RigidBody::LinkSleepIsland( idPhysics_RigidBody *body ) {
+	body->UnlinkSleepIsland();
+	body->sleepNext = sleepNext;
+	body->sleepPrev = this;
+	sleepNext->sleepPrev = body;
+	sleepNext = body;
+}
+
+/*
+================
+idPhysics_RigidBody::UnlinkSleepIsland
+================
+*/
+void idPhysics_RigidBody::UnlinkSleepIsland( void ) {
+	sleepNext->sleepPrev = sleepPrev;
+	sleepPrev->sleepNext = sleepNext;
+	sleepNext = sleepPrev = this;
+}
+
+/*
+================
+idPhysics_RigidBody::WakeSleepIsland
+================
+*/
+void idPhysics_RigidBody::WakeSleepIsland( void ) {
+	idPhysics_RigidBody *body;
+
+	while ( sleepNext != this ) {
+		body = sleepNext;
+		body->UnlinkSleepIsland();
+		body->Activate();
+	}
+}
+
+/*
+================
+idPhysics_RigidBody::RestoreSleepIslands
+
+  Every body of a sleep island saved the entity of the next body in the ring.
+  The physics of those entities are only known once all objects are restored.
+================
+*/
+void idPhysics_RigidBody::RestoreSleepIslands( void ) {
+	idEntity *ent;
+	idPhysics *phys;
+	idPhysics_RigidBody *body, *next;
+
+	for ( ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
+		phys = ent->GetPhysics();
+		if ( !phys || !phys->IsType( idPhysics_RigidBody::Type ) ) {
+			continue;
+		}
+		body = static_cast<idPhysics_RigidBody *>( phys );
+		if ( !body->sleepRestoreNext ) {
+			continue;
+		}
+		phys = body->sleepRestoreNext->GetPhysics();
+		assert( phys && phys->IsType( idPhysics_RigidBody::Type ) );
+		next = static_cast<idPhysics_RigidBody *>( phys );
+		body->sleepNext = next;
+		next->sleepPrev = body;
+		body->sleepRestoreNext = NULL;
+	}
+}
+
+/*
+================
+idPhysics_RigidBody::UpdateSleepStatistics
+
+  Prints the sleep statistics of the last frame if rb_showSleep is set.
+================
+*/
+void idPhysics_RigidBody::UpdateSleepStatistics( void ) {
+	int numActive, numSleeping;
+	idEntity *ent;
+	idPhysics *phys;
+
+	if ( rb_showSleep.GetBool() ) {
+		numActive = numSleeping = 0;
+		for ( ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
+			phys = ent->GetPhysics();
+			if ( phys && phys->IsType( idPhysics_RigidBody::Type ) ) {
+				if ( phys->IsAtRest() ) {
+					numSleeping++;
+				} else {
+					numActive++;
+				}
+			}
+		}
+
+		gameLocal.Printf( "%d: rigid bodies %d active, %d sleeping, %d woken, %d slept in %d islands, %d cached contacts\n",
+							gameLocal.time, numActive, numSleeping, numBodiesWoken, numBodiesSlept, numIslandsSlept, numCachedContacts );
+	}
+
+	numIslandsSlept = numBodiesSlept = numBodiesWoken = numCachedContacts = 0;
+}
+
 /*
 ================
 idPhysics_RigidBody::DropToFloor
@@ -751,6 +1087,12 @@ idPhysics_RigidBody::Activate
 ================
 */
 void idPhysics_RigidBody::Activate( void ) {
+	if ( current.atRest >= 0 ) {
+		numBodiesWoken++;
+		contactCacheTime = -1;
+		// wake up the bodies that went to sleep together with this one
+		WakeSleepIsland();
+	}
 	current.atRest = -1;
 	self->BecomeActive( TH_PHYSICS );
 }
@@ -889,19 +1231,23 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 
 	next = current;
 
-	// calculate next position and orientation
-	Integrate( timeStep, next );
+	// use the motion predicted in parallel if nothing it depends on changed since
+	if ( !UsePredictedMotion( timeStepMSec, next, collision, collided ) ) {
+
+		// calculate next position and orientation
+		Integrate( timeStep, next );
 
 #ifdef RB_TIMINGS
-	timer_collision.Start();
+		timer_collision.Start();
 #endif
 
-	// check for collisions from the current to the next state
-	collided = CheckForCollisions( timeStep, next, collision );
+		// check for collisions from the current to the next state
+		collided = CheckForCollisions( timeStep, next, collision );
 
 #ifdef RB_TIMINGS
-	timer_collision.Stop();
+		timer_collision.Stop();
 #endif
+	}
 
 	// set the new state
 	current = next;
@@ -924,7 +1270,9 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		timer_collision.Start();
 #endif
 		// get contacts
-		EvaluateContacts();
+		if ( !EvaluateCachedContacts() ) {
+			EvaluateContacts();
+		}
 
 #ifdef RB_TIMINGS
 		timer_collision.Stop();
@@ -932,16 +1280,27 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 
 		// check if the body has come to rest
 		if ( TestIfAtRest() ) {
-			// put to rest
-			Rest();
-			cameToRest = true;
-		}  else {
+			if ( rb_sleepIslands.GetBool() ) {
+				// wait until the whole contact island can go to sleep
+				restCandidate = true;
+				cameToRest = SleepIsland();
+			} else {
+				// put to rest
+				Rest();
+				cameToRest = true;
+			}
+		} else {
+			restCandidate = false;
+		}
+
+		if ( !cameToRest ) {
 			// apply contact friction
 			ContactFriction( timeStep );
 		}
 	}
 
-	if ( current.atRest < 0 ) {
+	// a body about to sleep does not wake up the bodies resting on it
+	if ( current.atRest < 0 && !restCandidate ) {
 		ActivateContactEntities();
 	}
 
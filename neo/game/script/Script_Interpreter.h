@@ -66,6 +66,7 @@ private:
 	void				SetString( idVarDef *def, const char *from );
 	const char			*GetString( idVarDef *def );
 	varEval_t			GetVariable( idVarDef *def );
+	varEval_t			GetOperand( const varEval_t &operand, int onStack );
 	idEntity			*GetEntity( int entnum ) const;
 	idScriptObject		*GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
@@ -114,6 +115,9 @@ public:
 	const function_t	*GetCurrentFunction( void ) const;
 	idThread			*GetThread( void ) const;
 
+	// opcode profiling, enabled with g_scriptProfileOpcodes
+	static void			ClearOpcodeStats( void );
+	static void			PrintOpcodeStats( int numPairs );
 };
 
 /*
@@ -226,6 +230,23 @@ ID_INLINE varEval_t idInterpreter::GetVariable( idVarDef *def ) {
 	}
 }
 
+/*
+====================
+idInterpreter::GetOperand
+
+Returns the variable for an operand of a decoded instruction.
+====================
+*/
+ID_INLINE varEval_t idInterpreter::GetOperand( const varEval_t &operand, int onStack ) {
+	if ( onStack ) {
+		varEval_t val;
+		val.intPtr = ( int * )&localstack[ localstackBase + operand.stackOffset ];
+		return val;
+	} else {
+		return operand;
+	}
+}
+
 /*
 ================
 idInterpreter::GetEntity
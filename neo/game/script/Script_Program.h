@@ -89,6 +89,8 @@ Contains type information for variables and functions.
 ***********************************************************************/
 
 class idTypeDef {
+	friend class idProgram;
+
 private:
 	etype_t						type;
 	idStr 						name;
@@ -422,6 +424,28 @@ typedef struct statement_s {
 
 /***********************************************************************
 
+scriptInstruction_t
+
+Statement decoded for the interpreter.  The operands hold the value of their
+var def, or the offset in the local stack for stack variables, so the
+interpreter doesn't need to look at the var defs while executing.
+
+***********************************************************************/
+
+#define INSTRUCTION_STACK_A		1
+#define INSTRUCTION_STACK_B		2
+#define INSTRUCTION_STACK_C		4
+
+typedef struct scriptInstruction_s {
+	unsigned short	op;
+	unsigned short	stackFlags;		// INSTRUCTION_STACK_? set for operands that are stack variables
+	varEval_t		a;
+	varEval_t		b;
+	varEval_t		c;
+} scriptInstruction_t;
+
+/***********************************************************************
+
 idProgram
 
 Handles compiling and storage of script data.  Multiple idProgram objects
@@ -442,6 +466,7 @@ private:
 	idStaticList<byte,MAX_GLOBALS>				variableDefaults;
 	idStaticList<function_t,MAX_FUNCS>			functions;
 	idStaticList<statement_t,MAX_STATEMENTS>	statements;
+	idList<scriptInstruction_t>					instructions;
 	idList<idTypeDef *>							types;
 	idList<idVarDefName *>						varDefNames;
 	idHashIndex									varDefNameHash;
@@ -456,6 +481,18 @@ private:
 	int											top_files;
 
 	void										CompileStats( void );
+	void										DecodeStatements( void );
+
+	// compiled script cache
+	static unsigned long						ScriptCacheChecksum( const idStrList &sourceFiles );
+	int											CacheTypeIndex( const idTypeDef *type ) const;
+	int											CacheDefIndex( const idVarDef *def ) const;
+	int											CacheFunctionIndex( const function_t *func ) const;
+	idTypeDef *									CacheType( int index );
+	idVarDef *									CacheDef( int index );
+	function_t *								CacheFunction( int index );
+	bool										WriteScriptCache( const char *cacheName, int compileTime ) const;
+	bool										ReadScriptCache( const char *cacheName, int &compileTime );
 
 public:
 	idVarDef									*returnDef;
@@ -508,6 +545,7 @@ public:
 
 	statement_t									*AllocStatement( void );
 	statement_t									&GetStatement( int index );
+	const scriptInstruction_t					&GetInstruction( int index ) const;
 	int											NumStatements( void ) { return statements.Num(); }
 
 	int 										GetReturnedInteger( void );
@@ -530,6 +568,15 @@ ID_INLINE statement_t &idProgram::GetStatement( int index ) {
 	return statements[ index ];
 }
 
+/*
+================
+idProgram::GetInstruction
+================
+*/
+ID_INLINE const scriptInstruction_t &idProgram::GetInstruction( int index ) const {
+	return instructions[ index ];
+}
+
 /*
 ================
 idProgram::GetFunction
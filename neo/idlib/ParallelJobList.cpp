@@ -0,0 +1,273 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include <atomic>
+#include <cfenv>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef struct jobThreads_s {
+	std::vector<std::thread>	workers;
+	std::mutex					mutex;
+	std::condition_variable		wake;			// signalled when a new generation of jobs is available or on shutdown
+	std::condition_variable		done;			// signalled when a worker finished a generation or finished its init
+	std::fenv_t					fenv;			// floating-point environment of the thread that started the workers
+	jobThreadInit_t				threadInit;
+	jobThreadShutdown_t			threadShutdown;
+	const void *				jobs;			// job_t array of the current generation
+	int							numJobs;
+	std::atomic<int>			nextJob;
+	int							generation;
+	int							numStarted;		// workers that finished their init
+	int							numActive;		// workers taking jobs
+	int							numBusy;		// workers still working on the current generation
+	bool						shutdown;
+} jobThreads_t;
+
+/*
+================
+idParallelJobList::idParallelJobList
+================
+*/
+idParallelJobList::idParallelJobList( void ) {
+	threads = NULL;
+}
+
+/*
+================
+idParallelJobList::~idParallelJobList
+================
+*/
+idParallelJobList::~idParallelJobList( void ) {
+	Shutdown();
+}
+
+/*
+================
+idParallelJobList::WorkerThread
+================
+*/
+void idParallelJobList::WorkerThread( jobThreads_t *t ) {
+	int generation;
+	bool active;
+
+	std::fesetenv( &t->fenv );
+
+	active = ( t->threadInit == NULL ) || t->threadInit();
+
+	{
+		std::unique_lock<std::mutex> lock( t->mutex );
+		t->numStarted++;
+		if ( active ) {
+			t->numActive++;
+		}
+		generation = t->generation;
+		t->done.notify_all();
+	}
+
+	while ( active ) {
+		const job_t *jobs;
+		int numJobs, i;
+
+		{
+			std::unique_lock<std::mutex> lock( t->mutex );
+			while ( !t->shutdown && t->generation == generation ) {
+				t->wake.wait( lock );
+			}
+			if ( t->shutdown ) {
+				break;
+			}
+			generation = t->generation;
+			jobs = (const job_t *) t->jobs;
+			numJobs = t->numJobs;
+		}
+
+		for ( i = t->nextJob++; i < numJobs; i = t->nextJob++ ) {
+			jobs[i].function( jobs[i].data );
+		}
+
+		{
+			std::unique_lock<std::mutex> lock( t->mutex );
+			t->numBusy--;
+			t->done.notify_all();
+		}
+	}
+
+	if ( active && t->threadShutdown != NULL ) {
+		t->threadShutdown();
+	}
+}
+
+/*
+================
+idParallelJobList::Init
+================
+*/
+void idParallelJobList::Init( int numThreads, jobThreadInit_t threadInit, jobThreadShutdown_t threadShutdown ) {
+	int i;
+
+	Shutdown();
+
+	if ( numThreads <= 0 ) {
+		return;
+	}
+
+	threads = new jobThreads_t;
+	std::fegetenv( &threads->fenv );
+	threads->threadInit = threadInit;
+	threads->threadShutdown = threadShutdown;
+	threads->jobs = NULL;
+	threads->numJobs = 0;
+	threads->nextJob = 0;
+	threads->generation = 0;
+	threads->numStarted = 0;
+	threads->numActive = 0;
+	threads->numBusy = 0;
+	threads->shutdown = false;
+
+	for ( i = 0; i < numThreads; i++ ) {
+		threads->workers.push_back( std::thread( WorkerThread, threads ) );
+	}
+
+	// wait for the workers to finish their init so Run knows how many take jobs
+	std::unique_lock<std::mutex> lock( threads->mutex );
+	while ( threads->numStarted < numThreads ) {
+		threads->done.wait( lock );
+	}
+}
+
+/*
+================
+idParallelJobList::Shutdown
+================
+*/
+void idParallelJobList::Shutdown( void ) {
+	size_t i;
+
+	if ( threads == NULL ) {
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock( threads->mutex );
+		threads->shutdown = true;
+		threads->wake.notify_all();
+	}
+	for ( i = 0; i < threads->workers.size(); i++ ) {
+		threads->workers[i].join();
+	}
+
+	delete threads;
+	threads = NULL;
+}
+
+/*
+================
+idParallelJobList::GetNumThreads
+
+  returns the number of worker threads that take jobs
+================
+*/
+int idParallelJobList::GetNumThreads( void ) const {
+	if ( threads == NULL ) {
+		return 0;
+	}
+	return threads->numActive;
+}
+
+/*
+================
+idParallelJobList::AddJob
+================
+*/
+void idParallelJobList::AddJob( jobRun_t function, void *data ) {
+	job_t &job = jobs.Alloc();
+	job.function = function;
+	job.data = data;
+}
+
+/*
+================
+idParallelJobList::Run
+================
+*/
+void idParallelJobList::Run( void ) {
+	int i;
+
+	if ( jobs.Num() == 0 ) {
+		return;
+	}
+
+	if ( threads == NULL || threads->numActive == 0 || jobs.Num() == 1 ) {
+		for ( i = 0; i < jobs.Num(); i++ ) {
+			jobs[i].function( jobs[i].data );
+		}
+		jobs.SetNum( 0, false );
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock( threads->mutex );
+		threads->jobs = jobs.Ptr();
+		threads->numJobs = jobs.Num();
+		threads->nextJob = 0;
+		threads->numBusy = threads->numActive;
+		threads->generation++;
+		threads->wake.notify_all();
+	}
+
+	for ( i = threads->nextJob++; i < jobs.Num(); i = threads->nextJob++ ) {
+		jobs[i].function( jobs[i].data );
+	}
+
+	// the jobs are done once all workers are, no worker touches the job list after this
+	{
+		std::unique_lock<std::mutex> lock( threads->mutex );
+		while ( threads->numBusy > 0 ) {
+			threads->done.wait( lock );
+		}
+	}
+
+	jobs.SetNum( 0, false );
+}
+
+/*
+================
+idParallelJobList::NumHardwareThreads
+================
+*/
+int idParallelJobList::NumHardwareThreads( void ) {
+	unsigned int num = std::thread::hardware_concurrency();
+	return ( num > 0 ) ? (int) num : 1;
+}
@@ -0,0 +1,87 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __PARALLELJOBLIST_H__
+#define __PARALLELJOBLIST_H__
+
+/*
+===============================================================================
+
+	Parallel job list
+
+	Runs independent jobs on a small pool of worker threads. The thread calling
+	Run executes jobs as well and Run only returns when all jobs are done, so the
+	jobs may use any data that stays untouched by the calling thread until then.
+
+	A worker thread first calls the thread init function, if it returns false the
+	worker never takes any jobs. Jobs should not depend on which thread runs them.
+
+===============================================================================
+*/
+
+typedef void ( *jobRun_t )( void *data );
+typedef bool ( *jobThreadInit_t )( void );
+typedef void ( *jobThreadShutdown_t )( void );
+
+class idParallelJobList {
+public:
+						idParallelJobList( void );
+						~idParallelJobList( void );
+
+						// starts the worker threads, the floating-point environment of the calling thread is copied to the workers
+	void				Init( int numThreads, jobThreadInit_t threadInit = NULL, jobThreadShutdown_t threadShutdown = NULL );
+						// waits for the worker threads to exit
+	void				Shutdown( void );
+	int					GetNumThreads( void ) const;
+
+	void				AddJob( jobRun_t function, void *data );
+	int					NumJobs( void ) const;
+						// runs all jobs added since the last call and waits for them to finish
+	void				Run( void );
+
+						// number of hardware threads, at least 1
+	static int			NumHardwareThreads( void );
+
+private:
+	typedef struct job_s {
+		jobRun_t		function;
+		void *			data;
+	} job_t;
+
+	idList<job_t>		jobs;
+	struct jobThreads_s *threads;
+
+	static void			WorkerThread( struct jobThreads_s *t );
+};
+
+ID_INLINE int idParallelJobList::NumJobs( void ) const {
+	return jobs.Num();
+}
+
+#endif /* !__PARALLELJOBLIST_H__ */
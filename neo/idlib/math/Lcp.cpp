@@ -509,6 +509,9 @@ bool idLCP_Square::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, con
 	float dir, maxStep, dot, s;
 	char *failed;
 
+	numIterations = 0;
+	warmStarted = false;
+
 	// true when the matrix rows are 16 byte padded
 	padded = ((o_m.GetNumRows()+3)&~3) == o_m.GetNumColumns();
 
@@ -656,6 +659,8 @@ bool idLCP_Square::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, con
 		// drive the current variable into a valid region
 		for ( n = 0; n < maxIterations; n++ ) {
 
+			numIterations++;
+
 			// direction to move
 			if ( a[i] <= 0.0f ) {
 				dir = 1.0f;
@@ -804,6 +809,7 @@ bool idLCP_Square::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, con
 class idLCP_Symmetric : public idLCP {
 public:
 	virtual bool	Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex );
+	virtual bool	SolveWarmStarted( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex, int *o_side );
 
 private:
 	idMatX			m;					// original matrix
@@ -835,6 +841,7 @@ private:
 	void			ChangeForce( int d, float step );
 	void			ChangeAccel( int d, float step );
 	void			GetMaxStep( int d, float dir, float &maxStep, int &limit, int &limitSide ) const;
+	bool			SolveGuess( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex, const int *o_side );
 };
 
 /*
@@ -1299,6 +1306,9 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 	float dir, maxStep, dot, s;
 	char *failed;
 
+	numIterations = 0;
+	warmStarted = false;
+
 	// true when the matrix rows are 16 byte padded
 	padded = ((o_m.GetNumRows()+3)&~3) == o_m.GetNumColumns();
 
@@ -1450,6 +1460,8 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 		// drive the current variable into a valid region
 		for ( n = 0; n < maxIterations; n++ ) {
 
+			numIterations++;
+
 			// direction to move
 			if ( a[i] <= 0.0f ) {
 				dir = 1.0f;
@@ -1589,6 +1601,179 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 }
 
 
+/*
+============
+idLCP_Symmetric::SolveGuess
+
+  Solves for the variables guessed to be inbetween their boundaries with all
+  other variables at the guessed boundaries. Returns false if the result does
+  not satisfy the complementarity conditions.
+============
+*/
+#define LCP_GUESS_BOX_ITERATIONS	4
+
+bool idLCP_Symmetric::SolveGuess( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex, const int *o_side ) {
+	int i, j, k, n, numGuessed, numFixed, iter;
+	int *guessed, *fixed;
+	float dot, s, bound;
+	bool settled;
+	idVecX x, l, h, rhs, sol;
+	idMatX guessMatrix;
+
+	n = o_m.GetNumRows();
+
+	x.SetData( n, VECX_ALLOCA( n ) );
+	l.SetData( n, VECX_ALLOCA( n ) );
+	h.SetData( n, VECX_ALLOCA( n ) );
+	guessed = (int *) _alloca16( n * sizeof( int ) );
+	fixed = (int *) _alloca16( n * sizeof( int ) );
+
+	// split into variables guessed inbetween their boundaries and variables fixed at a boundary
+	numGuessed = numFixed = 0;
+	for ( i = 0; i < n; i++ ) {
+		if ( o_side[i] == 0 || ( o_lo[i] == -idMath::INFINITY && o_hi[i] == idMath::INFINITY ) ) {
+			guessed[numGuessed++] = i;
+		} else {
+			fixed[numFixed++] = i;
+		}
+	}
+
+	if ( numGuessed ) {
+		// factor the sub matrix for the guessed variables
+		guessMatrix.SetData( numGuessed, numGuessed, MATX_ALLOCA( numGuessed * numGuessed ) );
+		for ( i = 0; i < numGuessed; i++ ) {
+			for ( j = 0; j < numGuessed; j++ ) {
+				guessMatrix[i][j] = o_m[guessed[i]][guessed[j]];
+			}
+		}
+		diagonal.SetData( numGuessed, VECX_ALLOCA( numGuessed ) );
+		solveCache1.SetData( numGuessed, VECX_ALLOCA( numGuessed ) );
+		if ( !SIMDProcessor->MatX_LDLTFactor( guessMatrix, diagonal, numGuessed ) ) {
+			return false;
+		}
+		rhs.SetData( numGuessed, VECX_ALLOCA( numGuessed ) );
+		sol.SetData( numGuessed, VECX_ALLOCA( numGuessed ) );
+	}
+
+	// the box index variables start at the guess
+	x = o_x;
+
+	// the boundaries of box constrained variables depend on the solution so iterate until they settle
+	for ( iter = 0; ; iter++ ) {
+
+		for ( i = 0; i < n; i++ ) {
+			l[i] = o_lo[i];
+			h[i] = o_hi[i];
+			if ( o_boxIndex && o_boxIndex[i] >= 0 ) {
+				s = x[o_boxIndex[i]];
+				if ( l[i] != -idMath::INFINITY ) {
+					l[i] = - idMath::Fabs( l[i] * s );
+				}
+				if ( h[i] != idMath::INFINITY ) {
+					h[i] = idMath::Fabs( h[i] * s );
+				}
+			}
+		}
+
+		// put the fixed variables at their boundary
+		settled = ( iter > 0 );
+		for ( i = 0; i < numFixed; i++ ) {
+			k = fixed[i];
+			bound = ( o_side[k] < 0 ) ? l[k] : h[k];
+			if ( bound == -idMath::INFINITY || bound == idMath::INFINITY ) {
+				return false;
+			}
+			if ( idMath::Fabs( x[k] - bound ) > LCP_BOUND_EPSILON ) {
+				settled = false;
+			}
+			x[k] = bound;
+		}
+
+		if ( settled ) {
+			break;
+		}
+		if ( iter >= LCP_GUESS_BOX_ITERATIONS ) {
+			return false;
+		}
+
+		if ( numGuessed ) {
+			// right hand side for the guessed variables
+			for ( i = 0; i < numGuessed; i++ ) {
+				k = guessed[i];
+				dot = o_b[k];
+				for ( j = 0; j < numFixed; j++ ) {
+					dot -= o_m[k][fixed[j]] * x[fixed[j]];
+				}
+				rhs[i] = dot;
+			}
+
+			// solve the LDLt factored sub matrix
+			SIMDProcessor->MatX_LowerTriangularSolve( guessMatrix, solveCache1.ToFloatPtr(), rhs.ToFloatPtr(), numGuessed );
+			SIMDProcessor->Mul( solveCache1.ToFloatPtr(), solveCache1.ToFloatPtr(), diagonal.ToFloatPtr(), numGuessed );
+			SIMDProcessor->MatX_LowerTriangularSolveTranspose( guessMatrix, sol.ToFloatPtr(), solveCache1.ToFloatPtr(), numGuessed );
+
+			for ( i = 0; i < numGuessed; i++ ) {
+				x[guessed[i]] = sol[i];
+			}
+		}
+
+		// the boundaries only change with box constrained variables
+		if ( !o_boxIndex ) {
+			break;
+		}
+	}
+
+	// the guessed variables must be within their boundaries
+	for ( i = 0; i < numGuessed; i++ ) {
+		k = guessed[i];
+		if ( x[k] < l[k] - LCP_BOUND_EPSILON || x[k] > h[k] + LCP_BOUND_EPSILON ) {
+			return false;
+		}
+		x[k] = idMath::ClampFloat( l[k], h[k], x[k] );
+	}
+
+	// the fixed variables must be pushed against their boundary
+	for ( i = 0; i < numFixed; i++ ) {
+		k = fixed[i];
+		SIMDProcessor->Dot( dot, o_m[k], x.ToFloatPtr(), n );
+		dot -= o_b[k];
+		if ( o_side[k] < 0 ) {
+			if ( dot < -LCP_ACCEL_EPSILON ) {
+				return false;
+			}
+		} else {
+			if ( dot > LCP_ACCEL_EPSILON ) {
+				return false;
+			}
+		}
+	}
+
+	o_x = x;
+
+	return true;
+}
+
+/*
+============
+idLCP_Symmetric::SolveWarmStarted
+============
+*/
+bool idLCP_Symmetric::SolveWarmStarted( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex, int *o_side ) {
+
+	if ( SolveGuess( o_m, o_x, o_b, o_lo, o_hi, o_boxIndex, o_side ) ) {
+		numIterations = 0;
+		warmStarted = true;
+		return true;
+	}
+
+	if ( !Solve( o_m, o_x, o_b, o_lo, o_hi, o_boxIndex ) ) {
+		return false;
+	}
+	GetSides( o_x, o_lo, o_hi, o_boxIndex, o_side );
+	return true;
+}
+
+
 //===============================================================
 //
 //	idLCP
@@ -1603,6 +1788,8 @@ idLCP::AllocSquare
 idLCP *idLCP::AllocSquare( void ) {
 	idLCP *lcp = new idLCP_Square;
 	lcp->SetMaxIterations( 32 );
+	lcp->numIterations = 0;
+	lcp->warmStarted = false;
 	return lcp;
 }
 
@@ -1614,6 +1801,8 @@ idLCP::AllocSymmetric
 idLCP *idLCP::AllocSymmetric( void ) {
 	idLCP *lcp = new idLCP_Symmetric;
 	lcp->SetMaxIterations( 32 );
+	lcp->numIterations = 0;
+	lcp->warmStarted = false;
 	return lcp;
 }
 
@@ -1625,6 +1814,52 @@ idLCP::~idLCP
 idLCP::~idLCP( void ) {
 }
 
+/*
+============
+idLCP::SolveWarmStarted
+
+  solves from scratch and only sets the sides of the solution
+============
+*/
+bool idLCP::SolveWarmStarted( const idMatX &A, idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex, int *side ) {
+	if ( !Solve( A, x, b, lo, hi, boxIndex ) ) {
+		return false;
+	}
+	GetSides( x, lo, hi, boxIndex, side );
+	return true;
+}
+
+/*
+============
+idLCP::GetSides
+============
+*/
+void idLCP::GetSides( const idVecX &x, const idVecX &lo, const idVecX &hi, const int *boxIndex, int *side ) {
+	int i;
+	float l, h, s;
+
+	for ( i = 0; i < x.GetSize(); i++ ) {
+		l = lo[i];
+		h = hi[i];
+		if ( boxIndex && boxIndex[i] >= 0 ) {
+			s = x[boxIndex[i]];
+			if ( l != -idMath::INFINITY ) {
+				l = - idMath::Fabs( l * s );
+			}
+			if ( h != idMath::INFINITY ) {
+				h = idMath::Fabs( h * s );
+			}
+		}
+		if ( l != -idMath::INFINITY && x[i] <= l + LCP_BOUND_EPSILON ) {
+			side[i] = -1;
+		} else if ( h != idMath::INFINITY && x[i] >= h - LCP_BOUND_EPSILON ) {
+			side[i] = 1;
+		} else {
+			side[i] = 0;
+		}
+	}
+}
+
 /*
 ============
 idLCP::SetMaxIterations
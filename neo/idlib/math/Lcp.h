@@ -56,6 +56,13 @@ If you have questions concerning this license or the applicable additional terms
   Before calculating any of the bounded x[i] with boxIndex[i] != -1 the
   solver calculates all unbounded x[i] and all x[i] with boxIndex[i] == -1.
 
+  SolveWarmStarted takes a guess of which variables are at their boundaries,
+  usually the solution of a similar problem. side[i] is -1 if x[i] is at the
+  low boundary, 1 if at the high boundary and 0 if inbetween, and x is the guess
+  for the variables referenced by the box index. If the guess satisfies the
+  complementarity conditions the problem is solved with a single factorization,
+  otherwise it is solved from scratch. On return side is set for the solution.
+
 ===============================================================================
 */
 
@@ -67,11 +74,21 @@ public:
 	virtual			~idLCP( void );
 
 	virtual bool	Solve( const idMatX &A, idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex = NULL ) = 0;
+	virtual bool	SolveWarmStarted( const idMatX &A, idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex, int *side );
 	virtual void	SetMaxIterations( int max );
 	virtual int		GetMaxIterations( void );
 
+					// statistics of the last solve
+	int				GetNumIterations( void ) const { return numIterations; }
+	bool			WasWarmStarted( void ) const { return warmStarted; }
+
+					// sets side from a solution
+	static void		GetSides( const idVecX &x, const idVecX &lo, const idVecX &hi, const int *boxIndex, int *side );
+
 protected:
 	int				maxIterations;
+	int				numIterations;			// number of times a variable was driven towards a valid region
+	bool			warmStarted;			// true if the guess was the solution
 };
 
 #endif /* !__MATH_LCP_H__ */
@@ -2354,6 +2354,55 @@ void TestBlendJoints( void ) {
 	PrintClocks( va( "   simd->BlendJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestDequantizeComponents
+============
+*/
+void TestDequantizeComponents( void ) {
+	int i;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( unsigned short src[COUNT] );
+	ALIGN16( float scale[COUNT] );
+	ALIGN16( float bias[COUNT] );
+	ALIGN16( float fdst0[COUNT] );
+	ALIGN16( float fdst1[COUNT] );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT; i++ ) {
+		src[i] = srnd.RandomInt( 65535 );
+		scale[i] = srnd.RandomFloat() * 10.0f / 65535.0f;
+		bias[i] = srnd.CRandomFloat() * 10.0f;
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->DequantizeComponents( fdst0, src, scale, bias, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->DequantizeComponents()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->DequantizeComponents( fdst1, src, scale, bias, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( idMath::Fabs( fdst0[i] - fdst1[i] ) > 1e-5f ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->DequantizeComponents() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
 /*
 ============
 TestConvertJointQuatsToJointMats
@@ -4188,6 +4237,7 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	idLib::common->Printf("====================================\n" );
 
 	TestBlendJoints();
+	TestDequantizeComponents();
 	TestConvertJointQuatsToJointMats();
 	TestConvertJointMatsToJointQuats();
 	TestTransformJoints();
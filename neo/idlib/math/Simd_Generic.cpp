@@ -2253,6 +2253,19 @@ void VPCALL idSIMD_Generic::BlendJoints( idJointQuat *joints, const idJointQuat
 	}
 }
 
+/*
+============
+idSIMD_Generic::DequantizeComponents
+
+  dst[i] = bias[i] + scale[i] * src[i];
+============
+*/
+void VPCALL idSIMD_Generic::DequantizeComponents( float *dst, const unsigned short *src, const float *scale, const float *bias, const int count ) {
+#define OPER(X) dst[(X)] = bias[(X)] + scale[(X)] * src[(X)];
+	UNROLL4(OPER)
+#undef OPER
+}
+
 /*
 ============
 idSIMD_Generic::ConvertJointQuatsToJointMats
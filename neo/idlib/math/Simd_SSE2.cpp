@@ -875,3 +875,34 @@ void VPCALL idSIMD_SSE2::MixedSoundToSamples( short *samples, const float *mixBu
 }
 
 #endif /* _WIN32 */
+
+#if defined(_WIN32) || defined(__SSE2__)
+
+#include <emmintrin.h>
+
+/*
+============
+idSIMD_SSE2::DequantizeComponents
+
+  dst[i] = bias[i] + scale[i] * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::DequantizeComponents( float *dst, const unsigned short *src, const float *scale, const float *bias, const int count ) {
+	int i;
+	const __m128i zero = _mm_setzero_si128();
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		__m128i s = _mm_loadu_si128( (const __m128i *)( src + i ) );
+		__m128 lo = _mm_cvtepi32_ps( _mm_unpacklo_epi16( s, zero ) );
+		__m128 hi = _mm_cvtepi32_ps( _mm_unpackhi_epi16( s, zero ) );
+		lo = _mm_add_ps( _mm_loadu_ps( bias + i + 0 ), _mm_mul_ps( _mm_loadu_ps( scale + i + 0 ), lo ) );
+		hi = _mm_add_ps( _mm_loadu_ps( bias + i + 4 ), _mm_mul_ps( _mm_loadu_ps( scale + i + 4 ), hi ) );
+		_mm_storeu_ps( dst + i + 0, lo );
+		_mm_storeu_ps( dst + i + 4, hi );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = bias[i] + scale[i] * src[i];
+	}
+}
+
+#endif
@@ -52,6 +52,10 @@ public:
 	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples );
 
 #endif
+
+#if defined(_WIN32) || defined(__SSE2__)
+	virtual void VPCALL DequantizeComponents( float *dst, const unsigned short *src, const float *scale, const float *bias, const int count );
+#endif
 };
 
 #endif /* !__MATH_SIMD_SSE2_H__ */
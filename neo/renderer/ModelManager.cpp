@@ -70,6 +70,7 @@ private:
 	static void				ListModels_f( const idCmdArgs &args );
 	static void				ReloadModels_f( const idCmdArgs &args );
 	static void				TouchModel_f( const idCmdArgs &args );
+	static void				TestBinaryModels_f( const idCmdArgs &args );
 };
 
 
@@ -141,6 +142,68 @@ void idRenderModelManagerLocal::ListModels_f( const idCmdArgs &args ) {
 	common->Printf( "total memory: %4.1fM\n", (float)totalMem / (1024*1024) );
 }
 
+/*
+==============
+idRenderModelManagerLocal::TestBinaryModels_f
+
+compares text and binary load times of the loaded md5 meshes
+==============
+*/
+void idRenderModelManagerLocal::TestBinaryModels_f( const idCmdArgs &args ) {
+	const char	*filter;
+	bool		binaryModels;
+	idTimer		textTimer, binaryTimer;
+	double		totalText, totalBinary;
+	int			num;
+
+	filter = ( args.Argc() > 1 ) ? args.Argv( 1 ) : "models/md5/monsters/";
+	binaryModels = r_binaryModels.GetBool();
+	totalText = totalBinary = 0.0;
+	num = 0;
+
+	common->Printf( "    text  binary\n" );
+	for ( int i = 0 ; i < localModelManager.models.Num() ; i++ ) {
+		idRenderModel	*model = localModelManager.models[i];
+		idStr			extension;
+
+		idStr( model->Name() ).ExtractFileExtension( extension );
+		if ( !model->IsLoaded() || extension.Icmp( MD5_MESH_EXT ) != 0 || idStr::Icmpn( model->Name(), filter, idStr::Length( filter ) ) != 0 ) {
+			continue;
+		}
+
+		// make sure the binary cache is up to date
+		r_binaryModels.SetBool( true );
+		idRenderModelMD5 *test = new idRenderModelMD5;
+		test->InitFromFile( model->Name() );
+		delete test;
+
+		r_binaryModels.SetBool( false );
+		textTimer.Clear();
+		textTimer.Start();
+		test = new idRenderModelMD5;
+		test->InitFromFile( model->Name() );
+		textTimer.Stop();
+		delete test;
+
+		r_binaryModels.SetBool( true );
+		binaryTimer.Clear();
+		binaryTimer.Start();
+		test = new idRenderModelMD5;
+		test->InitFromFile( model->Name() );
+		binaryTimer.Stop();
+		delete test;
+
+		common->Printf( "%6.1fms %6.1fms %s\n", textTimer.Milliseconds(), binaryTimer.Milliseconds(), model->Name() );
+		totalText += textTimer.Milliseconds();
+		totalBinary += binaryTimer.Milliseconds();
+		num++;
+	}
+
+	r_binaryModels.SetBool( binaryModels );
+
+	common->Printf( "%d md5 meshes: %.1fms text, %.1fms binary\n", num, totalText, totalBinary );
+}
+
 /*
 ==============
 idRenderModelManagerLocal::ReloadModels_f
@@ -210,6 +273,7 @@ void idRenderModelManagerLocal::Init() {
 	cmdSystem->AddCommand( "printModel", PrintModel_f, CMD_FL_RENDERER, "prints model info", idCmdSystem::ArgCompletion_ModelName );
 	cmdSystem->AddCommand( "reloadModels", ReloadModels_f, CMD_FL_RENDERER|CMD_FL_CHEAT, "reloads models" );
 	cmdSystem->AddCommand( "touchModel", TouchModel_f, CMD_FL_RENDERER, "touches a model", idCmdSystem::ArgCompletion_ModelName );
+	cmdSystem->AddCommand( "testBinaryModels", TestBinaryModels_f, CMD_FL_RENDERER, "compares text and binary load times of the loaded md5 meshes" );
 
 	insideLevelLoad = false;
 
@@ -145,6 +145,8 @@ public:
 								~idMD5Mesh();
 
  	void						ParseMesh( idLexer &parser, int numJoints, const idJointMat *joints );
+	bool						ReadBinary( idFile *file, int numJoints );
+	void						WriteBinary( idFile *file ) const;
 	void						UpdateSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf ) const;
 	idBounds					CalcBounds( const idJointMat *joints ) const;
 	int							NearestJoint( int a, int b, int c ) const;
@@ -164,6 +166,8 @@ private:
 
 	void						TransformVerts( idDrawVert *verts, const idJointMat *joints ) const;
 	void						TransformScaledVerts( idDrawVert *verts, const idJointMat *joints, float scale ) const;
+	void						PrepareSurface( modelSurface_t *surf ) const;
+	void						SkinSurface( const struct renderEntity_s *ent, const idJointMat *joints, srfTriangles_t *tri ) const;
 };
 
 class idRenderModelMD5 : public idRenderModelStatic {
@@ -185,7 +189,24 @@ public:
 	virtual const idJointQuat *	GetDefaultPose( void ) const;
 	virtual int					NearestJoint( int surfaceNum, int a, int b, int c ) const;
 
+								// while deferred, instantiated models only get their surfaces allocated and
+								// the skinning is queued until FinishDeferredSkinning runs it on the job threads
+	static void					BeginDeferredSkinning( void );
+	static int					FinishDeferredSkinning( idParallelJobList &jobList );
+
 private:
+	typedef struct skinningJob_s {
+		const idMD5Mesh *		mesh;
+		const renderEntity_t *	ent;
+		srfTriangles_t *		tri;
+		idRenderModelStatic *	model;
+	} skinningJob_t;
+
+	static bool					deferSkinning;
+	static idList<skinningJob_t> skinningJobs;
+
+	static void					SkinningJob( void *data );
+
 	idList<idMD5Joint>			joints;
 	idList<idJointQuat>			defaultPose;
 	idList<idMD5Mesh>			meshes;
@@ -194,6 +215,9 @@ private:
 	void						GetFrameBounds( const renderEntity_t *ent, idBounds &bounds ) const;
 	void						DrawJoints( const renderEntity_t *ent, const struct viewDef_s *view ) const;
 	void						ParseJoint( idLexer &parser, idMD5Joint *joint, idJointQuat *defaultPose );
+	bool						LoadBinaryModel( int sourceLength, ID_TIME_T sourceTime );
+	void						WriteBinaryModel( int sourceLength, ID_TIME_T sourceTime ) const;
+	idStr						BinaryModelName( void ) const;
 };
 
 /*
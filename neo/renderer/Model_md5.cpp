@@ -34,6 +34,10 @@ If you have questions concerning this license or the applicable additional terms
 
 static const char *MD5_SnapshotName = "_MD5_Snapshot_";
 
+#define MD5_BINARY_IDENT			( ( 'B' << 24 ) + ( '5' << 16 ) + ( 'D' << 8 ) + 'M' )
+#define MD5_BINARY_VERSION			1
+#define MD5_BINARY_EXT				"bmd5mesh"
+
 
 /***********************************************************************
 
@@ -245,6 +249,82 @@ void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, const idJointMat *joi
 	deformInfo = R_BuildDeformInfo( texCoords.Num(), verts, tris.Num(), tris.Ptr(), shader->UseUnsmoothedTangents() );
 }
 
+/*
+====================
+idMD5Mesh::WriteBinary
+====================
+*/
+void idMD5Mesh::WriteBinary( idFile *file ) const {
+	file->WriteString( shader->GetName() );
+
+	file->WriteInt( texCoords.Num() );
+	file->Write( texCoords.Ptr(), texCoords.Num() * sizeof( texCoords[0] ) );
+
+	file->WriteInt( numWeights );
+	file->Write( scaledWeights, numWeights * sizeof( scaledWeights[0] ) );
+	file->Write( weightIndex, numWeights * 2 * sizeof( weightIndex[0] ) );
+
+	file->WriteInt( numTris );
+	R_WriteDeformInfo( file, deformInfo );
+}
+
+/*
+====================
+idMD5Mesh::ReadBinary
+
+returns false if the file is truncated or inconsistent, the mesh is freed by the owning model
+====================
+*/
+bool idMD5Mesh::ReadBinary( idFile *file, int numJoints ) {
+	idStr	shaderName;
+	int		numVerts;
+	int		i;
+
+	file->ReadString( shaderName );
+	shader = declManager->FindMaterial( shaderName );
+
+	file->ReadInt( numVerts );
+	if ( numVerts < 0 ) {
+		return false;
+	}
+	texCoords.SetNum( numVerts );
+	if ( file->Read( texCoords.Ptr(), numVerts * sizeof( texCoords[0] ) ) != numVerts * (int)sizeof( texCoords[0] ) ) {
+		return false;
+	}
+
+	file->ReadInt( numWeights );
+	if ( numWeights < 0 ) {
+		return false;
+	}
+	scaledWeights = (idVec4 *) Mem_Alloc16( numWeights * sizeof( scaledWeights[0] ) );
+	weightIndex = (int *) Mem_Alloc16( numWeights * 2 * sizeof( weightIndex[0] ) );
+	if ( file->Read( scaledWeights, numWeights * sizeof( scaledWeights[0] ) ) != numWeights * (int)sizeof( scaledWeights[0] ) ||
+			file->Read( weightIndex, numWeights * 2 * sizeof( weightIndex[0] ) ) != numWeights * 2 * (int)sizeof( weightIndex[0] ) ) {
+		return false;
+	}
+	for ( i = 0; i < numWeights; i++ ) {
+		if ( weightIndex[i*2+0] < 0 || weightIndex[i*2+0] >= numJoints * (int)sizeof( idJointMat ) ) {
+			return false;
+		}
+	}
+
+	file->ReadInt( numTris );
+	deformInfo = R_ReadDeformInfo( file );
+	if ( !deformInfo || deformInfo->numSourceVerts != numVerts || deformInfo->numIndexes != numTris * 3 ) {
+		return false;
+	}
+
+	// update counters
+	c_numVerts += texCoords.Num();
+	c_numWeights += numWeights;
+	c_numWeightJoints++;
+	for ( i = 0; i < numWeights; i++ ) {
+		c_numWeightJoints += weightIndex[i*2+1];
+	}
+
+	return true;
+}
+
 /*
 ====================
 idMD5Mesh::TransformVerts
@@ -273,7 +353,28 @@ idMD5Mesh::UpdateSurface
 ====================
 */
 void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf ) const {
-	int i, base;
+	PrepareSurface( surf );
+	SkinSurface( ent, entJoints, surf->geometry );
+
+	// If a surface is going to be have a lighting interaction generated, it will also have to call
+	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
+	// needs shadows generated, it will only have to generate face planes.  If it only
+	// has ambient drawing, or is culled, no additional work will be necessary
+	if ( !r_useDeferredTangents.GetBool() ) {
+		// set face planes, vertex normals, tangents
+		R_DeriveTangents( surf->geometry );
+	}
+}
+
+/*
+====================
+idMD5Mesh::PrepareSurface
+
+Allocates the surface geometry and points it at the shared deform info, the verts are left for SkinSurface.
+====================
+*/
+void idMD5Mesh::PrepareSurface( modelSurface_t *surf ) const {
+	int i;
 	srfTriangles_t *tri;
 
 	tr.pc.c_deformedSurfaces++;
@@ -321,6 +422,18 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 			tri->verts[i].st = texCoords[i];
 		}
 	}
+}
+
+/*
+====================
+idMD5Mesh::SkinSurface
+
+Transforms the verts of a surface set up by PrepareSurface.  Doesn't allocate anything
+so surfaces of different entities can be skinned in parallel.
+====================
+*/
+void idMD5Mesh::SkinSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, srfTriangles_t *tri ) const {
+	int i, base;
 
 	if ( ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] != 0.0f ) {
 		TransformScaledVerts( tri->verts, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] );
@@ -335,15 +448,6 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 	}
 
 	R_BoundTriSurf( tri );
-
-	// If a surface is going to be have a lighting interaction generated, it will also have to call
-	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
-	// needs shadows generated, it will only have to generate face planes.  If it only
-	// has ambient drawing, or is culled, no additional work will be necessary
-	if ( !r_useDeferredTangents.GetBool() ) {
-		// set face planes, vertex normals, tangents
-		R_DeriveTangents( tri );
-	}
 }
 
 /*
@@ -434,6 +538,9 @@ int	idMD5Mesh::NumWeights( void ) const {
 
 ***********************************************************************/
 
+bool									idRenderModelMD5::deferSkinning = false;
+idList<idRenderModelMD5::skinningJob_t>	idRenderModelMD5::skinningJobs;
+
 /*
 ====================
 idRenderModelMD5::ParseJoint
@@ -470,6 +577,149 @@ void idRenderModelMD5::ParseJoint( idLexer &parser, idMD5Joint *joint, idJointQu
 	defaultPose->q.w = defaultPose->q.CalcW();
 }
 
+/*
+====================
+idRenderModelMD5::BinaryModelName
+====================
+*/
+idStr idRenderModelMD5::BinaryModelName( void ) const {
+	idStr binaryName = idStr( "generated/" ) + name;
+	binaryName.SetFileExtension( MD5_BINARY_EXT );
+	return binaryName;
+}
+
+/*
+====================
+idRenderModelMD5::WriteBinaryModel
+
+writes the joints, bounds and the final mesh arrays including the deform info,
+so loading doesn't need to parse text or build silhouette edges
+====================
+*/
+void idRenderModelMD5::WriteBinaryModel( int sourceLength, ID_TIME_T sourceTime ) const {
+	idFile_Memory	data;
+	idFile			*file;
+	int				i;
+
+	data.WriteInt( joints.Num() );
+	for ( i = 0; i < joints.Num(); i++ ) {
+		data.WriteString( joints[i].name );
+		data.WriteInt( joints[i].parent ? joints[i].parent - joints.Ptr() : -1 );
+	}
+	data.Write( defaultPose.Ptr(), defaultPose.Num() * sizeof( defaultPose[0] ) );
+	data.WriteVec3( bounds[0] );
+	data.WriteVec3( bounds[1] );
+
+	data.WriteInt( meshes.Num() );
+	for ( i = 0; i < meshes.Num(); i++ ) {
+		meshes[i].WriteBinary( &data );
+	}
+
+	file = fileSystem->OpenFileWrite( BinaryModelName() );
+	if ( !file ) {
+		common->Warning( "couldn't write %s", BinaryModelName().c_str() );
+		return;
+	}
+
+	file->WriteInt( MD5_BINARY_IDENT );
+	file->WriteInt( MD5_BINARY_VERSION );
+	file->WriteInt( sizeof( glIndex_t ) );
+	file->WriteInt( sourceLength );
+	file->WriteInt( (int) sourceTime );
+	file->WriteInt( data.Length() );
+	file->WriteInt( (int) CRC32_BlockChecksum( data.GetDataPtr(), data.Length() ) );
+	file->Write( data.GetDataPtr(), data.Length() );
+
+	fileSystem->CloseFile( file );
+}
+
+/*
+====================
+idRenderModelMD5::LoadBinaryModel
+
+loads the model with a single read from the binary cache written by WriteBinaryModel,
+returns false if the cache is missing, out of date or damaged
+====================
+*/
+bool idRenderModelMD5::LoadBinaryModel( int sourceLength, ID_TIME_T sourceTime ) {
+	void	*buffer;
+	int		length;
+	int		ident, version, indexSize, cachedLength, cachedTime, dataLength, crc;
+	int		i, num, parentNum;
+	bool	ok;
+
+	length = fileSystem->ReadFile( BinaryModelName(), &buffer );
+	if ( length <= 0 ) {
+		return false;
+	}
+
+	idFile_Memory file( BinaryModelName(), (const char *)buffer, length );
+
+	file.ReadInt( ident );
+	file.ReadInt( version );
+	file.ReadInt( indexSize );
+	file.ReadInt( cachedLength );
+	file.ReadInt( cachedTime );
+	file.ReadInt( dataLength );
+	file.ReadInt( crc );
+	if ( ident != MD5_BINARY_IDENT || version != MD5_BINARY_VERSION || indexSize != sizeof( glIndex_t ) ||
+			cachedLength != sourceLength || cachedTime != (int) sourceTime ||
+			dataLength != length - file.Tell() || (unsigned long) crc != CRC32_BlockChecksum( (const byte *)buffer + file.Tell(), dataLength ) ) {
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	ok = true;
+
+	file.ReadInt( num );
+	if ( num <= 0 ) {
+		ok = false;
+	} else {
+		joints.SetGranularity( 1 );
+		joints.SetNum( num );
+		defaultPose.SetGranularity( 1 );
+		defaultPose.SetNum( num );
+		for ( i = 0; i < num; i++ ) {
+			file.ReadString( joints[i].name );
+			file.ReadInt( parentNum );
+			if ( parentNum >= i ) {
+				ok = false;
+				break;
+			}
+			joints[i].parent = ( parentNum < 0 ) ? NULL : &joints[parentNum];
+		}
+		ok = ok && file.Read( defaultPose.Ptr(), num * sizeof( defaultPose[0] ) ) == num * (int)sizeof( defaultPose[0] );
+	}
+
+	if ( ok ) {
+		file.ReadVec3( bounds[0] );
+		file.ReadVec3( bounds[1] );
+
+		file.ReadInt( num );
+		if ( num < 0 ) {
+			ok = false;
+		} else {
+			meshes.SetGranularity( 1 );
+			meshes.SetNum( num );
+			for ( i = 0; i < num && ok; i++ ) {
+				ok = meshes[i].ReadBinary( &file, joints.Num() );
+			}
+		}
+	}
+
+	fileSystem->FreeFile( buffer );
+
+	if ( !ok ) {
+		common->Warning( "%s is damaged, loading %s", BinaryModelName().c_str(), name.c_str() );
+		PurgeModel();
+		purged = false;
+		return false;
+	}
+
+	timeStamp = sourceTime;
+	return true;
+}
+
 /*
 ====================
 idRenderModelMD5::InitFromFile
@@ -498,12 +748,19 @@ void idRenderModelMD5::LoadModel() {
 	idJointQuat	*pose;
 	idMD5Joint	*joint;
 	idJointMat *poseMat3;
+	int			sourceLength;
+	ID_TIME_T	sourceTime;
 
 	if ( !purged ) {
 		PurgeModel();
 	}
 	purged = false;
 
+	sourceLength = fileSystem->ReadFile( name, NULL, &sourceTime );
+	if ( sourceLength > 0 && r_binaryModels.GetBool() && LoadBinaryModel( sourceLength, sourceTime ) ) {
+		return;
+	}
+
 	if ( !parser.LoadFile( name ) ) {
 		MakeDefaultModel();
 		return;
@@ -571,6 +828,10 @@ void idRenderModelMD5::LoadModel() {
 
 	// set the timestamp for reloadmodels
 	fileSystem->ReadFile( name, NULL, &timeStamp );
+
+	if ( sourceLength > 0 && r_binaryModels.GetBool() ) {
+		WriteBinaryModel( sourceLength, sourceTime );
+	}
 }
 
 /*
@@ -801,6 +1062,18 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 			surf->id = i;
 		}
 
+		if ( deferSkinning ) {
+			// the model bounds are added once the surface is skinned
+			mesh->PrepareSurface( surf );
+
+			skinningJob_t &job = skinningJobs.Alloc();
+			job.mesh = mesh;
+			job.ent = ent;
+			job.tri = surf->geometry;
+			job.model = staticModel;
+			continue;
+		}
+
 		mesh->UpdateSurface( ent, ent->joints, surf );
 
 		staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
@@ -810,6 +1083,60 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 	return staticModel;
 }
 
+/*
+====================
+idRenderModelMD5::BeginDeferredSkinning
+====================
+*/
+void idRenderModelMD5::BeginDeferredSkinning( void ) {
+	deferSkinning = true;
+	skinningJobs.SetNum( 0, false );
+}
+
+/*
+====================
+idRenderModelMD5::SkinningJob
+====================
+*/
+void idRenderModelMD5::SkinningJob( void *data ) {
+	skinningJob_t *job = (skinningJob_t *) data;
+
+	job->mesh->SkinSurface( job->ent, job->ent->joints, job->tri );
+}
+
+/*
+====================
+idRenderModelMD5::FinishDeferredSkinning
+
+Skins all queued surfaces on the job threads and returns the number of surfaces skinned.
+====================
+*/
+int idRenderModelMD5::FinishDeferredSkinning( idParallelJobList &jobList ) {
+	int i, numSkinned;
+
+	deferSkinning = false;
+
+	for ( i = 0; i < skinningJobs.Num(); i++ ) {
+		jobList.AddJob( SkinningJob, &skinningJobs[i] );
+	}
+	jobList.Run();
+
+	for ( i = 0; i < skinningJobs.Num(); i++ ) {
+		skinningJobs[i].model->bounds.AddPoint( skinningJobs[i].tri->bounds[0] );
+		skinningJobs[i].model->bounds.AddPoint( skinningJobs[i].tri->bounds[1] );
+
+		// deriving the tangents may allocate the face planes, so it stays on this thread
+		if ( !r_useDeferredTangents.GetBool() ) {
+			R_DeriveTangents( skinningJobs[i].tri );
+		}
+	}
+
+	numSkinned = skinningJobs.Num();
+	skinningJobs.SetNum( 0, false );
+
+	return numSkinned;
+}
+
 /*
 ====================
 idRenderModelMD5::IsDynamicModel
@@ -71,6 +71,8 @@ idCVar r_useTurboShadow( "r_useTurboShadow", "1", CVAR_RENDERER | CVAR_BOOL, "us
 idCVar r_useTwoSidedStencil( "r_useTwoSidedStencil", "1", CVAR_RENDERER | CVAR_BOOL, "do stencil shadows in one pass with different ops on each side" );
 idCVar r_useDeferredTangents( "r_useDeferredTangents", "1", CVAR_RENDERER | CVAR_BOOL, "defer tangents calculations after deform" );
 idCVar r_useCachedDynamicModels( "r_useCachedDynamicModels", "1", CVAR_RENDERER | CVAR_BOOL, "cache snapshots of dynamic models" );
+idCVar r_parallelSkinning( "r_parallelSkinning", "2", CVAR_RENDERER | CVAR_INTEGER, "number of job threads skinning the md5 models in view, 0 = skin them one at a time while adding the model surfaces", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
+idCVar r_binaryModels( "r_binaryModels", "1", CVAR_RENDERER | CVAR_BOOL, "load md5 meshes from binary caches under generated/ and write the caches when they are missing or out of date" );
 
 idCVar r_useIndexBuffers( "r_useIndexBuffers", "0", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_INTEGER, "use ARB_vertex_buffer_object for indexes", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1>  );
 
@@ -2022,6 +2024,8 @@ void idRenderSystemLocal::Shutdown( void ) {
 	// free frame memory
 	R_ShutdownFrameData();
 
+	R_ShutdownSkinning();
+
 	// free the vertex cache, which should have nothing allocated now
 	vertexCache.Shutdown();
 
@@ -435,6 +435,10 @@ public:
 
 	// Text drawing for debug visualization.
 	virtual void			DrawText( const char *text, const idVec3 &origin, float scale, const idVec4 &color, const idMat3 &viewAxis, const int align = 1, const int lifetime = 0, bool depthTest = false ) = 0;
+
+	// changes whenever any portal state changes, so results of area flowing can be cached
+	// added last so the slots of the methods above stay where they were
+	virtual int				GetPortalStateCount( void ) const = 0;
 };
 
 #endif /* !__RENDERWORLD_H__ */
@@ -1022,6 +1022,15 @@ int		idRenderWorldLocal::GetPortalState( qhandle_t portal ) {
 	return doublePortals[portal-1].blockingBits;
 }
 
+/*
+==============
+GetPortalStateCount
+==============
+*/
+int		idRenderWorldLocal::GetPortalStateCount( void ) const {
+	return connectedAreaNum;
+}
+
 /*
 =====================
 idRenderWorldLocal::ShowPortals
@@ -30,9 +30,17 @@ If you have questions concerning this license or the applicable additional terms
 #pragma hdrstop
 
 #include "tr_local.h"
+#include "Model_local.h"
 
 static const float CHECK_BOUNDS_EPSILON = 1.0f;
 
+static const int MAX_SKINNING_THREADS = 3;
+
+static idParallelJobList				skinningJobList;
+static int								skinningThreads = 0;		// number of job threads requested
+static bool								deferDynamicModels = false;	// set while R_SkinViewEntities instantiates the models
+static idList<idRenderEntityLocal *>	deferredDynamicModels;		// instantiated models waiting for their overlays
+
 
 /*
 ===========================================================================================
@@ -1101,6 +1109,34 @@ bool R_IssueEntityDefCallback( idRenderEntityLocal *def ) {
 	return update;
 }
 
+/*
+===================
+R_FinishDynamicModelSnapshot
+
+Adds the overlays to a freshly instantiated dynamic model.
+===================
+*/
+static void R_FinishDynamicModelSnapshot( idRenderEntityLocal *def ) {
+	// add any overlays to the snapshot of the dynamic model
+	if ( def->overlay && !r_skipOverlays.GetBool() ) {
+		def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
+	} else {
+		idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
+	}
+
+	if ( r_checkBounds.GetBool() ) {
+		idBounds b = def->cachedDynamicModel->Bounds();
+		if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
+				b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
+				b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
+				b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
+				b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
+				b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
+			common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
+		}
+	}
+}
+
 /*
 ===================
 R_EntityDefDynamicModel
@@ -1145,24 +1181,11 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 		def->cachedDynamicModel = model->InstantiateDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
 
 		if ( def->cachedDynamicModel ) {
-
-			// add any overlays to the snapshot of the dynamic model
-			if ( def->overlay && !r_skipOverlays.GetBool() ) {
-				def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
+			if ( deferDynamicModels ) {
+				// the overlays copy the skinned vertexes, so they are added once the skinning jobs ran
+				deferredDynamicModels.Append( def );
 			} else {
-				idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
-			}
-
-			if ( r_checkBounds.GetBool() ) {
-				idBounds b = def->cachedDynamicModel->Bounds();
-				if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
-						b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
-						b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
-						b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
-						b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
-						b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
-					common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
-				}
+				R_FinishDynamicModelSnapshot( def );
 			}
 		}
 
@@ -1456,6 +1479,90 @@ idScreenRect R_CalcEntityScissorRectangle( viewEntity_t *vEntity ) {
 	return R_ScreenRectFromViewFrustumBounds( bounds );
 }
 
+/*
+===================
+R_SkinViewEntities
+
+Instantiates the md5 models of the entities with a visible rectangle before
+R_AddModelSurfaces walks the entities, so the meshes of all of them are skinned
+on the job threads at once.  The entity callbacks still run on this thread.
+===================
+*/
+void R_SkinViewEntities( void ) {
+	int						i, num;
+	viewEntity_t *			vEntity;
+	idRenderEntityLocal *	def;
+	float					oldFloatTime;
+	int						oldTime;
+
+	num = idMath::ClampInt( 0, MAX_SKINNING_THREADS, r_parallelSkinning.GetInteger() );
+	num = Min( num, idParallelJobList::NumHardwareThreads() - 1 );
+	if ( num != skinningThreads ) {
+		skinningThreads = num;
+		skinningJobList.Init( skinningThreads );
+	}
+
+	if ( skinningThreads == 0 || skinningJobList.GetNumThreads() == 0 ) {
+		return;
+	}
+
+	idRenderModelMD5::BeginDeferredSkinning();
+	deferDynamicModels = true;
+	deferredDynamicModels.SetNum( 0, false );
+
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		def = vEntity->entityDef;
+
+		// entities without a visible rectangle may never need their model
+		if ( vEntity->scissorRect.IsEmpty() ) {
+			continue;
+		}
+		if ( !def->parms.hModel || def->parms.hModel->IsDynamicModel() != DM_CACHED ) {
+			continue;
+		}
+		if ( tr.viewDef->isXraySubview ? ( def->parms.xrayIndex == 1 ) : ( def->parms.xrayIndex == 2 ) ) {
+			continue;
+		}
+
+		game->SelectTimeGroup( def->parms.timeGroup );
+
+		if ( def->parms.timeGroup ) {
+			oldFloatTime = tr.viewDef->floatTime;
+			oldTime = tr.viewDef->renderView.time;
+
+			tr.viewDef->floatTime = game->GetTimeGroupTime( def->parms.timeGroup ) * 0.001;
+			tr.viewDef->renderView.time = game->GetTimeGroupTime( def->parms.timeGroup );
+		}
+
+		R_EntityDefDynamicModel( def );
+
+		if ( def->parms.timeGroup ) {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
+		}
+	}
+
+	deferDynamicModels = false;
+
+	tr.pc.c_parallelDeformedSurfaces += idRenderModelMD5::FinishDeferredSkinning( skinningJobList );
+
+	for ( i = 0; i < deferredDynamicModels.Num(); i++ ) {
+		R_FinishDynamicModelSnapshot( deferredDynamicModels[i] );
+	}
+	deferredDynamicModels.SetNum( 0, false );
+}
+
+/*
+===================
+R_ShutdownSkinning
+===================
+*/
+void R_ShutdownSkinning( void ) {
+	skinningJobList.Shutdown();
+	skinningThreads = 0;
+	deferredDynamicModels.Clear();
+}
+
 /*
 ===================
 R_AddModelSurfaces
@@ -649,6 +649,7 @@ typedef struct {
 	int		c_deformedSurfaces;	// idMD5Mesh::GenerateSurface
 	int		c_deformedVerts;	// idMD5Mesh::GenerateSurface
 	int		c_deformedIndexes;	// idMD5Mesh::GenerateSurface
+	int		c_parallelDeformedSurfaces;	// idRenderModelMD5::FinishDeferredSkinning
 	int		c_tangentIndexes;	// R_DeriveTangents()
 	int		c_entityUpdates, c_lightUpdates, c_entityReferences, c_lightReferences;
 	int		c_guiSurfs;
@@ -933,6 +934,8 @@ extern idCVar r_useOptimizedShadows;	// 1 = use the dmap generated static shadow
 extern idCVar r_useShadowProjectedCull;	// 1 = discard triangles outside light volume before shadowing
 extern idCVar r_useDeferredTangents;	// 1 = don't always calc tangents after deform
 extern idCVar r_useCachedDynamicModels;	// 1 = cache snapshots of dynamic models
+extern idCVar r_binaryModels;			// 1 = load md5 meshes from binary caches under generated/
+extern idCVar r_parallelSkinning;		// number of job threads skinning the md5 models in view
 extern idCVar r_useTwoSidedStencil;		// 1 = do stencil shadows in one pass with different ops on each side
 extern idCVar r_useInfiniteFarZ;		// 1 = use the no-far-clip-plane trick
 extern idCVar r_useScissor;				// 1 = scissor clip as portals and lights are processed
@@ -1269,6 +1272,8 @@ void R_ListRenderEntityDefs_f( const idCmdArgs &args );
 
 bool R_IssueEntityDefCallback( idRenderEntityLocal *def );
 idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def );
+void R_SkinViewEntities( void );
+void R_ShutdownSkinning( void );
 
 viewEntity_t *R_SetEntityDefViewEntity( idRenderEntityLocal *def );
 viewLight_t *R_SetLightDefViewLight( idRenderLightLocal *def );
@@ -1544,6 +1549,8 @@ typedef struct deformInfo_s {
 deformInfo_t *		R_BuildDeformInfo( int numVerts, const idDrawVert *verts, int numIndexes, const int *indexes, bool useUnsmoothedTangents );
 void				R_FreeDeformInfo( deformInfo_t *deformInfo );
 int					R_DeformInfoMemoryUsed( deformInfo_t *deformInfo );
+void				R_WriteDeformInfo( idFile *file, const deformInfo_t *deformInfo );
+deformInfo_t *		R_ReadDeformInfo( idFile *file );
 
 /*
 ============================================================
@@ -1136,6 +1136,9 @@ void R_RenderView( viewDef_t *parms ) {
 	// add any pre-generated light shadows, and calculate the light shader values
 	R_AddLightSurfaces();
 
+	// instantiate the md5 models in view and skin them on the job threads
+	R_SkinViewEntities();
+
 	// adds ambient surfaces and create any necessary interaction surfaces to add to the light
 	// lists
 	R_AddModelSurfaces();
@@ -2267,3 +2267,89 @@ int R_DeformInfoMemoryUsed( deformInfo_t *deformInfo ) {
 	return total;
 }
 
+/*
+===================
+R_WriteDeformInfo
+
+arrays are written in native byte order, the files are a local cache
+===================
+*/
+void R_WriteDeformInfo( idFile *file, const deformInfo_t *deformInfo ) {
+	file->WriteInt( deformInfo->numSourceVerts );
+	file->WriteInt( deformInfo->numOutputVerts );
+	file->WriteInt( deformInfo->numIndexes );
+	file->WriteInt( deformInfo->numMirroredVerts );
+	file->WriteInt( deformInfo->numDupVerts );
+	file->WriteInt( deformInfo->numSilEdges );
+	file->WriteBool( deformInfo->dominantTris != NULL );
+
+	file->Write( deformInfo->indexes, deformInfo->numIndexes * sizeof( deformInfo->indexes[0] ) );
+	file->Write( deformInfo->silIndexes, deformInfo->numIndexes * sizeof( deformInfo->silIndexes[0] ) );
+	file->Write( deformInfo->mirroredVerts, deformInfo->numMirroredVerts * sizeof( deformInfo->mirroredVerts[0] ) );
+	file->Write( deformInfo->dupVerts, deformInfo->numDupVerts * 2 * sizeof( deformInfo->dupVerts[0] ) );
+	file->Write( deformInfo->silEdges, deformInfo->numSilEdges * sizeof( deformInfo->silEdges[0] ) );
+	if ( deformInfo->dominantTris != NULL ) {
+		file->Write( deformInfo->dominantTris, deformInfo->numOutputVerts * sizeof( deformInfo->dominantTris[0] ) );
+	}
+}
+
+/*
+===================
+R_ReadDeformInfo
+
+returns NULL if the file is truncated or inconsistent
+===================
+*/
+deformInfo_t *R_ReadDeformInfo( idFile *file ) {
+	deformInfo_t	*deform;
+	bool			hasDominantTris;
+	bool			ok;
+
+	deform = (deformInfo_t *)R_ClearedStaticAlloc( sizeof( *deform ) );
+
+	file->ReadInt( deform->numSourceVerts );
+	file->ReadInt( deform->numOutputVerts );
+	file->ReadInt( deform->numIndexes );
+	file->ReadInt( deform->numMirroredVerts );
+	file->ReadInt( deform->numDupVerts );
+	file->ReadInt( deform->numSilEdges );
+	file->ReadBool( hasDominantTris );
+
+	if ( deform->numSourceVerts < 0 || deform->numOutputVerts < deform->numSourceVerts || deform->numIndexes < 0 ||
+			deform->numMirroredVerts < 0 || deform->numDupVerts < 0 || deform->numSilEdges < 0 ) {
+		R_StaticFree( deform );
+		return NULL;
+	}
+
+	ok = true;
+	if ( deform->numIndexes ) {
+		deform->indexes = triIndexAllocator.Alloc( deform->numIndexes );
+		deform->silIndexes = triSilIndexAllocator.Alloc( deform->numIndexes );
+		ok &= file->Read( deform->indexes, deform->numIndexes * sizeof( deform->indexes[0] ) ) == deform->numIndexes * (int)sizeof( deform->indexes[0] );
+		ok &= file->Read( deform->silIndexes, deform->numIndexes * sizeof( deform->silIndexes[0] ) ) == deform->numIndexes * (int)sizeof( deform->silIndexes[0] );
+	}
+	if ( deform->numMirroredVerts ) {
+		deform->mirroredVerts = triMirroredVertAllocator.Alloc( deform->numMirroredVerts );
+		ok &= file->Read( deform->mirroredVerts, deform->numMirroredVerts * sizeof( deform->mirroredVerts[0] ) ) == deform->numMirroredVerts * (int)sizeof( deform->mirroredVerts[0] );
+	}
+	if ( deform->numDupVerts ) {
+		deform->dupVerts = triDupVertAllocator.Alloc( deform->numDupVerts * 2 );
+		ok &= file->Read( deform->dupVerts, deform->numDupVerts * 2 * sizeof( deform->dupVerts[0] ) ) == deform->numDupVerts * 2 * (int)sizeof( deform->dupVerts[0] );
+	}
+	if ( deform->numSilEdges ) {
+		deform->silEdges = triSilEdgeAllocator.Alloc( deform->numSilEdges );
+		ok &= file->Read( deform->silEdges, deform->numSilEdges * sizeof( deform->silEdges[0] ) ) == deform->numSilEdges * (int)sizeof( deform->silEdges[0] );
+	}
+	if ( hasDominantTris && deform->numOutputVerts ) {
+		deform->dominantTris = triDominantTrisAllocator.Alloc( deform->numOutputVerts );
+		ok &= file->Read( deform->dominantTris, deform->numOutputVerts * sizeof( deform->dominantTris[0] ) ) == deform->numOutputVerts * (int)sizeof( deform->dominantTris[0] );
+	}
+
+	if ( !ok ) {
+		R_FreeDeformInfo( deform );
+		return NULL;
+	}
+
+	return deform;
+}
+
@@ -50,6 +50,18 @@ idSoundCache::idSoundCache() {
 	listCache.AssureSize( 1024, NULL );
 	listCache.SetGranularity( 256 );
 	insideLevelLoad = false;
+
+	inUseMark = 0;
+	streamUseCount = 0;
+	streamData = soundCacheAllocator.Alloc( SOUND_CACHE_STREAM_BLOCKS * SOUND_CACHE_BLOCK_SIZE );
+	for ( int i = 0; i < SOUND_CACHE_STREAM_BLOCKS; i++ ) {
+		streamBlocks[i].sample = NULL;
+		streamBlocks[i].offset = 0;
+		streamBlocks[i].size = 0;
+		streamBlocks[i].lastUsed = 0;
+		streamBlocks[i].data = streamData + i * SOUND_CACHE_BLOCK_SIZE;
+	}
+	memset( &stats, 0, sizeof( stats ) );
 }
 
 /*
@@ -59,6 +71,7 @@ idSoundCache::~idSoundCache()
 */
 idSoundCache::~idSoundCache() {
 	listCache.DeleteContents( true );
+	soundCacheAllocator.Free( streamData );
 	soundCacheAllocator.Shutdown();
 }
 
@@ -97,8 +110,8 @@ idSoundSample *idSoundCache::FindSound( const idStr& filename, bool loadOnDemand
 		idSoundSample *def = listCache[i];
 		if ( def && def->name == fname ) {
 			def->levelLoadReferenced = true;
-			if ( def->purged && !loadOnDemandOnly ) {
-				def->Load();
+			if ( !loadOnDemandOnly && TouchSound( def ) ) {
+				EnforceBudget();
 			}
 			return def;
 		}
@@ -121,7 +134,8 @@ idSoundSample *idSoundCache::FindSound( const idStr& filename, bool loadOnDemand
 
 	if ( !loadOnDemandOnly ) {
 		// this may make it a default sound if it can't be loaded
-		def->Load();
+		TouchSound( def );
+		EnforceBudget();
 	}
 
 	return def;
@@ -141,6 +155,9 @@ void idSoundCache::ReloadSounds( bool force ) {
 		idSoundSample *def = listCache[i];
 		if ( def ) {
 			def->Reload( force );
+			if ( !def->purged ) {
+				TouchSound( def );
+			}
 		}
 	}
 }
@@ -188,6 +205,7 @@ void idSoundCache::EndLevelLoad() {
 	insideLevelLoad = false;
 
 	// purge the ones we don't need
+	int streamCount = 0;
 	useCount = 0;
 	purgeCount = 0;
 	for ( int i = 0 ; i < listCache.Num() ; i++ ) {
@@ -202,18 +220,303 @@ void idSoundCache::EndLevelLoad() {
 //			common->Printf( "Purging %s\n", sample->name.c_str() );
 			purgeCount += sample->objectMemSize;
 			sample->PurgeSoundSample();
+		} else if ( sample->streamed ) {
+			streamCount += sample->objectMemSize;
 		} else {
 			useCount += sample->objectMemSize;
 		}
 	}
 
+	EnforceBudget();
+
 	soundCacheAllocator.FreeEmptyBaseBlocks();
 
 	common->Printf( "%5ik referenced\n", useCount / 1024 );
+	common->Printf( "%5ik streamed\n", streamCount / 1024 );
 	common->Printf( "%5ik purged\n", purgeCount / 1024 );
 	common->Printf( "----------------------------------------\n" );
 }
 
+/*
+===================
+idSoundCache::TouchSound
+
+Loads the sample if it was purged and makes it the most recently used one.
+Returns true if it had to be loaded.
+===================
+*/
+bool idSoundCache::TouchSound( idSoundSample *sample ) {
+	bool loaded = false;
+
+	if ( sample->purged ) {
+		sample->Load();
+		loaded = true;
+	}
+	sample->cacheUsage.AddToFront( cacheUsage );
+
+	return loaded;
+}
+
+/*
+===================
+idSoundCache::GetResidentBytes
+
+Streamed samples only hold their header and don't count.
+===================
+*/
+int idSoundCache::GetResidentBytes( void ) const {
+	int bytes = 0;
+
+	for ( idSoundSample *sample = cacheUsage.Next(); sample; sample = sample->cacheUsage.Next() ) {
+		if ( !sample->streamed ) {
+			bytes += sample->objectMemSize;
+		}
+	}
+	return bytes;
+}
+
+/*
+===================
+idSoundCache::EnforceBudget
+
+Frees the least recently used samples until the resident ones fit in s_cacheBudget.
+Samples a channel still holds on to and the most recently used one are kept, they
+are loaded again by the next StartSound if needed.
+===================
+*/
+void idSoundCache::EnforceBudget( void ) {
+	int budget = idSoundSystemLocal::s_cacheBudget.GetInteger() * 1024 * 1024;
+	if ( budget <= 0 ) {
+		return;
+	}
+
+	int resident = GetResidentBytes();
+	if ( resident <= budget ) {
+		return;
+	}
+
+	inUseMark++;
+	for ( int i = 0; i < soundSystemLocal.soundWorlds.Num(); i++ ) {
+		soundSystemLocal.soundWorlds[i]->MarkSamplesInUse( inUseMark );
+	}
+
+	idSoundSample *sample = cacheUsage.Prev();
+	while ( sample && resident > budget ) {
+		idSoundSample *prev = sample->cacheUsage.Prev();
+		if ( prev == NULL ) {
+			break;
+		}
+		if ( !sample->streamed && !sample->defaultSound && sample->inUseMark != inUseMark ) {
+			resident -= sample->objectMemSize;
+			sample->PurgeSoundSample();
+			stats.evictions++;
+		}
+		sample = prev;
+	}
+}
+
+/*
+===================
+idSoundCache::FindStreamBlock
+===================
+*/
+idSoundCache::soundCacheBlock_t *idSoundCache::FindStreamBlock( const idSoundSample *sample, int offset ) {
+	for ( int i = 0; i < SOUND_CACHE_STREAM_BLOCKS; i++ ) {
+		if ( streamBlocks[i].sample == sample && streamBlocks[i].offset == offset ) {
+			return &streamBlocks[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+===================
+idSoundCache::ReadStreamBlock
+
+Reads the block at offset into a free or the least recently used block.
+Called with CRITICAL_SECTION_ONE held, which is released during the read.
+===================
+*/
+idSoundCache::soundCacheBlock_t *idSoundCache::ReadStreamBlock( idSoundSample *sample, int offset ) {
+	if ( sample->streamFile == NULL ) {
+		return NULL;
+	}
+
+	soundCacheBlock_t *block = &streamBlocks[0];
+
+	for ( int i = 0; i < SOUND_CACHE_STREAM_BLOCKS; i++ ) {
+		if ( streamBlocks[i].sample == NULL ) {
+			block = &streamBlocks[i];
+			break;
+		}
+		if ( streamBlocks[i].lastUsed < block->lastUsed ) {
+			block = &streamBlocks[i];
+		}
+	}
+	block->sample = NULL;
+
+	int size = Min( SOUND_CACHE_BLOCK_SIZE, sample->objectMemSize - offset );
+
+	// only the decode-ahead thread reads, so the detached block is filled without
+	// holding up the game thread and the mixer on the disk
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+	bool read = ( sample->streamFile->Seek( sample->streamOffset + offset, FS_SEEK_SET ) == 0 && sample->streamFile->Read( block->data, size ) == size );
+	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+
+	if ( !read ) {
+		common->Warning( "idSoundCache: couldn't read %d bytes at %d from '%s'", size, offset, sample->name.c_str() );
+		return NULL;
+	}
+	if ( sample->objectInfo.wFormatTag == WAVE_FORMAT_TAG_PCM ) {
+		LittleRevBytes( block->data, 2, size / 2 );
+	}
+
+	block->sample = sample;
+	block->offset = offset;
+	block->size = size;
+	block->lastUsed = ++streamUseCount;
+
+	stats.reads++;
+	stats.readBytes += size;
+
+	return block;
+}
+
+/*
+===================
+idSoundCache::FetchStreamBlock
+
+Returns the block holding offset of a streamed sample, the decoders call this while
+holding CRITICAL_SECTION_ONE. Only the decoders of the decode-ahead thread pass
+allowIO, the others get the blocks already in the cache. Once the reader is halfway
+through a block the next one is read ahead, so sequential decoding rarely waits on
+the disk.
+===================
+*/
+bool idSoundCache::FetchStreamBlock( idSoundSample *sample, int offset, const byte **output, int *position, int *size, const bool allowIO ) {
+	if ( offset < 0 || offset > sample->objectMemSize ) {
+		return false;
+	}
+
+	int blockOffset = offset - offset % SOUND_CACHE_BLOCK_SIZE;
+	if ( blockOffset == sample->objectMemSize ) {
+		// at the very end, there is nothing left to read
+		if ( output ) {
+			*output = NULL;
+		}
+		if ( position ) {
+			*position = 0;
+		}
+		if ( size ) {
+			*size = 0;
+		}
+		return true;
+	}
+
+	soundCacheBlock_t *block = FindStreamBlock( sample, blockOffset );
+	if ( block != NULL ) {
+		stats.hits++;
+		block->lastUsed = ++streamUseCount;
+	} else {
+		stats.misses++;
+		if ( !allowIO ) {
+			return false;
+		}
+		block = ReadStreamBlock( sample, blockOffset );
+		if ( block == NULL ) {
+			return false;
+		}
+	}
+
+	if ( output ) {
+		*output = block->data;
+	}
+	if ( position ) {
+		*position = offset - blockOffset;
+	}
+	if ( size ) {
+		*size = block->size;
+	}
+
+	int nextOffset = blockOffset + SOUND_CACHE_BLOCK_SIZE;
+	if ( allowIO && offset - blockOffset >= SOUND_CACHE_BLOCK_SIZE / 2 && nextOffset < sample->objectMemSize && FindStreamBlock( sample, nextOffset ) == NULL ) {
+		if ( ReadStreamBlock( sample, nextOffset ) != NULL ) {
+			stats.readAheads++;
+		}
+	}
+
+	return true;
+}
+
+/*
+===================
+idSoundCache::FreeStreamBlocks
+===================
+*/
+void idSoundCache::FreeStreamBlocks( const idSoundSample *sample ) {
+	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	for ( int i = 0; i < SOUND_CACHE_STREAM_BLOCKS; i++ ) {
+		if ( streamBlocks[i].sample == sample ) {
+			streamBlocks[i].sample = NULL;
+			streamBlocks[i].lastUsed = 0;
+		}
+	}
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+}
+
+/*
+===================
+idSoundCache::ReleaseStream
+
+Closes the file of a streamed sample once no channel of any sound world plays it.
+The channels free their decode-ahead streams before they are released, so nothing
+reads from the file anymore.
+===================
+*/
+void idSoundCache::ReleaseStream( idSoundSample *sample ) {
+	if ( sample == NULL || sample->streamFile == NULL ) {
+		return;
+	}
+
+	inUseMark++;
+	for ( int i = 0; i < soundSystemLocal.soundWorlds.Num(); i++ ) {
+		soundSystemLocal.soundWorlds[i]->MarkSamplesInUse( inUseMark );
+	}
+
+	if ( sample->inUseMark != inUseMark ) {
+		sample->CloseStream();
+	}
+}
+
+/*
+===================
+idSoundCache::UpdateStatistics
+
+Called once per sound frame.
+===================
+*/
+void idSoundCache::UpdateStatistics( void ) {
+	soundCacheStats_t frameStats;
+	int numStreamBlocks = 0;
+
+	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	frameStats = stats;
+	memset( &stats, 0, sizeof( stats ) );
+	for ( int i = 0; i < SOUND_CACHE_STREAM_BLOCKS; i++ ) {
+		if ( streamBlocks[i].sample != NULL ) {
+			numStreamBlocks++;
+		}
+	}
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+
+	if ( idSoundSystemLocal::s_showSoundCache.GetBool() && ( frameStats.hits || frameStats.misses || frameStats.evictions ) ) {
+		common->Printf( "%d: sound cache: %dk resident (%dMB budget), %d/%d stream blocks, %d hits, %d misses, %d reads %dk (%d ahead), %d evicted\n",
+			soundSystemLocal.CurrentSoundTime, GetResidentBytes() >> 10, idSoundSystemLocal::s_cacheBudget.GetInteger(),
+			numStreamBlocks, SOUND_CACHE_STREAM_BLOCKS, frameStats.hits, frameStats.misses, frameStats.reads,
+			frameStats.readBytes >> 10, frameStats.readAheads, frameStats.evictions );
+	}
+}
+
 /*
 ===================
 idSoundCache::PrintMemInfo
@@ -298,6 +601,12 @@ idSoundSample::idSoundSample() {
 	onDemand = false;
 	purged = false;
 	levelLoadReferenced = false;
+	streamed = false;
+	neverStream = false;
+	streamFile = NULL;
+	streamOffset = 0;
+	inUseMark = 0;
+	cacheUsage.SetOwner( this );
 }
 
 /*
@@ -477,6 +786,17 @@ void idSoundSample::Load( void ) {
 	objectSize = fh.GetOutputSize();
 	objectMemSize = fh.GetMemorySize();
 
+	// large samples are read in blocks while they play instead of being kept in memory
+	int streamSize = idSoundSystemLocal::s_streamSize.GetInteger() * 1024;
+	const char *fileName = fh.GetStreamName();
+	if ( streamSize > 0 && objectMemSize > streamSize && !neverStream && fileName != NULL ) {
+		streamName = fileName;
+		streamOffset = fh.GetStreamOffset();
+		streamed = true;
+		fh.Close();
+		return;
+	}
+
 	nonCacheData = (byte *)soundCacheAllocator.Alloc( objectMemSize );
 	fh.Read( nonCacheData, objectMemSize, NULL );
 
@@ -625,6 +945,14 @@ idSoundSample::PurgeSoundSample
 void idSoundSample::PurgeSoundSample() {
 	purged = true;
 
+	cacheUsage.Remove();
+
+	if ( streamed ) {
+		CloseStream();
+		soundSystemLocal.soundCache->FreeStreamBlocks( this );
+		streamed = false;
+	}
+
 	if ( hardwareBuffer ) {
 		alGetError();
 		alDeleteBuffers( 1, &openalBuffer );
@@ -647,6 +975,35 @@ void idSoundSample::PurgeSoundSample() {
 	}
 }
 
+/*
+===================
+idSoundSample::OpenStream
+
+Called by the game thread before a channel starts playing the sample.
+===================
+*/
+void idSoundSample::OpenStream() {
+	if ( !streamed || streamFile != NULL ) {
+		return;
+	}
+	streamFile = fileSystem->OpenFileRead( streamName );
+	if ( streamFile == NULL ) {
+		common->Warning( "idSoundSample: couldn't open '%s' for streaming", streamName.c_str() );
+	}
+}
+
+/*
+===================
+idSoundSample::CloseStream
+===================
+*/
+void idSoundSample::CloseStream() {
+	if ( streamFile != NULL ) {
+		fileSystem->CloseFile( streamFile );
+		streamFile = NULL;
+	}
+}
+
 /*
 ===================
 idSoundSample::Reload
@@ -684,7 +1041,13 @@ Returns true on success.
 ===================
 */
 bool idSoundSample::FetchFromCache( int offset, const byte **output, int *position, int *size, const bool allowIO ) {
-	offset &= 0xfffffffe;
+	if ( objectInfo.wFormatTag == WAVE_FORMAT_TAG_PCM ) {
+		offset &= 0xfffffffe;
+	}
+
+	if ( streamed ) {
+		return soundSystemLocal.soundCache->FetchStreamBlock( this, offset, output, position, size, allowIO );
+	}
 
 	if ( objectSize == 0 || offset < 0 || offset > objectSize * (int)sizeof( short ) || !nonCacheData ) {
 		return false;
@@ -33,6 +33,10 @@ If you have questions concerning this license or the applicable additional terms
 #include "OggVorbis/vorbis/codec.h"
 #include "OggVorbis/vorbis/vorbisfile.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 
 /*
 ===================================================================================
@@ -271,6 +275,94 @@ int idWaveFile::CloseOGG( void ) {
 }
 
 
+/*
+===================================================================================
+
+  idSoundSampleFile
+
+  Reads the encoded data of a streamed sample through the sound cache blocks.
+
+===================================================================================
+*/
+
+class idSoundSampleFile : public idFile {
+public:
+							idSoundSampleFile( void ) { sample = NULL; position = 0; allowIO = false; }
+
+	void					SetSample( idSoundSample *s, bool io ) { sample = s; position = 0; allowIO = io; }
+
+	virtual const char *	GetName( void ) { return sample ? sample->name.c_str() : ""; }
+	virtual const char *	GetFullPath( void ) { return GetName(); }
+	virtual int				Read( void *buffer, int len );
+	virtual int				Length( void ) { return sample ? sample->objectMemSize : 0; }
+	virtual int				Tell( void ) { return position; }
+	virtual int				Seek( long offset, fsOrigin_t origin );
+
+private:
+	idSoundSample *			sample;
+	int						position;
+	bool					allowIO;
+};
+
+/*
+====================
+idSoundSampleFile::Read
+====================
+*/
+int idSoundSampleFile::Read( void *buffer, int len ) {
+	int total = 0;
+
+	while ( total < len ) {
+		const byte *data;
+		int pos, size;
+
+		if ( !sample->FetchFromCache( position, &data, &pos, &size, allowIO ) ) {
+			break;
+		}
+		int count = Min( size - pos, len - total );
+		if ( count <= 0 ) {
+			break;
+		}
+		memcpy( (byte *)buffer + total, data + pos, count );
+		position += count;
+		total += count;
+	}
+	return total;
+}
+
+/*
+====================
+idSoundSampleFile::Seek
+====================
+*/
+int idSoundSampleFile::Seek( long offset, fsOrigin_t origin ) {
+	int newOffset;
+
+	switch( origin ) {
+		case FS_SEEK_CUR: {
+			newOffset = position + offset;
+			break;
+		}
+		case FS_SEEK_END: {
+			newOffset = Length() - offset;
+			break;
+		}
+		case FS_SEEK_SET: {
+			newOffset = offset;
+			break;
+		}
+		default: {
+			return -1;
+		}
+	}
+	if ( newOffset < 0 || newOffset > Length() ) {
+		return -1;
+	}
+	position = newOffset;
+	return 0;
+}
+
+
 /*
 ===================================================================================
 
@@ -287,16 +379,19 @@ public:
 	virtual int				GetLastDecodeTime( void ) const;
 
 	void					Clear( void );
+	void					SetAllowIO( bool allow ) { allowIO = allow; }
 	int						DecodePCM( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 	int						DecodeOGG( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 
 private:
 	bool					failed;				// set if decoding failed
+	bool					allowIO;			// streamed samples are read from disk, only on the decode-ahead thread
 	int						lastFormat;			// last format being decoded
 	idSoundSample *			lastSample;			// last sample being decoded
 	int						lastSampleOffset;	// last offset into the decoded sample
 	int						lastDecodeTime;		// last time decoding sound
 	idFile_Memory			file;				// encoded file in memory
+	idSoundSampleFile		streamFile;			// encoded file streamed through the sound cache
 
 	OggVorbis_File			ogg;				// OggVorbis file
 };
@@ -329,9 +424,10 @@ void idSampleDecoder::Shutdown( void ) {
 idSampleDecoder::Alloc
 ====================
 */
-idSampleDecoder *idSampleDecoder::Alloc( void ) {
+idSampleDecoder *idSampleDecoder::Alloc( bool allowIO ) {
 	idSampleDecoderLocal *decoder = sampleDecoderAllocator.Alloc();
 	decoder->Clear();
+	decoder->SetAllowIO( allowIO );
 	return decoder;
 }
 
@@ -479,25 +575,33 @@ int idSampleDecoderLocal::DecodePCM( idSoundSample *sample, int sampleOffset44k,
 	int sampleOffset = sampleOffset44k >> shift;
 	int sampleCount = sampleCount44k >> shift;
 
-	if ( sample->nonCacheData == NULL ) {
+	if ( sample->nonCacheData == NULL && !sample->streamed ) {
 		assert( false );	// this should never happen ( note: I've seen that happen with the main thread down in idGameLocal::MapClear clearing entities - TTimo )
 		failed = true;
 		return 0;
 	}
 
-	if ( !sample->FetchFromCache( sampleOffset * sizeof( short ), &first, &pos, &size, false ) ) {
-		failed = true;
-		return 0;
-	}
+	// streamed samples can span several cache blocks
+	readSamples = 0;
+	while ( readSamples < sampleCount ) {
+		if ( !sample->FetchFromCache( ( sampleOffset + readSamples ) * sizeof( short ), &first, &pos, &size, allowIO ) ) {
+			// a streamed block that isn't cached yet is silence, not a failure
+			if ( readSamples == 0 && allowIO ) {
+				failed = true;
+			}
+			break;
+		}
 
-	if ( size - pos < sampleCount * sizeof( short ) ) {
-		readSamples = ( size - pos ) / sizeof( short );
-	} else {
-		readSamples = sampleCount;
-	}
+		int count = Min( (int)( ( size - pos ) / sizeof( short ) ), sampleCount - readSamples );
+		if ( count <= 0 ) {
+			break;
+		}
+
+		// duplicate samples for 44kHz output
+		SIMDProcessor->UpSamplePCMTo44kHz( dest + ( readSamples << shift ), (const short *)(first+pos), count, sample->objectInfo.nSamplesPerSec, sample->objectInfo.nChannels );
 
-	// duplicate samples for 44kHz output
-	SIMDProcessor->UpSamplePCMTo44kHz( dest, (const short *)(first+pos), readSamples, sample->objectInfo.nSamplesPerSec, sample->objectInfo.nChannels );
+		readSamples += count;
+	}
 
 	return ( readSamples << shift );
 }
@@ -514,19 +618,31 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 	int sampleOffset = sampleOffset44k >> shift;
 	int sampleCount = sampleCount44k >> shift;
 
+	// the stream of an OGG file can only be read from disk
+	if ( sample->streamed && !allowIO ) {
+		return 0;
+	}
+
 	// open OGG file if not yet opened
 	if ( lastSample == NULL ) {
 		// make sure there is enough space for another decoder
 		if ( decoderMemoryAllocator.GetFreeBlockMemory() < MIN_OGGVORBIS_MEMORY ) {
 			return 0;
 		}
-		if ( sample->nonCacheData == NULL ) {
-			assert( false );	// this should never happen
-			failed = true;
-			return 0;
+		idFile *encoded;
+		if ( sample->streamed ) {
+			streamFile.SetSample( sample, allowIO );
+			encoded = &streamFile;
+		} else {
+			if ( sample->nonCacheData == NULL ) {
+				assert( false );	// this should never happen
+				failed = true;
+				return 0;
+			}
+			file.SetData( (const char *)sample->nonCacheData, sample->objectMemSize );
+			encoded = &file;
 		}
-		file.SetData( (const char *)sample->nonCacheData, sample->objectMemSize );
-		if ( ov_openFile( &file, &ogg ) < 0 ) {
+		if ( ov_openFile( encoded, &ogg ) < 0 ) {
 			failed = true;
 			return 0;
 		}
@@ -570,3 +686,315 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 
 	return ( readSamples << shift );
 }
+
+
+/*
+===================================================================================
+
+  idSoundDecodeAhead
+
+  A single background thread keeps every stream filled up to SOUND_STREAM_BLOCKS
+  mix buffers ahead of the mixer. Decoding still happens under the decoder lock,
+  so more threads would only wait on each other.
+
+===================================================================================
+*/
+
+class idSoundStream {
+public:
+	idSampleDecoder *		decoder;			// only used by the decode thread
+	idSoundSample *			leadin;
+	idSoundSample *			loop;				// NULL for one shot sounds
+	int						blockSamples;		// 44kHz samples per block, all channels
+	int						decodeOffset;		// offset of the next block to decode
+	int						generation;			// bumped when the mixer skips, stale blocks are dropped
+	int						head;				// next block the mixer will read
+	int						numReady;			// decoded blocks following head
+	bool					busy;				// decode thread is filling a block
+	int						blockOffsets[SOUND_STREAM_BLOCKS];
+	short					blocks[SOUND_STREAM_BLOCKS][MIXBUFFER_SAMPLES * 2];
+};
+
+typedef struct decodeAheadStats_s {
+	double					decodeTime;			// msec spent on the decode thread
+	double					mixerDecodeTime;	// msec spent decoding in place on the mixer
+	int						blocksDecoded;
+	int						blocksRead;
+	int						underruns;
+} decodeAheadStats_t;
+
+static idBlockAlloc<idSoundStream, 16>	soundStreamAllocator;
+static idList<idSoundStream *>			soundStreams;
+static std::thread						decodeThread;
+static std::mutex						decodeMutex;
+static std::condition_variable			decodeWake;		// signalled when a stream needs blocks or on shutdown
+static std::condition_variable			decodeDone;		// signalled when the decode thread finished a block
+static bool								decodeShutdown;
+static decodeAheadStats_t				decodeStats;		// current mix tick
+static int								totalUnderruns;
+static ALIGN16( float					decodeSamples[MIXBUFFER_SAMPLES * 2] );
+
+/*
+====================
+DecodeAheadThread
+====================
+*/
+static void DecodeAheadThread( void ) {
+	std::unique_lock<std::mutex> lock( decodeMutex );
+
+	while ( true ) {
+		// pick the stream that is closest to running dry
+		idSoundStream *stream = NULL;
+		for ( int i = 0; i < soundStreams.Num(); i++ ) {
+			idSoundStream *s = soundStreams[i];
+			if ( s->numReady < SOUND_STREAM_BLOCKS && ( stream == NULL || s->numReady < stream->numReady ) ) {
+				stream = s;
+			}
+		}
+
+		if ( stream == NULL ) {
+			if ( decodeShutdown ) {
+				break;
+			}
+			decodeWake.wait( lock );
+			continue;
+		}
+
+		idSoundSample *loop = stream->loop;
+		int generation = stream->generation;
+		int offset = stream->decodeOffset;
+		int block = ( stream->head + stream->numReady ) % SOUND_STREAM_BLOCKS;
+		stream->busy = true;
+
+		// the mixer never reads blocks that are not ready, so the block can be filled unlocked
+		lock.unlock();
+
+		idTimer timer;
+		timer.Start();
+		idSoundChannel::GatherSamples( stream->decoder, stream->leadin, loop, offset, stream->blockSamples, decodeSamples );
+		idSoundDecodeAhead::FloatToShort( stream->blocks[block], decodeSamples, stream->blockSamples );
+		timer.Stop();
+
+		lock.lock();
+
+		stream->busy = false;
+		if ( stream->generation == generation ) {
+			stream->blockOffsets[block] = offset;
+			stream->numReady++;
+			stream->decodeOffset += stream->blockSamples;
+		}
+		decodeStats.decodeTime += timer.Milliseconds();
+		decodeStats.blocksDecoded++;
+
+		decodeDone.notify_all();
+	}
+}
+
+/*
+====================
+idSoundDecodeAhead::Init
+====================
+*/
+void idSoundDecodeAhead::Init( void ) {
+	memset( &decodeStats, 0, sizeof( decodeStats ) );
+	totalUnderruns = 0;
+	decodeShutdown = false;
+	decodeThread = std::thread( DecodeAheadThread );
+}
+
+/*
+====================
+idSoundDecodeAhead::Shutdown
+
+Streams still owned by channels stay valid, they just won't be filled anymore.
+====================
+*/
+void idSoundDecodeAhead::Shutdown( void ) {
+	if ( !decodeThread.joinable() ) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( decodeMutex );
+		decodeShutdown = true;
+		soundStreams.Clear();
+	}
+	decodeWake.notify_all();
+	decodeThread.join();
+}
+
+/*
+====================
+idSoundDecodeAhead::AllocStream
+
+Starts decoding the samples ahead from the given offset. Called from the mixer
+after the first streaming buffers have been filled in place, or before them for
+samples streamed from disk.
+====================
+*/
+idSoundStream *idSoundDecodeAhead::AllocStream( idSoundSample *leadin, idSoundSample *loop, int sampleOffset44k, int sampleCount44k ) {
+	assert( sampleCount44k <= MIXBUFFER_SAMPLES * 2 );
+
+	if ( !decodeThread.joinable() ) {
+		return NULL;
+	}
+
+	idSoundStream *stream = soundStreamAllocator.Alloc();
+	stream->decoder = idSampleDecoder::Alloc( true );
+	stream->leadin = leadin;
+	stream->loop = loop;
+	stream->blockSamples = sampleCount44k;
+	stream->decodeOffset = sampleOffset44k;
+	stream->generation = 0;
+	stream->head = 0;
+	stream->numReady = 0;
+	stream->busy = false;
+
+	{
+		std::lock_guard<std::mutex> lock( decodeMutex );
+		soundStreams.Append( stream );
+	}
+	decodeWake.notify_one();
+
+	return stream;
+}
+
+/*
+====================
+idSoundDecodeAhead::FreeStream
+
+Waits for the block in flight, the samples may be purged right after this.
+====================
+*/
+void idSoundDecodeAhead::FreeStream( idSoundStream *stream ) {
+	{
+		std::unique_lock<std::mutex> lock( decodeMutex );
+		soundStreams.Remove( stream );
+		while ( stream->busy ) {
+			decodeDone.wait( lock );
+		}
+	}
+
+	idSampleDecoder::Free( stream->decoder );
+	soundStreamAllocator.Free( stream );
+}
+
+/*
+====================
+idSoundDecodeAhead::ReadStream
+
+Copies the block at the given offset if it is ready. Returns false on an underrun,
+in which case the caller decodes the block itself and the stream skips past it.
+The loop sample is passed in because the channel flags can change while playing.
+====================
+*/
+bool idSoundDecodeAhead::ReadStream( idSoundStream *stream, idSoundSample *loop, int sampleOffset44k, short *dest ) {
+	std::unique_lock<std::mutex> lock( decodeMutex );
+
+	if ( stream->numReady > 0 && stream->blockOffsets[stream->head] == sampleOffset44k && stream->loop == loop ) {
+		memcpy( dest, stream->blocks[stream->head], stream->blockSamples * sizeof( dest[0] ) );
+		stream->head = ( stream->head + 1 ) % SOUND_STREAM_BLOCKS;
+		stream->numReady--;
+		decodeStats.blocksRead++;
+
+		lock.unlock();
+		decodeWake.notify_one();
+		return true;
+	}
+
+	// drop whatever was decoded and restart behind the block the mixer is about to decode
+	stream->loop = loop;
+	stream->generation++;
+	stream->numReady = 0;
+	stream->decodeOffset = sampleOffset44k + stream->blockSamples;
+	decodeStats.underruns++;
+	totalUnderruns++;
+
+	lock.unlock();
+	decodeWake.notify_one();
+	return false;
+}
+
+/*
+====================
+idSoundDecodeAhead::IsStreamReady
+
+Returns true once numBlocks blocks from the given offset are decoded, or if there is
+no stream that could decode them. A stream decoding from elsewhere is restarted at
+the offset.
+====================
+*/
+bool idSoundDecodeAhead::IsStreamReady( idSoundStream *stream, idSoundSample *loop, int sampleOffset44k, int numBlocks ) {
+	if ( stream == NULL ) {
+		return true;
+	}
+
+	std::unique_lock<std::mutex> lock( decodeMutex );
+
+	int firstOffset = ( stream->numReady > 0 ) ? stream->blockOffsets[stream->head] : stream->decodeOffset;
+	if ( firstOffset == sampleOffset44k && stream->loop == loop ) {
+		return ( stream->numReady >= numBlocks );
+	}
+
+	stream->loop = loop;
+	stream->generation++;
+	stream->numReady = 0;
+	stream->decodeOffset = sampleOffset44k;
+
+	lock.unlock();
+	decodeWake.notify_one();
+	return false;
+}
+
+/*
+====================
+idSoundDecodeAhead::AddMixerDecodeTime
+====================
+*/
+void idSoundDecodeAhead::AddMixerDecodeTime( double msec ) {
+	std::lock_guard<std::mutex> lock( decodeMutex );
+	decodeStats.mixerDecodeTime += msec;
+}
+
+/*
+====================
+idSoundDecodeAhead::UpdateStatistics
+
+Called once per mix tick.
+====================
+*/
+void idSoundDecodeAhead::UpdateStatistics( void ) {
+	decodeAheadStats_t stats;
+	int numStreams, underruns;
+
+	{
+		std::lock_guard<std::mutex> lock( decodeMutex );
+		stats = decodeStats;
+		numStreams = soundStreams.Num();
+		underruns = totalUnderruns;
+		memset( &decodeStats, 0, sizeof( decodeStats ) );
+	}
+
+	if ( idSoundSystemLocal::s_showDecodeAhead.GetBool() && ( numStreams || stats.blocksDecoded || stats.underruns ) ) {
+		common->Printf( "%d: decode ahead: %d streams, %d decoded %1.2f ms, %d read, %d underruns %1.2f ms (%d total)\n",
+			soundSystemLocal.CurrentSoundTime, numStreams, stats.blocksDecoded, stats.decodeTime, stats.blocksRead,
+			stats.underruns, stats.mixerDecodeTime, underruns );
+	}
+}
+
+/*
+====================
+idSoundDecodeAhead::FloatToShort
+====================
+*/
+void idSoundDecodeAhead::FloatToShort( short *dest, const float *src, int numSamples ) {
+	for ( int i = 0; i < numSamples; i++ ) {
+		if ( src[i] < -32768.0f ) {
+			dest[i] = -32768;
+		} else if ( src[i] > 32767.0f ) {
+			dest[i] = 32767;
+		} else {
+			dest[i] = idMath::FtoiFast( src[i] );
+		}
+	}
+}
@@ -151,6 +151,11 @@ idSoundChannel::idSoundChannel
 */
 idSoundChannel::idSoundChannel( void ) {
 	decoder = NULL;
+	stream = NULL;
+	stopsQueued = 0;
+	stopsReleased = 0;
+	finished = false;
+	slowed = false;
 	Clear();
 }
 
@@ -172,6 +177,7 @@ void idSoundChannel::Clear( void ) {
 	int j;
 
 	Stop();
+	forgetOnRelease = false;
 	soundShader = NULL;
 	lastVolume = 0.0f;
 	triggerChannel = SCHANNEL_ANY;
@@ -185,6 +191,7 @@ void idSoundChannel::Clear( void ) {
 	memset( &parms, 0, sizeof(parms) );
 
 	triggered = false;
+	isVirtual = false;
 	openalSource = 0;
 	openalStreamingOffset = 0;
 	openalStreamingBuffer[0] = openalStreamingBuffer[1] = openalStreamingBuffer[2] = 0;
@@ -198,6 +205,9 @@ idSoundChannel::Start
 */
 void idSoundChannel::Start( void ) {
 	triggerState = true;
+	stolen = false;
+	finished = false;
+	slowed = false;
 	if ( decoder == NULL ) {
 		decoder = idSampleDecoder::Alloc();
 	}
@@ -210,10 +220,34 @@ idSoundChannel::Stop
 */
 void idSoundChannel::Stop( void ) {
 	triggerState = false;
+	mixing = false;
+	releasing = false;
+	stolen = false;
 	if ( decoder != NULL ) {
 		idSampleDecoder::Free( decoder );
 		decoder = NULL;
 	}
+	if ( stream != NULL ) {
+		idSoundDecodeAhead::FreeStream( stream );
+		stream = NULL;
+	}
+}
+
+/*
+===================
+idSoundChannel::Release
+
+Called by the mixer when it stops mixing the channel. The decoder is left to the
+game thread, which may still be gathering amplitudes with it.
+===================
+*/
+void idSoundChannel::Release( void ) {
+	mixing = false;
+	isVirtual = false;
+	if ( stream != NULL ) {
+		idSoundDecodeAhead::FreeStream( stream );
+		stream = NULL;
+	}
 }
 
 /*
@@ -255,11 +289,28 @@ samples and leadins
 ===================
 */
 void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount44k, float *dest ) const {
+//Sys_DebugPrintf( "msec:%i sample:%i : %i : %i\n", Sys_Milliseconds(), soundSystemLocal.GetCurrent44kHzTime(), sampleOffset44k, sampleCount44k );	//!@#
+
+	idSoundSample *loop = NULL;
+	if ( soundShader && ( parms.soundShaderFlags & SSF_LOOPING ) ) {
+		loop = soundShader->entries[0];
+	}
+
+	GatherSamples( decoder, leadinSample, loop, sampleOffset44k, sampleCount44k, dest );
+}
+
+/*
+===================
+idSoundChannel::GatherSamples
+
+Same as GatherChannelSamples, but decodes with the given decoder so decode-ahead
+streams can gather samples outside of the channel. loop is NULL for one shot sounds.
+===================
+*/
+void idSoundChannel::GatherSamples( idSampleDecoder *decoder, idSoundSample *leadin, idSoundSample *loop, int sampleOffset44k, int sampleCount44k, float *dest ) {
 	float	*dest_p = dest;
 	int		len;
 
-//Sys_DebugPrintf( "msec:%i sample:%i : %i : %i\n", Sys_Milliseconds(), soundSystemLocal.GetCurrent44kHzTime(), sampleOffset44k, sampleCount44k );	//!@#
-
 	// negative offset times will just zero fill
 	if ( sampleOffset44k < 0 ) {
 		len = -sampleOffset44k;
@@ -273,7 +324,6 @@ void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount4
 	}
 
 	// grab part of the leadin sample
-	idSoundSample *leadin = leadinSample;
 	if ( !leadin || sampleOffset44k < 0 || sampleCount44k <= 0 ) {
 		memset( dest_p, 0, sampleCount44k * sizeof( dest_p[0] ) );
 		return;
@@ -294,19 +344,12 @@ void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount4
 	}
 
 	// if not looping, zero fill any remaining spots
-	if ( !soundShader || !( parms.soundShaderFlags & SSF_LOOPING ) ) {
-		memset( dest_p, 0, sampleCount44k * sizeof( dest_p[0] ) );
-		return;
-	}
-
-	// fill the remainder with looped samples
-	idSoundSample *loop = soundShader->entries[0];
-
 	if ( !loop ) {
 		memset( dest_p, 0, sampleCount44k * sizeof( dest_p[0] ) );
 		return;
 	}
 
+	// fill the remainder with looped samples
 	sampleOffset44k -= leadin->LengthIn44kHzSamples();
 
 	while( sampleCount44k > 0 ) {
@@ -360,8 +403,12 @@ void idSoundEmitterLocal::Clear( void ) {
 	int i;
 
 	for( i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
+		idSoundSample *sample = channels[i].leadinSample;
 		channels[i].ALStop();
 		channels[i].Clear();
+		if ( sample && soundSystemLocal.soundCache ) {
+			soundSystemLocal.soundCache->ReleaseStream( sample );
+		}
 	}
 
 	removeStatus = REMOVE_STATUS_SAMPLEFINISHED;
@@ -437,6 +484,11 @@ void idSoundEmitterLocal::CheckForCompletion( int current44kHzTime ) {
 		for ( i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
 			idSoundChannel	*chan = &channels[i];
 
+			// a stopped channel keeps the emitter alive until the mixer released it
+			if ( !CheckRelease( chan ) ) {
+				hasActive = true;
+				continue;
+			}
 			if ( !chan->triggerState ) {
 				continue;
 			}
@@ -445,43 +497,27 @@ void idSoundEmitterLocal::CheckForCompletion( int current44kHzTime ) {
 				continue;
 			}
 
-			// see if this channel has completed
+			// the mixer gave the voice to another sound, it is already released
+			if ( chan->stolen ) {
+				chan->triggerState = false;
+				chan->stolen = false;
+				idSampleDecoder::Free( chan->decoder );
+				chan->decoder = NULL;
+				soundSystemLocal.soundCache->ReleaseStream( chan->leadinSample );
+				continue;
+			}
+
+			// see if this channel has completed, the voice and the slow channel belong to the mixer
 			if ( !( chan->parms.soundShaderFlags & SSF_LOOPING ) ) {
-				ALint state = AL_PLAYING;
+				bool timeUp = ( chan->trigger44kHzTime + chan->leadinSample->LengthIn44kHzSamples() < current44kHzTime );
 
-				if ( alIsSource( chan->openalSource ) ) {
-					alGetSourcei( chan->openalSource, AL_SOURCE_STATE, &state );
-				}
-				idSlowChannel slow = GetSlowChannel( chan );
-
-				if ( soundWorld->slowmoActive && slow.IsActive() ) {
-					if ( slow.GetCurrentPosition().time >= chan->leadinSample->LengthIn44kHzSamples() / 2 ) {
-						chan->Stop();
-						// if this was an onDemand sound, purge the sample now
-						if ( chan->leadinSample->onDemand ) {
-							chan->leadinSample->PurgeSoundSample();
-						}
-						continue;
-					}
-				} else if ( ( chan->trigger44kHzTime + chan->leadinSample->LengthIn44kHzSamples() < current44kHzTime ) || ( state == AL_STOPPED ) ) {
-					chan->Stop();
-
-					// free hardware resources
-					chan->ALStop();
-
-					// if this was an onDemand sound, purge the sample now
-					if ( chan->leadinSample->onDemand ) {
-						chan->leadinSample->PurgeSoundSample();
-					}
+				if ( chan->finished || ( timeUp && !( soundWorld->slowmoActive && chan->slowed ) ) ) {
+					StopChannel( chan, false );
+					hasActive = true;
 					continue;
 				}
 			}
 
-			// free decoder memory if no sound was decoded for a while
-			if ( chan->decoder != NULL && chan->decoder->GetLastDecodeTime() < current44kHzTime - SOUND_DECODER_FREE_DELAY ) {
-				chan->decoder->ClearDecoder();
-			}
-
 			hasActive = true;
 
 			if ( chan->parms.shakes > 0.0f ) {
@@ -500,6 +536,90 @@ void idSoundEmitterLocal::CheckForCompletion( int current44kHzTime ) {
 	}
 }
 
+/*
+===================
+idSoundEmitterLocal::StoreMixParms
+===================
+*/
+void idSoundEmitterLocal::StoreMixParms( emitterMixParms_t &mixParms ) const {
+	mixParms.origin = origin;
+	mixParms.spatializedOrigin = spatializedOrigin;
+	mixParms.realDistance = realDistance;
+	mixParms.distance = distance;
+	mixParms.listenerId = listenerId;
+}
+
+/*
+===================
+idSoundEmitterLocal::StopChannel
+
+Stops the channel for the game and queues the release for the mixer. The hardware
+voice, the decoder and onDemand samples are freed once the mixer let go of it.
+===================
+*/
+void idSoundEmitterLocal::StopChannel( idSoundChannel *chan, bool forget ) {
+	chan->triggerState = false;
+	chan->releasing = true;
+	chan->forgetOnRelease = forget;
+	chan->stopsQueued++;
+
+	mixCommand_t cmd;
+	cmd.type = MIXCMD_STOP;
+	cmd.emitter = index;
+	cmd.channel = chan - channels;
+	cmd.serial = chan->stopsQueued;
+	soundWorld->PushMixCommand( cmd );
+}
+
+/*
+===================
+idSoundEmitterLocal::CheckRelease
+
+Returns false while a queued stop hasn't been released by the mixer.
+===================
+*/
+bool idSoundEmitterLocal::CheckRelease( idSoundChannel *chan ) {
+	if ( !chan->releasing ) {
+		return true;
+	}
+	if ( chan->stopsReleased != chan->stopsQueued ) {
+		return false;
+	}
+
+	chan->releasing = false;
+
+	if ( chan->decoder != NULL ) {
+		idSampleDecoder::Free( chan->decoder );
+		chan->decoder = NULL;
+	}
+
+	// if this was an onDemand sound, purge the sample now unless it was restarted on another channel
+	idSoundSample *sample = chan->leadinSample;
+	if ( sample && sample->onDemand ) {
+		int i;
+		for ( i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
+			if ( channels[i].leadinSample == sample && ( channels[i].triggerState || channels[i].releasing ) ) {
+				break;
+			}
+		}
+		if ( i == SOUND_MAX_CHANNELS ) {
+			sample->PurgeSoundSample();
+		}
+	}
+
+	// close the file of a streamed sample unless another channel still plays it
+	if ( sample ) {
+		soundSystemLocal.soundCache->ReleaseStream( sample );
+	}
+
+	if ( chan->forgetOnRelease ) {
+		chan->leadinSample = NULL;
+		chan->soundShader = NULL;
+	}
+
+	return true;
+}
+
 /*
 ===================
 idSoundEmitterLocal::Spatialize
@@ -565,7 +685,7 @@ void idSoundEmitterLocal::Spatialize( idVec3 listenerPos, int listenerArea, idRe
 			return;
 		}
 
-		soundWorld->ResolveOrigin( 0, NULL, soundInArea, 0.0f, origin, this );
+		soundWorld->PropagateSound( soundInArea, this );
 		distance /= METERS_TO_DOOM;
 	} else {
 		// no portals available
@@ -634,11 +754,15 @@ void idSoundEmitterLocal::Free( bool immediate ) {
 		soundWorld->writeDemo->WriteInt( immediate );
 	}
 
-	if ( !immediate ) {
-		removeStatus = REMOVE_STATUS_WAITSAMPLEFINISHED;
-	} else {
-		Clear();
+	// an immediate free stops all channels, the emitter is reused once the mixer released them
+	if ( immediate ) {
+		for ( int i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
+			if ( channels[i].triggerState ) {
+				StopChannel( &channels[i], true );
+			}
+		}
 	}
+	removeStatus = REMOVE_STATUS_WAITSAMPLEFINISHED;
 }
 
 /*
@@ -751,8 +875,6 @@ int idSoundEmitterLocal::StartSound( const idSoundShader *shader, const s_channe
 		}
 	}
 
-	Sys_EnterCriticalSection();
-
 	// kill any sound that is currently playing on this channel
 	if ( channel != SCHANNEL_ANY ) {
 		for( i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
@@ -762,30 +884,23 @@ int idSoundEmitterLocal::StartSound( const idSoundShader *shader, const s_channe
 					common->Printf( "(override %s)", chan->soundShader->base->GetName() );
 				}
 
-				chan->Stop();
-
-				// if this was an onDemand sound, purge the sample now
-				if ( chan->leadinSample->onDemand ) {
-					chan->ALStop();
-					chan->leadinSample->PurgeSoundSample();
-				}
+				StopChannel( chan, false );
 				break;
 			}
 		}
 	}
 
-	// find a free channel to play the sound on
+	// find a free channel to play the sound on, the mixer may still be releasing recently stopped ones
 	idSoundChannel	*chan;
 	for( i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
 		chan = &channels[i];
-		if ( !chan->triggerState ) {
+		if ( !chan->triggerState && CheckRelease( chan ) ) {
 			break;
 		}
 	}
 
 	if ( i == SOUND_MAX_CHANNELS ) {
 		// we couldn't find a channel for it
-		Sys_LeaveCriticalSection();
 		if ( idSoundSystemLocal::s_showStartSound.GetInteger() ) {
 			common->Printf( "no channels available\n" );
 		}
@@ -800,10 +915,21 @@ int idSoundEmitterLocal::StartSound( const idSoundShader *shader, const s_channe
 		chan->leadinSample = shader->entries[ choice ];
 	}
 
-	// if the sample is onDemand (voice mails, etc), load it now
-	if ( chan->leadinSample->purged ) {
-		int		start = Sys_Milliseconds();
-		chan->leadinSample->Load();
+	// if the sample is onDemand (voice mails, etc) or was freed by the sound cache, load it now
+	bool loaded = false;
+	int start = Sys_Milliseconds();
+	if ( chanParms.soundShaderFlags & SSF_LOOPING ) {
+		loaded = soundSystemLocal.soundCache->TouchSound( shader->entries[0] );
+	}
+	if ( soundSystemLocal.soundCache->TouchSound( chan->leadinSample ) ) {
+		loaded = true;
+	}
+	// samples streamed from disk keep their file open while channels play them
+	chan->leadinSample->OpenStream();
+	if ( chanParms.soundShaderFlags & SSF_LOOPING ) {
+		shader->entries[0]->OpenStream();
+	}
+	if ( loaded ) {
 		int		end = Sys_Milliseconds();
 		session->TimeHitch( end - start );
 		// recalculate start44kHz, because loading may have taken a fair amount of time
@@ -822,11 +948,7 @@ int idSoundEmitterLocal::StartSound( const idSoundShader *shader, const s_channe
 		chan->disallowSlow = !allowSlow;
 	}
 
-	ResetSlowChannel( chan );
-
 	// the sound will start mixing in the next async mix block
-	chan->triggered = true;
-	chan->openalStreamingOffset = 0;
 	chan->trigger44kHzTime = start44kHz;
 	chan->parms = chanParms;
 	chan->triggerGame44kHzTime = soundWorld->game44kHz;
@@ -860,7 +982,14 @@ int idSoundEmitterLocal::StartSound( const idSoundShader *shader, const s_channe
 
 	length *= 1000 / (float)PRIMARYFREQ;
 
-	Sys_LeaveCriticalSection();
+	// hand the channel over to the mixer
+	mixCommand_t cmd;
+	cmd.type = MIXCMD_START;
+	cmd.emitter = index;
+	cmd.channel = i;
+	cmd.serial = 0;
+	StoreMixParms( cmd.parms );
+	soundWorld->PushMixCommand( cmd );
 
 	return length;
 }
@@ -929,8 +1058,6 @@ void idSoundEmitterLocal::StopSound( const s_channelType channel ) {
 		soundWorld->writeDemo->WriteInt( channel );
 	}
 
-	Sys_EnterCriticalSection();
-
 	for( i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
 		idSoundChannel	*chan = &channels[i];
 
@@ -941,22 +1068,9 @@ void idSoundEmitterLocal::StopSound( const s_channelType channel ) {
 			continue;
 		}
 
-		// stop it
-		chan->Stop();
-
-		// free hardware resources
-		chan->ALStop();
-
-		// if this was an onDemand sound, purge the sample now
-		if ( chan->leadinSample->onDemand ) {
-			chan->leadinSample->PurgeSoundSample();
-		}
-
-		chan->leadinSample = NULL;
-		chan->soundShader = NULL;
+		// stop it, the mixer frees the hardware resources
+		StopChannel( chan, true );
 	}
-
-	Sys_LeaveCriticalSection();
 }
 
 /*
@@ -31,6 +31,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "sound.h"
 
+#include <atomic>
+
 // you need the OpenAL headers for build, even if AL is not enabled - http://www.openal.org/
 #ifdef _WIN32
 #include "../openal-soft/include/AL/al.h"
@@ -273,6 +275,8 @@ public:
 
 	int				GetOutputSize( void ) { return mdwSize; }
 	int				GetMemorySize( void ) { return mMemSize; }
+	const char *	GetStreamName( void ) { return ( ogg == NULL && mhmmio != NULL ) ? mhmmio->GetName() : NULL; }	// NULL when decoded while reading
+	int				GetStreamOffset( void ) const { return mseekBase; }
 
     waveformatextensible_t	mpwfx;        // Pointer to waveformatex structure
 
@@ -445,6 +449,7 @@ enum {
 };
 
 class idSoundChannel;
+class idSoundStream;
 
 class idSlowChannel {
 	bool					active;
@@ -477,6 +482,13 @@ public:
 	FracTime				GetCurrentPosition()	{ return curPosition; };
 };
 
+/*
+	Channels are set up and stopped by the game thread and mixed by the mixer. The
+	game owns triggerState, the sample and the parms, the mixer owns mixing, the
+	decode-ahead stream and the OpenAL voice. Starts and stops are handed over with
+	MIXCMD_START and MIXCMD_STOP, and a stopped channel is only reused once the
+	mixer released it.
+*/
 class idSoundChannel {
 public:
 						idSoundChannel( void );
@@ -484,11 +496,22 @@ public:
 
 	void				Clear( void );
 	void				Start( void );
-	void				Stop( void );
+	void				Stop( void );			// stops both sides, only while the mixer is locked out
+	void				Release( void );		// mixer side of a stop
 	void				GatherChannelSamples( int sampleOffset44k, int sampleCount44k, float *dest ) const;
 	void				ALStop( void );			// free OpenAL resources if any
 
+	static void			GatherSamples( idSampleDecoder *decoder, idSoundSample *leadin, idSoundSample *loop, int sampleOffset44k, int sampleCount44k, float *dest );
+
 	bool				triggerState;
+	bool				mixing;					// set by the mixer between MIXCMD_START and MIXCMD_STOP
+	bool				releasing;				// a stop was queued and the mixer hasn't released the channel yet
+	bool				forgetOnRelease;		// clear the sample and shader once released
+	int					stopsQueued;
+	std::atomic<int>	stopsReleased;			// last stop the mixer released
+	std::atomic<bool>	stolen;					// the mixer gave the voice of this one shot sound to another channel
+	std::atomic<bool>	finished;				// the mixer found the voice or the slowed samples of this one shot sound played out
+	std::atomic<bool>	slowed;					// the mixer plays the channel through its slow channel
 	int					trigger44kHzTime;		// hardware time sample the channel started
 	int					triggerGame44kHzTime;	// game time sample time the channel started
 	soundShaderParms_t	parms;					// combines the shader parms and the per-channel overrides
@@ -496,13 +519,15 @@ public:
 	s_channelType		triggerChannel;
 	const idSoundShader *soundShader;
 	idSampleDecoder *	decoder;
+	idSoundStream *		stream;					// decode-ahead stream for OpenAL streamed samples
 	float				diversity;
 	float				lastVolume;				// last calculated volume based on distance
 	float				lastV[6];				// last calculated volume for each speaker, so we can smoothly fade
 	idSoundFade			channelFade;
 	bool				triggered;
+	bool				isVirtual;				// ranked out of the mixed voices, only its time advances
 	ALuint				openalSource;
-	ALuint				openalStreamingOffset;
+	ALuint				openalStreamingOffset;	// also where a virtual or restored channel resumes
 	ALuint				openalStreamingBuffer[3];
 	ALuint				lastopenalStreamingBuffer[3];
 
@@ -510,6 +535,15 @@ public:
 
 };
 
+// spatialization the mixer uses, published by the game once per sound frame
+typedef struct emitterMixParms_s {
+	idVec3				origin;
+	idVec3				spatializedOrigin;
+	float				realDistance;
+	float				distance;
+	int					listenerId;
+} emitterMixParms_t;
+
 class idSoundEmitterLocal : public idSoundEmitter {
 public:
 
@@ -551,6 +585,9 @@ public:
 	void				OverrideParms( const soundShaderParms_t *base, const soundShaderParms_t *over, soundShaderParms_t *out );
 	void				CheckForCompletion( int current44kHzTime );
 	void				Spatialize( idVec3 listenerPos, int listenerArea, idRenderWorld *rw );
+	void				StoreMixParms( emitterMixParms_t &mixParms ) const;
+	void				StopChannel( idSoundChannel *chan, bool forget );
+	bool				CheckRelease( idSoundChannel *chan );
 
 	idSoundWorldLocal *	soundWorld;				// the world that holds this emitter
 
@@ -574,6 +611,8 @@ public:
 													// it may go through a chain of portals.  If there
 													// is not an open-portal path, distance will be > maxDistance
 
+	emitterMixParms_t	mixParms[3];				// indexed by the mix parms slots of the world
+
 	// a single soundEmitter can have many channels playing from the same point
 	idSoundChannel		channels[SOUND_MAX_CHANNELS];
 
@@ -609,6 +648,8 @@ public:
 		missedWindow = 0;
 		missedUpdateWindow = 0;
 		activeSounds = 0;
+		activeVoices = 0;
+		virtualVoices = 0;
 	}
 	int		rinuse;
 	int		runs;
@@ -616,13 +657,93 @@ public:
 	int		missedWindow;
 	int		missedUpdateWindow;
 	int		activeSounds;
+	int		activeVoices;		// channels mixed on a hardware voice in the last tick
+	int		virtualVoices;		// channels only advanced in time in the last tick
+};
+
+typedef struct mixerLockStats_s {
+	int		locks;				// game thread entries of the mixer critical section
+	int		waits;				// entries that had to wait for the mixer
+	float	waitTime;			// msec spent waiting
+	int		commands;			// commands handed to the mixer, without locking unless s_mixerQueue is 0
+	int		drains;				// command queues applied on the game thread
+} mixerLockStats_t;
+
+typedef enum {
+	MIXCMD_START,				// the game set up the channel, start mixing it
+	MIXCMD_STOP					// the game stopped the channel, release it
+} mixCommandType_t;
+
+typedef struct mixCommand_s {
+	mixCommandType_t	type;
+	int					emitter;
+	int					channel;
+	int					serial;			// MIXCMD_STOP: stopsQueued of the channel
+	emitterMixParms_t	parms;			// MIXCMD_START: spatialization at start time
+} mixCommand_t;
+
+const int MIX_COMMAND_QUEUE_SIZE	= 1024;		// must be a power of two
+const int MIX_COMMAND_TIMEOUT		= 200;		// msec without a mix before the game applies the commands itself
+
+// single producer (game thread), single consumer (mixer) ring buffer
+class idMixCommandQueue {
+public:
+							idMixCommandQueue( void );
+
+	void					Clear( void );
+	bool					IsEmpty( void ) const;
+	bool					Push( const mixCommand_t &cmd );
+	bool					Pop( mixCommand_t &cmd );
+
+private:
+	mixCommand_t			commands[MIX_COMMAND_QUEUE_SIZE];
+	std::atomic<int>		head;				// next command to pop, only written by the consumer
+	std::atomic<int>		tail;				// next free slot, only written by the producer
 };
 
+// listener the mixer uses, published together with the emitter mix parms
+typedef struct listenerMixParms_s {
+	idVec3				pos;
+	idMat3				axis;
+	int					area;
+	int					privateId;
+} listenerMixParms_t;
+
+const int MIX_PARMS_FRESH			= 4;		// or'ed into pendingMixParms when the game published new parms
+
+// a triggered channel competing for one of the s_maxVoices hardware voices
+typedef struct mixVoice_s {
+	idSoundEmitterLocal *	sound;
+	idSoundChannel *		chan;
+	float					volume;			// estimated audibility, see ChannelVolume
+	float					spatialize;
+} mixVoice_t;
+
 typedef struct soundPortalTrace_s {
 	int		portalArea;
+	const idWinding *portal;		// portal leaving portalArea
+	bool	blocked;
 	const struct soundPortalTrace_s	*prevStack;
 } soundPortalTrace_t;
 
+const int MAX_PORTAL_TRACE_DEPTH	= 10;
+
+// shortest portal path from an emitter area to the listener area, found by ResolveOrigin
+typedef struct soundPropagation_s {
+	bool				valid;
+	float				maxDistance;		// the search was cut off at this distance
+	int					numPortals;			// -1 if there was no path within maxDistance
+	const idWinding *	portals[MAX_PORTAL_TRACE_DEPTH];
+	bool				blocked[MAX_PORTAL_TRACE_DEPTH];
+} soundPropagation_t;
+
+typedef struct propagationStats_s {
+	int					resolves;			// full portal searches
+	float				resolveTime;
+	int					cached;				// paths replayed from the propagation cache
+	float				cachedTime;
+} propagationStats_t;
+
 class idSoundWorldLocal : public idSoundWorld {
 public:
 	virtual					~idSoundWorldLocal( void );
@@ -697,14 +818,28 @@ public:
 
 	idSoundEmitterLocal *	AllocLocalSoundEmitter();
 	void					CalcEars( int numSpeakers, idVec3 realOrigin, idVec3 listenerPos, idMat3 listenerAxis, float ears[6], float spatialize );
-	void					AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
+	float					ChannelVolume( idSoundEmitterLocal *sound, idSoundChannel *chan, int current44kHz, float *spatialize );
+	void					AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan, float volume, float spatialize,
 												int current44kHz, int numSpeakers, float *finalMixBuffer );
+	void					VirtualizeChannel( idSoundChannel *chan );
+	void					ResumeChannel( idSoundChannel *chan, int current44kHz );
 	void					MixLoop( int current44kHz, int numSpeakers, float *finalMixBuffer );
 	void					AVIUpdate( void );
+	idVec3					PortalSoundOrigin( const idWinding *w, const idVec3 &soundOrigin ) const;
 	void					ResolveOrigin( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea, const float dist, const idVec3& soundOrigin, idSoundEmitterLocal *def );
+	void					PropagateSound( const int soundArea, idSoundEmitterLocal *def );
+	void					ClearPropagationCache( void );
+	void					UpdatePropagationStatistics( void );
+	void					MarkSamplesInUse( int mark ) const;
 	void					FindEffects( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea );
 	float					FindAmplitude( idSoundEmitterLocal *sound, const int localTime, const idVec3 *listenerPosition, const s_channelType channel, bool shakesOnly );
 
+	void					PushMixCommand( mixCommand_t &cmd );
+	void					ProcessMixCommands( void );
+	void					CheckMixCommands( void );
+	void					PublishMixParms( void );
+	void					AcquireMixParms( void );
+
 	//============================================
 
 	idRenderWorld *			rw;				// for portals and debug drawing
@@ -717,6 +852,14 @@ public:
 	int						listenerArea;
 	idStr					listenerAreaName;
 
+	// resolved portal paths to the listener area, indexed by emitter area
+	idList<soundPropagation_t>	propagationCache;
+	int						propagationArea;			// listener area of the cached paths
+	int						propagationPortalStates;	// render world portal state of the cached paths
+	soundPropagation_t		resolvedPath;				// best path of the current ResolveOrigin
+	propagationStats_t		propagationStats;
+	float					averageResolveTime;
+
 	ALuint                  alListenerFilter;
 
 	struct effect_slot_t {
@@ -742,6 +885,18 @@ public:
 
 	idList<idSoundEmitterLocal *>emitters;
 
+	// game to mixer hand over, so neither side has to lock the other out
+	idMixCommandQueue		mixCommands;
+	listenerMixParms_t		listenerMixParms[3];
+	int						gameMixParms;		// slot the game writes
+	int						mixerMixParms;		// slot the mixer reads
+	std::atomic<int>		pendingMixParms;	// slot in between, plus MIX_PARMS_FRESH
+	std::atomic<int>		mixTicks;			// bumped by every MixLoop
+	int						lastMixTicks;		// mixTicks at lastMixTickTime
+	int						lastMixTickTime;
+
+	idList<mixVoice_t>		mixVoices;			// mixer only, the channels ranked each tick
+
 	idSoundFade				soundClassFade[SOUND_MAX_CLASSES];	// for global sound fading
 
 	// avi stuff
@@ -839,6 +994,10 @@ public:
 
 	void					DoEnviroSuit( float* samples, int numSamples, int numSpeakers );
 
+	void					LockMixer( void );
+	void					UnlockMixer( void );
+	void					UpdateLockStatistics( void );
+
 	ALuint					AllocOpenALSource( idSoundChannel *chan, bool looping, bool stereo );
 	void					FreeOpenALSource( ALuint handle );
 
@@ -846,6 +1005,7 @@ public:
 	idSoundCache *			soundCache;
 
 	idSoundWorldLocal *		currentSoundWorld;	// the one to mix each async tic
+	idList<idSoundWorldLocal *>	soundWorlds;	// all allocated worlds, their channels keep samples in the cache
 
 	int						olddwCurrentWritePos;	// statistics
 	int						buffers;				// statistics
@@ -862,6 +1022,8 @@ public:
 	bool                    effectsDirty;
 
 	s_stats					soundStats;				// NOTE: updated throughout the code, not displayed anywhere
+	mixerLockStats_t		lockStats;				// game thread only, see s_showMixerLocks
+	int						mixerLockDepth;			// game thread only, nested LockMixer calls
 
 	int						meterTops[256];
 	int						meterTopsTime[256];
@@ -909,6 +1071,17 @@ public:
 	static idCVar			s_useEAXReverb;
 	static idCVar			s_efxFadeOutDistance;
 	static idCVar			s_decompressionLimit;
+	static idCVar			s_decodeAhead;
+	static idCVar			s_showDecodeAhead;
+	static idCVar			s_showMixerLocks;
+	static idCVar			s_mixerQueue;
+	static idCVar			s_maxVoices;
+	static idCVar			s_showVoices;
+	static idCVar			s_cachePropagation;
+	static idCVar			s_showPropagation;
+	static idCVar			s_cacheBudget;
+	static idCVar			s_streamSize;
+	static idCVar			s_showSoundCache;
 
 	static idCVar			s_slowAttenuate;
 
@@ -937,6 +1110,9 @@ extern	idSoundSystemLocal	soundSystemLocal;
 
 const int SCACHE_SIZE = MIXBUFFER_SAMPLES*20;	// 1/2 of a second (aroundabout)
 
+const int SOUND_CACHE_BLOCK_SIZE	= 32 * 1024;	// bytes read from disk at once for streamed samples
+const int SOUND_CACHE_STREAM_BLOCKS	= 32;			// blocks shared by all streamed samples
+
 class idSoundSample {
 public:
 							idSoundSample();
@@ -956,6 +1132,13 @@ public:
 	bool					onDemand;
 	bool					purged;
 	bool					levelLoadReferenced;		// so we can tell which samples aren't needed any more
+	bool					streamed;					// only the header is loaded, the data is read in blocks through the cache
+	bool					neverStream;				// looping samples stay resident
+	idStr					streamName;					// file the data of a streamed sample is read from
+	idFile *				streamFile;					// open while channels play the streamed sample
+	int						streamOffset;				// offset of the data in streamFile
+	int						inUseMark;					// set while a channel holds on to the sample
+	idLinkList<idSoundSample>	cacheUsage;				// resident samples, most recently used first
 
 	int						LengthIn44kHzSamples() const;
 	ID_TIME_T		 			GetNewTimeStamp( void ) const;
@@ -964,6 +1147,8 @@ public:
 	void					Reload( bool force );		// reloads if timestamp has changed, or always if force
 	void					PurgeSoundSample();			// frees all data
 	void					CheckForDownSample();		// down sample if required
+	void					OpenStream();				// opens streamFile when a channel starts the sample
+	void					CloseStream();				// closes streamFile, the cached blocks stay valid
 	bool					FetchFromCache( int offset, const byte **output, int *position, int *size, const bool allowIO );
 };
 
@@ -980,7 +1165,7 @@ class idSampleDecoder {
 public:
 	static void				Init( void );
 	static void				Shutdown( void );
-	static idSampleDecoder *Alloc( void );
+	static idSampleDecoder *Alloc( bool allowIO = false );
 	static void				Free( idSampleDecoder *decoder );
 	static int				GetNumUsedBlocks( void );
 	static int				GetUsedBlockMemory( void );
@@ -993,6 +1178,35 @@ public:
 };
 
 
+/*
+===================================================================================
+
+  Decode-ahead streams.
+
+  Compressed samples streamed through OpenAL buffers are decoded a few mix
+  buffers ahead on a background thread, so the mixer only copies finished PCM
+  and falls back to decoding in place when a block is not ready yet.  Samples
+  streamed from disk are only read by the decode-ahead thread.
+
+===================================================================================
+*/
+
+const int SOUND_STREAM_BLOCKS		= 4;			// mix buffers decoded ahead of the mixer
+
+class idSoundDecodeAhead {
+public:
+	static void				Init( void );
+	static void				Shutdown( void );
+	static idSoundStream *	AllocStream( idSoundSample *leadin, idSoundSample *loop, int sampleOffset44k, int sampleCount44k );
+	static void				FreeStream( idSoundStream *stream );
+	static bool				ReadStream( idSoundStream *stream, idSoundSample *loop, int sampleOffset44k, short *dest );
+	static bool				IsStreamReady( idSoundStream *stream, idSoundSample *loop, int sampleOffset44k, int numBlocks );
+	static void				AddMixerDecodeTime( double msec );
+	static void				UpdateStatistics( void );
+	static void				FloatToShort( short *dest, const float *src, int numSamples );
+};
+
+
 /*
 ===================================================================================
 
@@ -1016,11 +1230,46 @@ public:
 	void					BeginLevelLoad();
 	void					EndLevelLoad();
 
+	bool					TouchSound( idSoundSample *sample );
+	void					EnforceBudget( void );
+	int						GetResidentBytes( void ) const;
+	bool					FetchStreamBlock( idSoundSample *sample, int offset, const byte **output, int *position, int *size, const bool allowIO );
+	void					FreeStreamBlocks( const idSoundSample *sample );
+	void					ReleaseStream( idSoundSample *sample );
+	void					UpdateStatistics( void );
+
 	void					PrintMemInfo( MemInfo_t *mi );
 
 private:
+	typedef struct soundCacheBlock_s {
+		const idSoundSample *	sample;				// NULL while the block is free
+		int						offset;				// byte offset of the block in the sample data
+		int						size;
+		int						lastUsed;
+		byte *					data;
+	} soundCacheBlock_t;
+
+	typedef struct soundCacheStats_s {
+		int						hits;
+		int						misses;
+		int						reads;				// blocks read from disk, including read ahead
+		int						readAheads;
+		int						readBytes;
+		int						evictions;			// resident samples freed to stay within the budget
+	} soundCacheStats_t;
+
 	bool					insideLevelLoad;
 	idList<idSoundSample*>	listCache;
+	idLinkList<idSoundSample>	cacheUsage;
+
+	int						inUseMark;
+	int						streamUseCount;
+	byte *					streamData;
+	soundCacheBlock_t		streamBlocks[SOUND_CACHE_STREAM_BLOCKS];
+	soundCacheStats_t		stats;					// since the last UpdateStatistics, stream blocks are guarded by CRITICAL_SECTION_ONE
+
+	soundCacheBlock_t *		FindStreamBlock( const idSoundSample *sample, int offset );
+	soundCacheBlock_t *		ReadStreamBlock( idSoundSample *sample, int offset );
 };
 
 #endif /* !__SND_LOCAL_H__ */
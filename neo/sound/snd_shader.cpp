@@ -366,6 +366,18 @@ bool idSoundShader::ParseShader( idLexer &src ) {
 		CheckShakesAndOgg();
 	}
 
+	// looping samples stay resident, streaming them would read the start of the file again on every loop
+	if ( parms.soundShaderFlags & SSF_LOOPING ) {
+		for ( int i = 0; i < numEntries; i++ ) {
+			idSoundSample *sample = entries[i];
+			sample->neverStream = true;
+			if ( sample->streamed ) {
+				sample->PurgeSoundSample();
+				soundSystemLocal.soundCache->TouchSound( sample );
+			}
+		}
+	}
+
 	return true;
 }
 
@@ -75,6 +75,17 @@ idCVar idSoundSystemLocal::s_libOpenAL( "s_libOpenAL", "openal32.dll", CVAR_SOUN
 idCVar idSoundSystemLocal::s_useEAXReverb( "s_useEAXReverb", "1", CVAR_SOUND | CVAR_BOOL | CVAR_ARCHIVE, "use EAX reverb" );
 idCVar idSoundSystemLocal::s_efxFadeOutDistance( "s_efxFadeOutDistance", "100", CVAR_SOUND | CVAR_FLOAT | CVAR_ARCHIVE, "" );
 idCVar idSoundSystemLocal::s_decompressionLimit( "s_decompressionLimit", "6", CVAR_SOUND | CVAR_INTEGER | CVAR_ARCHIVE, "specifies maximum uncompressed sample length in seconds" );
+idCVar idSoundSystemLocal::s_decodeAhead( "s_decodeAhead", "1", CVAR_SOUND | CVAR_BOOL | CVAR_ARCHIVE, "decode streamed sounds ahead of the mixer on a background thread" );
+idCVar idSoundSystemLocal::s_showMixerLocks( "s_showMixerLocks", "0", CVAR_SOUND | CVAR_BOOL, "print how often the game thread locked out the mixer each frame" );
+idCVar idSoundSystemLocal::s_mixerQueue( "s_mixerQueue", "1", CVAR_SOUND | CVAR_BOOL, "hand channel changes to the mixer through a queue, 0 = lock out the mixer for every change and for the whole frame update as before, to compare the s_showMixerLocks counters" );
+idCVar idSoundSystemLocal::s_maxVoices( "s_maxVoices", "64", CVAR_SOUND | CVAR_INTEGER | CVAR_ARCHIVE, "number of most audible channels mixed on hardware voices, the others only advance in time", 8, 256 );
+idCVar idSoundSystemLocal::s_showVoices( "s_showVoices", "0", CVAR_SOUND | CVAR_BOOL, "print the mixed and virtual channel counts for each mix tick" );
+idCVar idSoundSystemLocal::s_cachePropagation( "s_cachePropagation", "1", CVAR_SOUND | CVAR_BOOL, "reuse the portal paths of sounds until the listener changes areas or a portal changes state" );
+idCVar idSoundSystemLocal::s_showPropagation( "s_showPropagation", "0", CVAR_SOUND | CVAR_BOOL, "print the portal searches for sound propagation each frame" );
+idCVar idSoundSystemLocal::s_cacheBudget( "s_cacheBudget", "0", CVAR_SOUND | CVAR_INTEGER | CVAR_ARCHIVE, "megabytes of resident sound samples, the least recently used idle samples are freed beyond it, 0 = no limit" );
+idCVar idSoundSystemLocal::s_streamSize( "s_streamSize", "0", CVAR_SOUND | CVAR_INTEGER | CVAR_ARCHIVE, "samples larger than this many kB are streamed from disk while they play instead of being loaded, 0 = never stream" );
+idCVar idSoundSystemLocal::s_showSoundCache( "s_showSoundCache", "0", CVAR_SOUND | CVAR_BOOL, "print sound cache hits, misses, stream reads and evictions each frame" );
+idCVar idSoundSystemLocal::s_showDecodeAhead( "s_showDecodeAhead", "0", CVAR_SOUND | CVAR_BOOL, "print decode times and underruns of streamed sounds for each mix tick" );
 
 bool idSoundSystemLocal::EAXAvailable = false;
 
@@ -184,6 +195,7 @@ static void ListSounds_f( const idCmdArgs &args ) {
 	int totalSamples = 0;
 	int totalMemory = 0;
 	int totalPCMMemory = 0;
+	int totalStreamed = 0;
 	for( i = 0; i < soundSystemLocal.soundCache->GetNumObjects(); i++ ) {
 		const idSoundSample *sample = soundSystemLocal.soundCache->GetObject(i);
 		if ( !sample ) {
@@ -197,13 +209,15 @@ static void ListSounds_f( const idCmdArgs &args ) {
 
 		const char *stereo = ( info.nChannels == 2 ? "ST" : "  " );
 		const char *format = ( info.wFormatTag == WAVE_FORMAT_TAG_OGG ) ? "OGG" : "WAV";
-		const char *defaulted = ( sample->defaultSound ? "(DEFAULTED)" : sample->purged ? "(PURGED)" : "" );
+		const char *defaulted = ( sample->defaultSound ? "(DEFAULTED)" : sample->purged ? "(PURGED)" : sample->streamed ? "(STREAMED)" : "" );
 
 		common->Printf( "%s %dkHz %6dms %5dkB %4s %s%s\n", stereo, sample->objectInfo.nSamplesPerSec / 1000,
 					soundSystemLocal.SamplesToMilliseconds( sample->LengthIn44kHzSamples() ),
 					sample->objectMemSize >> 10, format, sample->name.c_str(), defaulted );
 
-		if ( !sample->purged ) {
+		if ( sample->streamed ) {
+			totalStreamed++;
+		} else if ( !sample->purged ) {
 			totalSamples += sample->objectSize;
 			if ( info.wFormatTag != WAVE_FORMAT_TAG_OGG )
 				totalPCMMemory += sample->objectMemSize;
@@ -214,7 +228,9 @@ static void ListSounds_f( const idCmdArgs &args ) {
 	}
 	common->Printf( "%8d total sounds\n", totalSounds );
 	common->Printf( "%8d total samples loaded\n", totalSamples );
+	common->Printf( "%8d sounds streamed\n", totalStreamed );
 	common->Printf( "%8d kB total system memory used\n", totalMemory >> 10 );
+	common->Printf( "%8d kB resident in the sound cache, %d MB budget\n", soundSystemLocal.soundCache->GetResidentBytes() >> 10, idSoundSystemLocal::s_cacheBudget.GetInteger() );
 }
 
 /*
@@ -355,6 +371,9 @@ void idSoundSystemLocal::Init() {
 	currentSoundWorld = nullptr;
 	soundCache = nullptr;
 
+	memset( &lockStats, 0, sizeof( lockStats ) );
+	mixerLockDepth = 0;
+
 	olddwCurrentWritePos = 0;
 	buffers = 0;
 	CurrentSoundTime = 0;
@@ -429,6 +448,7 @@ void idSoundSystemLocal::Init() {
 
 	if (!s_noSound.GetBool()) {
 		idSampleDecoder::Init();
+		idSoundDecodeAhead::Init();
 		soundCache = new idSoundCache();
 	}
 
@@ -470,6 +490,9 @@ void idSoundSystemLocal::Shutdown() {
 		openalSources[i].looping = false;
 	}
 
+	// stop decoding ahead before the samples go away
+	idSoundDecodeAhead::Shutdown();
+
 	// destroy all the sounds (hardware buffers as well)
 	delete soundCache;
 	soundCache = NULL;
@@ -764,7 +787,7 @@ cinData_t idSoundSystemLocal::ImageForTime( const int milliseconds, const bool w
 		return ret;
 	}
 
-	Sys_EnterCriticalSection();
+	LockMixer();
 
 	if ( !graph ) {
 		graph = (dword *)Mem_Alloc( 256*128 * 4);
@@ -903,7 +926,7 @@ cinData_t idSoundSystemLocal::ImageForTime( const int milliseconds, const bool w
 	ret.imageWidth = 256;
 	ret.image = (unsigned char *)graph;
 
-	Sys_LeaveCriticalSection();
+	UnlockMixer();
 
 	return ret;
 }
@@ -974,6 +997,7 @@ idSoundWorld *idSoundSystemLocal::AllocSoundWorld( idRenderWorld *rw ) {
 	idSoundWorldLocal	*local = new idSoundWorldLocal;
 
 	local->Init( rw );
+	soundWorlds.Append( local );
 
 	return local;
 }
@@ -1109,9 +1133,10 @@ ALuint idSoundSystemLocal::AllocOpenALSource( idSoundChannel *chan, bool looping
 	if ( index != -1 ) {
 		// stop the channel that is being ripped off
 		if ( openalSources[index].chan ) {
-			// stop the channel only when not looping
+			// stop the channel only when not looping, the game notices on its next completion check
 			if ( !openalSources[index].looping ) {
-				openalSources[index].chan->Stop();
+				openalSources[index].chan->Release();
+				openalSources[index].chan->stolen = true;
 			} else {
 				openalSources[index].chan->triggered = true;
 			}
@@ -1237,6 +1262,63 @@ void SoundFX_Comb::ProcessSample( float* in, float* out ) {
 		currentTime -= len;
 }
 
+/*
+===================
+idSoundSystemLocal::LockMixer
+
+Keeps the async mixer out while the game thread changes emitters or channels
+directly. Most changes go through the mix command queue instead, this counts
+the ones that don't.
+===================
+*/
+void idSoundSystemLocal::LockMixer( void ) {
+	idTimer timer;
+
+	// already locked further up, e.g. by the whole frame update with s_mixerQueue 0
+	if ( mixerLockDepth++ > 0 ) {
+		return;
+	}
+
+	timer.Start();
+	Sys_EnterCriticalSection();
+	timer.Stop();
+
+	// anything above a tenth of a millisecond means the mixer was holding it
+	float msec = timer.Milliseconds();
+	if ( msec > 0.1f ) {
+		lockStats.waits++;
+		lockStats.waitTime += msec;
+	}
+	lockStats.locks++;
+}
+
+/*
+===================
+idSoundSystemLocal::UnlockMixer
+===================
+*/
+void idSoundSystemLocal::UnlockMixer( void ) {
+	if ( --mixerLockDepth > 0 ) {
+		return;
+	}
+	Sys_LeaveCriticalSection();
+}
+
+/*
+===================
+idSoundSystemLocal::UpdateLockStatistics
+
+Called once per sound frame by the game thread.
+===================
+*/
+void idSoundSystemLocal::UpdateLockStatistics( void ) {
+	if ( s_showMixerLocks.GetBool() ) {
+		common->Printf( "%d: mixer %s: %d locks, %d waited %1.2f ms, %d commands, %d drained\n", CurrentSoundTime, s_mixerQueue.GetBool() ? "queued" : "locked",
+			lockStats.locks, lockStats.waits, lockStats.waitTime, lockStats.commands, lockStats.drains );
+	}
+	memset( &lockStats, 0, sizeof( lockStats ) );
+}
+
 /*
 ===================
 idSoundSystemLocal::DoEnviroSuit
@@ -104,6 +104,26 @@ void idSoundWorldLocal::Init( idRenderWorld *renderWorld ) {
 	slowmoActive		= false;
 	slowmoSpeed			= 0;
 	enviroSuitActive	= false;
+
+	mixCommands.Clear();
+	for ( int i = 0; i < 3; i++ ) {
+		listenerMixParms[i].pos = listenerPos;
+		listenerMixParms[i].axis = listenerAxis;
+		listenerMixParms[i].area = listenerArea;
+		listenerMixParms[i].privateId = listenerPrivateId;
+	}
+	gameMixParms = 0;
+	pendingMixParms = 1;
+	mixerMixParms = 2;
+	mixTicks = 0;
+	lastMixTicks = 0;
+	lastMixTickTime = Sys_Milliseconds();
+
+	propagationCache.Clear();
+	propagationArea = -1;
+	propagationPortalStates = 0;
+	memset( &propagationStats, 0, sizeof( propagationStats ) );
+	averageResolveTime = 0.0f;
 }
 
 /*
@@ -136,6 +156,7 @@ void idSoundWorldLocal::Shutdown() {
 	if ( soundSystemLocal.currentSoundWorld == this ) {
 		soundSystemLocal.currentSoundWorld = NULL;
 	}
+	soundSystemLocal.soundWorlds.Remove( this );
 
 	AVIClose();
 
@@ -156,7 +177,7 @@ idSoundWorldLocal::ClearAllSoundEmitters
 void idSoundWorldLocal::ClearAllSoundEmitters() {
 	int i;
 
-	Sys_EnterCriticalSection();
+	soundSystemLocal.LockMixer();
 
 	AVIClose();
 
@@ -166,7 +187,13 @@ void idSoundWorldLocal::ClearAllSoundEmitters() {
 	}
 	localSound = NULL;
 
-	Sys_LeaveCriticalSection();
+	// the channels the commands refer to are gone
+	mixCommands.Clear();
+
+	// a new map may come with a new render world
+	ClearPropagationCache();
+
+	soundSystemLocal.UnlockMixer();
 }
 
 /*
@@ -200,9 +227,9 @@ idSoundEmitterLocal *idSoundWorldLocal::AllocLocalSoundEmitter() {
 		def = new idSoundEmitterLocal;
 
 		// we need to protect this from the async thread
-		Sys_EnterCriticalSection();
+		soundSystemLocal.LockMixer();
 		index = emitters.Append( def );
-		Sys_LeaveCriticalSection();
+		soundSystemLocal.UnlockMixer();
 
 		if ( idSoundSystemLocal::s_showStartSound.GetInteger() ) {
 			common->Printf( "sound: appended new sound def %d\n", index );
@@ -293,9 +320,9 @@ void idSoundWorldLocal::ProcessDemoCommand( idDemoFile *readDemo ) {
 		// we need to protect this from the async thread
 		// other instances of calling idSoundWorldLocal::ReadFromSaveGame do this while the sound code is muted
 		// setting muted and going right in may not be good enough here, as we async thread may already be in an async tick (in which case we could still race to it)
-		Sys_EnterCriticalSection();
+		soundSystemLocal.LockMixer();
 		ReadFromSaveGame( readDemo );
-		Sys_LeaveCriticalSection();
+		soundSystemLocal.UnlockMixer();
 		UnPause();
 		break;
 	case SCMD_PLACE_LISTENER:
@@ -438,6 +465,257 @@ float idSoundWorldLocal::CurrentShakeAmplitudeForPosition( const int time, const
 	return amp;
 }
 
+/*
+===================
+idMixCommandQueue::idMixCommandQueue
+===================
+*/
+idMixCommandQueue::idMixCommandQueue( void ) {
+	Clear();
+}
+
+/*
+===================
+idMixCommandQueue::Clear
+
+Only while the mixer is locked out.
+===================
+*/
+void idMixCommandQueue::Clear( void ) {
+	head = 0;
+	tail = 0;
+}
+
+/*
+===================
+idMixCommandQueue::IsEmpty
+===================
+*/
+bool idMixCommandQueue::IsEmpty( void ) const {
+	return head.load( std::memory_order_acquire ) == tail.load( std::memory_order_acquire );
+}
+
+/*
+===================
+idMixCommandQueue::Push
+
+Game thread only, returns false if the queue is full.
+===================
+*/
+bool idMixCommandQueue::Push( const mixCommand_t &cmd ) {
+	const int t = tail.load( std::memory_order_relaxed );
+	if ( t - head.load( std::memory_order_acquire ) >= MIX_COMMAND_QUEUE_SIZE ) {
+		return false;
+	}
+	commands[t & ( MIX_COMMAND_QUEUE_SIZE - 1 )] = cmd;
+	tail.store( t + 1, std::memory_order_release );
+	return true;
+}
+
+/*
+===================
+idMixCommandQueue::Pop
+
+Mixer side, returns false if the queue is empty.
+===================
+*/
+bool idMixCommandQueue::Pop( mixCommand_t &cmd ) {
+	const int h = head.load( std::memory_order_relaxed );
+	if ( h == tail.load( std::memory_order_acquire ) ) {
+		return false;
+	}
+	cmd = commands[h & ( MIX_COMMAND_QUEUE_SIZE - 1 )];
+	head.store( h + 1, std::memory_order_release );
+	return true;
+}
+
+/*
+===================
+idSoundWorldLocal::PushMixCommand
+
+Hands a channel change to the mixer.  If the mixer fell that far behind, the queue
+is applied here with the mixer locked out.
+===================
+*/
+void idSoundWorldLocal::PushMixCommand( mixCommand_t &cmd ) {
+	soundSystemLocal.lockStats.commands++;
+
+	// apply every change right away with the mixer locked out, as before the queue
+	if ( !idSoundSystemLocal::s_mixerQueue.GetBool() ) {
+		soundSystemLocal.LockMixer();
+		ProcessMixCommands();
+		mixCommands.Push( cmd );
+		ProcessMixCommands();
+		soundSystemLocal.UnlockMixer();
+		return;
+	}
+
+	if ( mixCommands.Push( cmd ) ) {
+		return;
+	}
+
+	soundSystemLocal.LockMixer();
+	ProcessMixCommands();
+	soundSystemLocal.lockStats.drains++;
+	soundSystemLocal.UnlockMixer();
+
+	mixCommands.Push( cmd );
+}
+
+/*
+===================
+idSoundWorldLocal::ProcessMixCommands
+
+Mixer side of the channel changes.  Called at the start of each MixLoop, or from
+the game thread with the mixer locked out.
+===================
+*/
+void idSoundWorldLocal::ProcessMixCommands( void ) {
+	mixCommand_t cmd;
+
+	while ( mixCommands.Pop( cmd ) ) {
+		if ( cmd.emitter < 0 || cmd.emitter >= emitters.Num() ) {
+			continue;
+		}
+		idSoundEmitterLocal *sound = emitters[cmd.emitter];
+		idSoundChannel *chan = &sound->channels[cmd.channel];
+
+		switch ( cmd.type ) {
+			case MIXCMD_START:
+				chan->mixing = true;
+				chan->triggered = true;
+				chan->openalStreamingOffset = 0;
+				sound->ResetSlowChannel( chan );
+				sound->mixParms[mixerMixParms] = cmd.parms;
+				break;
+			case MIXCMD_STOP:
+				chan->Release();
+				chan->ALStop();
+				// the game may reuse the channel from here on
+				chan->stopsReleased.store( cmd.serial, std::memory_order_release );
+				break;
+		}
+	}
+}
+
+/*
+===================
+idSoundWorldLocal::CheckMixCommands
+
+Applies the queued commands on the game thread if this world isn't mixed at the
+moment, e.g. while it's muted or not the current world.
+===================
+*/
+void idSoundWorldLocal::CheckMixCommands( void ) {
+	const int now = Sys_Milliseconds();
+	const int ticks = mixTicks.load( std::memory_order_relaxed );
+
+	if ( ticks != lastMixTicks ) {
+		lastMixTicks = ticks;
+		lastMixTickTime = now;
+		return;
+	}
+
+	if ( now - lastMixTickTime < MIX_COMMAND_TIMEOUT || mixCommands.IsEmpty() ) {
+		return;
+	}
+
+	soundSystemLocal.LockMixer();
+	ProcessMixCommands();
+	soundSystemLocal.lockStats.drains++;
+	soundSystemLocal.UnlockMixer();
+}
+
+/*
+===================
+idSoundWorldLocal::PublishMixParms
+
+Hands the current listener and emitter spatialization to the mixer.  The game
+fills its own slot and swaps it with the pending one, so neither side waits.
+===================
+*/
+void idSoundWorldLocal::PublishMixParms( void ) {
+	listenerMixParms_t &listener = listenerMixParms[gameMixParms];
+	listener.pos = listenerPos;
+	listener.axis = listenerAxis;
+	listener.area = listenerArea;
+	listener.privateId = listenerPrivateId;
+
+	for ( int i = 1; i < emitters.Num(); i++ ) {
+		idSoundEmitterLocal *def = emitters[i];
+		if ( def->playing ) {
+			def->StoreMixParms( def->mixParms[gameMixParms] );
+		}
+	}
+
+	gameMixParms = pendingMixParms.exchange( gameMixParms | MIX_PARMS_FRESH, std::memory_order_acq_rel ) & 3;
+}
+
+/*
+===================
+idSoundWorldLocal::AcquireMixParms
+
+Mixer side of PublishMixParms.
+===================
+*/
+void idSoundWorldLocal::AcquireMixParms( void ) {
+	if ( pendingMixParms.load( std::memory_order_acquire ) & MIX_PARMS_FRESH ) {
+		mixerMixParms = pendingMixParms.exchange( mixerMixParms, std::memory_order_acq_rel ) & 3;
+	}
+}
+
+/*
+===================
+MixVoiceCompare
+
+Sorts the most audible channels first.
+===================
+*/
+static int MixVoiceCompare( const mixVoice_t *a, const mixVoice_t *b ) {
+	if ( a->volume > b->volume ) {
+		return -1;
+	}
+	if ( a->volume < b->volume ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+===================
+idSoundWorldLocal::VirtualizeChannel
+
+Gives up the hardware voice and the decode-ahead stream of a channel that isn't
+audible enough to be mixed.  Its time keeps running from trigger44kHzTime.
+===================
+*/
+void idSoundWorldLocal::VirtualizeChannel( idSoundChannel *chan ) {
+	if ( chan->isVirtual ) {
+		return;
+	}
+	chan->isVirtual = true;
+	chan->lastVolume = 0.0f;
+	chan->ALStop();
+	if ( chan->stream != NULL ) {
+		idSoundDecodeAhead::FreeStream( chan->stream );
+		chan->stream = NULL;
+	}
+}
+
+/*
+===================
+idSoundWorldLocal::ResumeChannel
+
+Restarts a virtual channel at the position it would have reached if it had been
+mixed all along.
+===================
+*/
+void idSoundWorldLocal::ResumeChannel( idSoundChannel *chan, int current44kHz ) {
+	chan->isVirtual = false;
+	chan->triggered = true;
+	chan->openalStreamingOffset = Max( current44kHz - chan->trigger44kHzTime, 0 );
+}
+
 /*
 ===================
 idSoundWorldLocal::MixLoop
@@ -454,8 +732,18 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 	int i, j;
 	idSoundEmitterLocal *sound;
 
+	// report the streaming decodes of the previous mix tick
+	idSoundDecodeAhead::UpdateStatistics();
+
+	// pick up the latest game state and channel changes
+	AcquireMixParms();
+	ProcessMixCommands();
+	mixTicks++;
+
+	const listenerMixParms_t &listener = listenerMixParms[mixerMixParms];
+
 	// if noclip flying outside the world, leave silence
-	if ( listenerArea == -1 ) {
+	if ( listener.area == -1 ) {
 		alListenerf( AL_GAIN, 0.0f );
 		return;
 	}
@@ -464,19 +752,19 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 
 	ALfloat listenerPosition[3];
 
-	listenerPosition[0] = -listenerPos.y;
-	listenerPosition[1] =  listenerPos.z;
-	listenerPosition[2] = -listenerPos.x;
+	listenerPosition[0] = -listener.pos.y;
+	listenerPosition[1] =  listener.pos.z;
+	listenerPosition[2] = -listener.pos.x;
 
 	ALfloat listenerOrientation[6];
 
-	listenerOrientation[0] = -listenerAxis[0].y;
-	listenerOrientation[1] =  listenerAxis[0].z;
-	listenerOrientation[2] = -listenerAxis[0].x;
+	listenerOrientation[0] = -listener.axis[0].y;
+	listenerOrientation[1] =  listener.axis[0].z;
+	listenerOrientation[2] = -listener.axis[0].x;
 
-	listenerOrientation[3] = -listenerAxis[2].y;
-	listenerOrientation[4] =  listenerAxis[2].z;
-	listenerOrientation[5] = -listenerAxis[2].x;
+	listenerOrientation[3] = -listener.axis[2].y;
+	listenerOrientation[4] =  listener.axis[2].z;
+	listenerOrientation[5] = -listener.axis[2].x;
 
 	alListenerf( AL_GAIN, 1.0f );
 	alListenerfv( AL_POSITION, listenerPosition );
@@ -502,17 +790,21 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 				idSoundChannel	*chan = &sound->channels[j];
 
 				// see if we have a sound triggered on this channel
-				if ( !chan->triggerState ) {
+				if ( !chan->mixing ) {
 					chan->ALStop();
 					continue;
 				}
 
-				AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer );
+				float spatialize;
+				float volume = ChannelVolume( sound, chan, current44kHz, &spatialize );
+				AddChannelContribution( sound, chan, volume, spatialize, current44kHz, numSpeakers, finalMixBuffer );
 			}
 		}
 		return;
 	}
 
+	mixVoices.SetNum( 0, false );
+
 	for ( i = 1; i < emitters.Num(); i++ ) {
 		sound = emitters[i];
 
@@ -528,13 +820,59 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 			idSoundChannel	*chan = &sound->channels[j];
 
 			// see if we have a sound triggered on this channel
-			if ( !chan->triggerState ) {
+			if ( !chan->mixing ) {
 				chan->ALStop();
 				continue;
 			}
 
-			AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer );
+			// free decoder memory if no sound was decoded for a while
+			if ( chan->decoder != NULL && chan->decoder->GetLastDecodeTime() < current44kHz - SOUND_DECODER_FREE_DELAY ) {
+				chan->decoder->ClearDecoder();
+			}
+
+			mixVoice_t &voice = mixVoices.Alloc();
+			voice.sound = sound;
+			voice.chan = chan;
+			voice.volume = ChannelVolume( sound, chan, current44kHz, &voice.spatialize );
+
+			// a one shot sound that already ran out has nothing left to resume
+			if ( chan->isVirtual && !( chan->parms.soundShaderFlags & SSF_LOOPING ) && chan->leadinSample &&
+					current44kHz - chan->trigger44kHzTime >= chan->leadinSample->LengthIn44kHzSamples() ) {
+				voice.volume = 0.0f;
+			}
+		}
+	}
+
+	// only the most audible channels get a hardware voice, the others are virtual
+	int maxVoices = Min( idSoundSystemLocal::s_maxVoices.GetInteger(), (int)soundSystemLocal.openalSourceCount );
+	if ( mixVoices.Num() > maxVoices ) {
+		mixVoices.Sort( MixVoiceCompare );
+	}
+
+	int numVirtual = 0;
+	for ( i = 0; i < mixVoices.Num(); i++ ) {
+		mixVoice_t &voice = mixVoices[i];
+		idSoundChannel *chan = voice.chan;
+
+		// channels that stay silent don't need a voice either
+		if ( i >= maxVoices || ( voice.volume < SND_EPSILON && chan->lastVolume < SND_EPSILON ) ) {
+			VirtualizeChannel( chan );
+			numVirtual++;
+			continue;
+		}
+
+		if ( chan->isVirtual ) {
+			ResumeChannel( chan, current44kHz );
 		}
+
+		AddChannelContribution( voice.sound, chan, voice.volume, voice.spatialize, current44kHz, numSpeakers, finalMixBuffer );
+	}
+
+	soundSystemLocal.soundStats.activeVoices = mixVoices.Num() - numVirtual;
+	soundSystemLocal.soundStats.virtualVoices = numVirtual;
+
+	if ( idSoundSystemLocal::s_showVoices.GetBool() ) {
+		common->Printf( "%d: voices: %d mixed, %d virtual\n", current44kHz, mixVoices.Num() - numVirtual, numVirtual );
 	}
 }
 
@@ -717,6 +1055,103 @@ void idSoundWorldLocal::AVIClose( void ) {
 //==============================================================================
 
 
+/*
+===================
+idSoundWorldLocal::PortalSoundOrigin
+
+Picks the point on a portal that serves as the virtual origin of a sound coming
+through it from soundOrigin
+===================
+*/
+idVec3 idSoundWorldLocal::PortalSoundOrigin( const idWinding *w, const idVec3 &soundOrigin ) const {
+	idVec3	source;
+
+#if 1
+	idPlane	pl;
+	w->GetPlane( pl );
+
+	float	scale;
+	idVec3	dir = listenerQU - soundOrigin;
+	if ( !pl.RayIntersection( soundOrigin, dir, scale ) ) {
+		source = w->GetCenter();
+	} else {
+		source = soundOrigin + scale * dir;
+
+		// if this point isn't inside the portal edges, slide it in
+		for ( int i = 0 ; i < w->GetNumPoints() ; i++ ) {
+			int j = ( i + 1 ) % w->GetNumPoints();
+			idVec3	edgeDir = (*w)[j].ToVec3() - (*w)[i].ToVec3();
+			idVec3	edgeNormal;
+
+			edgeNormal.Cross( pl.Normal(), edgeDir );
+
+			idVec3	fromVert = source - (*w)[j].ToVec3();
+
+			float	d = edgeNormal * fromVert;
+			if ( d > 0 ) {
+				// move it in
+				float div = edgeNormal.Normalize();
+				d /= div;
+
+				source -= d * edgeNormal;
+			}
+		}
+	}
+#else
+	// clip the ray from the listener to the center of the portal by
+	// all the portal edge planes, then project that point (or the original if not clipped)
+	// onto the portal plane to get the spatialized origin
+
+	idVec3	start = listenerQU;
+	idVec3	mid = w->GetCenter();
+	bool	wasClipped = false;
+
+	for ( int i = 0 ; i < w->GetNumPoints() ; i++ ) {
+		int j = ( i + 1 ) % w->GetNumPoints();
+		idVec3	v1 = (*w)[j].ToVec3() - soundOrigin;
+		idVec3	v2 = (*w)[i].ToVec3() - soundOrigin;
+
+		v1.Normalize();
+		v2.Normalize();
+
+		idVec3	edgeNormal;
+
+		edgeNormal.Cross( v1, v2 );
+
+		idVec3	fromVert = start - soundOrigin;
+		float	d1 = edgeNormal * fromVert;
+
+		if ( d1 > 0.0f ) {
+			fromVert = mid - (*w)[j].ToVec3();
+			float d2 = edgeNormal * fromVert;
+
+			// move it in
+			float	f = d1 / ( d1 - d2 );
+
+			idVec3	clipped = start * ( 1.0f - f ) + mid * f;
+			start = clipped;
+			wasClipped = true;
+		}
+	}
+
+	if ( wasClipped ) {
+		// now project it onto the portal plane
+		idPlane	pl;
+		w->GetPlane( pl );
+
+		float	f1 = pl.Distance( start );
+		float	f2 = pl.Distance( soundOrigin );
+
+		float	f = f1 / ( f1 - f2 );
+		source = start * ( 1.0f - f ) + soundOrigin * f;
+	} else {
+		source = soundOrigin;
+	}
+#endif
+
+	return source;
+}
+
 /*
 ===================
 idSoundWorldLocal::ResolveOrigin
@@ -732,8 +1167,6 @@ If there is no path through open portals from the sound to the listener, def->di
 set at maxDistance
 ===================
 */
-static const int MAX_PORTAL_TRACE_DEPTH = 10;
-
 void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea, const float dist, const idVec3& soundOrigin, idSoundEmitterLocal *def ) {
 
 	if ( dist >= def->distance ) {
@@ -746,6 +1179,19 @@ void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 		if ( fullDist < def->distance ) {
 			def->distance = fullDist;
 			def->spatializedOrigin = soundOrigin;
+
+			// remember the portals of the best path for the propagation cache
+			const soundPortalTrace_t *trace;
+			int n = 0;
+			for ( trace = prevStack; trace; trace = trace->prevStack ) {
+				n++;
+			}
+			resolvedPath.numPortals = n;
+			for ( trace = prevStack; trace; trace = trace->prevStack ) {
+				n--;
+				resolvedPath.portals[n] = trace->portal;
+				resolvedPath.blocked[n] = trace->blocked;
+			}
 		}
 		return;
 	}
@@ -771,6 +1217,8 @@ void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 			// continue;
 			occlusionDistance = idSoundSystemLocal::s_doorDistanceAdd.GetFloat();
 		}
+		newStack.portal = re.w;
+		newStack.blocked = ( re.blockingBits & ( PS_BLOCK_VIEW | PS_BLOCK_AIR ) ) != 0;
 
 		// what area are we about to go look at
 		int otherArea = re.areas[0];
@@ -790,99 +1238,151 @@ void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 		}
 
 		// pick a point on the portal to serve as our virtual sound origin
-#if 1
-		idVec3	source;
+		idVec3 source = PortalSoundOrigin( re.w, soundOrigin );
 
-		idPlane	pl;
-		re.w->GetPlane( pl );
+		idVec3 tlen = source - soundOrigin;
+		float tlenLength = tlen.LengthFast();
 
-		float	scale;
-		idVec3	dir = listenerQU - soundOrigin;
-		if ( !pl.RayIntersection( soundOrigin, dir, scale ) ) {
-			source = re.w->GetCenter();
-		} else {
-			source = soundOrigin + scale * dir;
+		ResolveOrigin( stackDepth+1, &newStack, otherArea, dist+tlenLength+occlusionDistance, source, def );
+	}
+}
+
+
+/*
+===================
+idSoundWorldLocal::PropagateSound
+
+ResolveOrigin with a cache of the best portal path from each area to the listener
+area.  A cached path only has the virtual origins on its portals recomputed for
+the current sound and listener positions.  The cache is dropped when the listener
+changes areas or a portal opens or closes.
+  this is called by the main thread
+===================
+*/
+void idSoundWorldLocal::PropagateSound( const int soundArea, idSoundEmitterLocal *def ) {
+	idTimer timer;
+
+	timer.Start();
 
-			// if this point isn't inside the portal edges, slide it in
-			for ( int i = 0 ; i < re.w->GetNumPoints() ; i++ ) {
-				int j = ( i + 1 ) % re.w->GetNumPoints();
-				idVec3	edgeDir = (*(re.w))[j].ToVec3() - (*(re.w))[i].ToVec3();
-				idVec3	edgeNormal;
+	if ( listenerArea != propagationArea || rw->GetPortalStateCount() != propagationPortalStates ) {
+		ClearPropagationCache();
+	}
 
-				edgeNormal.Cross( pl.Normal(), edgeDir );
+	soundPropagation_t *path = NULL;
+	if ( idSoundSystemLocal::s_cachePropagation.GetBool() && soundArea < propagationCache.Num() ) {
+		path = &propagationCache[soundArea];
+	}
 
-				idVec3	fromVert = source - (*(re.w))[j].ToVec3();
+	// a path that wasn't there for a larger distance won't be there now either
+	if ( path && path->valid && ( path->numPortals >= 0 || def->distance <= path->maxDistance ) ) {
+		idVec3 source = def->origin;
+		float dist = 0.0f;
 
-				float	d = edgeNormal * fromVert;
-				if ( d > 0 ) {
-					// move it in
-					float div = edgeNormal.Normalize();
-					d /= div;
+		for ( int i = 0; i < path->numPortals; i++ ) {
+			idVec3 portalOrigin = PortalSoundOrigin( path->portals[i], source );
+			dist += ( portalOrigin - source ).LengthFast();
+			if ( path->blocked[i] ) {
+				dist += idSoundSystemLocal::s_doorDistanceAdd.GetFloat();
+			}
+			source = portalOrigin;
+		}
 
-					source -= d * edgeNormal;
-				}
+		if ( path->numPortals >= 0 ) {
+			float fullDist = dist + ( source - listenerQU ).LengthFast();
+			if ( fullDist < def->distance ) {
+				def->distance = fullDist;
+				def->spatializedOrigin = source;
 			}
 		}
-#else
-		// clip the ray from the listener to the center of the portal by
-		// all the portal edge planes, then project that point (or the original if not clipped)
-		// onto the portal plane to get the spatialized origin
 
-		idVec3	start = listenerQU;
-		idVec3	mid = re.w->GetCenter();
-		bool	wasClipped = false;
+		timer.Stop();
+		propagationStats.cached++;
+		propagationStats.cachedTime += timer.Milliseconds();
+		return;
+	}
 
-		for ( int i = 0 ; i < re.w->GetNumPoints() ; i++ ) {
-			int j = ( i + 1 ) % re.w->GetNumPoints();
-			idVec3	v1 = (*(re.w))[j].ToVec3() - soundOrigin;
-			idVec3	v2 = (*(re.w))[i].ToVec3() - soundOrigin;
+	float maxDistance = def->distance;
 
-			v1.Normalize();
-			v2.Normalize();
+	resolvedPath.valid = true;
+	resolvedPath.maxDistance = maxDistance;
+	resolvedPath.numPortals = -1;
 
-			idVec3	edgeNormal;
+	ResolveOrigin( 0, NULL, soundArea, 0.0f, def->origin, def );
 
-			edgeNormal.Cross( v1, v2 );
+	if ( path ) {
+		*path = resolvedPath;
+	}
 
-			idVec3	fromVert = start - soundOrigin;
-			float	d1 = edgeNormal * fromVert;
+	timer.Stop();
+	propagationStats.resolves++;
+	propagationStats.resolveTime += timer.Milliseconds();
+}
 
-			if ( d1 > 0.0f ) {
-				fromVert = mid - (*(re.w))[j].ToVec3();
-				float d2 = edgeNormal * fromVert;
+/*
+===================
+idSoundWorldLocal::ClearPropagationCache
+===================
+*/
+void idSoundWorldLocal::ClearPropagationCache( void ) {
+	propagationCache.SetNum( rw ? rw->NumAreas() : 0, false );
+	for ( int i = 0; i < propagationCache.Num(); i++ ) {
+		propagationCache[i].valid = false;
+	}
+	propagationArea = listenerArea;
+	propagationPortalStates = rw ? rw->GetPortalStateCount() : 0;
+}
 
-				// move it in
-				float	f = d1 / ( d1 - d2 );
+/*
+===================
+idSoundWorldLocal::MarkSamplesInUse
 
-				idVec3	clipped = start * ( 1.0f - f ) + mid * f;
-				start = clipped;
-				wasClipped = true;
+Marks the samples the channels of this world still play or haven't released yet,
+the sound cache won't free those.
+===================
+*/
+void idSoundWorldLocal::MarkSamplesInUse( int mark ) const {
+	for ( int i = 0; i < emitters.Num(); i++ ) {
+		const idSoundEmitterLocal *def = emitters[i];
+		if ( !def ) {
+			continue;
+		}
+		for ( int j = 0; j < SOUND_MAX_CHANNELS; j++ ) {
+			const idSoundChannel *chan = &def->channels[j];
+			if ( !chan->triggerState && !chan->releasing ) {
+				continue;
+			}
+			if ( chan->leadinSample ) {
+				chan->leadinSample->inUseMark = mark;
+			}
+			if ( chan->soundShader && chan->soundShader->numEntries > 0 ) {
+				chan->soundShader->entries[0]->inUseMark = mark;
 			}
 		}
+	}
+}
 
-		idVec3	source;
-		if ( wasClipped ) {
-			// now project it onto the portal plane
-			idPlane	pl;
-			re.w->GetPlane( pl );
-
-			float	f1 = pl.Distance( start );
-			float	f2 = pl.Distance( soundOrigin );
-
-			float	f = f1 / ( f1 - f2 );
-			source = start * ( 1.0f - f ) + soundOrigin * f;
-		} else {
-			source = soundOrigin;
-		}
-#endif
+/*
+===================
+idSoundWorldLocal::UpdatePropagationStatistics
 
-		idVec3 tlen = source - soundOrigin;
-		float tlenLength = tlen.LengthFast();
+Prints the portal searches of the last frame and the time the cached paths saved,
+estimated from the average cost of a full search.
+===================
+*/
+void idSoundWorldLocal::UpdatePropagationStatistics( void ) {
+	if ( propagationStats.resolves ) {
+		float resolveTime = propagationStats.resolveTime / propagationStats.resolves;
+		averageResolveTime = averageResolveTime ? averageResolveTime * 0.9f + resolveTime * 0.1f : resolveTime;
+	}
 
-		ResolveOrigin( stackDepth+1, &newStack, otherArea, dist+tlenLength+occlusionDistance, source, def );
+	if ( idSoundSystemLocal::s_showPropagation.GetBool() ) {
+		float savedTime = propagationStats.cached * averageResolveTime - propagationStats.cachedTime;
+		common->Printf( "%d: propagation: %d resolved %1.3f ms, %d cached %1.3f ms, %1.3f ms saved\n", gameMsec,
+			propagationStats.resolves, propagationStats.resolveTime, propagationStats.cached, propagationStats.cachedTime, savedTime );
 	}
-}
 
+	memset( &propagationStats, 0, sizeof( propagationStats ) );
+}
 
 void idSoundWorldLocal::FindEffects( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea ) {
 	if ( stackDepth == MAX_PORTAL_TRACE_DEPTH ) {
@@ -955,6 +1455,8 @@ void idSoundWorldLocal::PlaceListener( const idVec3& origin, const idMat3& axis,
 	}
 
 	if ( listenerArea < 0 ) {
+		// let the mixer know the listener left the world
+		PublishMixParms();
 		return;
 	}
 
@@ -1025,7 +1527,14 @@ void idSoundWorldLocal::ForegroundUpdate( int current44kHzTime ) {
 		return;
 	}
 
-	Sys_EnterCriticalSection();
+	// apply the mix commands here if nobody is mixing this world
+	CheckMixCommands();
+
+	// without the mix command queue the whole update keeps the mixer out
+	const bool lockMixer = !idSoundSystemLocal::s_mixerQueue.GetBool();
+	if ( lockMixer ) {
+		soundSystemLocal.LockMixer();
+	}
 
 	// if we are recording an AVI demo, don't use hardware time
 	if ( fpa[0] ) {
@@ -1100,7 +1609,7 @@ void idSoundWorldLocal::ForegroundUpdate( int current44kHzTime ) {
 		}
 	}
 
-	Sys_LeaveCriticalSection();
+	PublishMixParms();
 
 	//
 	// the sound meter
@@ -1121,6 +1630,19 @@ void idSoundWorldLocal::ForegroundUpdate( int current44kHzTime ) {
 	if ( fpa[0] ) {
 		AVIUpdate();
 	}
+
+	if ( lockMixer ) {
+		soundSystemLocal.UnlockMixer();
+	}
+
+	soundSystemLocal.UpdateLockStatistics();
+	UpdatePropagationStatistics();
+
+	// samples loaded for sounds started this frame may have gone over the budget
+	if ( soundSystemLocal.soundCache ) {
+		soundSystemLocal.soundCache->EnforceBudget();
+		soundSystemLocal.soundCache->UpdateStatistics();
+	}
 }
 
 /*
@@ -1346,6 +1868,10 @@ void idSoundWorldLocal::ReadFromSaveGame( idFile *savefile ) {
 		savefile->ReadInt( (int&)def->removeStatus );
 		savefile->ReadVec3( def->spatializedOrigin );
 
+		for ( int k = 0; k < 3; k++ ) {
+			def->StoreMixParms( def->mixParms[k] );
+		}
+
 		// read the individual channels
 		savefile->ReadInt( channel );
 
@@ -1368,6 +1894,14 @@ void idSoundWorldLocal::ReadFromSaveGame( idFile *savefile ) {
 			// load savegames with s_noSound 1
 			if ( soundSystemLocal.soundCache ) {
 				chan->leadinSample = soundSystemLocal.soundCache->FindSound( soundShader, false );
+				if ( chan->leadinSample && chan->triggerState ) {
+					chan->leadinSample->OpenStream();
+				}
+
+				// the loop sample may have been freed by the sound cache
+				if ( chan->soundShader && chan->soundShader->numEntries > 0 ) {
+					soundSystemLocal.soundCache->TouchSound( chan->soundShader->entries[0] );
+				}
 			} else {
 				chan->leadinSample = NULL;
 			}
@@ -1377,6 +1911,7 @@ void idSoundWorldLocal::ReadFromSaveGame( idFile *savefile ) {
 
 			// make sure we start up the hardware voice if needed
 			chan->triggered = chan->triggerState;
+			chan->mixing = chan->triggerState;
 			chan->openalStreamingOffset = currentSoundTime - chan->trigger44kHzTime;
 
 			// adjust the hardware fade time
@@ -1619,37 +2154,31 @@ void idSoundWorldLocal::CalcEars( int numSpeakers, idVec3 spatializedOrigin, idV
 
 /*
 ===============
-idSoundWorldLocal::AddChannelContribution
-
-Adds the contribution of a single sound channel to finalMixBuffer
-this is called from the async thread
+idSoundWorldLocal::ChannelVolume
 
-Mixes MIXBUFFER_SAMPLES samples starting at current44kHz sample time into
-finalMixBuffer
+Returns the volume a triggered channel will be mixed at, with distance, portal
+occlusion and fades applied, and the spatialization bias for CalcEars.  The mixer
+ranks the channels by it before any of them are decoded.
 ===============
 */
-void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
-				   int current44kHz, int numSpeakers, float *finalMixBuffer ) {
-	int j;
+float idSoundWorldLocal::ChannelVolume( idSoundEmitterLocal *sound, idSoundChannel *chan, int current44kHz, float *spatialize ) {
 	float volume;
 
-	//
-	// get the sound definition and parameters from the entity
-	//
-	soundShaderParms_t *parms = &chan->parms;
+	*spatialize = 1.0f;
 
-	// assume we have a sound triggered on this channel
-	assert( chan->triggerState );
+	const soundShaderParms_t *parms = &chan->parms;
+	const emitterMixParms_t &mixParms = sound->mixParms[mixerMixParms];
+	const listenerMixParms_t &listener = listenerMixParms[mixerMixParms];
 
 	// fetch the actual wave file and see if it's valid
-	idSoundSample *sample = chan->leadinSample;
+	const idSoundSample *sample = chan->leadinSample;
 	if ( sample == NULL ) {
-		return;
+		return 0.0f;
 	}
 
 	// if you don't want to hear all the beeps from missing sounds
 	if ( sample->defaultSound && !idSoundSystemLocal::s_playDefaultSound.GetBool() ) {
-		return;
+		return 0.0f;
 	}
 
 	// get the actual shader
@@ -1657,15 +2186,12 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 
 	// this might happen if the foreground thread just deleted the sound emitter
 	if ( !shader ) {
-		return;
+		return 0.0f;
 	}
 
 	float maxd = parms->maxDistance;
 	float mind = parms->minDistance;
 
-	int  mask = shader->speakerMask;
-	bool omni = ( parms->soundShaderFlags & SSF_OMNIDIRECTIONAL) != 0;
-	bool looping = ( parms->soundShaderFlags & SSF_LOOPING ) != 0;
 	bool global = ( parms->soundShaderFlags & SSF_GLOBAL ) != 0;
 	bool noOcclusion = ( parms->soundShaderFlags & SSF_NO_OCCLUSION ) || !idSoundSystemLocal::s_useOcclusion.GetBool();
 
@@ -1674,13 +2200,8 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 		maxd *= slowmoSpeed;
 	}
 
-	// stereo samples are always omni
-	if ( sample->objectInfo.nChannels == 2 ) {
-		omni = true;
-	}
-
 	// if the sound is playing from the current listener, it will not be spatialized at all
-	if ( sound->listenerId == listenerPrivateId ) {
+	if ( mixParms.listenerId == listener.privateId ) {
 		global = true;
 	}
 
@@ -1716,20 +2237,9 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 	// if it's a global sound then
 	// it's not affected by distance or occlusion
 	//
-	float	spatialize = 1;
-	idVec3 spatializedOriginInMeters;
 	if ( !global ) {
-		float	dlen;
-
-		if ( noOcclusion ) {
-			// use the real origin and distance
-			spatializedOriginInMeters = sound->origin * DOOM_TO_METERS;
-			dlen = sound->realDistance;
-		} else {
-			// use the possibly portal-occluded origin and distance
-			spatializedOriginInMeters = sound->spatializedOrigin * DOOM_TO_METERS;
-			dlen = sound->distance;
-		}
+		// use the real distance, or the possibly portal-occluded one
+		float dlen = noOcclusion ? mixParms.realDistance : mixParms.distance;
 
 		// reduce volume based on distance
 		if ( dlen >= maxd ) {
@@ -1742,7 +2252,7 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 			volume *= frac;
 		} else if ( mind > 0.0f ) {
 			// we tweak the spatialization bias when you are inside the minDistance
-			spatialize = dlen / mind;
+			*spatialize = dlen / mind;
 		}
 	}
 
@@ -1751,16 +2261,100 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 	// unless we match the listenerId
 	//
 	if ( parms->soundShaderFlags & SSF_PRIVATE_SOUND ) {
-		if ( sound->listenerId != listenerPrivateId ) {
+		if ( mixParms.listenerId != listener.privateId ) {
 			volume = 0;
 		}
 	}
 	if ( parms->soundShaderFlags & SSF_ANTI_PRIVATE_SOUND ) {
-		if ( sound->listenerId == listenerPrivateId ) {
+		if ( mixParms.listenerId == listener.privateId ) {
 			volume = 0;
 		}
 	}
 
+	return volume;
+}
+
+/*
+===============
+idSoundWorldLocal::AddChannelContribution
+
+Adds the contribution of a single sound channel to finalMixBuffer
+this is called from the async thread
+
+Mixes MIXBUFFER_SAMPLES samples starting at current44kHz sample time into
+finalMixBuffer, volume and spatialize come from ChannelVolume
+===============
+*/
+void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan, float volume, float spatialize,
+				   int current44kHz, int numSpeakers, float *finalMixBuffer ) {
+	int j;
+
+	//
+	// get the sound definition and parameters from the entity
+	//
+	soundShaderParms_t *parms = &chan->parms;
+
+	// the spatialization the game published for this mix tick
+	const emitterMixParms_t &mixParms = sound->mixParms[mixerMixParms];
+	const listenerMixParms_t &listener = listenerMixParms[mixerMixParms];
+
+	// assume we have a sound triggered on this channel
+	assert( chan->mixing );
+
+	// fetch the actual wave file and see if it's valid
+	idSoundSample *sample = chan->leadinSample;
+	if ( sample == NULL ) {
+		return;
+	}
+
+	// if you don't want to hear all the beeps from missing sounds
+	if ( sample->defaultSound && !idSoundSystemLocal::s_playDefaultSound.GetBool() ) {
+		return;
+	}
+
+	// get the actual shader
+	const idSoundShader *shader = chan->soundShader;
+
+	// this might happen if the foreground thread just deleted the sound emitter
+	if ( !shader ) {
+		return;
+	}
+
+	float maxd = parms->maxDistance;
+	float mind = parms->minDistance;
+
+	int  mask = shader->speakerMask;
+	bool omni = ( parms->soundShaderFlags & SSF_OMNIDIRECTIONAL) != 0;
+	bool looping = ( parms->soundShaderFlags & SSF_LOOPING ) != 0;
+	bool global = ( parms->soundShaderFlags & SSF_GLOBAL ) != 0;
+	bool noOcclusion = ( parms->soundShaderFlags & SSF_NO_OCCLUSION ) || !idSoundSystemLocal::s_useOcclusion.GetBool();
+
+	// speed goes from 1 to 0.2
+	if ( idSoundSystemLocal::s_slowAttenuate.GetBool() && slowmoActive && !chan->disallowSlow ) {
+		maxd *= slowmoSpeed;
+	}
+
+	// stereo samples are always omni
+	if ( sample->objectInfo.nChannels == 2 ) {
+		omni = true;
+	}
+
+	// if the sound is playing from the current listener, it will not be spatialized at all
+	if ( mixParms.listenerId == listener.privateId ) {
+		global = true;
+	}
+
+	idVec3 spatializedOriginInMeters;
+	if ( !global ) {
+		if ( noOcclusion ) {
+			// use the real origin
+			spatializedOriginInMeters = mixParms.origin * DOOM_TO_METERS;
+		} else {
+			// use the possibly portal-occluded origin
+			spatializedOriginInMeters = mixParms.spatializedOrigin * DOOM_TO_METERS;
+		}
+	}
+
 	//
 	// do we have anything to add?
 	//
@@ -1822,17 +2416,42 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 				}
 			}
 
+			bool waitForStream = false;
+
 			if ( ( !looping && chan->leadinSample->hardwareBuffer ) || ( looping && chan->soundShader->entries[0]->hardwareBuffer ) ) {
 				// handle uncompressed (non streaming) single shot and looping sounds
 				if ( chan->triggered ) {
-					alSourcei( chan->openalSource, AL_BUFFER, looping ? chan->soundShader->entries[0]->openalBuffer : chan->leadinSample->openalBuffer );
+					idSoundSample *buffer = looping ? chan->soundShader->entries[0] : chan->leadinSample;
+					alSourcei( chan->openalSource, AL_BUFFER, buffer->openalBuffer );
+
+					// a resumed virtual channel or a restored one continues where it would be by now
+					int length = buffer->LengthIn44kHzSamples() / buffer->objectInfo.nChannels;
+					if ( chan->openalStreamingOffset > 0 && length > 0 ) {
+						int position = looping ? chan->openalStreamingOffset % length : Min( (int)chan->openalStreamingOffset, length - 1 );
+						alSourcei( chan->openalSource, AL_SAMPLE_OFFSET, (ALint)( (int64)position * buffer->objectInfo.nSamplesPerSec / PRIMARYFREQ ) );
+					}
 				}
 			} else {
 				ALint finishedbuffers;
 				ALuint buffers[3];
+				idSoundSample *loop = looping ? chan->soundShader->entries[0] : NULL;
+
+				// samples streamed from disk are only read by the decode-ahead thread, the
+				// source starts once it decoded the first buffers
+				if ( sample->streamed || ( loop && loop->streamed ) ) {
+					int streamOffset = chan->openalStreamingOffset * sample->objectInfo.nChannels;
+					if ( chan->stream == NULL ) {
+						chan->stream = idSoundDecodeAhead::AllocStream( chan->leadinSample, loop, streamOffset, MIXBUFFER_SAMPLES * sample->objectInfo.nChannels );
+					}
+					waitForStream = chan->triggered && !idSoundDecodeAhead::IsStreamReady( chan->stream, loop, streamOffset, 3 );
+				}
 
 				// handle streaming sounds (decode on the fly) both single shot AND looping
-				if ( chan->triggered ) {
+				if ( waitForStream ) {
+					// keep the source initial, a stopped one would be taken as finished
+					alSourceRewind( chan->openalSource );
+					finishedbuffers = 0;
+				} else if ( chan->triggered ) {
 					alSourcei( chan->openalSource, AL_BUFFER, 0 );
 					alDeleteBuffers( 3, &chan->lastopenalStreamingBuffer[0] );
 					chan->lastopenalStreamingBuffer[0] = chan->openalStreamingBuffer[0];
@@ -1852,29 +2471,45 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 				}
 
 				for ( j = 0; j < finishedbuffers; j++ ) {
-					chan->GatherChannelSamples( chan->openalStreamingOffset * sample->objectInfo.nChannels, MIXBUFFER_SAMPLES * sample->objectInfo.nChannels, alignedInputSamples );
-					for ( int i = 0; i < ( MIXBUFFER_SAMPLES * sample->objectInfo.nChannels ); i++ ) {
-						if ( alignedInputSamples[i] < -32768.0f )
-							((short *)alignedInputSamples)[i] = -32768;
-						else if ( alignedInputSamples[i] > 32767.0f )
-							((short *)alignedInputSamples)[i] = 32767;
-						else
-							((short *)alignedInputSamples)[i] = idMath::FtoiFast( alignedInputSamples[i] );
+					int offset = chan->openalStreamingOffset * sample->objectInfo.nChannels;
+					int count = MIXBUFFER_SAMPLES * sample->objectInfo.nChannels;
+					if ( chan->stream == NULL || !idSoundDecodeAhead::ReadStream( chan->stream, loop, offset, (short *)alignedInputSamples ) ) {
+						idTimer decodeTimer;
+						decodeTimer.Start();
+						chan->GatherChannelSamples( offset, count, alignedInputSamples );
+						idSoundDecodeAhead::FloatToShort( (short *)alignedInputSamples, alignedInputSamples, count );
+						decodeTimer.Stop();
+						idSoundDecodeAhead::AddMixerDecodeTime( decodeTimer.Milliseconds() );
 					}
-					alBufferData( buffers[j], chan->leadinSample->objectInfo.nChannels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16, alignedInputSamples, MIXBUFFER_SAMPLES * sample->objectInfo.nChannels * sizeof( short ), 44100 );
+					alBufferData( buffers[j], chan->leadinSample->objectInfo.nChannels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16, alignedInputSamples, count * sizeof( short ), 44100 );
 					chan->openalStreamingOffset += MIXBUFFER_SAMPLES;
 				}
 
+				// compressed samples are decoded ahead from here on
+				if ( chan->stream == NULL && idSoundSystemLocal::s_decodeAhead.GetBool() &&
+						( sample->objectInfo.wFormatTag == WAVE_FORMAT_TAG_OGG || ( loop && loop->objectInfo.wFormatTag == WAVE_FORMAT_TAG_OGG ) ) ) {
+					chan->stream = idSoundDecodeAhead::AllocStream( chan->leadinSample, loop, chan->openalStreamingOffset * sample->objectInfo.nChannels, MIXBUFFER_SAMPLES * sample->objectInfo.nChannels );
+				}
+
 				if ( finishedbuffers ) {
 					alSourceQueueBuffers( chan->openalSource, finishedbuffers, &buffers[0] );
 				}
 			}
 
 			// (re)start if needed..
-			if ( chan->triggered ) {
+			if ( chan->triggered && !waitForStream ) {
 				alSourcePlay( chan->openalSource );
 				chan->triggered = false;
 			}
+
+			// tell the game when the voice of a one shot sound played out
+			if ( !looping && !chan->triggered ) {
+				ALint state = AL_PLAYING;
+				alGetSourcei( chan->openalSource, AL_SOURCE_STATE, &state );
+				if ( state == AL_STOPPED ) {
+					chan->finished = true;
+				}
+			}
 		}
 	} else {
 
@@ -1891,8 +2526,14 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 				}
 
 			sound->SetSlowChannel( chan, slow );
+
+			chan->slowed = slow.IsActive();
+			if ( !looping && slow.IsActive() && slow.GetCurrentPosition().time >= sample->LengthIn44kHzSamples() / 2 ) {
+				chan->finished = true;
+			}
 		} else {
 			sound->ResetSlowChannel( chan );
+			chan->slowed = false;
 
 			// if we are getting a stereo sample adjust accordingly
 			if ( sample->objectInfo.nChannels == 2 ) {
@@ -1915,7 +2556,7 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 			ears[3] = idSoundSystemLocal::s_subFraction.GetFloat() * volume;		// subwoofer
 
 		} else {
-			CalcEars( numSpeakers, spatializedOriginInMeters, listenerPos, listenerAxis, ears, spatialize );
+			CalcEars( numSpeakers, spatializedOriginInMeters, listener.pos, listener.axis, ears, spatialize );
 
 			for ( int i = 0 ; i < 6 ; i++ ) {
 				ears[i] *= volume;
@@ -187,9 +187,13 @@ Sys_DestroyThread
 ==================
 */
 void Sys_DestroyThread( xthreadInfo& info ) {
+	int ret;
+
 	// the target thread must have a cancelation point, otherwise pthread_cancel is useless
 	assert( info.threadHandle );
-	if ( pthread_cancel( ( pthread_t )info.threadHandle ) != 0 ) {
+	// the thread may already have returned from its function, it still has to be joined
+	ret = pthread_cancel( ( pthread_t )info.threadHandle );
+	if ( ret != 0 && ret != ESRCH ) {
 		common->Error( "ERROR: pthread_cancel %s failed\n", info.name );
 	}
 	if ( pthread_join( ( pthread_t )info.threadHandle, NULL ) != 0 ) {